@@ -33,6 +33,15 @@ else ()
 option (ENABLE_MPI "Enable the compilation of the MPI communication code" off)
 endif ()
 
+############################
+## OpenMP related options
+option(ENABLE_OPENMP "Use OpenMP threads in parts of the CPU code" off)
+if (ENABLE_OPENMP)
+    find_package(OpenMP REQUIRED)
+    set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${OpenMP_C_FLAGS}")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+endif (ENABLE_OPENMP)
+
 #################################
 ## Optionally enable documentation build
 OPTION(ENABLE_DOXYGEN "Enables building of documentation with doxygen" OFF)
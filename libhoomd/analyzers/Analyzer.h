@@ -61,6 +61,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __ANALYZER_H__
 
 #include "Profiler.h"
+#include "PerformanceCounter.h"
 #include "SystemDefinition.h"
 
 #include <boost/shared_ptr.hpp>
@@ -150,6 +151,41 @@ class Analyzer : boost::noncopyable
             return PDataFlags(0);
             }
 
+        //! Returns a list of log quantities this analyzer calculates
+        /*! The base class implementation just returns an empty vector. Derived classes should override
+            this behavior and return a list of quantities that they log.
+
+            See Logger for more information on what this is about.
+        */
+        virtual std::vector< std::string > getProvidedLogQuantities()
+            {
+            return std::vector< std::string >();
+            }
+
+        //! Calculates the requested log value and returns it
+        /*! \param quantity Name of the log quantity to get
+            \param timestep Current time step of the simulation
+
+            The base class just returns 0. Derived classes should override this behavior and return
+            the calculated value for the given quantity. Only quantities listed in
+            the return value getProvidedLogQuantities() will be requested from
+            getLogValue().
+
+            See Logger for more information on what this is about.
+        */
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep)
+            {
+            return Scalar(0.0);
+            }
+
+        //! Get the counter of the wall clock time spent in analyze()
+        /*! System times every call to analyze() with this counter. Derived classes can provide it as a log quantity.
+        */
+        PerformanceCounter& getAnalyzeTimer()
+            {
+            return m_analyze_timer;
+            }
+
 #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -170,6 +206,7 @@ class Analyzer : boost::noncopyable
 #endif
 
         boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Stored shared ptr to the execution configuration
+        PerformanceCounter m_analyze_timer; //!< Wall clock time spent in analyze()
     };
 
 //! Export the Analyzer class to python
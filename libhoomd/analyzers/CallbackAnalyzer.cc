@@ -57,6 +57,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CallbackAnalyzer.h"
 #include "HOOMDInitializer.h"
+#include "ScopedGIL.h"
+#include "ClockSource.h"
+#include "num_util.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -69,6 +72,7 @@ using namespace boost::python;
 using namespace boost::filesystem;
 
 #include <iomanip>
+#include <stdexcept>
 using namespace std;
 
 /*! \param sysdef SystemDefinition containing the Particle data to analyze
@@ -76,28 +80,335 @@ using namespace std;
 */
 CallbackAnalyzer::CallbackAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
                          boost::python::object callback)
-    : Analyzer(sysdef), callback(callback)
+    : Analyzer(sysdef), callback(callback), m_async(false), m_max_queue(1), m_policy(block), m_fields(0),
+      m_busy(false), m_stop(false), m_worker_error(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing CallbackAnalyzer" << endl;
+    resetStats();
     }
 
 CallbackAnalyzer::~CallbackAnalyzer()
     {
     m_exec_conf->msg->notice(5) << "Destroying CallbackAnalyzer" << endl;
+
+    if (m_worker.joinable())
+        {
+        // discard samples that were not processed, and let the worker exit
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_queue.clear();
+            m_stop = true;
+            }
+        m_cond_work.notify_all();
+
+        // the worker may be waiting for the GIL to finish its current sample
+        ScopedGILRelease gil_release;
+        m_worker.join();
+        }
+    }
+
+/*! \param max_queue Maximum number of samples waiting for the worker
+    \param policy What to do with a new sample when the queue is full
+    \param fields Particle fields to copy for the callback (combination of fieldFlags)
+
+    After setAsync(), the callback is called as callback(timestep, data) on a worker thread, where data is a dict
+    with the box and a read-only numpy array (in tag order) for each requested field.
+*/
+void CallbackAnalyzer::setAsync(unsigned int max_queue, queuePolicy policy, unsigned int fields)
+    {
+    if (max_queue == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.callback: queue size must be at least 1" << endl;
+        throw runtime_error("Error setting up asynchronous callback");
+        }
+
+    // the worker must not see the parameters change while it works on queued samples
+    flush();
+
+    m_max_queue = max_queue;
+    m_policy = policy;
+    m_fields = fields;
+    m_async = true;
+
+    // only the root rank calls the callback
+    if (m_exec_conf->getRank() == 0 && !m_worker.joinable())
+        {
+        #if PY_VERSION_HEX < 0x03070000
+        PyEval_InitThreads();
+        #endif
+        m_worker = boost::thread(&CallbackAnalyzer::workerThread, this);
+        }
     }
 
 /*!\param timestep Current time step of the simulation
 
-    analyze() will call the callback
+    analyze() will call the callback, or queue a sample for the worker in asynchronous mode
 */
 void CallbackAnalyzer::analyze(unsigned int timestep)
     {
-      callback(timestep);
+    if (!m_async)
+        {
+        ScopedGILAcquire gil;
+        callback(timestep);
+        return;
+        }
+
+    checkWorkerError();
+
+    boost::shared_ptr<CallbackSample> sample(new CallbackSample);
+    sample->timestep = timestep;
+    sample->box = m_pdata->getGlobalBox();
+
+    if (m_fields)
+        {
+        // gather all particle data, then keep only the requested fields
+        SnapshotParticleData<Scalar> snap(m_pdata->getNGlobal());
+        m_pdata->takeSnapshot(snap);
+
+        SnapshotParticleData<Scalar>& out = sample->snapshot;
+        out.size = snap.size;
+        if (m_fields & field_position)
+            out.pos.swap(snap.pos);
+        if (m_fields & field_velocity)
+            out.vel.swap(snap.vel);
+        if (m_fields & field_image)
+            out.image.swap(snap.image);
+        if (m_fields & field_type)
+            out.type.swap(snap.type);
+        if (m_fields & field_mass)
+            out.mass.swap(snap.mass);
+        if (m_fields & field_charge)
+            out.charge.swap(snap.charge);
+        if (m_fields & field_diameter)
+            out.diameter.swap(snap.diameter);
+        if (m_fields & field_body)
+            out.body.swap(snap.body);
+        if (m_fields & field_orientation)
+            out.orientation.swap(snap.orientation);
+        }
+
+    if (m_exec_conf->getRank() != 0)
+        return;
+
+        {
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (m_queue.size() >= m_max_queue)
+            {
+            if (m_policy == block)
+                {
+                // GIL is normally released by System::run(), but the worker needs it in any case
+                ScopedGILRelease gil_release;
+                ClockSource clk;
+                while (m_queue.size() >= m_max_queue && !m_worker_error)
+                    m_cond_space.wait(lock);
+                m_block_time += clk.getTime();
+                }
+            else if (m_policy == drop_oldest)
+                {
+                m_queue.pop_front();
+                m_num_dropped++;
+                }
+            else
+                {
+                m_num_dropped++;
+                return;
+                }
+            }
+
+        m_queue.push_back(sample);
+        m_num_queued++;
+        unsigned int depth = m_queue.size();
+        m_sum_depth += depth;
+        if (depth > m_max_depth)
+            m_max_depth = depth;
+        }
+    m_cond_work.notify_one();
+    }
+
+/*! Blocks until the queue is empty and the worker is idle. Errors raised by the callback on the worker are
+    reported by throwing an exception.
+*/
+void CallbackAnalyzer::flush()
+    {
+    if (m_worker.joinable())
+        {
+        ScopedGILRelease gil_release;
+        boost::mutex::scoped_lock lock(m_mutex);
+        while ((!m_queue.empty() || m_busy) && !m_worker_error)
+            m_cond_space.wait(lock);
+        }
+
+    checkWorkerError();
+    }
+
+unsigned int CallbackAnalyzer::getQueueDepth()
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_queue.size();
+    }
+
+void CallbackAnalyzer::printStats()
+    {
+    if (!m_async || m_exec_conf->getRank() != 0)
+        return;
+
+    double mean_depth = m_num_queued ? double(m_sum_depth) / double(m_num_queued) : 0.0;
+    m_exec_conf->msg->notice(1) << "-- Asynchronous callback stats:" << endl;
+    m_exec_conf->msg->notice(1) << "Samples queued: " << m_num_queued << " / dropped: " << m_num_dropped << endl;
+    m_exec_conf->msg->notice(1) << "Queue depth mean / max: " << mean_depth << " / " << m_max_depth
+                                << " (limit " << m_max_queue << ")" << endl;
+    if (m_policy == block)
+        m_exec_conf->msg->notice(1) << "Time waiting for the worker: " << double(m_block_time) / 1e9 << " s" << endl;
+    }
+
+void CallbackAnalyzer::resetStats()
+    {
+    m_num_queued = 0;
+    m_num_dropped = 0;
+    m_max_depth = 0;
+    m_sum_depth = 0;
+    m_block_time = 0;
+    }
+
+void CallbackAnalyzer::checkWorkerError()
+    {
+    bool error = false;
+        {
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (m_worker_error)
+            {
+            error = true;
+            m_worker_error = false;
+            m_queue.clear();
+            }
+        }
+
+    if (error)
+        {
+        m_exec_conf->msg->error() << "analyze.callback: the asynchronous callback raised an exception" << endl;
+        throw runtime_error("Error in asynchronous callback");
+        }
+    }
+
+void CallbackAnalyzer::workerThread()
+    {
+    while (true)
+        {
+        boost::shared_ptr<CallbackSample> sample;
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            while (m_queue.empty() && !m_stop)
+                m_cond_work.wait(lock);
+
+            if (m_queue.empty())
+                return;
+
+            sample = m_queue.front();
+            m_queue.pop_front();
+            m_busy = true;
+            }
+        m_cond_space.notify_all();
+
+        bool error = false;
+            {
+            ScopedGILAcquire gil;
+            try
+                {
+                processSample(*sample);
+                }
+            catch (error_already_set const &)
+                {
+                PyErr_Print();
+                error = true;
+                }
+            }
+        sample.reset();
+
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            m_busy = false;
+            if (error)
+                m_worker_error = true;
+            }
+        m_cond_space.notify_all();
+        }
+    }
+
+//! Make a read-only numpy array with a copy of \a v, with \a ncomp components of type \a T per element
+template<class T, class V>
+static object makeReadOnlyArray(const std::vector<V>& v, unsigned int ncomp)
+    {
+    std::vector<intp> dims(1, v.size());
+    if (ncomp > 1)
+        dims.push_back(ncomp);
+
+    PyObject *arr;
+    if (v.empty())
+        arr = num_util::makeNum(dims, num_util::getEnum<T>());
+    else
+        arr = num_util::makeNum((T*)&v[0], dims);
+
+    PyArray_CLEARFLAGS((PyArrayObject*)arr, NPY_ARRAY_WRITEABLE);
+    return object(handle<>(arr));
+    }
+
+/*! \param sample Sample to pass to the callback
+*/
+void CallbackAnalyzer::processSample(const CallbackSample& sample)
+    {
+    const SnapshotParticleData<Scalar>& snap = sample.snapshot;
+
+    dict data;
+    data["box"] = sample.box;
+    if (m_fields & field_position)
+        data["position"] = makeReadOnlyArray<Scalar>(snap.pos, 3);
+    if (m_fields & field_velocity)
+        data["velocity"] = makeReadOnlyArray<Scalar>(snap.vel, 3);
+    if (m_fields & field_image)
+        data["image"] = makeReadOnlyArray<int>(snap.image, 3);
+    if (m_fields & field_type)
+        data["typeid"] = makeReadOnlyArray<unsigned int>(snap.type, 1);
+    if (m_fields & field_mass)
+        data["mass"] = makeReadOnlyArray<Scalar>(snap.mass, 1);
+    if (m_fields & field_charge)
+        data["charge"] = makeReadOnlyArray<Scalar>(snap.charge, 1);
+    if (m_fields & field_diameter)
+        data["diameter"] = makeReadOnlyArray<Scalar>(snap.diameter, 1);
+    if (m_fields & field_body)
+        data["body"] = makeReadOnlyArray<unsigned int>(snap.body, 1);
+    if (m_fields & field_orientation)
+        data["orientation"] = makeReadOnlyArray<Scalar>(snap.orientation, 4);
+
+    callback(sample.timestep, data);
     }
 
 void export_CallbackAnalyzer()
     {
-    class_<CallbackAnalyzer, boost::shared_ptr<CallbackAnalyzer>, bases<Analyzer>, boost::noncopyable>
+    scope in_callback = class_<CallbackAnalyzer, boost::shared_ptr<CallbackAnalyzer>, bases<Analyzer>, boost::noncopyable>
     ("CallbackAnalyzer", init< boost::shared_ptr<SystemDefinition>, boost::python::object>())
+    .def("setAsync", &CallbackAnalyzer::setAsync)
+    .def("flush", &CallbackAnalyzer::flush)
+    .def("getQueueDepth", &CallbackAnalyzer::getQueueDepth)
+    .def("getMaxQueueDepth", &CallbackAnalyzer::getMaxQueueDepth)
+    .def("getNumQueued", &CallbackAnalyzer::getNumQueued)
+    .def("getNumDropped", &CallbackAnalyzer::getNumDropped)
+    ;
+
+    enum_<CallbackAnalyzer::queuePolicy>("queuePolicy")
+    .value("block", CallbackAnalyzer::block)
+    .value("drop_oldest", CallbackAnalyzer::drop_oldest)
+    .value("skip", CallbackAnalyzer::skip)
+    ;
+
+    enum_<CallbackAnalyzer::fieldFlags>("fieldFlags")
+    .value("position", CallbackAnalyzer::field_position)
+    .value("velocity", CallbackAnalyzer::field_velocity)
+    .value("image", CallbackAnalyzer::field_image)
+    .value("type", CallbackAnalyzer::field_type)
+    .value("mass", CallbackAnalyzer::field_mass)
+    .value("charge", CallbackAnalyzer::field_charge)
+    .value("diameter", CallbackAnalyzer::field_diameter)
+    .value("body", CallbackAnalyzer::field_body)
+    .value("orientation", CallbackAnalyzer::field_orientation)
     ;
     }
@@ -65,17 +65,59 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <fstream>
+#include <deque>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+//! A copy of the particle data handed to an asynchronous callback
+/*! Only the fields requested with CallbackAnalyzer::setAsync() are filled, the others are empty.
+    \ingroup analyzers
+*/
+struct CallbackSample
+    {
+    unsigned int timestep;                  //!< Time step of the sample
+    BoxDim box;                             //!< Box at the time step
+    SnapshotParticleData<Scalar> snapshot;  //!< Requested particle fields in tag order
+    };
 
 //! Calls a python functor object
 /*! On construction, CallbackAnalyzer stores a python object to be called every analyzer period.
     The functor is expected to take the current timestep as single argument.
 
+    In asynchronous mode (see setAsync()), analyze() only copies the requested particle fields into a CallbackSample
+    and appends it to a bounded queue. A worker thread takes samples from the queue and calls the functor with
+    the time step and a dict of read-only numpy arrays, holding the GIL only for the duration of the call. When the
+    queue is full, the configured queuePolicy decides whether the simulation waits for the worker, the oldest
+    queued sample is dropped, or the new sample is skipped. The sample is gathered on the root rank and the functor
+    is only called there.
+
     \ingroup analyzers
 */
 class CallbackAnalyzer : public Analyzer
     {
     public:
+        //! What to do with a new sample when the queue is full
+        enum queuePolicy
+            {
+            block,          //!< Wait until the worker has taken a sample from the queue
+            drop_oldest,    //!< Drop the oldest queued sample
+            skip            //!< Drop the new sample
+            };
+
+        //! Fields that can be requested for an asynchronous callback
+        enum fieldFlags
+            {
+            field_position = 1,
+            field_velocity = 2,
+            field_image = 4,
+            field_type = 8,
+            field_mass = 16,
+            field_charge = 32,
+            field_diameter = 64,
+            field_body = 128,
+            field_orientation = 256
+            };
+
         //! Construct the callback analyzer
         CallbackAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
                     boost::python::object callback);
@@ -86,10 +128,71 @@ class CallbackAnalyzer : public Analyzer
         //! Call the analyzer callback
         void analyze(unsigned int timestep);
 
+        //! Call the callback asynchronously on a worker thread
+        void setAsync(unsigned int max_queue, queuePolicy policy, unsigned int fields);
+
+        //! Wait until the worker has processed all queued samples
+        void flush();
+
+        //! Get the number of samples currently in the queue
+        unsigned int getQueueDepth();
+
+        //! Get the largest queue depth observed since the last resetStats()
+        unsigned int getMaxQueueDepth()
+            {
+            return m_max_depth;
+            }
+
+        //! Get the number of samples queued since the last resetStats()
+        unsigned int getNumQueued()
+            {
+            return m_num_queued;
+            }
+
+        //! Get the number of samples dropped since the last resetStats()
+        unsigned int getNumDropped()
+            {
+            return m_num_dropped;
+            }
+
+        //! Print statistics on the queue
+        virtual void printStats();
+
+        //! Reset the queue statistics
+        virtual void resetStats();
+
     private:
+        //! The worker thread loop
+        void workerThread();
+
+        //! Call the callback with a sample, the GIL must be held
+        void processSample(const CallbackSample& sample);
+
+        //! Throw if the worker reported an error
+        void checkWorkerError();
 
         ////! The callback function to be called at each analyzer period.
         boost::python::object callback;
+
+        bool m_async;                       //!< True if the callback is called on the worker thread
+        unsigned int m_max_queue;           //!< Maximum number of queued samples
+        queuePolicy m_policy;               //!< Policy when the queue is full
+        unsigned int m_fields;              //!< Requested fields (combination of fieldFlags)
+
+        std::deque< boost::shared_ptr<CallbackSample> > m_queue; //!< Samples waiting for the worker
+        bool m_busy;                        //!< True while the worker processes a sample
+        bool m_stop;                        //!< Set to ask the worker to exit
+        bool m_worker_error;                //!< Set when the callback raised an exception on the worker
+        boost::mutex m_mutex;               //!< Protects the queue and the flags
+        boost::condition_variable m_cond_work;  //!< Signals the worker that there is work or it should stop
+        boost::condition_variable m_cond_space; //!< Signals that a sample has been taken or processed
+        boost::thread m_worker;             //!< The worker thread
+
+        unsigned int m_num_queued;          //!< Number of samples queued
+        unsigned int m_num_dropped;         //!< Number of samples dropped
+        unsigned int m_max_depth;           //!< Largest queue depth after a push
+        uint64_t m_sum_depth;               //!< Sum of the queue depths after each push
+        uint64_t m_block_time;              //!< Time (ns) the simulation waited for the worker with the block policy
     };
 
 //! Exports the CallbackAnalyzer class to python
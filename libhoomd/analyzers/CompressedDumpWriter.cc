@@ -0,0 +1,433 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file CompressedDumpWriter.cc
+    \brief Defines the CompressedDumpWriter class
+*/
+
+#include "CompressedDumpWriter.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <stdexcept>
+#include <sstream>
+#include <cstring>
+#include <cmath>
+
+#include <boost/python.hpp>
+#include <boost/filesystem/operations.hpp>
+using boost::filesystem::exists;
+using namespace boost::python;
+using namespace std;
+
+/*! \param sysdef SystemDefinition containing the ParticleData to dump
+    \param fname File name to write to
+    \param group Group of particles to include in the output
+    \param precision Quantization step of the positions
+    \param keyframe_interval Number of frames between keyframes
+    \param overwrite If false, existing files will be appended to. If true, existing files will be overwritten.
+
+    No file operations are attempted until analyze() is called.
+*/
+CompressedDumpWriter::CompressedDumpWriter(boost::shared_ptr<SystemDefinition> sysdef,
+                                           const std::string &fname,
+                                           boost::shared_ptr<ParticleGroup> group,
+                                           Scalar precision,
+                                           unsigned int keyframe_interval,
+                                           bool overwrite)
+    : Analyzer(sysdef), m_fname(fname), m_group(group), m_precision(precision),
+      m_keyframe_interval(keyframe_interval), m_overwrite(overwrite), m_unwrap_full(false), m_is_initialized(false),
+      m_nglobal(0), m_end_of_frames(0), m_index_written(false), m_appending(false), m_last_written_step(0),
+      m_frames_since_keyframe(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CompressedDumpWriter: " << fname << " " << precision << " "
+                                << keyframe_interval << " " << overwrite << endl;
+
+    if (!(precision > Scalar(0.0)))
+        {
+        m_exec_conf->msg->error() << "dump.compressed: precision must be positive" << endl;
+        throw runtime_error("Error initializing dump.compressed");
+        }
+
+    if (keyframe_interval == 0)
+        {
+        m_exec_conf->msg->error() << "dump.compressed: keyframe_interval must be at least 1" << endl;
+        throw runtime_error("Error initializing dump.compressed");
+        }
+    }
+
+CompressedDumpWriter::~CompressedDumpWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CompressedDumpWriter" << endl;
+
+    try
+        {
+        writeIndex();
+        }
+    catch (std::exception const &)
+        {
+        // the error has already been reported, the file can still be read without an index
+        }
+    }
+
+/*! When appending, the frames of the existing file are read and the index at its end is removed. The next frame
+    written is a keyframe.
+*/
+void CompressedDumpWriter::initFileIO()
+    {
+    m_nglobal = m_group->getNumMembersGlobal();
+
+    if (!m_overwrite && exists(m_fname))
+        {
+        m_exec_conf->msg->notice(3) << "dump.compressed: Appending to existing file \"" << m_fname << "\"" << endl;
+
+        hct_file_header header;
+        string error;
+            {
+            ifstream in(m_fname.c_str(), ios::in | ios::binary);
+            if (!hctReadIndex(in, header, m_index, m_end_of_frames, error))
+                {
+                m_exec_conf->msg->error() << "dump.compressed: " << m_fname << ": " << error << endl;
+                throw runtime_error("Error appending to compressed trajectory file");
+                }
+            }
+
+        if (header.N != m_nglobal)
+            {
+            m_exec_conf->msg->error() << "dump.compressed: " << m_fname << " has " << header.N
+                                      << " particles per frame, but the group has " << m_nglobal << endl;
+            throw runtime_error("Error appending to compressed trajectory file");
+            }
+
+        if (header.precision != m_precision)
+            {
+            m_exec_conf->msg->error() << "dump.compressed: " << m_fname << " is written with precision "
+                                      << header.precision << ", not " << m_precision << endl;
+            throw runtime_error("Error appending to compressed trajectory file");
+            }
+
+        // remove the index (and an incomplete last frame)
+        boost::filesystem::resize_file(m_fname, m_end_of_frames);
+
+        if (m_index.size() > 0)
+            m_last_written_step = (unsigned int)m_index.back().timestep;
+        m_appending = true;
+
+        m_file.open(m_fname.c_str(), ios::in | ios::out | ios::binary);
+        }
+    else
+        {
+        m_file.open(m_fname.c_str(), ios::out | ios::trunc | ios::binary);
+
+        hct_file_header header;
+        memcpy(header.magic, HCT_FILE_MAGIC, sizeof(HCT_FILE_MAGIC));
+        header.version = HCT_VERSION;
+        header.N = m_nglobal;
+        header.precision = m_precision;
+        header.keyframe_interval = m_keyframe_interval;
+        header.reserved = 0;
+        m_file.write((char *)&header, sizeof(hct_file_header));
+        m_end_of_frames = sizeof(hct_file_header);
+        }
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "dump.compressed: I/O error while opening " << m_fname << endl;
+        throw runtime_error("Error writing compressed trajectory file");
+        }
+
+    m_frames_since_keyframe = 0;
+    m_is_initialized = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The positions are copied on the calling thread and written on a separate thread.
+*/
+void CompressedDumpWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Dump compressed");
+
+    // do not touch the writer state while a previous frame is still being written
+    waitForWrite();
+
+    SnapshotParticleData<Scalar> snapshot(m_pdata->getNGlobal());
+    m_pdata->takeSnapshot(snapshot);
+
+#ifdef ENABLE_MPI
+    // if we are not the root processor, do not perform file I/O
+    if (m_comm && !m_exec_conf->isRoot())
+        {
+        if (m_prof) m_prof->pop();
+        return;
+        }
+#endif
+
+    if (! m_is_initialized)
+        initFileIO();
+
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    if (nparticles != m_nglobal)
+        {
+        m_exec_conf->msg->error() << "dump.compressed: Change in number of particles unsupported by the file format."
+                                  << endl;
+        throw runtime_error("Error writing compressed trajectory file");
+        }
+
+    if (m_appending && m_index.size() > 0 && timestep <= m_last_written_step)
+        {
+        m_exec_conf->msg->warning() << "dump.compressed: not writing output at timestep " << timestep
+                                    << " because the file reports that it already has data up to step "
+                                    << m_last_written_step << endl;
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    // copy the positions of the group members in tag order
+    boost::shared_ptr<CompressedDumpFrame> frame(new CompressedDumpFrame());
+    frame->timestep = timestep;
+    frame->box = m_pdata->getGlobalBox();
+    frame->pos.resize(size_t(nparticles) * 3);
+
+    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+        {
+        unsigned int tag = m_group->getMemberTag(group_idx);
+        vec3<Scalar> pos = snapshot.pos[tag];
+        if (m_unwrap_full)
+            pos = frame->box.shift(pos, snapshot.image[tag]);
+
+        frame->pos[group_idx] = pos.x;
+        frame->pos[nparticles + group_idx] = pos.y;
+        frame->pos[2*nparticles + group_idx] = pos.z;
+        }
+
+    m_write_thread = boost::thread(&CompressedDumpWriter::writeFrameThread, this, frame);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Rethrows any error that occured while writing the frame in the background.
+*/
+void CompressedDumpWriter::waitForWrite()
+    {
+    m_write_thread.join();
+
+    if (m_write_error.size())
+        {
+        string error = m_write_error;
+        m_write_error.clear();
+        m_exec_conf->msg->error() << "dump.compressed: " << error << endl;
+        throw runtime_error("Error writing compressed trajectory file");
+        }
+    }
+
+/*! The index is placed behind the last frame. Frames written later overwrite it, so it needs to be written again
+    after them.
+*/
+void CompressedDumpWriter::writeIndex()
+    {
+    waitForWrite();
+
+    if (!m_file.is_open() || m_index_written)
+        return;
+
+    m_file.seekp(m_end_of_frames);
+    if (m_index.size() > 0)
+        m_file.write((char *)&m_index[0], m_index.size() * sizeof(hct_index_entry));
+
+    hct_trailer trailer;
+    trailer.index_offset = m_end_of_frames;
+    trailer.n_frames = m_index.size();
+    memcpy(trailer.magic, HCT_INDEX_MAGIC, sizeof(HCT_INDEX_MAGIC));
+    m_file.write((char *)&trailer, sizeof(hct_trailer));
+    m_file.flush();
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "dump.compressed: I/O error while writing the index of " << m_fname << endl;
+        throw runtime_error("Error writing compressed trajectory file");
+        }
+
+    m_index_written = true;
+    }
+
+/*! \param frame The frame to write
+
+    This method does not access the particle data, so that it can be called from a separate thread.
+*/
+void CompressedDumpWriter::writeFrame(boost::shared_ptr<CompressedDumpFrame> frame)
+    {
+    // a stale index behind the new frame would be mistaken for the index of the file
+    if (m_index_written)
+        {
+        m_file.close();
+        boost::filesystem::resize_file(m_fname, m_end_of_frames);
+        m_file.open(m_fname.c_str(), ios::in | ios::out | ios::binary);
+        m_index_written = false;
+        }
+
+    // quantize the positions
+    unsigned int N = m_nglobal;
+    m_q.resize(size_t(N) * 3);
+    double inv_precision = 1.0 / m_precision;
+    for (unsigned int i = 0; i < 3*N; i++)
+        {
+        double q = floor(double(frame->pos[i]) * inv_precision + 0.5);
+        if (!(fabs(q) < double(HCT_MAX_QUANTIZED)))
+            {
+            ostringstream s;
+            s << "position " << frame->pos[i] << " cannot be stored with precision " << m_precision;
+            throw runtime_error(s.str());
+            }
+        m_q[i] = int(q);
+        }
+
+    bool keyframe = (m_frames_since_keyframe == 0);
+    hctEncodeFrame(m_q, m_q_prev, N, keyframe, m_payload);
+
+    hct_frame_header header;
+    header.magic = HCT_FRAME_MAGIC;
+    header.flags = keyframe ? HCT_KEYFRAME : 0;
+    header.timestep = frame->timestep;
+    Scalar3 L = frame->box.getL();
+    header.box[0] = L.x;
+    header.box[1] = L.y;
+    header.box[2] = L.z;
+    header.box[3] = frame->box.getTiltFactorXY();
+    header.box[4] = frame->box.getTiltFactorXZ();
+    header.box[5] = frame->box.getTiltFactorYZ();
+    header.payload_bytes = m_payload.size();
+
+    m_file.seekp(m_end_of_frames);
+    m_file.write((char *)&header, sizeof(hct_frame_header));
+    if (m_payload.size() > 0)
+        m_file.write((char *)&m_payload[0], m_payload.size());
+    m_file.flush();
+
+    if (!m_file.good())
+        throw runtime_error("I/O error while writing frame data");
+
+    hct_index_entry entry;
+    entry.offset = m_end_of_frames;
+    entry.timestep = frame->timestep;
+    entry.flags = header.flags;
+    entry.reserved = 0;
+    m_index.push_back(entry);
+
+    m_end_of_frames += sizeof(hct_frame_header) + m_payload.size();
+    m_q_prev.swap(m_q);
+    m_frames_since_keyframe = (m_frames_since_keyframe + 1) % m_keyframe_interval;
+    }
+
+/*! \param frame The frame to write
+
+    Errors are stored and reported by the next call to waitForWrite().
+*/
+void CompressedDumpWriter::writeFrameThread(boost::shared_ptr<CompressedDumpFrame> frame)
+    {
+    try
+        {
+        writeFrame(frame);
+        }
+    catch (std::exception const & ex)
+        {
+        m_write_error = string("error writing the frame in the background: ") + ex.what();
+        }
+    }
+
+/*! CompressedDumpWriter provides
+    - \b time_dump_compressed - wall clock time (in seconds) spent in analyze() since the last log write. This
+      includes waiting for the previous frame to be written, but not writing the current one.
+*/
+std::vector< std::string > CompressedDumpWriter::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_dump_compressed");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar CompressedDumpWriter::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "time_dump_compressed")
+        {
+        Scalar t = m_analyze_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "dump.compressed: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+    }
+
+void export_CompressedDumpWriter()
+    {
+    class_<CompressedDumpWriter, boost::shared_ptr<CompressedDumpWriter>, bases<Analyzer>, boost::noncopyable>
+    ("CompressedDumpWriter", init< boost::shared_ptr<SystemDefinition>, std::string, boost::shared_ptr<ParticleGroup>,
+                                   Scalar, unsigned int, bool>())
+    .def("setUnwrapFull", &CompressedDumpWriter::setUnwrapFull)
+    .def("waitForWrite", &CompressedDumpWriter::waitForWrite)
+    .def("writeIndex", &CompressedDumpWriter::writeIndex)
+    ;
+    }
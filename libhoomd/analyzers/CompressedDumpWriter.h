@@ -0,0 +1,170 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file CompressedDumpWriter.h
+    \brief Declares the CompressedDumpWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __COMPRESSED_DUMP_WRITER_H__
+#define __COMPRESSED_DUMP_WRITER_H__
+
+#include "Analyzer.h"
+#include "ParticleGroup.h"
+#include "TrajectoryCodec.h"
+
+#include <string>
+#include <fstream>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+//! Positions of the group members at one time step, as they are passed to the writer thread
+struct CompressedDumpFrame
+    {
+    unsigned int timestep;          //!< Time step of the frame
+    BoxDim box;                     //!< Global simulation box
+    std::vector<Scalar> pos;        //!< All x, then all y, then all z coordinates of the group members in tag order
+    };
+
+//! Analyzer for writing compressed trajectory files
+/*! CompressedDumpWriter writes the positions of the particles in a group to a single file every time analyze() is
+    called. Positions are quantized to a fixed precision and coded as differences to the previous frame, see
+    \ref page_hct_format. At a precision of 1e-3, a frame takes typically 3-5 bytes per particle instead
+    of the 12 bytes of a DCD frame.
+
+    analyze() only copies the positions (a collective operation in MPI simulations). Quantizing, coding and writing
+    the frame happens on a separate thread on the root processor while the simulation continues. At most one frame is
+    written at a time, the next call to analyze() waits for the previous frame to be written.
+
+    The index of the frames is written when the writer is destroyed. When appending to an existing file, the index is
+    removed and rewritten when the writer is destroyed again.
+
+    \ingroup analyzers
+*/
+class CompressedDumpWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CompressedDumpWriter(boost::shared_ptr<SystemDefinition> sysdef,
+                             const std::string &fname,
+                             boost::shared_ptr<ParticleGroup> group,
+                             Scalar precision,
+                             unsigned int keyframe_interval,
+                             bool overwrite=false);
+
+        //! Destructor
+        ~CompressedDumpWriter();
+
+        //! Write out the data for the current timestep
+        void analyze(unsigned int timestep);
+
+        //! Returns a list of log quantities this analyzer calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        //! Set whether coordinates should be written out wrapped or unwrapped.
+        void setUnwrapFull(bool enable)
+            {
+            m_unwrap_full = enable;
+            }
+
+        //! Wait until the frame that is currently written in the background is complete
+        void waitForWrite();
+
+        //! Write the index to the end of the file
+        void writeIndex();
+
+    private:
+        std::string m_fname;                //!< The file name we are writing to
+        boost::shared_ptr<ParticleGroup> m_group; //!< Group of particles to write
+        double m_precision;                 //!< Quantization step of the positions
+        unsigned int m_keyframe_interval;   //!< Number of frames between keyframes
+        bool m_overwrite;                   //!< True if the file should be overwritten
+        bool m_unwrap_full;                 //!< True if coordinates should be written out fully unwrapped
+        bool m_is_initialized;              //!< True if file IO has been initialized
+        unsigned int m_nglobal;             //!< Number of particles in every frame
+
+        std::fstream m_file;                //!< The open file (only on the root processor)
+        uint64_t m_end_of_frames;           //!< File offset behind the last frame
+        std::vector<hct_index_entry> m_index;   //!< Index entries of the frames in the file
+        bool m_index_written;               //!< True if the index at the end of the file is up to date
+        bool m_appending;                   //!< True if the file existed before this writer was created
+        unsigned int m_last_written_step;   //!< Last time step in the file we are appending to
+        unsigned int m_frames_since_keyframe;   //!< Number of frames written after the last keyframe
+
+        std::vector<int> m_q;               //!< Quantized positions of the frame being written
+        std::vector<int> m_q_prev;          //!< Quantized positions of the last frame written
+        std::vector<unsigned char> m_payload;   //!< Coded positions of the frame being written
+
+        boost::thread m_write_thread;       //!< Thread writing the current frame in the background
+        std::string m_write_error;          //!< Error message of the last background write (empty on success)
+
+        //! Open the file, and read the frames of an existing file when appending
+        void initFileIO();
+
+        //! Quantize, code and write a frame to the file
+        void writeFrame(boost::shared_ptr<CompressedDumpFrame> frame);
+
+        //! Entry point of the background writer thread
+        void writeFrameThread(boost::shared_ptr<CompressedDumpFrame> frame);
+    };
+
+//! Exports the CompressedDumpWriter class to python
+void export_CompressedDumpWriter();
+
+#endif
@@ -464,6 +464,37 @@ void DCDDumpWriter::write_updated_header(std::fstream &file, unsigned int timest
     write_int(file, timestep);
     }
 
+/*! DCDDumpWriter provides
+    - \b time_dump_dcd - wall clock time (in seconds) spent in analyze() since the last log write
+*/
+std::vector< std::string > DCDDumpWriter::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_dump_dcd");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar DCDDumpWriter::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "time_dump_dcd")
+        {
+        Scalar t = m_analyze_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "dump.dcd: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+    }
+
 void export_DCDDumpWriter()
     {
     class_<DCDDumpWriter, boost::shared_ptr<DCDDumpWriter>, bases<Analyzer>, boost::noncopyable>
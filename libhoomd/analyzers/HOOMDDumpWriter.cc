@@ -86,7 +86,8 @@ HOOMDDumpWriter::HOOMDDumpWriter(boost::shared_ptr<SystemDefinition> sysdef, std
         m_output_type(false), m_output_bond(false), m_output_angle(false),
         m_output_dihedral(false), m_output_improper(false), m_output_accel(false), m_output_body(false),
         m_output_charge(false), m_output_orientation(false), m_output_angmom(false),
-        m_output_moment_inertia(false), m_vizsigma_set(false), m_mode_restart(mode_restart)
+        m_output_moment_inertia(false), m_vizsigma_set(false), m_mode_restart(mode_restart), m_background(false),
+        m_keep(1)
     {
     m_exec_conf->msg->notice(5) << "Constructing HOOMDDumpWriter: " << base_fname << endl;
     }
@@ -94,6 +95,11 @@ HOOMDDumpWriter::HOOMDDumpWriter(boost::shared_ptr<SystemDefinition> sysdef, std
 HOOMDDumpWriter::~HOOMDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying HOOMDDumpWriter" << endl;
+
+    // finish writing the last file
+    m_write_thread.join();
+    if (m_write_error.size())
+        m_exec_conf->msg->error() << "dump.xml: " << m_write_error << endl;
     }
 
 /*! \param enable Set to true to enable the writing of particle positions to the files in analyze()
@@ -207,29 +213,59 @@ void HOOMDDumpWriter::setOutputMomentInertia(bool enable)
 */
 void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     {
-    // acquire the particle data
-    SnapshotParticleData<Scalar> snapshot(m_pdata->getNGlobal());
+    // do not write while a previous file is still being written
+    waitForWrite();
 
-    m_pdata->takeSnapshot(snapshot);
+    boost::shared_ptr<HOOMDDumpFrame> frame = takeFrame(timestep);
 
-    BondData::Snapshot bdata_snapshot(m_sysdef->getBondData()->getNGlobal());
-    if (m_output_bond) m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
+    // only the root processor writes the output file
+    if (frame)
+        writeFrame(fname, *frame);
+    }
 
-    AngleData::Snapshot adata_snapshot(m_sysdef->getAngleData()->getNGlobal());
-    if (m_output_angle) m_sysdef->getAngleData()->takeSnapshot(adata_snapshot);
+/*! \param timestep Current time step of the simulation
+    \returns The frame on the processor that writes the file, a null pointer on all other ranks
 
-    DihedralData::Snapshot ddata_snapshot(m_sysdef->getDihedralData()->getNGlobal());
-    if (m_output_dihedral) m_sysdef->getDihedralData()->takeSnapshot(ddata_snapshot);
+    In MPI simulations, this method must be called on all ranks.
+*/
+boost::shared_ptr<HOOMDDumpFrame> HOOMDDumpWriter::takeFrame(unsigned int timestep)
+    {
+    boost::shared_ptr<HOOMDDumpFrame> frame(new HOOMDDumpFrame);
+
+    // acquire the particle data
+    m_pdata->takeSnapshot(frame->snapshot);
 
-    ImproperData::Snapshot idata_snapshot(m_sysdef->getImproperData()->getNGlobal());
-    if (m_output_improper) m_sysdef->getImproperData()->takeSnapshot(idata_snapshot);
+    if (m_output_bond) m_sysdef->getBondData()->takeSnapshot(frame->bdata_snapshot);
+    if (m_output_angle) m_sysdef->getAngleData()->takeSnapshot(frame->adata_snapshot);
+    if (m_output_dihedral) m_sysdef->getDihedralData()->takeSnapshot(frame->ddata_snapshot);
+    if (m_output_improper) m_sysdef->getImproperData()->takeSnapshot(frame->idata_snapshot);
 
 #ifdef ENABLE_MPI
     // only the root processor writes the output file
     if (m_pdata->getDomainDecomposition() && ! m_exec_conf->isRoot())
-        return;
+        return boost::shared_ptr<HOOMDDumpFrame>();
 #endif
 
+    frame->timestep = timestep;
+    frame->dimensions = m_sysdef->getNDimensions();
+    frame->box = m_pdata->getGlobalBox();
+
+    return frame;
+    }
+
+/*! \param fname File name to write
+    \param frame The frame to write
+
+    This method does not access the particle data, so that it can be called from a separate thread.
+*/
+void HOOMDDumpWriter::writeFrame(const std::string& fname, const HOOMDDumpFrame& frame)
+    {
+    const SnapshotParticleData<Scalar>& snapshot = frame.snapshot;
+    const BondData::Snapshot& bdata_snapshot = frame.bdata_snapshot;
+    const AngleData::Snapshot& adata_snapshot = frame.adata_snapshot;
+    const DihedralData::Snapshot& ddata_snapshot = frame.ddata_snapshot;
+    const ImproperData::Snapshot& idata_snapshot = frame.idata_snapshot;
+
     // open the file for writing
     ofstream f(fname.c_str());
 
@@ -239,7 +275,7 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         throw runtime_error("Error writting hoomd_xml dump file");
         }
 
-    BoxDim box = m_pdata->getGlobalBox();
+    const BoxDim& box = frame.box;
     Scalar3 L = box.getL();
     Scalar xy = box.getTiltFactorXY();
     Scalar xz = box.getTiltFactorXZ();
@@ -248,9 +284,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     f.precision(13);
     f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << "\n";
     f << "<hoomd_xml version=\"1.6\">" << "\n";
-    f << "<configuration time_step=\"" << timestep << "\" "
-      << "dimensions=\"" << m_sysdef->getNDimensions() << "\" "
-      << "natoms=\"" << m_pdata->getNGlobal() << "\" ";
+    f << "<configuration time_step=\"" << frame.timestep << "\" "
+      << "dimensions=\"" << frame.dimensions << "\" "
+      << "natoms=\"" << snapshot.size << "\" ";
     if (m_vizsigma_set)
         f << "vizsigma=\"" << m_vizsigma << "\" ";
     f << ">" << "\n";
@@ -262,8 +298,8 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the position flag is true output the position of all particles to the file
     if (m_output_position)
         {
-        f << "<position num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f << "<position num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             vec3<Scalar> pos = snapshot.pos[j];
 
@@ -281,8 +317,8 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the image flag is true, output the image of each particle to the file
     if (m_output_image)
         {
-        f << "<image num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f << "<image num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             int3 image = snapshot.image[j];
 
@@ -300,9 +336,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the velocity flag is true output the velocity of all particles to the file
     if (m_output_velocity)
         {
-        f <<"<velocity num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<velocity num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             vec3<Scalar> vel = snapshot.vel[j];
             f << vel.x << " " << vel.y << " " << vel.z << "\n";
@@ -319,9 +355,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the velocity flag is true output the velocity of all particles to the file
     if (m_output_accel)
         {
-        f <<"<acceleration num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<acceleration num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             vec3<Scalar> accel = snapshot.accel[j];
 
@@ -339,9 +375,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the mass flag is true output the mass of all particles to the file
     if (m_output_mass)
         {
-        f <<"<mass num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<mass num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar mass = snapshot.mass[j];
 
@@ -359,9 +395,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the diameter flag is true output the mass of all particles to the file
     if (m_output_diameter)
         {
-        f <<"<diameter num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<diameter num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar diameter = snapshot.diameter[j];
             f << diameter << "\n";
@@ -378,11 +414,11 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the Type flag is true output the types of all particles to an xml file
     if  (m_output_type)
         {
-        f <<"<type num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f <<"<type num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             unsigned int type = snapshot.type[j];
-            f << m_pdata->getNameByType(type) << "\n";
+            f << snapshot.type_mapping[type] << "\n";
             }
         f <<"</type>" << "\n";
         }
@@ -390,8 +426,8 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the body flag is true output the bodies of all particles to an xml file
     if  (m_output_body)
         {
-        f <<"<body num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f <<"<body num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             unsigned int body;
             int out;
@@ -410,14 +446,13 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     if (m_output_bond)
         {
         f << "<bond num=\"" << bdata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
 
         // loop over all bonds and write them out
         for (unsigned int i = 0; i < bdata_snapshot.groups.size(); i++)
             {
             BondData::members_t bond = bdata_snapshot.groups[i];
             unsigned int bond_type = bdata_snapshot.type_id[i];
-            f << bond_data->getNameByType(bond_type) << " " << bond.tag[0] << " " << bond.tag[1] << "\n";
+            f << bdata_snapshot.type_mapping[bond_type] << " " << bond.tag[0] << " " << bond.tag[1] << "\n";
             }
 
         f << "</bond>" << "\n";
@@ -427,14 +462,13 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     if (m_output_angle)
         {
         f << "<angle num=\"" << adata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < adata_snapshot.groups.size(); i++)
             {
             AngleData::members_t angle = adata_snapshot.groups[i];
             unsigned int angle_type = adata_snapshot.type_id[i];
-            f << angle_data->getNameByType(angle_type) << " " << angle.tag[0]  << " " << angle.tag[1] << " " << angle.tag[2] << "\n";
+            f << adata_snapshot.type_mapping[angle_type] << " " << angle.tag[0]  << " " << angle.tag[1] << " " << angle.tag[2] << "\n";
             }
 
         f << "</angle>" << "\n";
@@ -444,14 +478,13 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     if (m_output_dihedral)
         {
         f << "<dihedral num=\"" << ddata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < ddata_snapshot.groups.size(); i++)
             {
             DihedralData::members_t dihedral = ddata_snapshot.groups[i];
             unsigned int dihedral_type = ddata_snapshot.type_id[i];
-            f << dihedral_data->getNameByType(dihedral_type) << " " << dihedral.tag[0]  << " " << dihedral.tag[1] << " "
+            f << ddata_snapshot.type_mapping[dihedral_type] << " " << dihedral.tag[0]  << " " << dihedral.tag[1] << " "
             << dihedral.tag[2] << " " << dihedral.tag[3] << "\n";
             }
 
@@ -462,14 +495,13 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     if (m_output_improper)
         {
         f << "<improper num=\"" << idata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<ImproperData> improper_data = m_sysdef->getImproperData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < idata_snapshot.groups.size(); i++)
             {
             ImproperData::members_t improper = idata_snapshot.groups[i];
             unsigned int improper_type = idata_snapshot.type_id[i];
-            f << improper_data->getNameByType(improper_type) << " " << improper.tag[0]  << " " << improper.tag[1] << " "
+            f << idata_snapshot.type_mapping[improper_type] << " " << improper.tag[0]  << " " << improper.tag[1] << " "
             << improper.tag[2] << " " << improper.tag[3] << "\n";
             }
 
@@ -479,9 +511,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // If the charge flag is true output the mass of all particles to the file
     if (m_output_charge)
         {
-        f <<"<charge num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<charge num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar charge = snapshot.charge[j];
             f << charge << "\n";
@@ -498,9 +530,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // if the orientation flag is set, write out the orientation quaternion to the XML file
     if (m_output_orientation)
         {
-        f << "<orientation num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f << "<orientation num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             // use the rtag data to output the particles in the order they were read in
             Scalar4 orientation = quat_to_scalar4(snapshot.orientation[j]);
@@ -517,9 +549,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // if the angmom flag is set, write out the angular momentum quaternion to the XML file
     if (m_output_angmom)
         {
-        f << "<angmom num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f << "<angmom num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             // use the rtag data to output the particles in the order they were read in
             Scalar4 angmom = quat_to_scalar4(snapshot.angmom[j]);
@@ -537,9 +569,9 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     // if the moment_inertia flag is set, write out the principal moments of inertia to the XML file
     if (m_output_moment_inertia)
         {
-        f << "<moment_inertia num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f << "<moment_inertia num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int i = 0; i < m_pdata->getNGlobal(); i++)
+        for (unsigned int i = 0; i < snapshot.size; i++)
             {
             // inertia tensors are stored by tag
             Scalar3 I = vec_to_scalar3(snapshot.inertia[i]);
@@ -575,19 +607,91 @@ void HOOMDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump XML");
 
+    // do not write while a previous file is still being written
+    waitForWrite();
+
+    boost::shared_ptr<HOOMDDumpFrame> frame = takeFrame(timestep);
+
+    // only the root processor writes the output file
+    if (frame)
+        {
+        if (m_background)
+            m_write_thread = boost::thread(&HOOMDDumpWriter::writeOutputThread, this, frame);
+        else
+            writeOutput(frame);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Unlike analyze(), the file is complete when this method returns, also when writing in the background.
+*/
+void HOOMDDumpWriter::writeRestart(unsigned int timestep)
+    {
+    waitForWrite();
+
+    boost::shared_ptr<HOOMDDumpFrame> frame = takeFrame(timestep);
+    if (frame)
+        writeOutput(frame);
+    }
+
+/*! \param keep Number of restart files to keep (including the current one)
+*/
+void HOOMDDumpWriter::setKeep(unsigned int keep)
+    {
+    if (keep == 0)
+        {
+        m_exec_conf->msg->error() << "dump.xml: the number of restart files to keep must be at least 1" << endl;
+        throw runtime_error("Error setting dump.xml parameters");
+        }
+
+    m_keep = keep;
+    }
+
+/*! Rethrows any error that occured while writing the file in the background.
+*/
+void HOOMDDumpWriter::waitForWrite()
+    {
+    m_write_thread.join();
+
+    if (m_write_error.size())
+        {
+        string error = m_write_error;
+        m_write_error.clear();
+        m_exec_conf->msg->error() << "dump.xml: " << error << endl;
+        throw runtime_error("Error writing HOOMD dump file");
+        }
+    }
+
+/*! \param frame The frame to write
+
+    In restart mode, the frame is written to a temporary file which is moved to the restart file name once it is
+    complete. The previous restart files are rotated first if more than one is kept. Otherwise, the time step is
+    appended to the file name.
+*/
+void HOOMDDumpWriter::writeOutput(boost::shared_ptr<HOOMDDumpFrame> frame)
+    {
     if (m_mode_restart)
         {
         string tmp_file = m_base_fname + string(".tmp");
-        writeFile(tmp_file, timestep);
-#ifdef ENABLE_MPI
-        // only the root processor writes the output file
-        if (m_pdata->getDomainDecomposition() && ! m_exec_conf->isRoot())
+        writeFrame(tmp_file, *frame);
+
+        // rotate the previous restart files, base.(keep-2) -> base.(keep-1), ..., base -> base.1
+        for (unsigned int i = m_keep - 1; i > 0; i--)
             {
-            if (m_prof)
-                m_prof->pop();
-	    return;
+            ostringstream src, dst;
+            src << m_base_fname;
+            if (i > 1)
+                src << "." << i-1;
+            dst << m_base_fname << "." << i;
+
+            // the older files may not exist yet
+            rename(src.str().c_str(), dst.str().c_str());
             }
-#endif
+
         if (rename(tmp_file.c_str(), m_base_fname.c_str()) != 0)
             {
             m_exec_conf->msg->error() << "dump.xml: Error renaming restart file." << endl;
@@ -600,12 +704,57 @@ void HOOMDDumpWriter::analyze(unsigned int timestep)
         string filetype = ".xml";
 
         // Generate a filename with the timestep padded to ten zeros
-        full_fname << m_base_fname << "." << setfill('0') << setw(10) << timestep << filetype;
-        writeFile(full_fname.str(), timestep);
+        full_fname << m_base_fname << "." << setfill('0') << setw(10) << frame->timestep << filetype;
+        writeFrame(full_fname.str(), *frame);
         }
+    }
 
-    if (m_prof)
-        m_prof->pop();
+/*! \param frame The frame to write
+
+    Errors are stored and reported by the next call to waitForWrite().
+*/
+void HOOMDDumpWriter::writeOutputThread(boost::shared_ptr<HOOMDDumpFrame> frame)
+    {
+    try
+        {
+        writeOutput(frame);
+        }
+    catch (std::exception const & ex)
+        {
+        m_write_error = string("error writing the file in the background: ") + ex.what();
+        }
+    }
+
+/*! HOOMDDumpWriter provides
+    - \b time_dump_xml - wall clock time (in seconds) spent in analyze() since the last log write. With background
+      writes, this is the time to take the snapshot.
+*/
+std::vector< std::string > HOOMDDumpWriter::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_dump_xml");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar HOOMDDumpWriter::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "time_dump_xml")
+        {
+        Scalar t = m_analyze_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "dump.xml: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
     }
 
 void export_HOOMDDumpWriter()
@@ -630,5 +779,9 @@ void export_HOOMDDumpWriter()
     .def("setOutputMomentInertia", &HOOMDDumpWriter::setOutputMomentInertia)
     .def("setVizSigma", &HOOMDDumpWriter::setVizSigma)
     .def("writeFile", &HOOMDDumpWriter::writeFile)
+    .def("writeRestart", &HOOMDDumpWriter::writeRestart)
+    .def("setBackground", &HOOMDDumpWriter::setBackground)
+    .def("setKeep", &HOOMDDumpWriter::setKeep)
+    .def("waitForWrite", &HOOMDDumpWriter::waitForWrite)
     ;
     }
@@ -58,14 +58,32 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "Analyzer.h"
+#include "BondedGroupData.h"
 
 #include <string>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
 
 #ifndef __HOOMD_DUMP_WRITER_H__
 #define __HOOMD_DUMP_WRITER_H__
 
+//! Copy of the system state that is written to one HOOMD XML file
+/*! The frame holds everything the writer needs, so that the file can be written while the simulation continues.
+    \ingroup analyzers
+*/
+struct HOOMDDumpFrame
+    {
+    unsigned int timestep;                      //!< Time step of the frame
+    unsigned int dimensions;                    //!< Number of dimensions of the system
+    BoxDim box;                                 //!< Global simulation box
+    SnapshotParticleData<Scalar> snapshot;      //!< Particle data
+    BondData::Snapshot bdata_snapshot;          //!< Bonds
+    AngleData::Snapshot adata_snapshot;         //!< Angles
+    DihedralData::Snapshot ddata_snapshot;      //!< Dihedrals
+    ImproperData::Snapshot idata_snapshot;      //!< Impropers
+    };
+
 //! Analyzer for writing out HOOMD  dump files
 /*! HOOMDDumpWriter can be used to write out xml files containing various levels of information
     of the current time step of the simulation. At a minimum, the current time step and box
@@ -82,6 +100,14 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     To include positions, velocities and types, see: setOutputPosition() setOutputVelocity()
     and setOutputType(). Similarly, bonds can be included with setOutputBond().
 
+    In restart mode, the file is written to base_file.tmp and then moved to base_file. setKeep() keeps the previous
+    restart files as base_file.1, base_file.2, ... (the most recent first).
+
+    With setBackground(), analyze() only copies the system state into a HOOMDDumpFrame (on the calling thread, a
+    collective operation in MPI simulations) and writes the file on a separate thread while the simulation continues.
+    At most one file is written at a time, the next call to analyze() waits for the previous write to finish.
+    writeRestart() always writes synchronously.
+
     Future versions will include the ability to dump forces on each particle to the file also.
 
     For information on the structure of the xml file format: see \ref page_dev_info
@@ -99,6 +125,12 @@ class HOOMDDumpWriter : public Analyzer
 
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
+
+        //! Returns a list of log quantities this analyzer calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
         //! Enables/disables the writing of the particle positions
         void setOutputPosition(bool enable);
         //! Enables/disables the writing of particle images
@@ -140,7 +172,37 @@ class HOOMDDumpWriter : public Analyzer
 
         //! Writes a file at the current time step
         void writeFile(std::string fname, unsigned int timestep);
+
+        //! Writes a restart file at the current time step, and waits until it is written
+        void writeRestart(unsigned int timestep);
+
+        //! Write the files on a separate thread
+        /*! \param enable Set to true to write files in the background
+        */
+        void setBackground(bool enable)
+            {
+            m_background = enable;
+            }
+
+        //! Set the number of restart files to keep
+        void setKeep(unsigned int keep);
+
+        //! Wait until the file that is currently written in the background is complete
+        void waitForWrite();
+
     private:
+        //! Copy the current state of the system
+        boost::shared_ptr<HOOMDDumpFrame> takeFrame(unsigned int timestep);
+
+        //! Write a frame to a file
+        void writeFrame(const std::string& fname, const HOOMDDumpFrame& frame);
+
+        //! Write a frame to the file of the current mode, and rotate restart files
+        void writeOutput(boost::shared_ptr<HOOMDDumpFrame> frame);
+
+        //! Entry point of the background writer thread
+        void writeOutputThread(boost::shared_ptr<HOOMDDumpFrame> frame);
+
         std::string m_base_fname;   //!< String used to store the file name of the XML file
         bool m_output_position;     //!< true if the particle positions should be written
         bool m_output_image;        //!< true if the particle positions should be written
@@ -161,6 +223,10 @@ class HOOMDDumpWriter : public Analyzer
         Scalar m_vizsigma;          //!< vizsigma value to write out to xml files
         bool m_vizsigma_set;        //!< true if vizsigma has been set
         bool m_mode_restart;        //!< true if we are writing restart files
+        bool m_background;          //!< true if files are written on a separate thread
+        unsigned int m_keep;        //!< Number of restart files to keep
+        boost::thread m_write_thread;   //!< Thread writing the current file in the background
+        std::string m_write_error;  //!< Error message of the last background write (empty on success)
         };
 
 //! Exports the HOOMDDumpWriter class to python
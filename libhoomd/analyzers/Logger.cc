@@ -144,7 +144,8 @@ void Logger::registerCompute(boost::shared_ptr<Compute> compute)
     for (unsigned int i = 0; i < provided_quantities.size(); i++)
         {
         // first check if this quantity is already set, printing a warning if so
-        if (m_compute_quantities.count(provided_quantities[i]) || m_updater_quantities.count(provided_quantities[i]))
+        if (m_compute_quantities.count(provided_quantities[i]) || m_updater_quantities.count(provided_quantities[i])
+            || m_analyzer_quantities.count(provided_quantities[i]))
             m_exec_conf->msg->warning() << "analyze.log: The log quantity " << provided_quantities[i] <<
                  " has been registered more than once. Only the most recent registration takes effect" << endl;
         m_compute_quantities[provided_quantities[i]] = compute;
@@ -165,19 +166,42 @@ void Logger::registerUpdater(boost::shared_ptr<Updater> updater)
     for (unsigned int i = 0; i < provided_quantities.size(); i++)
         {
         // first check if this quantity is already set, printing a warning if so
-        if (m_compute_quantities.count(provided_quantities[i]) || m_updater_quantities.count(provided_quantities[i]))
+        if (m_compute_quantities.count(provided_quantities[i]) || m_updater_quantities.count(provided_quantities[i])
+            || m_analyzer_quantities.count(provided_quantities[i]))
             m_exec_conf->msg->warning() << "analyze.log: The log quantity " << provided_quantities[i] <<
                  " has been registered more than once. Only the most recent registration takes effect" << endl;
         m_updater_quantities[provided_quantities[i]] = updater;
         }
     }
 
+/*! \param analyzer The Analyzer to register
+
+    After the analyzer is registered, all of the analyzer's provided log quantities are available for
+    logging.
+*/
+void Logger::registerAnalyzer(boost::shared_ptr<Analyzer> analyzer)
+    {
+    vector< string > provided_quantities = analyzer->getProvidedLogQuantities();
+
+    // loop over all log quantities
+    for (unsigned int i = 0; i < provided_quantities.size(); i++)
+        {
+        // first check if this quantity is already set, printing a warning if so
+        if (m_compute_quantities.count(provided_quantities[i]) || m_updater_quantities.count(provided_quantities[i])
+            || m_analyzer_quantities.count(provided_quantities[i]))
+            m_exec_conf->msg->warning() << "analyze.log: The log quantity " << provided_quantities[i] <<
+                 " has been registered more than once. Only the most recent registration takes effect" << endl;
+        m_analyzer_quantities[provided_quantities[i]] = analyzer;
+        }
+    }
+
 /*! After calling removeAll(), no quantities are registered for logging
 */
 void Logger::removeAll()
     {
     m_compute_quantities.clear();
     m_updater_quantities.clear();
+    m_analyzer_quantities.clear();
     }
 
 /*! \param quantities A list of quantities to log
@@ -356,6 +380,12 @@ Scalar Logger::getValue(const std::string &quantity, int timestep)
         // get the log value
         return m_updater_quantities[quantity]->getLogValue(quantity, timestep);
         }
+    // check to see if the quantity exists in the analyzers list
+    else if (m_analyzer_quantities.count(quantity))
+        {
+        // get the log value
+        return m_analyzer_quantities[quantity]->getLogValue(quantity, timestep);
+        }
     else
         {
         m_exec_conf->msg->warning() << "analyze.log: Log quantity " << quantity << " is not registered, logging a value of 0" << endl;
@@ -370,6 +400,7 @@ void export_Logger()
     ("Logger", init< boost::shared_ptr<SystemDefinition>, const std::string&, const std::string&, bool >())
     .def("registerCompute", &Logger::registerCompute)
     .def("registerUpdater", &Logger::registerUpdater)
+    .def("registerAnalyzer", &Logger::registerAnalyzer)
     .def("removeAll", &Logger::removeAll)
     .def("setLoggedQuantities", &Logger::setLoggedQuantities)
     .def("setDelimiter", &Logger::setDelimiter)
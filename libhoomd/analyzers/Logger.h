@@ -73,11 +73,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __LOGGER_H__
 
 //! Logs registered quantities to a delimited file
-/*! \note design notes: Computes and Updaters have getProvidedLogQuantities and getLogValue. The first lists
-    all quantities that the compute/updater provides (a list of strings). And getLogValue takes a string
+/*! \note design notes: Computes, Updaters and Analyzers have getProvidedLogQuantities and getLogValue. The first
+    lists all quantities that the compute/updater/analyzer provides (a list of strings). And getLogValue takes a string
     as an argument and returns a scalar.
 
-    Logger will open and overwrite its log file on construction. Any number of computes and updaters
+    Logger will open and overwrite its log file on construction. Any number of computes, updaters and analyzers
     can be registered with the Logger. It will track which quantities are provided. If any particular
     quantity is registered twice, a warning is printed and the most recent registered source will take
     effect. setLoggedQuantities will specify a list of quantities to log. When it is called, a header
@@ -85,8 +85,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     being called and getLogValue called for each value to produce a line in the file. If a logged quantity
     is not registered, a 0 is printed to the file and a warning to stdout.
 
-    The removeAll method can be used to clear all registered computes and updaters. hoomd_script will
-    removeAll() and re-register all active computes and updaters before every run()
+    The removeAll method can be used to clear all registered computes, updaters and analyzers. hoomd_script will
+    removeAll() and re-register all active computes, updaters and analyzers before every run()
 
     As an option, Logger can be initialized with no file. Such a logger will skip doing anything during
     analyze() but is still available for getQuantity() operations.
@@ -111,7 +111,10 @@ class Logger : public Analyzer
         //! Registers an updater
         void registerUpdater(boost::shared_ptr<Updater> updater);
 
-        //! Clears all registered computes and updaters
+        //! Registers an analyzer
+        void registerAnalyzer(boost::shared_ptr<Analyzer> analyzer);
+
+        //! Clears all registered computes, updaters and analyzers
         void removeAll();
 
         //! Selects which quantities to log
@@ -154,6 +157,8 @@ class Logger : public Analyzer
         std::map< std::string, boost::shared_ptr<Compute> > m_compute_quantities;
         //! A map of updaters indexed by logged quantity that they provide
         std::map< std::string, boost::shared_ptr<Updater> > m_updater_quantities;
+        //! A map of analyzers indexed by logged quantity that they provide
+        std::map< std::string, boost::shared_ptr<Analyzer> > m_analyzer_quantities;
         //! List of quantities to log
         std::vector< std::string > m_logged_quantities;
         //! Clock for the time log quantity
@@ -54,6 +54,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "POSDumpWriter.h"
+#include "ScopedGIL.h"
 
 #include <boost/python.hpp>
 using namespace boost::python;
@@ -169,7 +170,11 @@ void POSDumpWriter::analyze(unsigned int timestep)
     // if there is a string to be written due to the python method addInfo, write it.
     if (m_write_info) 
         {
-        string info = boost::python::extract<string> (m_add_info(timestep));
+        string info;
+            {
+            ScopedGILAcquire gil;
+            info = boost::python::extract<string> (m_add_info(timestep));
+            }
         m_file << info;
         }
 
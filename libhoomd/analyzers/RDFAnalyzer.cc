@@ -0,0 +1,281 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file RDFAnalyzer.cc
+    \brief Defines the RDFAnalyzer class
+*/
+
+#include "RDFAnalyzer.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <boost/python.hpp>
+using namespace boost::python;
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+using namespace std;
+
+/*! \param sysdef SystemDefinition containing the Particle data to analyze
+    \param nlist Neighbor list to take the pairs from
+    \param fname File name to write output to
+    \param r_max Maximum pair distance to bin
+    \param nbins Number of bins between 0 and \a r_max
+
+    Nothing is written to the file until writeFile() is called.
+*/
+RDFAnalyzer::RDFAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
+                         boost::shared_ptr<NeighborList> nlist,
+                         const std::string& fname,
+                         Scalar r_max,
+                         unsigned int nbins)
+    : Analyzer(sysdef), m_nlist(nlist), m_fname(fname), m_delimiter("\t"), m_r_max(r_max), m_nbins(nbins),
+      m_ntypes(m_pdata->getNTypes()), m_typpair_idx(m_ntypes), m_inv_volume(0.0), m_num_samples(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RDFAnalyzer: " << fname << " " << r_max << " " << nbins << endl;
+
+    if (r_max <= Scalar(0.0) || nbins == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.rdf: r_max and nbins must be positive" << endl;
+        throw runtime_error("Error initializing analyze.rdf");
+        }
+
+    m_hist.resize(m_typpair_idx.getNumElements()*m_nbins, 0.0);
+    m_type_count.resize(m_ntypes, 0.0);
+    }
+
+RDFAnalyzer::~RDFAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RDFAnalyzer" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every pair in the neighbor list closer than r_max is added to the histogram of its type pair. Each distinct
+    pair must add a weight of one summed over all ranks: a pair with a ghost particle is found on both ranks that
+    own one of the particles in half storage mode, and every pair is found twice in full storage mode.
+*/
+void RDFAnalyzer::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Analyze RDF");
+
+    if (m_pdata->getNTypes() != m_ntypes)
+        {
+        m_exec_conf->msg->error() << "analyze.rdf: Change in the number of particle types unsupported." << endl;
+        throw runtime_error("Error computing rdf");
+        }
+
+    // make sure the neighbor list is current (this is a no-op when a force already computed it this step)
+    m_nlist->compute(timestep);
+
+    if (m_nlist->getMinRCut() < m_r_max)
+        {
+        m_exec_conf->msg->error() << "analyze.rdf: r_max = " << m_r_max
+                                  << " is larger than the neighbor list cutoff " << m_nlist->getMinRCut() << endl;
+        throw runtime_error("Error computing rdf");
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const unsigned int N = m_pdata->getN();
+    const bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    const Scalar r_max_sq = m_r_max*m_r_max;
+    const Scalar inv_dr = Scalar(m_nbins) / m_r_max;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        m_type_count[typei] += 1.0;
+
+        const unsigned int head = h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = h_nlist.data[head + k];
+
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(pi - pj);
+            Scalar rsq = dot(dx, dx);
+            if (rsq >= r_max_sq)
+                continue;
+
+            unsigned int bin = (unsigned int)(sqrt(rsq) * inv_dr);
+            if (bin >= m_nbins)
+                continue;
+
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            double weight = (third_law && j < N) ? 1.0 : 0.5;
+            m_hist[m_typpair_idx(typei, typej)*m_nbins + bin] += weight;
+            }
+        }
+
+    m_inv_volume += 1.0 / m_pdata->getGlobalBox().getVolume(m_sysdef->getNDimensions() == 2);
+    m_num_samples++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! The histograms and type counts are summed over all ranks in a single reduction and the root rank writes
+    g(r) of every type pair to the file, overwriting previous output. This must be called on all ranks.
+*/
+void RDFAnalyzer::writeFile()
+    {
+    // pack the histograms and the type counts so that they are reduced together
+    std::vector<double> buf(m_hist);
+    buf.insert(buf.end(), m_type_count.begin(), m_type_count.end());
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        bool is_root = m_exec_conf->isRoot();
+        MPI_Reduce(is_root ? MPI_IN_PLACE : &buf[0], &buf[0], buf.size(), MPI_DOUBLE, MPI_SUM, 0,
+                   m_exec_conf->getMPICommunicator());
+
+        // only the root processor performs file I/O
+        if (!is_root)
+            return;
+        }
+#endif
+
+    if (m_num_samples == 0)
+        {
+        m_exec_conf->msg->warning() << "analyze.rdf: No samples accumulated, not writing " << m_fname << endl;
+        return;
+        }
+
+    ofstream file(m_fname.c_str(), ios_base::out);
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.rdf: Unable to open file " << m_fname << endl;
+        throw runtime_error("Error writing rdf file");
+        }
+
+    const double* hist = &buf[0];
+    const double* type_count = &buf[m_hist.size()];
+    const double samples = double(m_num_samples);
+    const double inv_volume = m_inv_volume / samples;
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    const double dr = double(m_r_max) / double(m_nbins);
+
+    // header
+    file << "r";
+    for (unsigned int a = 0; a < m_ntypes; a++)
+        for (unsigned int b = a; b < m_ntypes; b++)
+            file << m_delimiter << m_pdata->getNameByType(a) << "-" << m_pdata->getNameByType(b);
+    file << endl;
+
+    for (unsigned int bin = 0; bin < m_nbins; bin++)
+        {
+        double r_lo = dr*double(bin);
+        double r_hi = r_lo + dr;
+        double shell = twod ? M_PI*(r_hi*r_hi - r_lo*r_lo) : 4.0/3.0*M_PI*(r_hi*r_hi*r_hi - r_lo*r_lo*r_lo);
+
+        file << setprecision(10) << r_lo + 0.5*dr;
+        for (unsigned int a = 0; a < m_ntypes; a++)
+            for (unsigned int b = a; b < m_ntypes; b++)
+                {
+                double n_a = type_count[a] / samples;
+                double n_b = type_count[b] / samples;
+                double n_pairs = (a == b) ? 0.5*n_a*(n_a - 1.0) : n_a*n_b;
+
+                double g = 0.0;
+                if (n_pairs > 0.0)
+                    g = hist[m_typpair_idx(a,b)*m_nbins + bin] / (samples * n_pairs * inv_volume * shell);
+                file << m_delimiter << setprecision(10) << g;
+                }
+        file << endl;
+        }
+
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.rdf: I/O error while writing file" << endl;
+        throw runtime_error("Error writing rdf file");
+        }
+    }
+
+void RDFAnalyzer::reset()
+    {
+    m_hist.assign(m_hist.size(), 0.0);
+    m_type_count.assign(m_type_count.size(), 0.0);
+    m_inv_volume = 0.0;
+    m_num_samples = 0;
+    }
+
+/*! \param delimiter New delimiter to set
+
+    The delimiter is printed between every element in the row of the output
+*/
+void RDFAnalyzer::setDelimiter(const std::string& delimiter)
+    {
+    m_delimiter = delimiter;
+    }
+
+void export_RDFAnalyzer()
+    {
+    class_<RDFAnalyzer, boost::shared_ptr<RDFAnalyzer>, bases<Analyzer>, boost::noncopyable>
+    ("RDFAnalyzer", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<NeighborList>, const std::string&,
+                          Scalar, unsigned int >())
+    .def("writeFile", &RDFAnalyzer::writeFile)
+    .def("reset", &RDFAnalyzer::reset)
+    .def("getNumSamples", &RDFAnalyzer::getNumSamples)
+    .def("setDelimiter", &RDFAnalyzer::setDelimiter)
+    ;
+    }
@@ -0,0 +1,137 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file RDFAnalyzer.h
+    \brief Declares the RDFAnalyzer class
+*/
+
+#ifndef __RDF_ANALYZER_H__
+#define __RDF_ANALYZER_H__
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "NeighborList.h"
+#include "Index1D.h"
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+//! Accumulates the radial distribution function g(r) of every type pair on the fly
+/*! RDFAnalyzer bins the pair distances found in a NeighborList into one histogram per type pair. Every call to
+    analyze() adds one sample to the histograms, so the cost of a sample is a single pass over the neighbor list
+    and no particle data leaves the rank. The accumulated histograms are reduced over all ranks and normalized
+    only when writeFile() is called.
+
+    The neighbor list must include all pairs up to \a r_max. The python interface subscribes \a r_max to the
+    neighbor list for this purpose. Pairs excluded from the neighbor list (e.g. bonded particles) do not contribute
+    to the histograms.
+
+    g(r) of types a and b is normalized as
+    \f[ g_{ab}(r) = \frac{\langle n_{ab}(r) \rangle}{N_{ab} \langle 1/V \rangle \Delta V(r)} \f]
+    where \f$ n_{ab}(r) \f$ is the number of a-b pairs in the shell, \f$ N_{ab} \f$ is the number of distinct a-b
+    pairs in the system and \f$ \Delta V(r) \f$ is the volume (area in 2D) of the shell.
+
+    \ingroup analyzers
+*/
+class RDFAnalyzer : public Analyzer
+    {
+    public:
+        //! Construct the rdf analyzer
+        RDFAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
+                    boost::shared_ptr<NeighborList> nlist,
+                    const std::string& fname,
+                    Scalar r_max,
+                    unsigned int nbins);
+
+        //! Destructor
+        ~RDFAnalyzer();
+
+        //! Add a sample of the current configuration to the histograms
+        void analyze(unsigned int timestep);
+
+        //! Write the averaged g(r) to the file
+        void writeFile();
+
+        //! Clear the accumulated histograms
+        void reset();
+
+        //! Get the number of samples accumulated since the last reset()
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Sets the delimiter to use between fields
+        void setDelimiter(const std::string& delimiter);
+
+    private:
+        boost::shared_ptr<NeighborList> m_nlist;   //!< Neighbor list to take the pairs from
+        std::string m_fname;                        //!< File name to write to
+        std::string m_delimiter;                    //!< The delimiter to put between columns in the file
+        Scalar m_r_max;                             //!< Maximum pair distance binned
+        unsigned int m_nbins;                       //!< Number of bins in each histogram
+        unsigned int m_ntypes;                      //!< Number of particle types when the analyzer was created
+        Index2DUpperTriangular m_typpair_idx;       //!< Indexer for the type pair histograms
+
+        std::vector<double> m_hist;                 //!< Pair histograms by type pair (a <= b) and bin
+        std::vector<double> m_type_count;           //!< Local particles of each type summed over all samples
+        double m_inv_volume;                        //!< 1/V summed over all samples
+        unsigned int m_num_samples;                 //!< Number of samples accumulated
+    };
+
+//! Exports the RDFAnalyzer class to python
+void export_RDFAnalyzer();
+
+#endif
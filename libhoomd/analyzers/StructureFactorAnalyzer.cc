@@ -0,0 +1,411 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file StructureFactorAnalyzer.cc
+    \brief Defines the StructureFactorAnalyzer class
+*/
+
+#include "StructureFactorAnalyzer.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <boost/python.hpp>
+#include <boost/bind.hpp>
+#include <boost/random.hpp>
+using namespace boost::python;
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+using namespace std;
+
+/*! \param sysdef SystemDefinition containing the Particle data to analyze
+    \param group Particles to compute S(k) of
+    \param fname File name to write output to
+    \param k_max Largest wave vector magnitude to sample
+    \param nbins Number of bins between 0 and \a k_max
+    \param max_k_per_bin Maximum number of wave vectors to evaluate in each bin
+
+    Nothing is written to the file until writeFile() is called.
+*/
+StructureFactorAnalyzer::StructureFactorAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
+                                                 boost::shared_ptr<ParticleGroup> group,
+                                                 const std::string& fname,
+                                                 Scalar k_max,
+                                                 unsigned int nbins,
+                                                 unsigned int max_k_per_bin)
+    : Analyzer(sysdef), m_group(group), m_fname(fname), m_delimiter("\t"), m_k_max(k_max), m_nbins(nbins),
+      m_max_k_per_bin(max_k_per_bin), m_box_changed(false), m_pending_samples(0), m_num_samples(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StructureFactorAnalyzer: " << fname << " " << k_max << " "
+                                << nbins << " " << max_k_per_bin << endl;
+
+    if (k_max <= Scalar(0.0) || nbins == 0 || max_k_per_bin == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.sq: k_max, nbins and max_k must be positive" << endl;
+        throw runtime_error("Error initializing analyze.sq");
+        }
+
+    m_sk.resize(m_nbins, 0.0);
+    m_k_sum.resize(m_nbins, 0.0);
+    m_count.resize(m_nbins, 0.0);
+
+    m_boxchange_connection = m_pdata->connectBoxChange(boost::bind(&StructureFactorAnalyzer::slotBoxChanged, this));
+    updateWaveVectors();
+    }
+
+StructureFactorAnalyzer::~StructureFactorAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying StructureFactorAnalyzer" << endl;
+    m_boxchange_connection.disconnect();
+    }
+
+/*! The reciprocal lattice vectors \f$ \vec{b}_i \f$ satisfy \f$ \vec{a}_i \cdot \vec{b}_j = 2\pi\delta_{ij} \f$, so
+    \f$ |n_i| \le k_{max} |\vec{a}_i| / 2\pi \f$ bounds the integer coordinates of every wave vector within reach.
+    Only one of each \f$ \pm\vec{k} \f$ pair is kept since both give the same S(k). Bins with more than
+    m_max_k_per_bin candidates are subsampled with a fixed seed, so every rank generates the same set.
+*/
+void StructureFactorAnalyzer::updateWaveVectors()
+    {
+    const BoxDim& box = m_pdata->getGlobalBox();
+    vec3<Scalar> a1(box.getLatticeVector(0));
+    vec3<Scalar> a2(box.getLatticeVector(1));
+    vec3<Scalar> a3(box.getLatticeVector(2));
+    Scalar two_pi_over_V = Scalar(2.0*M_PI) / dot(a1, cross(a2, a3));
+    vec3<Scalar> b1 = two_pi_over_V * cross(a2, a3);
+    vec3<Scalar> b2 = two_pi_over_V * cross(a3, a1);
+    vec3<Scalar> b3 = two_pi_over_V * cross(a1, a2);
+
+    int n1_max = int(m_k_max * sqrt(dot(a1, a1)) / Scalar(2.0*M_PI));
+    int n2_max = int(m_k_max * sqrt(dot(a2, a2)) / Scalar(2.0*M_PI));
+    int n3_max = int(m_k_max * sqrt(dot(a3, a3)) / Scalar(2.0*M_PI));
+    if (m_sysdef->getNDimensions() == 2)
+        n3_max = 0;
+
+    // collect the candidates of each bin
+    std::vector< std::vector<int3> > candidates(m_nbins);
+    const Scalar k_max_sq = m_k_max*m_k_max;
+    const Scalar inv_dk = Scalar(m_nbins) / m_k_max;
+    for (int n1 = 0; n1 <= n1_max; n1++)
+        for (int n2 = -n2_max; n2 <= n2_max; n2++)
+            for (int n3 = -n3_max; n3 <= n3_max; n3++)
+                {
+                // keep the half space
+                if (n1 == 0 && (n2 < 0 || (n2 == 0 && n3 <= 0)))
+                    continue;
+
+                vec3<Scalar> k = Scalar(n1)*b1 + Scalar(n2)*b2 + Scalar(n3)*b3;
+                Scalar ksq = dot(k, k);
+                if (ksq > k_max_sq)
+                    continue;
+
+                unsigned int bin = (unsigned int)(sqrt(ksq) * inv_dk);
+                if (bin >= m_nbins)
+                    bin = m_nbins - 1;
+                candidates[bin].push_back(make_int3(n1, n2, n3));
+                }
+
+    // subsample crowded bins
+    boost::mt19937 rng(12345);
+    m_kvec.clear();
+    for (unsigned int bin = 0; bin < m_nbins; bin++)
+        {
+        std::vector<int3>& c = candidates[bin];
+        unsigned int n_keep = c.size();
+        if (n_keep > m_max_k_per_bin)
+            {
+            // partial Fisher-Yates shuffle
+            n_keep = m_max_k_per_bin;
+            for (unsigned int i = 0; i < n_keep; i++)
+                {
+                boost::uniform_int<unsigned int> pick(i, c.size()-1);
+                std::swap(c[i], c[pick(rng)]);
+                }
+            }
+        m_kvec.insert(m_kvec.end(), c.begin(), c.begin() + n_keep);
+        }
+
+    m_kvec_L = box.getL();
+    updateMagnitudes();
+
+    m_exec_conf->msg->notice(6) << "analyze.sq: Evaluating " << m_kvec.size() << " wave vectors" << endl;
+    }
+
+/*! The integer coordinates of the cached wave vectors stay valid lattice vectors when the box deforms, only their
+    magnitudes change.
+*/
+void StructureFactorAnalyzer::updateMagnitudes()
+    {
+    const BoxDim& box = m_pdata->getGlobalBox();
+    vec3<Scalar> a1(box.getLatticeVector(0));
+    vec3<Scalar> a2(box.getLatticeVector(1));
+    vec3<Scalar> a3(box.getLatticeVector(2));
+    Scalar two_pi_over_V = Scalar(2.0*M_PI) / dot(a1, cross(a2, a3));
+    vec3<Scalar> b1 = two_pi_over_V * cross(a2, a3);
+    vec3<Scalar> b2 = two_pi_over_V * cross(a3, a1);
+    vec3<Scalar> b3 = two_pi_over_V * cross(a1, a2);
+
+    m_kmag.resize(m_kvec.size());
+    for (unsigned int ik = 0; ik < m_kvec.size(); ik++)
+        {
+        vec3<Scalar> k = Scalar(m_kvec[ik].x)*b1 + Scalar(m_kvec[ik].y)*b2 + Scalar(m_kvec[ik].z)*b3;
+        m_kmag[ik] = sqrt(dot(k, k));
+        }
+
+    m_box_changed = false;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    With fractional coordinates \f$ \vec{f}_j \f$, \f$ \vec{k} \cdot \vec{r}_j = 2\pi \vec{n} \cdot \vec{f}_j \f$ up to
+    a constant phase that does not change \f$ |\rho(\vec{k})| \f$. The wave vectors are independent, so the density
+    modes are evaluated in parallel over them.
+*/
+void StructureFactorAnalyzer::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Analyze S(k)");
+
+    if (m_box_changed)
+        {
+        // regenerate the set only after a large deformation
+        Scalar3 L = m_pdata->getGlobalBox().getL();
+        if (fabs(L.x/m_kvec_L.x - Scalar(1.0)) > Scalar(0.1) ||
+            fabs(L.y/m_kvec_L.y - Scalar(1.0)) > Scalar(0.1) ||
+            fabs(L.z/m_kvec_L.z - Scalar(1.0)) > Scalar(0.1))
+            updateWaveVectors();
+        else
+            updateMagnitudes();
+        }
+
+    const unsigned int nk = m_kvec.size();
+
+    // fractional coordinates of the local group members
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const unsigned int n_members = m_group->getNumMembers();
+    m_frac.resize(n_members);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+        for (unsigned int m = 0; m < n_members; m++)
+            {
+            Scalar4 postype = h_pos.data[h_index.data[m]];
+            m_frac[m] = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+            }
+        }
+
+    m_rho.resize(2*nk);
+    #pragma omp parallel for schedule(static)
+    for (int ik = 0; ik < (int)nk; ik++)
+        {
+        const Scalar3 n = make_scalar3(Scalar(m_kvec[ik].x), Scalar(m_kvec[ik].y), Scalar(m_kvec[ik].z));
+        double re = 0.0;
+        double im = 0.0;
+        for (unsigned int m = 0; m < n_members; m++)
+            {
+            Scalar phase = Scalar(2.0*M_PI) * dot(n, m_frac[m]);
+            re += fast::cos(phase);
+            im += fast::sin(phase);
+            }
+        m_rho[2*ik] = re;
+        m_rho[2*ik+1] = im;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // buffer the local modes until the next output
+        m_pending_rho.insert(m_pending_rho.end(), m_rho.begin(), m_rho.end());
+        m_pending_kmag.insert(m_pending_kmag.end(), m_kmag.begin(), m_kmag.end());
+        m_pending_samples++;
+        m_num_samples++;
+
+        // bound the memory used by the buffer
+        if (m_pending_rho.size() > (1 << 20))
+            flushSamples();
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+#endif
+
+    accumulate(&m_rho[0], &m_kmag[0], nk);
+    m_num_samples++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param rho Real and imaginary parts of the density modes summed over all ranks
+    \param kmag Magnitude of each wave vector
+    \param nk Number of wave vectors
+*/
+void StructureFactorAnalyzer::accumulate(const double *rho, const Scalar *kmag, unsigned int nk)
+    {
+    const double N = double(m_group->getNumMembersGlobal());
+    if (N == 0.0)
+        return;
+
+    const Scalar inv_dk = Scalar(m_nbins) / m_k_max;
+    for (unsigned int ik = 0; ik < nk; ik++)
+        {
+        // vectors may leave the range when the box shrinks
+        unsigned int bin = (unsigned int)(kmag[ik] * inv_dk);
+        if (bin >= m_nbins)
+            continue;
+
+        m_sk[bin] += (rho[2*ik]*rho[2*ik] + rho[2*ik+1]*rho[2*ik+1]) / N;
+        m_k_sum[bin] += kmag[ik];
+        m_count[bin] += 1.0;
+        }
+    }
+
+/*! All ranks buffer the same wave vectors for the same samples, so a single element-wise sum reduces all buffered
+    samples at once. This must be called on all ranks.
+*/
+void StructureFactorAnalyzer::flushSamples()
+    {
+#ifdef ENABLE_MPI
+    if (m_comm && m_pending_samples > 0)
+        {
+        bool is_root = m_exec_conf->isRoot();
+        MPI_Reduce(is_root ? MPI_IN_PLACE : &m_pending_rho[0], &m_pending_rho[0], m_pending_rho.size(), MPI_DOUBLE,
+                   MPI_SUM, 0, m_exec_conf->getMPICommunicator());
+
+        // only the root processor accumulates the histogram
+        if (is_root)
+            accumulate(&m_pending_rho[0], &m_pending_kmag[0], m_pending_kmag.size());
+
+        m_pending_rho.clear();
+        m_pending_kmag.clear();
+        m_pending_samples = 0;
+        }
+#endif
+    }
+
+/*! The root rank writes the averaged S(k) of every non-empty bin to the file, overwriting previous output.
+    Each row gives the mean \f$ |\vec{k}| \f$ of the wave vectors in the bin. This must be called on all ranks.
+*/
+void StructureFactorAnalyzer::writeFile()
+    {
+    flushSamples();
+
+#ifdef ENABLE_MPI
+    // only the root processor performs file I/O
+    if (m_comm && !m_exec_conf->isRoot())
+        return;
+#endif
+
+    if (m_num_samples == 0)
+        {
+        m_exec_conf->msg->warning() << "analyze.sq: No samples accumulated, not writing " << m_fname << endl;
+        return;
+        }
+
+    ofstream file(m_fname.c_str(), ios_base::out);
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.sq: Unable to open file " << m_fname << endl;
+        throw runtime_error("Error writing sq file");
+        }
+
+    file << "k" << m_delimiter << "S(k)" << endl;
+    for (unsigned int bin = 0; bin < m_nbins; bin++)
+        {
+        if (m_count[bin] == 0.0)
+            continue;
+
+        file << setprecision(10) << m_k_sum[bin] / m_count[bin] << m_delimiter
+             << setprecision(10) << m_sk[bin] / m_count[bin] << endl;
+        }
+
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.sq: I/O error while writing file" << endl;
+        throw runtime_error("Error writing sq file");
+        }
+    }
+
+void StructureFactorAnalyzer::reset()
+    {
+    m_sk.assign(m_nbins, 0.0);
+    m_k_sum.assign(m_nbins, 0.0);
+    m_count.assign(m_nbins, 0.0);
+    m_pending_rho.clear();
+    m_pending_kmag.clear();
+    m_pending_samples = 0;
+    m_num_samples = 0;
+    }
+
+/*! \param delimiter New delimiter to set
+
+    The delimiter is printed between every element in the row of the output
+*/
+void StructureFactorAnalyzer::setDelimiter(const std::string& delimiter)
+    {
+    m_delimiter = delimiter;
+    }
+
+void export_StructureFactorAnalyzer()
+    {
+    class_<StructureFactorAnalyzer, boost::shared_ptr<StructureFactorAnalyzer>, bases<Analyzer>, boost::noncopyable>
+    ("StructureFactorAnalyzer", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<ParticleGroup>,
+                                      const std::string&, Scalar, unsigned int, unsigned int >())
+    .def("writeFile", &StructureFactorAnalyzer::writeFile)
+    .def("reset", &StructureFactorAnalyzer::reset)
+    .def("getNumSamples", &StructureFactorAnalyzer::getNumSamples)
+    .def("getNumWaveVectors", &StructureFactorAnalyzer::getNumWaveVectors)
+    .def("setDelimiter", &StructureFactorAnalyzer::setDelimiter)
+    ;
+    }
@@ -0,0 +1,175 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file StructureFactorAnalyzer.h
+    \brief Declares the StructureFactorAnalyzer class
+*/
+
+#ifndef __STRUCTURE_FACTOR_ANALYZER_H__
+#define __STRUCTURE_FACTOR_ANALYZER_H__
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "ParticleGroup.h"
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+//! Accumulates the static structure factor S(k) of a group of particles on the fly
+/*! StructureFactorAnalyzer evaluates
+    \f[ S(\vec{k}) = \frac{1}{N} \left| \sum_j e^{i \vec{k} \cdot \vec{r}_j} \right|^2 \f]
+    on wave vectors of the reciprocal lattice of the simulation box with \f$ 0 < |\vec{k}| \le k_{max} \f$
+    (one of each \f$ \pm\vec{k} \f$ pair). Every call to analyze() adds one sample, binned by \f$ |\vec{k}| \f$.
+
+    The number of lattice vectors in a shell grows as \f$ (k L)^2 \f$, so at most \a max_k_per_bin of them are kept
+    in each bin, chosen at random with a fixed seed so that all ranks pick the same set. The cost of a sample is
+    proportional to the number of local particles times the number of kept wave vectors. The set is generated once
+    and cached. When the box changes, the magnitudes of the cached vectors are updated, and the set is only
+    regenerated once a box length has changed by more than 10% since the set was generated.
+
+    S(k) is nonlinear in the density modes, so the modes of a sample must be summed over all ranks before they are
+    squared. Each rank buffers the modes of its local group members and the buffer is reduced to the root rank when
+    writeFile() is called (or earlier, when the buffer grows beyond a few megabytes). Without MPI, the histogram is
+    accumulated directly.
+
+    \ingroup analyzers
+*/
+class StructureFactorAnalyzer : public Analyzer
+    {
+    public:
+        //! Construct the structure factor analyzer
+        StructureFactorAnalyzer(boost::shared_ptr<SystemDefinition> sysdef,
+                                boost::shared_ptr<ParticleGroup> group,
+                                const std::string& fname,
+                                Scalar k_max,
+                                unsigned int nbins,
+                                unsigned int max_k_per_bin);
+
+        //! Destructor
+        ~StructureFactorAnalyzer();
+
+        //! Add a sample of the current configuration to the histogram
+        void analyze(unsigned int timestep);
+
+        //! Write the averaged S(k) to the file
+        void writeFile();
+
+        //! Clear the accumulated histogram
+        void reset();
+
+        //! Get the number of samples accumulated since the last reset()
+        unsigned int getNumSamples() const
+            {
+            return m_num_samples;
+            }
+
+        //! Get the number of wave vectors evaluated per sample
+        unsigned int getNumWaveVectors() const
+            {
+            return m_kvec.size();
+            }
+
+        //! Sets the delimiter to use between fields
+        void setDelimiter(const std::string& delimiter);
+
+    private:
+        boost::shared_ptr<ParticleGroup> m_group;   //!< Particles to compute S(k) of
+        std::string m_fname;                        //!< File name to write to
+        std::string m_delimiter;                    //!< The delimiter to put between columns in the file
+        Scalar m_k_max;                             //!< Largest wave vector magnitude sampled
+        unsigned int m_nbins;                       //!< Number of bins between 0 and k_max
+        unsigned int m_max_k_per_bin;               //!< Maximum number of wave vectors kept in each bin
+
+        std::vector<int3> m_kvec;                   //!< Wave vectors in units of the reciprocal lattice vectors
+        std::vector<Scalar> m_kmag;                 //!< Magnitude of each wave vector in the current box
+        Scalar3 m_kvec_L;                           //!< Box lengths the wave vectors were generated for
+        bool m_box_changed;                         //!< True if the box changed since the magnitudes were computed
+        boost::signals2::connection m_boxchange_connection; //!< Connection to the box change signal
+
+        std::vector<Scalar3> m_frac;                //!< Fractional coordinates of the local group members
+        std::vector<double> m_rho;                  //!< Real and imaginary parts of the density modes
+
+        std::vector<double> m_pending_rho;          //!< Buffered local density modes of samples not yet reduced
+        std::vector<Scalar> m_pending_kmag;         //!< Wave vector magnitudes of the buffered modes
+        unsigned int m_pending_samples;             //!< Number of buffered samples
+
+        std::vector<double> m_sk;                   //!< S(k) summed by bin over all samples
+        std::vector<double> m_k_sum;                //!< |k| summed by bin over all samples
+        std::vector<double> m_count;                //!< Number of wave vectors summed by bin
+        unsigned int m_num_samples;                 //!< Number of samples accumulated
+
+        //! Generate the wave vectors for the current box
+        void updateWaveVectors();
+
+        //! Update the cached wave vector magnitudes after a box change
+        void updateMagnitudes();
+
+        //! Add the density modes of one sample to the histogram
+        void accumulate(const double *rho, const Scalar *kmag, unsigned int nk);
+
+        //! Reduce the buffered samples to the root rank and add them to the histogram
+        void flushSamples();
+
+        //! Slot called when the box changes
+        void slotBoxChanged()
+            {
+            m_box_changed = true;
+            }
+    };
+
+//! Exports the StructureFactorAnalyzer class to python
+void export_StructureFactorAnalyzer();
+
+#endif
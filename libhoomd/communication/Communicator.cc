@@ -67,6 +67,55 @@ using namespace std;
 using namespace boost::python;
 
 #include <vector>
+#include <string.h>
+
+//! Returns a pointer to the beginning of a packed buffer, or NULL if it is empty
+static inline char *buffer_data(std::vector<char>& buf)
+    {
+    return buf.empty() ? NULL : &buf.front();
+    }
+
+//! Appends a value to a packed buffer
+template<class T>
+static inline void pack(char *& ptr, const T& val)
+    {
+    memcpy(ptr, &val, sizeof(T));
+    ptr += sizeof(T);
+    }
+
+//! Reads a value from a packed buffer
+template<class T>
+static inline void unpack(const char *& ptr, T& val)
+    {
+    memcpy(&val, ptr, sizeof(T));
+    ptr += sizeof(T);
+    }
+
+//! Size of a packed ghost particle record in exchangeGhosts()
+static size_t ghost_element_size(const CommFlags& flags)
+    {
+    // plan and tag are always sent
+    size_t sz = 2*sizeof(unsigned int);
+    if (flags[comm_flag::position]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::charge]) sz += sizeof(Scalar);
+    if (flags[comm_flag::diameter]) sz += sizeof(Scalar);
+    if (flags[comm_flag::velocity]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::orientation]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::body]) sz += sizeof(unsigned int);
+    return sz;
+    }
+
+//! Size of a packed ghost particle record in beginUpdateGhosts()
+/*! Only non-permanent fields (position, velocity, orientation) are updated, charge and diameter do not change during a run
+ */
+static size_t ghost_update_element_size(const CommFlags& flags)
+    {
+    size_t sz = 0;
+    if (flags[comm_flag::position]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::velocity]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::orientation]) sz += sizeof(Scalar4);
+    return sz;
+    }
 
 template<class group_data>
 Communicator::GroupCommunicator<group_data>::GroupCommunicator(Communicator& comm, boost::shared_ptr<group_data> gdata)
@@ -819,13 +868,8 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
             m_force_migrate(false),
             m_nneigh(0),
             m_n_unique_neigh(0),
-            m_pos_copybuf(m_exec_conf),
-            m_charge_copybuf(m_exec_conf),
-            m_diameter_copybuf(m_exec_conf),
-            m_velocity_copybuf(m_exec_conf),
-            m_orientation_copybuf(m_exec_conf),
-            m_plan_copybuf(m_exec_conf),
             m_tag_copybuf(m_exec_conf),
+            m_scalar_copybuf(m_exec_conf),
             m_r_ghost_max(Scalar(0.0)),
             m_plan(m_exec_conf),
             m_last_flags(0),
@@ -855,6 +899,10 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
         m_num_recv_ghosts[dir] = 0;
         }
 
+    for (unsigned int i = 0; i < 12; ++i)
+        m_update_reqs[i] = MPI_REQUEST_NULL;
+    m_update_reqs_valid = false;
+
     // connect to particle sort signal
     m_sort_connection = m_pdata->connectParticleSort(boost::bind(&Communicator::forceMigrate, this));
 
@@ -931,6 +979,8 @@ Communicator::~Communicator()
     m_angle_connection.disconnect();
     m_dihedral_connection.disconnect();
     m_improper_connection.disconnect();
+
+    freeGhostUpdateRequests();
     }
 
 void Communicator::initializeNeighborArrays()
@@ -1028,6 +1078,8 @@ void Communicator::initializeNeighborArrays()
 //! Interface to the communication methods.
 void Communicator::communicate(unsigned int timestep)
     {
+    PerformanceRegion region(m_comm_timer);
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -1116,109 +1168,245 @@ void Communicator::migrateParticles()
     // get box dimensions
     const BoxDim& box = m_pdata->getBox();
 
-    // determine local particles that are to be sent to neighboring processors and fill send buffer
-    for (unsigned int dir=0; dir < 6; dir++)
+    // mask of directions we are communicating along
+    unsigned int comm_mask = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        if (isCommunicating(dir)) comm_mask |= (1 << dir);
+
         {
-        if (! isCommunicating(dir) ) continue;
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flag(m_pdata->getCommFlags(), access_location::host, access_mode::readwrite);
+
+        // mark all particles which have left the box for sending, in a single pass over all directions
+        unsigned int N = m_pdata->getN();
 
+        for (unsigned int idx = 0; idx < N; ++idx)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_comm_flag(m_pdata->getCommFlags(), access_location::host, access_mode::readwrite);
+            const Scalar4& postype = h_pos.data[idx];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            Scalar3 f = box.makeFraction(pos);
 
-            // mark all particles which have left the box for sending (rtag=NOT_LOCAL)
-            unsigned int N = m_pdata->getN();
+            unsigned int flags = 0;
+            if (f.x >= Scalar(1.0)) flags |= send_east;
+            else if (f.x < Scalar(0.0)) flags |= send_west;
 
-            for (unsigned int idx = 0; idx < N; ++idx)
-                {
-                const Scalar4& postype = h_pos.data[idx];
-                Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-                Scalar3 f = box.makeFraction(pos);
-
-                // return true if the particle stays leaves the box
-                unsigned int flags = 0;
-                if (dir == 0 && f.x >= Scalar(1.0)) flags |= send_east;
-                else if (dir == 1 && f.x < Scalar(0.0)) flags |= send_west;
-                else if (dir == 2 && f.y >= Scalar(1.0)) flags |= send_north;
-                else if (dir == 3 && f.y < Scalar(0.0)) flags |= send_south;
-                else if (dir == 4 && f.z >= Scalar(1.0)) flags |= send_up;
-                else if (dir == 5 && f.z < Scalar(0.0)) flags |= send_down;
-
-                h_comm_flag.data[idx] = flags;
-                }
+            if (f.y >= Scalar(1.0)) flags |= send_north;
+            else if (f.y < Scalar(0.0)) flags |= send_south;
+
+            if (f.z >= Scalar(1.0)) flags |= send_up;
+            else if (f.z < Scalar(0.0)) flags |= send_down;
+
+            h_comm_flag.data[idx] = flags & comm_mask;
             }
+        }
 
-        /*
-         * Bonded group communication, determine groups to be sent
-         */
-        // Bonds
-        m_bond_comm.migrateGroups(m_bonds_changed);
-        m_bonds_changed = false;
+    /*
+     * Bonded group communication, determine groups to be sent
+     */
+    // Bonds
+    m_bond_comm.migrateGroups(m_bonds_changed);
+    m_bonds_changed = false;
 
-        // Angles
-        m_angle_comm.migrateGroups(m_angles_changed);
-        m_angles_changed = false;
+    // Angles
+    m_angle_comm.migrateGroups(m_angles_changed);
+    m_angles_changed = false;
 
-        // Dihedrals
-        m_dihedral_comm.migrateGroups(m_dihedrals_changed);
-        m_dihedrals_changed = false;
+    // Dihedrals
+    m_dihedral_comm.migrateGroups(m_dihedrals_changed);
+    m_dihedrals_changed = false;
 
-        // Dihedrals
-        m_improper_comm.migrateGroups(m_impropers_changed);
-        m_impropers_changed = false;
+    // Dihedrals
+    m_improper_comm.migrateGroups(m_impropers_changed);
+    m_impropers_changed = false;
 
-        // fill send buffer
-        std::vector<unsigned int> comm_flag_out; // not currently used
-        m_pdata->removeParticles(m_sendbuf, comm_flag_out);
+    // fill send buffer
+    std::vector<unsigned int> comm_flag_out;
+    m_pdata->removeParticles(m_sendbuf, comm_flag_out);
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+    unsigned int n_send_ptls[m_n_unique_neigh];
+    unsigned int n_recv_ptls[m_n_unique_neigh];
+    unsigned int offs[m_n_unique_neigh];
+    unsigned int n_recv_tot = 0;
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+        {
+        ArrayHandle<unsigned int> h_begin(m_begin, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_end(m_end, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
-        if (m_prof)
-            m_prof->push("MPI send/recv");
+        const Index3D& di = m_decomposition->getDomainIndexer();
+        uint3 mypos = m_decomposition->getGridPos();
 
-        unsigned int n_recv_ptls;
+        // look up the unique neighbor index of every rank we may send to
+        std::map<unsigned int, unsigned int> neigh_idx;
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            neigh_idx.insert(std::make_pair(h_unique_neighbors.data[ineigh], ineigh));
 
-        // communicate size of the message that will contain the particle data
-        MPI_Request reqs[2];
-        MPI_Status status[2];
+        // classify the removed particles by destination neighbor
+        unsigned int nsend = m_sendbuf.size();
+        ScopedHostAllocation<unsigned int> key_buf(m_exec_conf->getHostArena(), nsend);
+        unsigned int *key = key_buf.data;
 
-        unsigned int n_send_ptls = m_sendbuf.size();
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            n_send_ptls[ineigh] = 0;
 
-        MPI_Isend(&n_send_ptls, 1, MPI_UNSIGNED, send_neighbor, 0, m_mpi_comm, & reqs[0]);
-        MPI_Irecv(&n_recv_ptls, 1, MPI_UNSIGNED, recv_neighbor, 0, m_mpi_comm, & reqs[1]);
-        MPI_Waitall(2, reqs, status);
+        for (unsigned int i = 0; i < nsend; ++i)
+            {
+            unsigned int flags = comm_flag_out[i];
+
+            int ix, iy, iz;
+            ix = iy = iz = 0;
+
+            if (flags & send_east)
+                ix = 1;
+            else if (flags & send_west)
+                ix = -1;
+
+            if (flags & send_north)
+                iy = 1;
+            else if (flags & send_south)
+                iy = -1;
+
+            if (flags & send_up)
+                iz = 1;
+            else if (flags & send_down)
+                iz = -1;
+
+            int ni = (int)mypos.x + ix;
+            if (ni == (int)di.getW())
+                ni = 0;
+            else if (ni < 0)
+                ni += di.getW();
+
+            int nj = (int)mypos.y + iy;
+            if (nj == (int)di.getH())
+                nj = 0;
+            else if (nj < 0)
+                nj += di.getH();
+
+            int nk = (int)mypos.z + iz;
+            if (nk == (int)di.getD())
+                nk = 0;
+            else if (nk < 0)
+                nk += di.getD();
+
+            std::map<unsigned int, unsigned int>::iterator it = neigh_idx.find(h_cart_ranks.data[di(ni,nj,nk)]);
+            assert(it != neigh_idx.end());
+
+            key[i] = it->second;
+            n_send_ptls[key[i]]++;
+            }
 
-        // Resize receive buffer
-        m_recvbuf.resize(n_recv_ptls);
+        // sort the send buffer by neighbor (counting sort)
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            {
+            h_begin.data[ineigh] = ineigh ? h_end.data[ineigh-1] : 0;
+            h_end.data[ineigh] = h_begin.data[ineigh] + n_send_ptls[ineigh];
+            }
 
-        // exchange particle data
-        MPI_Isend(&m_sendbuf.front(), n_send_ptls*sizeof(pdata_element), MPI_BYTE, send_neighbor, 1, m_mpi_comm, & reqs[0]);
-        MPI_Irecv(&m_recvbuf.front(), n_recv_ptls*sizeof(pdata_element), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, & reqs[1]);
-        MPI_Waitall(2, reqs, status);
+        ScopedHostAllocation<pdata_element> sorted(m_exec_conf->getHostArena(), nsend);
+        std::vector<unsigned int> pos(h_begin.data, h_begin.data + m_n_unique_neigh);
+        for (unsigned int i = 0; i < nsend; ++i)
+            sorted.data[pos[key[i]]++] = m_sendbuf[i];
+        std::copy(sorted.data, sorted.data + nsend, m_sendbuf.begin());
+        }
 
-        if (m_prof)
-            m_prof->pop();
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+        {
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
 
-        // wrap received particles across a global boundary back into global box
-        const BoxDim shifted_box = getShiftedBox();
-        for (unsigned int idx = 0; idx < n_recv_ptls; idx++)
+        // communicate the sizes of the messages that will contain the particle data
+        MPI_Request req[2*m_n_unique_neigh];
+        MPI_Status stat[2*m_n_unique_neigh];
+        unsigned int nreq = 0;
+
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
             {
-            pdata_element& p = m_recvbuf[idx];
-            Scalar4& postype = p.pos;
-            int3& image = p.image;
+            unsigned int neighbor = h_unique_neighbors.data[ineigh];
 
-            shifted_box.wrap(postype, image);
+            MPI_Isend(&n_send_ptls[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
+            MPI_Irecv(&n_recv_ptls[ineigh], 1, MPI_UNSIGNED, neighbor, 0, m_mpi_comm, & req[nreq++]);
             }
 
-        // remove particles that were sent and fill particle data with received particles
-        m_pdata->addParticles(m_recvbuf);
-        } // end dir loop
+        MPI_Waitall(nreq, req, stat);
+
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            {
+            offs[ineigh] = n_recv_tot;
+            n_recv_tot += n_recv_ptls[ineigh];
+            }
+        }
+
+    // Resize receive buffer
+    m_recvbuf.resize(n_recv_tot);
+
+        {
+        ArrayHandle<unsigned int> h_begin(m_begin, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::read);
+
+        std::vector<MPI_Request> reqs;
+        MPI_Request req;
+
+        unsigned int send_bytes = 0;
+        unsigned int recv_bytes = 0;
+
+        // one packed message per unique neighbor, completed by a single MPI_Waitall
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+            {
+            unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+            if (n_send_ptls[ineigh])
+                {
+                MPI_Isend(&m_sendbuf.front()+h_begin.data[ineigh],
+                    n_send_ptls[ineigh]*sizeof(pdata_element),
+                    MPI_BYTE,
+                    neighbor,
+                    1,
+                    m_mpi_comm,
+                    &req);
+                reqs.push_back(req);
+                }
+            send_bytes += n_send_ptls[ineigh]*sizeof(pdata_element);
+
+            if (n_recv_ptls[ineigh])
+                {
+                MPI_Irecv(&m_recvbuf.front()+offs[ineigh],
+                    n_recv_ptls[ineigh]*sizeof(pdata_element),
+                    MPI_BYTE,
+                    neighbor,
+                    1,
+                    m_mpi_comm,
+                    &req);
+                reqs.push_back(req);
+                }
+            recv_bytes += n_recv_ptls[ineigh]*sizeof(pdata_element);
+            }
+
+        if (reqs.size())
+            {
+            std::vector<MPI_Status> stats(reqs.size());
+            MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
+            }
+
+        if (m_prof)
+            m_prof->pop(0, send_bytes+recv_bytes);
+        }
+
+    // wrap received particles across a global boundary back into global box
+    const BoxDim shifted_box = getShiftedBox();
+    for (unsigned int idx = 0; idx < n_recv_tot; idx++)
+        {
+        pdata_element& p = m_recvbuf[idx];
+        Scalar4& postype = p.pos;
+        int3& image = p.image;
+
+        shifted_box.wrap(postype, image);
+        }
+
+    // remove particles that were sent and fill particle data with received particles
+    m_pdata->addParticles(m_recvbuf);
 
     if (m_prof)
         m_prof->pop();
@@ -1347,17 +1535,15 @@ void Communicator::exchangeGhosts()
      * Fill send buffers, exchange particles according to plans
      */
 
-    // resize buffers
-    m_plan_copybuf.resize(m_pdata->getN());
-    m_pos_copybuf.resize(m_pdata->getN());
-    m_charge_copybuf.resize(m_pdata->getN());
-    m_diameter_copybuf.resize(m_pdata->getN());
-    m_velocity_copybuf.resize(m_pdata->getN());
-    m_orientation_copybuf.resize(m_pdata->getN());
+    // the ghost lists change, the persistent ghost update requests have to be set up again
+    freeGhostUpdateRequests();
 
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    // every ghost is sent as a single record that contains all requested fields
+    const size_t element_size = ghost_element_size(flags);
+
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
@@ -1368,45 +1554,37 @@ void Communicator::exchangeGhosts()
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
         m_copy_ghosts[dir].resize(max_copy_ghosts);
 
-        // resize buffers
-        m_plan_copybuf.resize(max_copy_ghosts);
-        m_pos_copybuf.resize(max_copy_ghosts);
-        m_charge_copybuf.resize(max_copy_ghosts);
-        m_diameter_copybuf.resize(max_copy_ghosts);
-        m_velocity_copybuf.resize(max_copy_ghosts);
-        m_orientation_copybuf.resize(max_copy_ghosts);
-
+        // resize send buffer
+        m_ghost_sendbuf.resize(max_copy_ghosts*element_size);
 
             {
-            // we fill all fields, but send only those that are requested by the CommFlags bitset
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
             ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int>  h_plan(m_plan, access_location::host, access_mode::read);
 
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+
+            char *ptr = buffer_data(m_ghost_sendbuf);
 
             for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
                 {
 
                 if (h_plan.data[idx] & (1 << dir))
                     {
-                    // send with next message
-                    h_pos_copybuf.data[m_num_copy_ghosts[dir]] = h_pos.data[idx];
-                    h_charge_copybuf.data[m_num_copy_ghosts[dir]] = h_charge.data[idx];
-                    h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
-                    h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
-                    h_orientation_copybuf.data[m_num_copy_ghosts[dir]] = h_orientation.data[idx];
-                    h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
+                    // pack the fields requested by the CommFlags bitset
+                    pack(ptr, h_plan.data[idx]);
+                    pack(ptr, h_tag.data[idx]);
+                    if (flags[comm_flag::position]) pack(ptr, h_pos.data[idx]);
+                    if (flags[comm_flag::charge]) pack(ptr, h_charge.data[idx]);
+                    if (flags[comm_flag::diameter]) pack(ptr, h_diameter.data[idx]);
+                    if (flags[comm_flag::velocity]) pack(ptr, h_vel.data[idx]);
+                    if (flags[comm_flag::orientation]) pack(ptr, h_orientation.data[idx]);
+                    if (flags[comm_flag::body]) pack(ptr, h_body.data[idx]);
 
                     h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
@@ -1426,8 +1604,8 @@ void Communicator::exchangeGhosts()
             m_prof->push("MPI send/recv");
 
         // communicate size of the message that will contain the particle data
-        MPI_Request reqs[14];
-        MPI_Status status[14];
+        MPI_Request reqs[2];
+        MPI_Status status[2];
 
         MPI_Isend(&m_num_copy_ghosts[dir],
             sizeof(unsigned int),
@@ -1445,8 +1623,27 @@ void Communicator::exchangeGhosts()
             &reqs[1]);
         MPI_Waitall(2, reqs, status);
 
+        // exchange the packed particle data
+        m_ghost_recvbuf.resize(m_num_recv_ghosts[dir]*element_size);
+
+        MPI_Isend(buffer_data(m_ghost_sendbuf),
+            m_num_copy_ghosts[dir]*element_size,
+            MPI_BYTE,
+            send_neighbor,
+            1,
+            m_mpi_comm,
+            &reqs[0]);
+        MPI_Irecv(buffer_data(m_ghost_recvbuf),
+            m_num_recv_ghosts[dir]*element_size,
+            MPI_BYTE,
+            recv_neighbor,
+            1,
+            m_mpi_comm,
+            &reqs[1]);
+        MPI_Waitall(2, reqs, status);
+
         if (m_prof)
-            m_prof->pop();
+            m_prof->pop(0, (m_num_copy_ghosts[dir]+m_num_recv_ghosts[dir])*element_size);
 
         // append ghosts at the end of particle data array
         unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
@@ -1457,156 +1654,32 @@ void Communicator::exchangeGhosts()
         // resize plan array
         m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
 
-        // exchange particle data, write directly to the particle data arrays
-        if (m_prof)
-            m_prof->push("MPI send/recv");
-
             {
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
-            ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::read);
-            ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
-
+            // unpack the received ghosts directly into the particle data arrays
             ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
 
-            unsigned int nreq = 0;
-
-            MPI_Isend(h_plan_copybuf.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                1,
-                m_mpi_comm,
-                &reqs[nreq++]);
-            MPI_Irecv(h_plan.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                1,
-                m_mpi_comm,
-                &reqs[nreq++]);
-
-            MPI_Isend(h_copy_ghosts.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                2,
-                m_mpi_comm,
-                &reqs[nreq++]);
-            MPI_Irecv(h_tag.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                2,
-                m_mpi_comm,
-                &reqs[nreq++]);
-
-            if (flags[comm_flag::position])
-                {
-                MPI_Isend(h_pos_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_pos.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
-
-            if (flags[comm_flag::charge])
-                {
-                MPI_Isend(h_charge_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_charge.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+            const char *ptr = buffer_data(m_ghost_recvbuf);
 
-            if (flags[comm_flag::diameter])
-                {
-                MPI_Isend(h_diameter_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_diameter.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
-
-            if (flags[comm_flag::velocity])
-                {
-                MPI_Isend(h_velocity_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_vel.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
-
-
-            if (flags[comm_flag::orientation])
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
                 {
-                MPI_Isend(h_orientation_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_orientation.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
+                unpack(ptr, h_plan.data[idx]);
+                unpack(ptr, h_tag.data[idx]);
+                if (flags[comm_flag::position]) unpack(ptr, h_pos.data[idx]);
+                if (flags[comm_flag::charge]) unpack(ptr, h_charge.data[idx]);
+                if (flags[comm_flag::diameter]) unpack(ptr, h_diameter.data[idx]);
+                if (flags[comm_flag::velocity]) unpack(ptr, h_vel.data[idx]);
+                if (flags[comm_flag::orientation]) unpack(ptr, h_orientation.data[idx]);
+                if (flags[comm_flag::body]) unpack(ptr, h_body.data[idx]);
                 }
-
-            MPI_Waitall(nreq, reqs, status);
             }
 
-        if (m_prof)
-            m_prof->pop();
-
         // wrap particle positions
         if (flags[comm_flag::position])
             {
@@ -1614,14 +1687,8 @@ void Communicator::exchangeGhosts()
 
             const BoxDim shifted_box = getShiftedBox();
 
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
-
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0,0,0);
-                shifted_box.wrap(pos,img);
-                }
+            // wrap particles received across a global boundary
+            shifted_box.wrapArray(h_pos.data + start_idx, NULL, m_num_recv_ghosts[dir]);
             }
 
             {
@@ -1644,6 +1711,74 @@ void Communicator::exchangeGhosts()
         m_prof->pop();
     }
 
+//! Set up the persistent requests for ghost updates
+/*! The ghost lists, and therefore the message sizes, do not change between two calls to exchangeGhosts().
+    The packed update buffers are allocated once and the send and receive requests for every direction
+    are initialized with MPI_Send_init/MPI_Recv_init, to be started in every subsequent ghost update.
+
+    \param flags The ghost communication flags that determine the fields that are updated
+ */
+void Communicator::initGhostUpdateRequests(const CommFlags& flags)
+    {
+    freeGhostUpdateRequests();
+
+    const size_t element_size = ghost_update_element_size(flags);
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+        m_update_sendbuf[dir].resize(m_num_copy_ghosts[dir]*element_size);
+        m_update_recvbuf[dir].resize(m_num_recv_ghosts[dir]*element_size);
+
+        MPI_Send_init(buffer_data(m_update_sendbuf[dir]),
+            m_update_sendbuf[dir].size(),
+            MPI_BYTE,
+            send_neighbor,
+            1,
+            m_mpi_comm,
+            &m_update_reqs[2*dir]);
+        MPI_Recv_init(buffer_data(m_update_recvbuf[dir]),
+            m_update_recvbuf[dir].size(),
+            MPI_BYTE,
+            recv_neighbor,
+            1,
+            m_mpi_comm,
+            &m_update_reqs[2*dir+1]);
+        }
+
+    m_update_reqs_flags = flags;
+    m_update_reqs_valid = true;
+    }
+
+//! Free the persistent requests for ghost updates
+void Communicator::freeGhostUpdateRequests()
+    {
+    if (! m_update_reqs_valid) return;
+
+    // the requests can no longer be freed once MPI has been shut down
+    int finalized;
+    MPI_Finalized(&finalized);
+
+    for (unsigned int i = 0; i < 12; ++i)
+        {
+        if (m_update_reqs[i] != MPI_REQUEST_NULL && !finalized)
+            MPI_Request_free(&m_update_reqs[i]);
+        m_update_reqs[i] = MPI_REQUEST_NULL;
+        }
+
+    m_update_reqs_valid = false;
+    }
+
 //! update positions of ghost particles
 void Communicator::beginUpdateGhosts(unsigned int timestep)
     {
@@ -1654,7 +1789,14 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    CommFlags flags = getFlags();
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    // charge and diameter are not updated during a run
+    const size_t element_size = ghost_update_element_size(flags);
+
+    if (element_size && (! m_update_reqs_valid || flags != m_update_reqs_flags))
+        initGhostUpdateRequests(flags);
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
@@ -1662,66 +1804,110 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         {
         if (! isCommunicating(dir) ) continue;
 
-        CommFlags flags = getFlags();
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        if (! element_size) continue;
 
-        if (flags[comm_flag::position])
             {
+            // pack the fields of the ghost particles into the send buffer
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-            // copy positions of ghost particles
+            char *ptr = buffer_data(m_update_sendbuf[dir]);
+
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                if (flags[comm_flag::position]) pack(ptr, h_pos.data[idx]);
+                if (flags[comm_flag::velocity]) pack(ptr, h_vel.data[idx]);
+                if (flags[comm_flag::orientation]) pack(ptr, h_orientation.data[idx]);
                 }
             }
 
-        if (flags[comm_flag::velocity])
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        // exchange particle data using the persistent requests
+        MPI_Status status[2];
+        MPI_Startall(2, &m_update_reqs[2*dir]);
+        MPI_Waitall(2, &m_update_reqs[2*dir], status);
+
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*element_size);
+
             {
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+            // unpack the received fields into the particle data arrays
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
 
-            // copy velocity of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            const char *ptr = buffer_data(m_update_recvbuf[dir]);
+
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                if (flags[comm_flag::position]) unpack(ptr, h_pos.data[idx]);
+                if (flags[comm_flag::velocity]) unpack(ptr, h_vel.data[idx]);
+                if (flags[comm_flag::orientation]) unpack(ptr, h_orientation.data[idx]);
+                }
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+            // wrap particle positions (only if copying positions)
+            if (flags[comm_flag::position])
+                {
+                const BoxDim shifted_box = getShiftedBox();
 
-                // copy velocityition into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                // wrap particles received across a global boundary
+                shifted_box.wrapArray(h_pos.data + start_idx, NULL, m_num_recv_ghosts[dir]);
                 }
             }
+        } // end dir loop
+
+        if (m_prof)
+            m_prof->pop();
+    }
+
+void Communicator::updateGhostScalar(GPUArray<Scalar>& field)
+    {
+    assert(field.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_scalar");
+
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        // the buffer persists between calls and only grows
+        if (m_scalar_copybuf.size() < m_num_copy_ghosts[dir])
+            m_scalar_copybuf.resize(m_num_copy_ghosts[dir]);
+
+        ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::readwrite);
 
-        if (flags[comm_flag::orientation])
             {
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-            // copy orientation of ghost particles
+            // values of ghosts received in a previous direction are forwarded as well
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
+                h_scalar_copybuf.data[ghost_idx] = h_field.data[idx];
                 }
             }
 
-
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
         // we receive from the direction opposite to the one we send to
@@ -1731,91 +1917,29 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         else
             recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
-
-        unsigned int start_idx;
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
         if (m_prof)
             m_prof->push("MPI send/recv");
 
-        start_idx = m_pdata->getN() + num_tot_recv_ghosts;
-
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
-
-        size_t sz = 0;
-        // only non-permanent fields (position, velocity, orientation) need to be considered here
-        // charge and diameter are not updated during a run
-        if (flags[comm_flag::position])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
-
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
-
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
-
-            sz += sizeof(Scalar4);
-            }
-
-        if (flags[comm_flag::velocity])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
-
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
-
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
-
-            sz += sizeof(Scalar4);
-            }
-
-        if (flags[comm_flag::orientation])
             {
             MPI_Request reqs[2];
             MPI_Status status[2];
 
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_scalar_copybuf(m_scalar_copybuf, access_location::host, access_mode::read);
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &reqs[1]);
+            MPI_Isend(h_scalar_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar), MPI_BYTE, send_neighbor, 4, m_mpi_comm, &reqs[0]);
+            MPI_Irecv(h_field.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar), MPI_BYTE, recv_neighbor, 4, m_mpi_comm, &reqs[1]);
             MPI_Waitall(2, reqs, status);
-
-            sz += sizeof(Scalar4);
             }
 
         if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
-
-
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
-
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0,0,0);
-                shifted_box.wrap(pos, img);
-                }
-            }
-
+            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sizeof(Scalar));
         } // end dir loop
 
-        if (m_prof)
-            m_prof->pop();
+    if (m_prof)
+        m_prof->pop();
     }
 
 void Communicator::removeGhostParticleTags()
@@ -1830,6 +1954,46 @@ void Communicator::removeGhostParticleTags()
         }
     }
 
+/*! The communicator provides
+    - \b time_comm - maximum over all ranks of the wall clock time (in seconds) spent in communicate() since the last
+      log write, excluding the force computes that it triggers
+    - \b ghost_count - total number of ghost particles over all ranks
+
+    Like Compute::getProvidedLogQuantities(), but the quantities are logged through the Integrator that owns the
+    communicator.
+*/
+std::vector< std::string > Communicator::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_comm");
+    result.push_back("ghost_count");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar Communicator::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "time_comm")
+        {
+        Scalar t = m_comm_timer.getIntervalSeconds(timestep);
+        MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
+        return t;
+        }
+    else if (quantity == "ghost_count")
+        {
+        unsigned int n_ghosts = m_pdata->getNGhosts();
+        MPI_Allreduce(MPI_IN_PLACE, &n_ghosts, 1, MPI_UNSIGNED, MPI_SUM, m_mpi_comm);
+        return Scalar(n_ghosts);
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "comm: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+    }
+
 const BoxDim Communicator::getShiftedBox() const
     {
     // construct the shifted global box for applying global boundary conditions
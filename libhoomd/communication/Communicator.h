@@ -73,6 +73,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/signals2.hpp>
 
 #include "Autotuner.h"
+#include "PerformanceCounter.h"
 
 /*! \ingroup hoomd_lib
     @{
@@ -110,7 +111,8 @@ struct comm_flag
         charge,      //! Bit id in CommFlags for particle charge
         diameter,    //! Bit id in CommFlags for particle diameter
         velocity,    //! Bit id in CommFlags for particle velocity
-        orientation  //! Bit id in CommFlags for particle orientation
+        orientation, //! Bit id in CommFlags for particle orientation
+        body         //! Bit id in CommFlags for particle rigid body ids
         };
     };
 
@@ -240,7 +242,11 @@ struct rank_element
  *
  * <b>Implementation details:</b>
  *
- * In every stage, particles are subsequently exchanged in six directions:
+ * Particle migration (stage one) is performed in a single step. Every local particle is classified by the
+ * (up to 26) neighboring domains it has moved into, the send buffer is sorted by destination, and one message per unique
+ * neighbor rank is exchanged. A particle migrating to the processor north-east of the present one is sent there directly.
+ *
+ * In stages two and three, particles are subsequently exchanged in six directions:
  *
  * -# send particles to the east, receive from the west
  * -# send particles to the west, receive from the east
@@ -262,6 +268,11 @@ struct rank_element
  * In stage two and three, ghost atoms received from a neighboring processor are always included in the local
  * ghost atom lists, and they maybe replicated to more neighboring processors by the communication pattern
  * described above.
+ *
+ * In stages two and three, all fields of a ghost particle that are requested by the CommFlags are packed into a
+ * single, per-particle interleaved buffer, so that only one message is sent per direction. The ghost updates
+ * of stage three reuse persistent MPI requests (MPI_Send_init/MPI_Recv_init) until the ghost lists or the
+ * communication flags change.
  * \ingroup communication
  */
 class Communicator
@@ -411,6 +422,12 @@ class Communicator
 
         //@}
 
+        //! Returns a list of log quantities the communicator provides
+        std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
         //! Force particle migration
         void forceMigrate()
             {
@@ -448,9 +465,9 @@ class Communicator
          * boundaries and transfers them to neighboring processors.
          *
          * Particles sent to a neighbor are deleted from the local particle data.
-         * Particles received from a neighbor in one of the six communication steps
-         * are added to the local particle data, and are also considered for forwarding to a neighbor
-         * in the subseqent communication steps.
+         * Every particle is sent directly to the (face, edge or corner) neighbor whose domain it has
+         * moved into, with one message per unique neighbor rank. This assumes that no particle has moved
+         * farther than one domain width since the last migration.
          *
          * \post Every particle on every processor can be found inside the local domain boundaries.
          */
@@ -466,6 +483,19 @@ class Communicator
          */
         virtual void exchangeGhosts();
 
+        /*! Copy the values of a per-particle quantity from the owning processors to the ghost particles
+         *
+         * This is used by force computes which depend on an intermediate per-particle result of a neighbor
+         * (such as the derivative of the embedding function in EAM) in the middle of the force computation.
+         * Using the same ghost exchange lists as beginUpdateGhosts(), the values of the local particles are sent
+         * and written into the ghost entries of \a field.
+         *
+         * \param field Array indexed like the particle data, with room for at least N+Nghosts elements
+         *
+         * \pre The ghost exchange list has been constructed using exchangeGhosts().
+         */
+        virtual void updateGhostScalar(GPUArray<Scalar>& field);
+
         //! \name Enumerations
         //@{
 
@@ -584,6 +614,7 @@ class Communicator
         boost::shared_ptr<Profiler> m_prof;                           //!< Profiler
 
         bool m_is_communicating;               //!< Whether we are currently communicating
+        PerformanceCounter m_comm_timer;       //!< Wall clock time spent in communicate()
         bool m_force_migrate;                  //!< True if particle migration is forced
 
         unsigned int m_is_at_boundary[6];      //!< Array of flags indicating whether this box lies at a global boundary
@@ -596,13 +627,8 @@ class Communicator
         GPUArray<unsigned int> m_begin;                //!< Begin index for every neighbor in send buf
         GPUArray<unsigned int> m_end;                  //!< End index for every neighbor in send buf
 
-        GPUVector<Scalar4> m_pos_copybuf;         //!< Buffer for particle positions to be copied
-        GPUVector<Scalar> m_charge_copybuf;       //!< Buffer for particle charges to be copied
-        GPUVector<Scalar> m_diameter_copybuf;     //!< Buffer for particle diameters to be copied
-        GPUVector<Scalar4> m_velocity_copybuf;    //!< Buffer for particle velocities to be copied
-        GPUVector<Scalar4> m_orientation_copybuf; //!< Buffer for particle orientation to be copied
-        GPUVector<unsigned int> m_plan_copybuf;  //!< Buffer for particle plans
         GPUVector<unsigned int> m_tag_copybuf;    //!< Buffer for particle tags
+        GPUVector<Scalar> m_scalar_copybuf;       //!< Buffer for per-particle quantities in updateGhostScalar()
 
         GPUVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
@@ -695,6 +721,21 @@ class Communicator
         std::vector<pdata_element> m_sendbuf;  //!< Buffer for particles that are sent
         std::vector<pdata_element> m_recvbuf;  //!< Buffer for particles that are received
 
+        /* Packed ghost communication */
+        std::vector<char> m_ghost_sendbuf;     //!< Packed send buffer for ghost particles
+        std::vector<char> m_ghost_recvbuf;     //!< Packed receive buffer for ghost particles
+        std::vector<char> m_update_sendbuf[6]; //!< Per-direction packed send buffers for ghost updates
+        std::vector<char> m_update_recvbuf[6]; //!< Per-direction packed receive buffers for ghost updates
+        MPI_Request m_update_reqs[12];         //!< Persistent send and receive request for ghost updates, per direction
+        bool m_update_reqs_valid;              //!< True if the persistent requests match the current ghost lists
+        CommFlags m_update_reqs_flags;         //!< Ghost communication flags the persistent requests were set up for
+
+        //! Set up the persistent requests for ghost updates
+        void initGhostUpdateRequests(const CommFlags& flags);
+
+        //! Free the persistent requests for ghost updates
+        void freeGhostUpdateRequests();
+
         /* Communication of bonded groups */
         GroupCommunicator<BondData> m_bond_comm;    //!< Communication helper for bonds
         friend class GroupCommunicator<BondData>;
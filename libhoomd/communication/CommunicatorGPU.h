@@ -104,6 +104,14 @@ class CommunicatorGPU : public Communicator
         //! Build a ghost particle list, exchange ghost particle data with neighboring processors
         virtual void exchangeGhosts();
 
+        //! Ghost updates of other per-particle quantities are not implemented on the GPU
+        virtual void updateGhostScalar(GPUArray<Scalar>& field)
+            {
+            m_exec_conf->msg->error() << "comm: Updating ghost values of per-particle quantities is not supported on the GPU"
+                                      << std::endl;
+            throw std::runtime_error("Error updating ghost particles");
+            }
+
         //@}
 
         //! Set maximum number of communication stages
@@ -70,7 +70,7 @@ using namespace std;
 BondTablePotential::BondTablePotential(boost::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondTablePotential" << endl;
 
@@ -163,6 +163,55 @@ void BondTablePotential::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = F[i];
         }
+
+    // and the cubic coefficients, if they are in use
+    if (m_cubic)
+        {
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::readwrite);
+        table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                           h_tables.data + m_table_value(0, type),
+                           m_table_width,
+                           h_params.data[type].z);
+        }
+    }
+
+/*! \param cubic True to interpolate with cubic Hermite polynomials, false for linear interpolation
+
+    The coefficients are only allocated while cubic interpolation is selected. They are computed from the tables set
+    so far here, and updated by later calls to setTable().
+*/
+void BondTablePotential::setCubicInterpolation(bool cubic)
+    {
+    if (cubic && m_table_width < 2)
+        {
+        m_exec_conf->msg->error() << "bond.table: Cubic interpolation needs a table width of at least 2" << endl;
+        throw runtime_error("Error initializing BondTablePotential");
+        }
+
+    if (cubic && !m_cubic)
+        {
+        // one set of coefficients per interval between table points
+        unsigned int n_types = m_bond_data->getNTypes();
+        GPUArray<Scalar4> coeffs((m_table_width - 1) * n_types, m_exec_conf);
+        m_coeffs.swap(coeffs);
+
+        ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::overwrite);
+        for (unsigned int type = 0; type < n_types; type++)
+            table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                               h_tables.data + m_table_value(0, type),
+                               m_table_width,
+                               h_params.data[type].z);
+        }
+    else if (!cubic)
+        {
+        // release the coefficients
+        GPUArray<Scalar4> coeffs;
+        m_coeffs.swap(coeffs);
+        }
+
+    m_cubic = cubic;
     }
 
 /*! BondTablePotential provides
@@ -221,6 +270,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::read);
 
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
@@ -278,20 +328,32 @@ void BondTablePotential::computeForces(unsigned int timestep)
 
             /// Here we use the table!!
             unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
-            Scalar f = value_f - Scalar(value_i);
-
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            if (m_cubic)
+                {
+                // guard against round off placing r in the (nonexistent) interval past the end
+                if (value_i > m_table_width - 2)
+                    value_i = m_table_width - 2;
+                Scalar f = value_f - Scalar(value_i);
+                table_hermite_eval(h_coeffs.data[(m_table_width - 1) * type + value_i], f, Scalar(1.0) / delta_r, V, F);
+                }
+            else
+                {
+                Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
+                Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
+                // unpack the data
+                Scalar V0 = VF0.x;
+                Scalar V1 = VF1.x;
+                Scalar F0 = VF0.y;
+                Scalar F1 = VF1.y;
+
+                // compute the linear interpolation coefficient
+                Scalar f = value_f - Scalar(value_i);
+
+                // interpolate to get V and F;
+                V = V0 + f * (V1 - V0);
+                F = F0 + f * (F1 - F0);
+                }
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar force_divr = Scalar(0.0);
@@ -342,5 +404,6 @@ void export_BondTablePotential()
     class_<BondTablePotential, boost::shared_ptr<BondTablePotential>, bases<ForceCompute>, boost::noncopyable >
     ("BondTablePotential", init< boost::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &BondTablePotential::setTable)
+    .def("setCubicInterpolation", &BondTablePotential::setCubicInterpolation)
     ;
     }
@@ -52,6 +52,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ForceCompute.h"
 #include "Index1D.h"
 #include "GPUArray.h"
+#include "TableInterpolation.h"
 
 #include <boost/shared_ptr.hpp>
 
@@ -91,6 +92,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - float(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    setCubicInterpolation() selects cubic Hermite interpolation instead, see TablePotential. It is only available on
+    the CPU.
     \ingroup computes
 */
 class BondTablePotential : public ForceCompute
@@ -111,6 +115,9 @@ class BondTablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Select cubic Hermite (true) or linear (false) interpolation
+        virtual void setCubicInterpolation(bool cubic);
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -136,6 +143,8 @@ class BondTablePotential : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GPUArray<Scalar4> m_params;                 //!< Parameters stored for each table
         Index2D m_table_value;                      //!< Index table helper
+        GPUArray<Scalar4> m_coeffs;                 //!< Cubic Hermite coefficients for each table interval
+        bool m_cubic;                               //!< True if cubic interpolation is used
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
@@ -79,6 +79,8 @@ CellList::CellList(boost::shared_ptr<SystemDefinition> sysdef)
     m_particles_sorted = false;
     m_box_changed = false;
     m_multiple = 1;
+    m_deformation_tol = Scalar(0.05);
+    m_box_deformed = false;
 
     GPUFlags<uint3> conditions(exec_conf);
     m_conditions.swap(conditions);
@@ -110,9 +112,10 @@ static unsigned int roundDown(unsigned int v, unsigned int m)
     return d*m;
     }
 
-/*! \returns Cell dimensions that match with the current width, and box dimension
+/*! \param width Minimum width of a cell
+    \returns Cell dimensions that match with \a width, and box dimension
 */
-uint3 CellList::computeDimensions()
+uint3 CellList::computeDimensions(Scalar width)
     {
     uint3 dim;
 
@@ -121,9 +124,9 @@ uint3 CellList::computeDimensions()
 
     Scalar3 L = box.getNearestPlaneDistance();
 
-    dim.x = roundDown((unsigned int)((L.x) / (m_nominal_width)), m_multiple);
-    dim.y = roundDown((unsigned int)((L.y) / (m_nominal_width)), m_multiple);
-    dim.z = (m_sysdef->getNDimensions() == 3) ? roundDown((unsigned int)((L.z) / (m_nominal_width)), m_multiple) : 1;
+    dim.x = roundDown((unsigned int)((L.x) / (width)), m_multiple);
+    dim.y = roundDown((unsigned int)((L.y) / (width)), m_multiple);
+    dim.z = (m_sysdef->getNDimensions() == 3) ? roundDown((unsigned int)((L.z) / (width)), m_multiple) : 1;
 
     // expand for ghost width if communicating ghosts
 #ifdef ENABLE_MPI
@@ -169,6 +172,7 @@ void CellList::compute(unsigned int timestep)
         {
         m_exec_conf->msg->notice(10) << "Cell list params changed" << endl;
         // need to fully reinitialize on any parameter change
+        m_box_deformed = false;
         initializeAll();
         m_params_changed = false;
         force = true;
@@ -176,21 +180,18 @@ void CellList::compute(unsigned int timestep)
 
     if (m_box_changed)
         {
-        uint3 new_dim = computeDimensions();
+        // from now on, choose dimensions that tolerate further deformation
+        m_box_deformed = true;
+
+        uint3 old_dim = m_dim;
+        initializeWidth();
         m_exec_conf->msg->notice(10) << "Cell list box changed "
-                                     << m_dim.x << " x " << m_dim.y << " x " << m_dim.z << " -> "
-                                     << new_dim.x << " x " << new_dim.y << " x " << new_dim.z << " -> "
-                                     << endl;
-        if (new_dim.x == m_dim.x && new_dim.y == m_dim.y && new_dim.z == m_dim.z)
-            {
-            // number of bins has not changed, only need to update width
-            initializeWidth();
-            }
-        else
-            {
-            // number of bins has changed, need to fully reinitialize memory
-            initializeAll();
-            }
+                                     << old_dim.x << " x " << old_dim.y << " x " << old_dim.z << " -> "
+                                     << m_dim.x << " x " << m_dim.y << " x " << m_dim.z << endl;
+
+        // only need to reinitialize memory if the number of bins has changed
+        if (old_dim.x != m_dim.x || old_dim.y != m_dim.y || old_dim.z != m_dim.z)
+            initializeMemory();
 
         m_box_changed = false;
         force = true;
@@ -299,7 +300,22 @@ void CellList::initializeWidth()
 #endif
 
     // initialize dimensions and width
-    m_dim = computeDimensions();
+    uint3 dim = computeDimensions(m_nominal_width);
+    if (m_box_deformed && m_deformation_tol > Scalar(0.0))
+        {
+        // keep the current dimensions while they are valid and no coarser than the padded choice
+        uint3 padded_dim = computeDimensions(m_nominal_width * (Scalar(1.0) + m_deformation_tol));
+        if (m_dim.x < padded_dim.x || m_dim.x > dim.x ||
+            m_dim.y < padded_dim.y || m_dim.y > dim.y ||
+            m_dim.z < padded_dim.z || m_dim.z > dim.z)
+            {
+            m_dim = padded_dim;
+            }
+        }
+    else
+        {
+        m_dim = dim;
+        }
 
     // stash the current actual cell width
     const Scalar3 L = box.getNearestPlaneDistance();
@@ -504,6 +520,12 @@ void CellList::computeCellList()
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
+    // compute the fractional coordinates of all particles in one pass
+    if (m_frac.size() < n_tot_particles)
+        m_frac.resize(n_tot_particles);
+    if (n_tot_particles > 0)
+        box.makeFractionArray(h_pos.data, &m_frac[0], n_tot_particles, ghost_width);
+
     for (unsigned int n = 0; n < n_tot_particles; n++)
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
@@ -515,7 +537,7 @@ void CellList::computeCellList()
 
 
         // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(p,ghost_width);
+        const Scalar3& f = m_frac[n];
         int ib = (int)(f.x * m_dim.x);
         int jb = (int)(f.y * m_dim.y);
         int kb = (int)(f.z * m_dim.z);
@@ -709,6 +731,7 @@ void export_CellList()
         .def("setFlagCharge", &CellList::setFlagCharge)
         .def("setFlagIndex", &CellList::setFlagIndex)
         .def("setSortCellList", &CellList::setSortCellList)
+        .def("setDeformationTolerance", &CellList::setDeformationTolerance)
         .def("getDim", &CellList::getDim, return_internal_reference<>())
         .def("getNmax", &CellList::getNmax)
         .def("benchmark", &CellList::benchmark)
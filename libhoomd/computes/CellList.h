@@ -58,6 +58,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/shared_ptr.hpp>
 #include <boost/signals2.hpp>
 
+#include <vector>
+
 /*! \file CellList.h
     \brief Declares the CellList class
 */
@@ -123,9 +125,18 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
      - \c radius - integer radius of cells to generate in \c cell_adj (1,2,3,4,...)
      - \c multiple - Round down to the nearest multiple number of cells in each direction (only applied to cells
                      inside the domain, not the ghost cells).
+     - \c deformation_tolerance - Relative box deformation to tolerate without changing the cell dimensions (see below)
 
     After a set call is made to adjust a parameter, changes do not take effect until the next call to compute().
 
+    <b>Box deformation:</b>
+    When the box changes, only the cell width is updated as long as the number of cells remains valid. Under constant
+    pressure the box fluctuates around a fixed size, which would repeatedly push the dimensions back and forth across
+    an integer boundary and reallocate all of the memory each time. Once the box has changed and the dimensions must
+    change, the new dimensions are chosen for a nominal width padded by \c deformation_tolerance. The current
+    dimensions are then kept for as long as they lie between the padded and unpadded choices, so the box may shrink
+    or grow by roughly the tolerance before the next reallocation. Cells are never narrower than the nominal width.
+
     <b>Overvlow and error flag handling:</b>
     For easy support of derived GPU classes to implement overvlow detection and error handling, all error flags are
     stored in the GPUArray \a d_conditions.
@@ -229,6 +240,12 @@ class CellList : public Compute
                 m_multiple = 1;
             }
 
+        //! Set the relative box deformation to tolerate without changing the cell dimensions
+        void setDeformationTolerance(Scalar tol)
+            {
+            m_deformation_tol = tol;
+            }
+
         //! Set the sort flag
         void setSortCellList(bool sort)
             {
@@ -365,6 +382,8 @@ class CellList : public Compute
         bool m_particles_sorted;     //!< Set to true when the particles have been sorted
         bool m_box_changed;          //!< Set to ttrue when the box size has changed
         unsigned int m_multiple;     //!< Round cell dimensions down to a multiple of this value
+        Scalar m_deformation_tol;    //!< Relative box deformation tolerated before changing the dimensions
+        bool m_box_deformed;         //!< Set to true once the box has changed after the last parameter change
 
         // parameters determined by initialize
         uint3 m_dim;                 //!< Current dimensions
@@ -387,9 +406,10 @@ class CellList : public Compute
         boost::signals2::connection m_boxchange_connection;   //!< Connection to the ParticleData box size change signal
 
         bool m_sort_cell_list;               //!< If true, sort cell list
+        std::vector<Scalar3> m_frac;         //!< Fractional coordinates of the particles (scratch space)
 
-        //! Computes what the dimensions should me
-        uint3 computeDimensions();
+        //! Computes what the dimensions should be for a given cell width
+        uint3 computeDimensions(Scalar width);
 
         //! Initialize width and indexers, allocates memory
         void initializeAll();
@@ -68,13 +68,14 @@ using namespace boost::python;
  */
 CellListStencil::CellListStencil(boost::shared_ptr<SystemDefinition> sysdef,
                                  boost::shared_ptr<CellList> cl)
-    : Compute(sysdef), m_cl(cl), m_compute_stencil(true)
+    : Compute(sysdef), m_cl(cl), m_compute_stencil(true), m_check_geometry(false),
+      m_deformation_tol(Scalar(0.05)), m_box_deformed(false), m_pad(Scalar(0.0))
     {
     m_exec_conf->msg->notice(5) << "Constructing CellListStencil" << endl;
 
     m_num_type_change_conn = m_pdata->connectNumTypesChange(boost::bind(&CellListStencil::slotTypeChange, this));
-    m_box_change_conn = m_pdata->connectBoxChange(boost::bind(&CellListStencil::requestCompute, this));
-    m_width_change_conn = m_cl->connectCellWidthChange(boost::bind(&CellListStencil::requestCompute, this));
+    m_box_change_conn = m_pdata->connectBoxChange(boost::bind(&CellListStencil::slotGeometryChange, this));
+    m_width_change_conn = m_cl->connectCellWidthChange(boost::bind(&CellListStencil::slotGeometryChange, this));
 
     // Default initialization is no stencil for any type
     m_rstencil = std::vector<Scalar>(m_pdata->getNTypes(), -1.0);
@@ -96,6 +97,167 @@ CellListStencil::~CellListStencil()
     m_width_change_conn.disconnect();
     }
 
+//! Distance squared from the origin to the closest point on a line segment
+/*!
+ * \param p Start of the segment
+ * \param e Segment vector
+ */
+static Scalar segmentDistSq(const Scalar3& p, const Scalar3& e)
+    {
+    Scalar ee = dot(e,e);
+    Scalar t = (ee > Scalar(0.0)) ? -dot(p,e) / ee : Scalar(0.0);
+    t = std::max(Scalar(0.0), std::min(Scalar(1.0), t));
+    Scalar3 q = p + t*e;
+    return dot(q,q);
+    }
+
+//! Distance squared from the origin to the closest point on a parallelogram
+/*!
+ * \param p Corner of the parallelogram
+ * \param e1 First edge vector
+ * \param e2 Second edge vector
+ */
+static Scalar parallelogramDistSq(const Scalar3& p, const Scalar3& e1, const Scalar3& e2)
+    {
+    // project the origin onto the plane of the parallelogram
+    Scalar g11 = dot(e1,e1);
+    Scalar g12 = dot(e1,e2);
+    Scalar g22 = dot(e2,e2);
+    Scalar det = g11*g22 - g12*g12;
+    if (det > Scalar(0.0))
+        {
+        Scalar b1 = -dot(p,e1);
+        Scalar b2 = -dot(p,e2);
+        Scalar s = (g22*b1 - g12*b2) / det;
+        Scalar t = (g11*b2 - g12*b1) / det;
+        if (s >= Scalar(0.0) && s <= Scalar(1.0) && t >= Scalar(0.0) && t <= Scalar(1.0))
+            {
+            Scalar3 q = p + s*e1 + t*e2;
+            return dot(q,q);
+            }
+        }
+
+    // otherwise, the closest point is on one of the edges
+    Scalar dr2 = segmentDistSq(p, e1);
+    dr2 = std::min(dr2, segmentDistSq(p, e2));
+    dr2 = std::min(dr2, segmentDistSq(p + e1, e2));
+    dr2 = std::min(dr2, segmentDistSq(p + e2, e1));
+    return dr2;
+    }
+
+//! Minimum distance squared between points in the reference cell and in the cell shifted by (i,j,k)
+/*!
+ * \param lattice Lattice vectors spanning a single cell (the third is zero in 2D)
+ * \param i Shift along the first lattice vector
+ * \param j Shift along the second lattice vector
+ * \param k Shift along the third lattice vector
+ *
+ * The separation vectors between the two cells form a parallelepiped spanning [i-1,i+1] x [j-1,j+1] x [k-1,k+1] in
+ * units of the cell lattice vectors. The minimum distance is the distance of the origin to this parallelepiped, which
+ * is found on one of its faces if the origin lies outside. In an orthorhombic box this reduces to the familiar sum
+ * of the squared gaps along each direction.
+ */
+static Scalar cellDistSq(const Scalar3 *lattice, int i, int j, int k)
+    {
+    // adjacent cells share a point with the reference cell
+    if (std::abs(i) <= 1 && std::abs(j) <= 1 && std::abs(k) <= 1)
+        return Scalar(0.0);
+
+    const int lo[3] = {i-1, j-1, k-1};
+    Scalar3 e[3];
+    for (unsigned int a=0; a < 3; ++a)
+        e[a] = Scalar(2.0)*lattice[a];
+    Scalar3 corner = Scalar(lo[0])*lattice[0] + Scalar(lo[1])*lattice[1] + Scalar(lo[2])*lattice[2];
+
+    // the 2D cells are flat, so the parallelepiped is a single parallelogram
+    if (dot(lattice[2],lattice[2]) == Scalar(0.0))
+        return parallelogramDistSq(corner, e[0], e[1]);
+
+    Scalar dr2 = parallelogramDistSq(corner, e[1], e[2]);
+    dr2 = std::min(dr2, parallelogramDistSq(corner + e[0], e[1], e[2]));
+    dr2 = std::min(dr2, parallelogramDistSq(corner, e[0], e[2]));
+    dr2 = std::min(dr2, parallelogramDistSq(corner + e[1], e[0], e[2]));
+    dr2 = std::min(dr2, parallelogramDistSq(corner, e[0], e[1]));
+    dr2 = std::min(dr2, parallelogramDistSq(corner + e[2], e[0], e[1]));
+    return dr2;
+    }
+
+/*!
+ * \param lattice Array of three vectors to fill with the lattice vectors spanning a single cell
+ *
+ * The cell widths of the CellList are measured between the nearest planes, so the box lattice vectors are scaled by
+ * the ratio of the cell width to the box nearest plane distance. In 2D, the third vector is zero.
+ */
+void CellListStencil::getCellLattice(Scalar3 *lattice)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar3 L = box.getNearestPlaneDistance();
+    const Scalar3 cell_size = m_cl->getCellWidth();
+
+    lattice[0] = (cell_size.x / L.x) * box.getLatticeVector(0);
+    lattice[1] = (cell_size.y / L.y) * box.getLatticeVector(1);
+    if (m_sysdef->getNDimensions() == 3)
+        lattice[2] = (cell_size.z / L.z) * box.getLatticeVector(2);
+    else
+        lattice[2] = make_scalar3(0.0, 0.0, 0.0);
+    }
+
+/*!
+ * \returns true if the current stencil can be used with the current cell geometry
+ *
+ * A stencil built with padding \a m_pad for the cell lattice vectors v0 stays valid for the lattice vectors v as long
+ * as the stencil cells move by less than the padding, i.e. sum_a (n_a+1)|v_a - v0_a| <= m_pad where n_a is the
+ * stencil size. The cells outside of the stencil must additionally remain out of reach along each direction.
+ */
+bool CellListStencil::checkGeometry()
+    {
+    // the periodic wrapping guards depend on the dimensions, so any change requires a new stencil
+    const uint3 dim = m_cl->getDim();
+    const uchar3 periodic = m_pdata->getBox().getPeriodic();
+    if (dim.x != m_built_dim.x || dim.y != m_built_dim.y || dim.z != m_built_dim.z ||
+        periodic.x != m_built_periodic.x || periodic.y != m_built_periodic.y || periodic.z != m_built_periodic.z)
+        return false;
+
+    Scalar3 lattice[3];
+    getCellLattice(lattice);
+    const Scalar3 cell_size = m_cl->getCellWidth();
+
+    int3 max_size = make_int3(0,0,0);
+    for (unsigned int cur_type=0; cur_type < m_built_size.size(); ++cur_type)
+        {
+        Scalar r_list_max = m_rstencil[cur_type];
+        if (r_list_max <= Scalar(0.0)) continue;
+
+        const int3 size = m_built_size[cur_type];
+        if (Scalar(size.x)*cell_size.x < r_list_max ||
+            Scalar(size.y)*cell_size.y < r_list_max ||
+            (m_sysdef->getNDimensions() == 3 && Scalar(size.z)*cell_size.z < r_list_max))
+            {
+            m_box_deformed = true;
+            return false;
+            }
+
+        max_size.x = std::max(max_size.x, size.x);
+        max_size.y = std::max(max_size.y, size.y);
+        max_size.z = std::max(max_size.z, size.z);
+        }
+
+    Scalar3 dv[3];
+    for (unsigned int a=0; a < 3; ++a)
+        dv[a] = lattice[a] - m_built_lattice[a];
+    Scalar shift = Scalar(max_size.x+1)*sqrt(dot(dv[0],dv[0]))
+                   + Scalar(max_size.y+1)*sqrt(dot(dv[1],dv[1]))
+                   + Scalar(max_size.z+1)*sqrt(dot(dv[2],dv[2]));
+
+    if (shift > m_pad)
+        {
+        m_box_deformed = true;
+        return false;
+        }
+
+    return true;
+    }
+
 void CellListStencil::compute(unsigned int timestep)
     {
     // guard against unnecessary calls
@@ -114,20 +276,37 @@ void CellListStencil::compute(unsigned int timestep)
     const BoxDim& box = m_pdata->getBox();
     const uchar3 periodic = box.getPeriodic();
 
+    // record the geometry this stencil is built for
+    Scalar3 lattice[3];
+    getCellLattice(lattice);
+    m_built_dim = dim;
+    m_built_periodic = periodic;
+    for (unsigned int a=0; a < 3; ++a)
+        m_built_lattice[a] = lattice[a];
+    m_built_size.assign(m_pdata->getNTypes(), make_int3(0,0,0));
+
     Scalar rstencil_max = *std::max_element(m_rstencil.begin(), m_rstencil.end());
-    int3 max_stencil_size = make_int3(static_cast<int>(ceil(rstencil_max / cell_size.x)),
-                                      static_cast<int>(ceil(rstencil_max / cell_size.y)),
-                                      static_cast<int>(ceil(rstencil_max / cell_size.z)));
-    if (m_sysdef->getNDimensions() == 2) max_stencil_size.z = 0;
 
     // extremely rare: zero interactions, quit without generating stencils
     if (rstencil_max < Scalar(0.0))
         {
+        m_pad = Scalar(0.0);
         ArrayHandle<unsigned int> h_n_stencil(m_n_stencil, access_location::host, access_mode::overwrite);
         memset((void*)h_n_stencil.data, 0, sizeof(unsigned int)*m_pdata->getNTypes());
+
+        if (m_prof)
+            m_prof->pop();
         return;
         }
 
+    // pad the stencil for further deformation once the box has deformed
+    m_pad = m_box_deformed ? m_deformation_tol * rstencil_max : Scalar(0.0);
+
+    int3 max_stencil_size = make_int3(static_cast<int>(ceil((rstencil_max + m_pad) / cell_size.x)),
+                                      static_cast<int>(ceil((rstencil_max + m_pad) / cell_size.y)),
+                                      static_cast<int>(ceil((rstencil_max + m_pad) / cell_size.z)));
+    if (m_sysdef->getNDimensions() == 2) max_stencil_size.z = 0;
+
     // compute the maximum number of bins in the stencil
     unsigned int max_n_stencil = (2*max_stencil_size.x+1)*(2*max_stencil_size.y+1)*(2*max_stencil_size.z+1);
 
@@ -155,13 +334,16 @@ void CellListStencil::compute(unsigned int timestep)
             continue;
             }
         
-        Scalar r_listsq_max = r_list_max*r_list_max;
+        // include all cells within the padded radius
+        Scalar r_include = r_list_max + m_pad;
+        Scalar r_includesq = r_include*r_include;
 
         // get the stencil size
-        int3 stencil_size = make_int3(static_cast<int>(ceil(r_list_max / cell_size.x)),
-                                      static_cast<int>(ceil(r_list_max / cell_size.y)),
-                                      static_cast<int>(ceil(r_list_max / cell_size.z)));
+        int3 stencil_size = make_int3(static_cast<int>(ceil(r_include / cell_size.x)),
+                                      static_cast<int>(ceil(r_include / cell_size.y)),
+                                      static_cast<int>(ceil(r_include / cell_size.z)));
         if (m_sysdef->getNDimensions() == 2) stencil_size.z = 0;
+        m_built_size[cur_type] = stencil_size;
 
         // loop through the possible stencils
         // all active stencils must have at least one member -- the current cell
@@ -180,26 +362,23 @@ void CellListStencil::compute(unsigned int timestep)
 
                 for (int i=-stencil_size.x; i <= stencil_size.x; ++i)
                     {
-                    if (periodic.z && ((origin.x + i) < 0 || (origin.x + i) >= (int)dim.x) ) continue;
+                    if (periodic.x && ((origin.x + i) < 0 || (origin.x + i) >= (int)dim.x) ) continue;
 
                     // (0,0,0) is always added first
                     if (i == 0 && j == 0 && k == 0) continue;
 
                     // compute the distance to the closest point in the bin
-                    Scalar3 dr = make_scalar3(0.0,0.0,0.0);
-                    if (i > 0) dr.x = (i-1) * cell_size.x;
-                    else if (i < 0) dr.x = (i+1) * cell_size.x;
-
-                    if (j > 0) dr.y = (j-1) * cell_size.y;
-                    else if (j < 0) dr.y = (j+1) * cell_size.y;
+                    Scalar dr2 = cellDistSq(lattice, i, j, k);
 
-                    if (k > 0) dr.z = (k-1) * cell_size.z;
-                    else if (k < 0) dr.z = (k+1) * cell_size.z;
-
-                    Scalar dr2 = dot(dr, dr);
-
-                    if (dr2 < r_listsq_max)
+                    if (dr2 < r_includesq)
                         {
+                        // the deformed cell may be closer by up to the padding
+                        if (m_pad > Scalar(0.0))
+                            {
+                            Scalar dr = std::max(sqrt(dr2) - m_pad, Scalar(0.0));
+                            dr2 = dr*dr;
+                            }
+
                         h_stencil.data[m_stencil_idx(n_stencil_i, cur_type)] = make_scalar4(__int_as_scalar(i),
                                                                                             __int_as_scalar(j),
                                                                                             __int_as_scalar(k),
@@ -223,14 +402,23 @@ bool CellListStencil::shouldCompute(unsigned int timestep)
     if (m_compute_stencil)
         {
         m_compute_stencil = false;
+        m_check_geometry = false;
         return true;
         }
-    
+
+    // only rebuild for a changed box if the current stencil no longer covers the deformed cells
+    if (m_check_geometry)
+        {
+        m_check_geometry = false;
+        return !checkGeometry();
+        }
+
     return false;
     }
 
 void export_CellListStencil()
     {
     class_<CellListStencil, boost::shared_ptr<CellListStencil>, bases<Compute>, boost::noncopyable >
-        ("CellListStencil", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<CellList> >());
+        ("CellListStencil", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<CellList> >())
+        .def("setDeformationTolerance", &CellListStencil::setDeformationTolerance);
     }
@@ -75,9 +75,16 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * that cells are not duplicated.
  *
  * The minimum distance to each cell in the stencil from the reference is also precomputed and saved during stencil
- * construction. This can be used to accelerate particle search from the cell list without distance check.
+ * construction. This can be used to accelerate particle search from the cell list without distance check. Cells are
+ * parallelepipeds spanned by the box lattice vectors divided by the cell dimensions, so in triclinic boxes the
+ * distance is the exact minimum distance between two such cells rather than the orthorhombic estimate.
  *
- * The stencil is rebuilt any time the search radius or the box dimensions change.
+ * The stencil is rebuilt any time the search radius or the cell dimensions change. When only the box shape changes,
+ * the stencil is checked lazily on the next compute() and kept if it is still valid for the deformed cells. Once the
+ * box has been seen to deform without changing the cell dimensions, the stencil is built with a padding of
+ * \a deformation_tolerance times the largest search radius: cells up to the padded radius are included, and the
+ * stored distances are reduced by the padding. The stencil then remains valid as long as the cell lattice vectors
+ * move the stencil cells by less than the padding, and constant pressure runs rebuild it only occasionally.
  *
  * \sa NeighborListStencil
  *
@@ -125,12 +132,25 @@ class CellListStencil : public Compute
             return m_stencil_idx;
             }
 
+        //! Set the relative deformation to pad the stencil for
+        void setDeformationTolerance(Scalar tol)
+            {
+            m_deformation_tol = tol;
+            requestCompute();
+            }
+
         //! Slot to recompute the stencil
         void requestCompute()
             {
             m_compute_stencil = true;
             }
 
+        //! Slot to check the stencil against the current cell geometry
+        void slotGeometryChange()
+            {
+            m_check_geometry = true;
+            }
+
     protected:
         virtual bool shouldCompute(unsigned int timestep);
 
@@ -146,6 +166,21 @@ class CellListStencil : public Compute
         GPUArray<Scalar4> m_stencil;            //!< Stencil of shifts and closest distance to bin
         GPUArray<unsigned int> m_n_stencil;     //!< Number of bins in a stencil
         bool m_compute_stencil;                 //!< Flag if stencil should be recomputed
+        bool m_check_geometry;                  //!< Flag if the stencil should be checked against the cell geometry
+
+        Scalar m_deformation_tol;               //!< Relative deformation to pad the stencil for
+        bool m_box_deformed;                    //!< True once the cells were deformed at fixed dimensions
+        Scalar m_pad;                           //!< Padding distance the current stencil was built with
+        uint3 m_built_dim;                      //!< Cell dimensions the current stencil was built for
+        uchar3 m_built_periodic;                //!< Periodic flags the current stencil was built for
+        Scalar3 m_built_lattice[3];             //!< Cell lattice vectors the current stencil was built for
+        std::vector<int3> m_built_size;         //!< Per-type stencil size the current stencil was built with
+
+        //! Get the lattice vectors spanning a single cell
+        void getCellLattice(Scalar3 *lattice);
+
+        //! Test if the current stencil is still valid for the current cell geometry
+        bool checkGeometry();
 
         //! Slot for the number of types changing, which triggers a resize
         void slotTypeChange()
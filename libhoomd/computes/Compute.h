@@ -51,6 +51,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "SystemDefinition.h"
 #include "Profiler.h"
+#include "PerformanceCounter.h"
 
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
@@ -202,6 +203,7 @@ class Compute : boost::noncopyable
 #endif
         boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Stored shared ptr to the execution configuration
         bool m_force_compute;           //!< true if calculation is enforced
+        PerformanceCounter m_compute_timer; //!< Wall clock time spent computing, for derived classes to log
 
         //! Simple method for testing if the computation should be run or not
         virtual bool shouldCompute(unsigned int timestep);
@@ -72,7 +72,7 @@ using namespace std;
     \param type_of_file Undocumented parameter
 */
 EAMForceCompute::EAMForceCompute(boost::shared_ptr<SystemDefinition> sysdef, char *filename, int type_of_file)
-    : ForceCompute(sysdef)
+    : ForceCompute(sysdef), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing EAMForceCompute" << endl;
 
@@ -287,7 +287,51 @@ void EAMForceCompute::loadFile(char *filename, int type_of_file)
             }
 
         }
+    }
+
+/*! \param cubic True to interpolate the tables with cubic Hermite polynomials, false for linear interpolation
+
+    The slopes of the cubic interpolants are estimated from the tabulated values by central differences. The
+    coefficients are only kept while cubic interpolation is selected.
+*/
+void EAMForceCompute::setCubicInterpolation(bool cubic)
+    {
+    if (cubic && (nrho < 2 || nr < 2))
+        {
+        m_exec_conf->msg->error() << "pair.eam: Cubic interpolation needs at least 2 points in every table" << endl;
+        throw runtime_error("Error initializing EAMForceCompute");
+        }
+
+    if (cubic && !m_cubic)
+        {
+        // Cubic Hermite coefficients of all tables
+        embeddingCoeffs.resize((nrho - 1) * m_ntypes);
+        for (unsigned int type = 0; type < m_ntypes; type++)
+            table_hermite_fill_values(&embeddingCoeffs[type * (nrho - 1)], &embeddingFunction[type * nrho], nrho, drho);
+
+        electronDensityCoeffs.resize((nr - 1) * m_ntypes * m_ntypes);
+        for (unsigned int j = 0; j < m_ntypes * m_ntypes; j++)
+            table_hermite_fill_values(&electronDensityCoeffs[j * (nr - 1)], &electronDensity[j * nr], nr, dr);
+
+        unsigned int n_pair_rows = pairPotential.size() / nr;
+        std::vector<Scalar> row(nr);
+        pairPotentialCoeffs.resize((nr - 1) * n_pair_rows);
+        for (unsigned int j = 0; j < n_pair_rows; j++)
+            {
+            for (unsigned int i = 0; i < nr; i++)
+                row[i] = pairPotential[j * nr + i].x;
+            table_hermite_fill_values(&pairPotentialCoeffs[j * (nr - 1)], &row[0], nr, dr);
+            }
+        }
+    else if (!cubic)
+        {
+        // release the coefficients
+        std::vector<Scalar4>().swap(embeddingCoeffs);
+        std::vector<Scalar4>().swap(electronDensityCoeffs);
+        std::vector<Scalar4>().swap(pairPotentialCoeffs);
+        }
 
+    m_cubic = cubic;
     }
 std::vector< std::string > EAMForceCompute::getProvidedLogQuantities()
     {
@@ -310,9 +354,15 @@ Scalar EAMForceCompute::getLogValue(const std::string& quantity, unsigned int ti
         }
     }
 
-/*! \post The lennard jones forces are computed for the given timestep. The neighborlist's
+/*! \post The EAM forces are computed for the given timestep. The neighborlist's
      compute method is called to ensure that it is up to date.
 
+    The computation proceeds in three passes over the local particles: the electron density is summed over the
+    neighbors, the embedding function and its derivative F'(rho) are evaluated, and finally the pair forces are
+    computed. The force between i and a neighbor k depends on F'(rho) of both particles. In domain decomposition
+    simulations, F'(rho) of ghost particles is obtained from their owning processors between the second and third
+    pass.
+
     \param timestep specifies the current time step of the simulation
 */
 void EAMForceCompute::computeForces(unsigned int timestep)
@@ -328,6 +378,16 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // the per-particle work arrays cover local and ghost particles, they are kept between steps
+    unsigned int n_all = m_pdata->getN() + m_pdata->getNGhosts();
+    if (m_rho.getNumElements() < n_all)
+        {
+        GPUArray<Scalar> rho(n_all, m_exec_conf);
+        m_rho.swap(rho);
+        GPUArray<Scalar> dFdrho(n_all, m_exec_conf);
+        m_dFdrho.swap(dFdrho);
+        }
+
     // access the neighbor list
     assert(m_nlist);
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
@@ -358,85 +418,129 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // tally up the number of forces calculated
     int64_t n_calc = 0;
 
-
-    // for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
     unsigned int ntypes = m_pdata->getNTypes();
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-
-        for (unsigned int j = 0; j < size; j++)
+        {
+        ArrayHandle<Scalar> h_rho(m_rho, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_dFdrho(m_dFdrho, access_location::host, access_mode::overwrite);
+        memset((void*)h_rho.data, 0, sizeof(Scalar)*n_all);
+
+        // for each particle
+        // with a full neighbor list, every thread only writes the density of its own particles
+        #pragma omp parallel for schedule(guided) reduction(+:n_calc) if(!third_law)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
             {
-            // increment our calculation counter
-            n_calc++;
-
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
 
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
             // sanity check
-            assert(typej < m_pdata->getNTypes());
+            assert(typei < m_pdata->getNTypes());
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
 
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);;
-            // only compute the force if the particles are closer than the cuttoff (FLOPS: 1)
-            if (rsq < r_cut_sq)
+            for (unsigned int j = 0; j < size; j++)
                 {
-                 Scalar position_scalar = sqrt(rsq) * rdr;
-                 Scalar position = position_scalar;
-                 unsigned int r_index = (unsigned int)position;
-                 r_index = min(r_index,nr);
-                 position -= r_index;
-                 atomElectronDensity[i] += electronDensity[r_index + nr * (typei * ntypes + typej)] + derivativeElectronDensity[r_index + nr * (typei * ntypes + typej)] * position * dr;
-                 if(third_law)
+                // increment our calculation counter
+                n_calc++;
+
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < n_all);
+
+                // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // start computing the force
+                // calculate r squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);;
+                // only compute the force if the particles are closer than the cuttoff (FLOPS: 1)
+                if (rsq < r_cut_sq && m_cubic)
                     {
-                    atomElectronDensity[k] += electronDensity[r_index + nr * (typej * ntypes + typei)]
-                        + derivativeElectronDensity[r_index + nr * (typej * ntypes + typei)] * position * dr;
+                    Scalar position = sqrt(rsq) * rdr;
+                    unsigned int r_index = min((unsigned int)position, nr - 2);
+                    Scalar t = position - Scalar(r_index);
+                    Scalar rho, mdrho;
+                    table_hermite_eval(electronDensityCoeffs[r_index + (nr - 1) * (typei * ntypes + typej)], t, rdr, rho, mdrho);
+                    h_rho.data[i] += rho;
+                    if (third_law)
+                        {
+                        table_hermite_eval(electronDensityCoeffs[r_index + (nr - 1) * (typej * ntypes + typei)], t, rdr, rho, mdrho);
+                        h_rho.data[k] += rho;
+                        }
+                    }
+                else if (rsq < r_cut_sq)
+                    {
+                     Scalar position_scalar = sqrt(rsq) * rdr;
+                     Scalar position = position_scalar;
+                     unsigned int r_index = (unsigned int)position;
+                     r_index = min(r_index,nr);
+                     position -= r_index;
+                     h_rho.data[i] += electronDensity[r_index + nr * (typei * ntypes + typej)] + derivativeElectronDensity[r_index + nr * (typei * ntypes + typej)] * position * dr;
+                     // the density of ghost particles is summed up by their owner, there is no need to skip them
+                     if(third_law)
+                        {
+                        h_rho.data[k] += electronDensity[r_index + nr * (typej * ntypes + typei)]
+                            + derivativeElectronDensity[r_index + nr * (typej * ntypes + typei)] * position * dr;
+                        }
                     }
                 }
             }
-        }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        // the embedding function only depends on the particle itself
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-        Scalar position = atomElectronDensity[i] * rdrho;
-        unsigned int r_index = (unsigned int)position;
-        r_index = min(r_index,nrho);
-        position -= (Scalar)r_index;
-        atomDerivativeEmbeddingFunction[i] = derivativeEmbeddingFunction[r_index + typei * nrho];
+            if (m_cubic)
+                {
+                Scalar position = h_rho.data[i] * rdrho;
+                unsigned int r_index = min((unsigned int)position, nrho - 2);
+                Scalar F, mdF;
+                table_hermite_eval(embeddingCoeffs[r_index + typei * (nrho - 1)], position - Scalar(r_index), rdrho, F, mdF);
+                h_dFdrho.data[i] = -mdF;
+                h_force.data[i].w += F;
+                continue;
+                }
 
-        h_force.data[i].w += embeddingFunction[r_index + typei * nrho] + derivativeEmbeddingFunction[r_index + typei * nrho] * position * drho;
+            Scalar position = h_rho.data[i] * rdrho;
+            unsigned int r_index = (unsigned int)position;
+            r_index = min(r_index,nrho);
+            position -= (Scalar)r_index;
+            h_dFdrho.data[i] = derivativeEmbeddingFunction[r_index + typei * nrho];
+
+            h_force.data[i].w += embeddingFunction[r_index + typei * nrho] + derivativeEmbeddingFunction[r_index + typei * nrho] * position * drho;
+            }
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+#ifdef ENABLE_MPI
+    // the forces on local particles depend on F'(rho) of their ghost neighbors
+    if (m_comm)
+        {
+        if (m_prof) m_prof->push("ghost F'");
+        m_comm->updateGhostScalar(m_dFdrho);
+        if (m_prof) m_prof->pop();
+        }
+#endif
+
+    ArrayHandle<Scalar> h_dFdrho(m_dFdrho, access_location::host, access_mode::read);
+
+    // as for the density, threads only write to their own particles with a full neighbor list
+    #pragma omp parallel for schedule(guided) reduction(+:n_calc) if(!third_law)
+    for (int i = 0; i < (int)m_pdata->getN(); i++)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -464,7 +568,7 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < n_all);
 
             // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -489,33 +593,62 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             unsigned int r_index = (unsigned int)position;
             position = position - (Scalar)r_index;
             int shift = (typei>=typej)?(int)(0.5 * (2 * ntypes - typej -1)*typej + typei) * nr:(int)(0.5 * (2 * ntypes - typei -1)*typei + typej) * nr;
-            //r_index = min(r_index,nr - 1);
-            Scalar pair_eng = (pairPotential[r_index + shift].x +
-                pairPotential[r_index + shift].y * position * dr) * inverseR;
-            Scalar derivativePhi = (pairPotential[r_index + shift].y - pair_eng) * inverseR;
-            Scalar derivativeRhoI = derivativeElectronDensity[r_index + typei * nr];
-            Scalar derivativeRhoJ = derivativeElectronDensity[r_index + typej * nr];
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ +
-                atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
+            Scalar pair_eng;
+            Scalar fullDerivativePhi;
+            if (m_cubic)
+                {
+                r_index = min(r_index, nr - 2);
+                position = r * rdr - Scalar(r_index);
+
+                // the pair table holds Z(r) = r phi(r)
+                Scalar Z, mdZ;
+                table_hermite_eval(pairPotentialCoeffs[r_index + (shift / nr) * (nr - 1)], position, rdr, Z, mdZ);
+                pair_eng = Z * inverseR;
+                Scalar derivativePhi = (-mdZ - pair_eng) * inverseR;
+
+                Scalar rho, mdrhoI, mdrhoJ;
+                table_hermite_eval(electronDensityCoeffs[r_index + (nr - 1) * (typei * ntypes + typej)], position, rdr, rho, mdrhoJ);
+                table_hermite_eval(electronDensityCoeffs[r_index + (nr - 1) * (typej * ntypes + typei)], position, rdr, rho, mdrhoI);
+                fullDerivativePhi = -h_dFdrho.data[i] * mdrhoJ - h_dFdrho.data[k] * mdrhoI + derivativePhi;
+                }
+            else
+                {
+                //r_index = min(r_index,nr - 1);
+                pair_eng = (pairPotential[r_index + shift].x +
+                    pairPotential[r_index + shift].y * position * dr) * inverseR;
+                Scalar derivativePhi = (pairPotential[r_index + shift].y - pair_eng) * inverseR;
+                Scalar derivativeRhoI = derivativeElectronDensity[r_index + typei * nr];
+                Scalar derivativeRhoJ = derivativeElectronDensity[r_index + typej * nr];
+                fullDerivativePhi = h_dFdrho.data[i] * derivativeRhoJ +
+                    h_dFdrho.data[k] * derivativeRhoI + derivativePhi;
+                }
             Scalar pairForce = - fullDerivativePhi * inverseR;
-            // are the virial and potential energy correctly calculated
-            // with respect to double counting?
-            viriali[0] += dx.x*dx.x * pairForce;
-            viriali[1] += dx.x*dx.y * pairForce;
-            viriali[2] += dx.x*dx.z * pairForce;
-            viriali[3] += dx.y*dx.y * pairForce;
-            viriali[4] += dx.y*dx.z * pairForce;
-            viriali[5] += dx.z*dx.z * pairForce;
+
+            // the pair energy and virial are split evenly between i and k, so that each pair is counted once
+            // in total both with full neighbor lists and with pairs that span processor boundaries
+            Scalar pair_virial[6];
+            pair_virial[0] = Scalar(0.5) * dx.x*dx.x * pairForce;
+            pair_virial[1] = Scalar(0.5) * dx.x*dx.y * pairForce;
+            pair_virial[2] = Scalar(0.5) * dx.x*dx.z * pairForce;
+            pair_virial[3] = Scalar(0.5) * dx.y*dx.y * pairForce;
+            pair_virial[4] = Scalar(0.5) * dx.y*dx.z * pairForce;
+            pair_virial[5] = Scalar(0.5) * dx.z*dx.z * pairForce;
+            for (int l = 0; l < 6; l++)
+                viriali[l] += pair_virial[l];
             fxi += dx.x * pairForce;
             fyi += dx.y * pairForce;
             fzi += dx.z * pairForce;
-            pei += pair_eng;
+            pei += Scalar(0.5) * pair_eng;
 
-            if (third_law)
+            // forces on ghost particles are computed by their owner
+            if (third_law && k < m_pdata->getN())
                 {
                 h_force.data[k].x -= dx.x * pairForce;
                 h_force.data[k].y -= dx.y * pairForce;
                 h_force.data[k].z -= dx.z * pairForce;
+                h_force.data[k].w += Scalar(0.5) * pair_eng;
+                for (int l = 0; l < 6; l++)
+                    h_virial.data[l*virial_pitch+k] += pair_virial[l];
                 }
             }
         h_force.data[i].x += fxi;
@@ -549,5 +682,6 @@ void export_EAMForceCompute()
 
     .def("set_neighbor_list", &EAMForceCompute::set_neighbor_list)
     .def("get_r_cut", &EAMForceCompute::get_r_cut)
+    .def("setCubicInterpolation", &EAMForceCompute::setCubicInterpolation)
     ;
     }
@@ -52,6 +52,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ForceCompute.h"
 #include "NeighborList.h"
+#include "TableInterpolation.h"
 
 #include <boost/shared_ptr.hpp>
 
@@ -78,6 +79,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
     a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+    By default the tables are interpolated linearly. setCubicInterpolation() selects cubic Hermite interpolation
+    (see TableInterpolation.h), which keeps the forces consistent with the energy. It is only available on the CPU.
+
+    When built with ENABLE_OPENMP, the embedding function is evaluated with OpenMP threads. The density and force
+    loops over the neighbor list are only threaded with a full neighbor list, where every thread writes to its own
+    particles only.
+
     \ingroup computes
 */
 class EAMForceCompute : public ForceCompute
@@ -95,6 +103,9 @@ class EAMForceCompute : public ForceCompute
         //! Get the r cut value read from the EAM potential file
         virtual Scalar get_r_cut();
 
+        //! Select cubic Hermite (true) or linear (false) interpolation of the tables
+        virtual void setCubicInterpolation(bool cubic);
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -129,6 +140,14 @@ class EAMForceCompute : public ForceCompute
         std::vector<Scalar> derivativePairPotential;        //!< array Z'(r)
         std::vector<Scalar> derivativeEmbeddingFunction;    //!< array F'(rho)
 
+        std::vector<Scalar4> electronDensityCoeffs;         //!< cubic coefficients of rho(r)
+        std::vector<Scalar4> pairPotentialCoeffs;           //!< cubic coefficients of Z(r)
+        std::vector<Scalar4> embeddingCoeffs;               //!< cubic coefficients of F(rho)
+        bool m_cubic;                                       //!< True if cubic interpolation is used
+
+        GPUArray<Scalar> m_rho;                        //!< Electron density of the local and ghost particles
+        GPUArray<Scalar> m_dFdrho;                     //!< F'(rho) of the local and ghost particles
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
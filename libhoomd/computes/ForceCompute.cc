@@ -76,7 +76,9 @@ using namespace boost;
     \post \c force and \c virial GPUarrays are initialized
     \post All forces are initialized to 0
 */
-ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef), m_particles_sorted(false)
+ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef)
+    : Compute(sysdef), m_particles_sorted(false), m_energy_skipped(false), m_computed_timestep(0),
+      m_computed_flags(0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -124,10 +126,32 @@ ForceCompute::~ForceCompute()
     m_max_particle_num_change_connection.disconnect();
     }
 
+/*! Derived classes may skip the per particle energies when pdata_flag::potential_energy is not set, and flag this by
+    setting m_energy_skipped in computeForces(). Consumers of the energies outside of the scheduled logging steps (e.g.
+    python data access) then call this method, which recomputes the forces of the last time step with the flag set.
+*/
+void ForceCompute::ensureEnergyComputed()
+    {
+    if (!m_energy_skipped)
+        return;
+
+    // recompute with the same flags as before, so that the virial is not changed
+    PDataFlags flags = m_pdata->getFlags();
+    PDataFlags energy_flags = m_computed_flags;
+    energy_flags[pdata_flag::potential_energy] = 1;
+
+    m_pdata->setFlags(energy_flags);
+    m_energy_skipped = false;
+    computeForces(m_computed_timestep);
+    m_pdata->setFlags(flags);
+    }
+
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    ensureEnergyComputed();
+
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -161,7 +185,13 @@ void ForceCompute::compute(unsigned int timestep)
     if (!m_particles_sorted && !shouldCompute(timestep))
         return;
 
-    computeForces(timestep);
+    m_energy_skipped = false;
+    m_computed_timestep = timestep;
+    m_computed_flags = m_pdata->getFlags();
+        {
+        PerformanceRegion region(m_compute_timer);
+        computeForces(timestep);
+        }
     m_particles_sorted = false;
     }
 
@@ -275,6 +305,8 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    ensureEnergyComputed();
+
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -174,8 +174,14 @@ class ForceCompute : public Compute
             return false;
             }
 
+        //! Recompute the forces including the energies if they were skipped
+        void ensureEnergyComputed();
+
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
+        bool m_energy_skipped;      //!< Set by computeForces() when the per particle energies were not computed
+        unsigned int m_computed_timestep; //!< Time step of the last call to computeForces() from compute()
+        PDataFlags m_computed_flags;      //!< Particle data flags in effect during the last call to computeForces()
 
         //! Helper function called when particles are sorted
         /*! setParticlesSorted() is passed as a slot to the particle sort signal.
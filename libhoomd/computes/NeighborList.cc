@@ -85,7 +85,8 @@ NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar _r
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
       m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
-      m_dist_check(true), m_has_been_updated_once(false)
+      m_dist_check(true), m_has_been_updated_once(false), m_distance_checks(0), m_adaptive(false),
+      m_adaptive_safety(0.5), m_next_check_tstep(0), m_tune_r_buff(false), m_tune_window_open(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
 
@@ -101,6 +102,8 @@ NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar _r
     m_last_checked_tstep = 0;
     m_last_check_result = false;
     m_every = 0;
+    m_max_disp_ratio = Scalar(-1.0);
+    setTuneRBuff(false);
     m_exclusions_set = false;
 
     m_need_reallocate_exlist = false;
@@ -261,6 +264,7 @@ void NeighborList::compute(unsigned int timestep)
     if (!shouldCompute(timestep) && !m_force_update)
         return;
 
+    PerformanceRegion region(m_compute_timer);
     if (m_prof) m_prof->push("Neighbor");
 
 	// take care of some updates if things have changed since construction
@@ -294,6 +298,7 @@ void NeighborList::compute(unsigned int timestep)
                 resetConditions();
                 }
             } while (overflowed);
+        m_build_counter.add();
 
         if (m_exclusions_set)
             filterNlist();
@@ -403,6 +408,21 @@ void NeighborList::setRBuff(Scalar r_buff)
     forceUpdate();
     } 
 
+/*! \param tune Set to true to tune r_buff during the following runs
+
+    The search starts from the current r_buff.
+*/
+void NeighborList::setTuneRBuff(bool tune)
+    {
+    m_tune_r_buff = tune;
+    m_tune_window_open = false;
+    m_tune_best_time = -1.0;
+    m_tune_best_r_buff = m_r_buff;
+    m_tune_step = Scalar(0.2);
+    m_tune_dir = 1;
+    m_tune_failures = 0;
+    }
+
 void NeighborList::updateRList()
 	{
 	// only need a read on the real cutoff
@@ -934,6 +954,40 @@ void NeighborList::addOneFourExclusionsFromTopology()
     }
 
 
+//! Squared displacement of a particle since the last build and the largest allowed value
+/*! \param i Particle index
+    \param pos Current positions
+    \param last_pos Positions at the last build
+    \param rcut_max Largest cutoff of each type
+    \param box Local simulation box
+    \param lambda Ratio of the current to the last box lengths
+    \param lambda_min Smallest component of \a lambda
+    \param maxsq Set to the largest squared displacement allowed for this particle
+    \returns The squared displacement after subtraction of homogeneous dilations
+*/
+inline Scalar NeighborList::particleDisplacementSq(unsigned int i, const Scalar4 *pos, const Scalar4 *last_pos,
+    const Scalar *rcut_max, const BoxDim& box, const Scalar3& lambda, Scalar lambda_min, Scalar& maxsq) const
+    {
+    const unsigned int type_i = __scalar_as_int(pos[i].w);
+
+    // minimum distance within which all particles should be included
+    Scalar old_rmin = rcut_max[type_i];
+
+    // maximum value we have checked for neighbors, defined by the buffer layer
+    Scalar rmax = old_rmin + m_r_buff;
+
+    // max displacement for each particle (after subtraction of homogeneous dilations)
+    const Scalar delta_max = (rmax*lambda_min - old_rmin)/Scalar(2.0);
+    maxsq = (delta_max > 0) ? delta_max*delta_max : 0;
+
+    Scalar3 dx = make_scalar3(pos[i].x - lambda.x*last_pos[i].x,
+                              pos[i].y - lambda.y*last_pos[i].y,
+                              pos[i].z - lambda.z*last_pos[i].z);
+
+    dx = box.minImage(dx);
+    return dot(dx, dx);
+    }
+
 /*! \returns true If any of the particles have been moved more than 1/2 of the buffer distance since the last call
         to this method that returned true.
     \returns false If none of the particles has been moved more than 1/2 of the buffer distance since the last call to this
@@ -968,51 +1022,79 @@ bool NeighborList::distanceCheck(unsigned int timestep)
     
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
-    
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+
+    const unsigned int N = m_pdata->getN();
+
+    if (m_adaptive)
         {
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
-        
-        // minimum distance within which all particles should be included
-        Scalar old_rmin = h_rcut_max.data[type_i];
-        
-        // maximum value we have checked for neighbors, defined by the buffer layer
-        Scalar rmax = old_rmin + m_r_buff;
-        
-        // max displacement for each particle (after subtraction of homogeneous dilations)
-        const Scalar delta_max = (rmax*lambda_min - old_rmin)/Scalar(2.0);
-        Scalar maxsq = (delta_max > 0) ? delta_max*delta_max : 0;
-        
-        Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x*h_last_pos.data[i].x,
-                                  h_pos.data[i].y - lambda.y*h_last_pos.data[i].y,
-                                  h_pos.data[i].z - lambda.z*h_last_pos.data[i].z);
+        // the adaptive mode needs the largest displacement relative to the allowed one, so the loop runs over all
+        // particles
+        Scalar max_ratio_sq = Scalar(0.0);
 
-        dx = box.minImage(dx);
+        #pragma omp parallel for schedule(static) reduction(max:max_ratio_sq)
+        for (int i = 0; i < (int)N; i++)
+            {
+            Scalar maxsq;
+            Scalar dsq = particleDisplacementSq(i, h_pos.data, h_last_pos.data, h_rcut_max.data, box, lambda,
+                                                lambda_min, maxsq);
+
+            // a particle with no buffer left always triggers a rebuild
+            Scalar ratio_sq = (maxsq > Scalar(0.0)) ? dsq / maxsq : Scalar(1.0);
+            if (ratio_sq > max_ratio_sq)
+                max_ratio_sq = ratio_sq;
+            }
 
-        if (dot(dx, dx) >= maxsq)
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
             {
-            result = true;
-            break;
+            if (m_prof) m_prof->push("MPI allreduce");
+            // the largest displacement on any rank decides
+            MPI_Allreduce(MPI_IN_PLACE,
+                &max_ratio_sq,
+                1,
+                MPI_HOOMD_SCALAR,
+                MPI_MAX,
+                m_exec_conf->getMPICommunicator());
+            if (m_prof) m_prof->pop();
             }
-        }
+        #endif
 
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+        m_max_disp_ratio = sqrt(max_ratio_sq);
+        result = (max_ratio_sq >= Scalar(1.0));
+        }
+    else
         {
-        if (m_prof) m_prof->push("MPI allreduce");
-        // check if migrate criterium is fulfilled on any rank
-        int local_result = result ? 1 : 0;
-        int global_result = 0;
-        MPI_Allreduce(&local_result,
-            &global_result,
-            1,
-            MPI_INT,
-            MPI_MAX,
-            m_exec_conf->getMPICommunicator());
-        result = (global_result > 0);
-        if (m_prof) m_prof->pop();
+        // stop at the first particle that moved too far
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar maxsq;
+            Scalar dsq = particleDisplacementSq(i, h_pos.data, h_last_pos.data, h_rcut_max.data, box, lambda,
+                                                lambda_min, maxsq);
+            if (dsq >= maxsq)
+                {
+                result = true;
+                break;
+                }
+            }
+
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            if (m_prof) m_prof->push("MPI allreduce");
+            // check if migrate criterium is fulfilled on any rank
+            int local_result = result ? 1 : 0;
+            int global_result = 0;
+            MPI_Allreduce(&local_result,
+                &global_result,
+                1,
+                MPI_INT,
+                MPI_MAX,
+                m_exec_conf->getMPICommunicator());
+            result = (global_result > 0);
+            if (m_prof) m_prof->pop();
+            }
+        #endif
         }
-    #endif
 
     // don't worry about computing flops here, this is fast
     if (m_prof) m_prof->pop();
@@ -1034,7 +1116,8 @@ void NeighborList::setLastUpdatedPos()
 
     // update the last position arrays
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::overwrite);
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)m_pdata->getN(); i++)
         {
         h_last_pos.data[i] = make_scalar4(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z, Scalar(0.0));
         }
@@ -1048,6 +1131,9 @@ void NeighborList::setLastUpdatedPos()
 
 bool NeighborList::shouldCheckDistance(unsigned int timestep)
     {
+    if (m_adaptive && timestep < m_next_check_tstep)
+        return false;
+
     return !m_force_update && !(timestep < (m_last_updated_tstep + m_every));
     }
 
@@ -1071,8 +1157,13 @@ bool NeighborList::needsUpdating(unsigned int timestep)
         return m_last_check_result;
         }
 
+    unsigned int prev_checked_tstep = m_last_checked_tstep;
     m_last_checked_tstep = timestep;
 
+    // r_buff changes take effect here, before a migration or ghost exchange uses the new ghost layer width
+    if (m_tune_r_buff)
+        tuneRBuff(timestep);
+
     if (!m_force_update && !shouldCheckDistance(timestep))
         {
         m_last_check_result = false;
@@ -1086,7 +1177,7 @@ bool NeighborList::needsUpdating(unsigned int timestep)
     // we are dangerous if m_every is greater than 1 and this is the first check after the
     // last build
     bool dangerous = false;
-    if (m_dist_check && (m_every > 1 && timestep == (m_last_updated_tstep + m_every)))
+    if (m_dist_check && !m_adaptive && (m_every > 1 && timestep == (m_last_updated_tstep + m_every)))
         dangerous = true;
 
     // if the update has been forced, the result defaults to true
@@ -1113,7 +1204,12 @@ bool NeighborList::needsUpdating(unsigned int timestep)
             }
         else
             {
+            m_max_disp_ratio = Scalar(-1.0);
             result = distanceCheck(timestep);
+            m_distance_checks += 1;
+
+            if (m_adaptive)
+                dangerous = scheduleDistanceCheck(timestep, prev_checked_tstep, result);
             }
 
         if (result)
@@ -1140,9 +1236,147 @@ bool NeighborList::needsUpdating(unsigned int timestep)
         }
 
     m_last_check_result = result;
+
+    // the schedule starts over after every build
+    if (m_adaptive && result)
+        m_next_check_tstep = timestep + 1;
+
     return result;
     }
 
+/*! \param timestep Current time step
+    \param prev_checked_tstep Time step of the previous check
+    \param result Result of the distance check performed on this step
+    \returns true if the limit was already exceeded on a skipped step
+
+    m_max_disp_ratio is the largest displacement since the last build divided by the allowed one. Assuming that it
+    grows linearly with the number of steps since the last build, it reaches 1 after
+    (timestep - m_last_updated_tstep) / m_max_disp_ratio steps. Linear growth is the ballistic limit, diffusive motion
+    reaches the limit later. Only a fraction m_adaptive_safety of the predicted remaining steps is skipped.
+*/
+bool NeighborList::scheduleDistanceCheck(unsigned int timestep, unsigned int prev_checked_tstep, bool result)
+    {
+    // no estimate available (e.g. the distance check of a derived class does not provide one)
+    if (m_max_disp_ratio < Scalar(0.0))
+        {
+        m_next_check_tstep = timestep + 1;
+        return false;
+        }
+
+    if (result)
+        {
+        // m_last_updated_tstep is the previous build until needsUpdating() records this one
+        bool dangerous = false;
+        unsigned int elapsed = timestep - m_last_updated_tstep;
+        if (timestep > prev_checked_tstep + 1 && elapsed > 1)
+            {
+            // estimate the ratio on the previous step, if it was above 1 a skipped step used a stale list
+            Scalar prev_ratio = m_max_disp_ratio * Scalar(elapsed - 1) / Scalar(elapsed);
+            if (prev_ratio > Scalar(1.0))
+                {
+                dangerous = true;
+                m_adaptive_safety *= Scalar(0.5);
+                m_exec_conf->msg->notice(2) << "nlist: Adaptive distance check missed a build, reducing the "
+                                            << "skip fraction to " << m_adaptive_safety << endl;
+                }
+            }
+
+        return dangerous;
+        }
+
+    unsigned int elapsed = timestep - m_last_updated_tstep;
+    unsigned int skip = 1;
+    if (m_max_disp_ratio > Scalar(0.0))
+        {
+        Scalar steps_left = Scalar(elapsed) * (Scalar(1.0) / m_max_disp_ratio - Scalar(1.0));
+        Scalar predicted_skip = m_adaptive_safety * steps_left;
+        if (predicted_skip > Scalar(1.0))
+            skip = (predicted_skip < Scalar(1e6)) ? (unsigned int)predicted_skip : 1000000;
+        }
+    else
+        {
+        // nothing has moved, back off
+        skip = (elapsed > 1) ? elapsed : 1;
+        }
+
+    m_next_check_tstep = timestep + skip;
+    return false;
+    }
+
+/*! \param timestep Current time step
+
+    Called once per time step. The window is closed after 5 builds (or 5000 steps) so that it averages over complete
+    rebuild cycles. The wall time per step includes the force computation and everything else in the step, which
+    is what r_buff trades off against the neighbor list builds. With MPI, the slowest rank determines the time and
+    all ranks take the same decision.
+*/
+void NeighborList::tuneRBuff(unsigned int timestep)
+    {
+    int64_t now = m_tune_clock.getTime();
+
+    if (!m_tune_window_open || timestep <= m_tune_window_start_tstep)
+        {
+        m_tune_window_open = true;
+        m_tune_window_start_time = now;
+        m_tune_window_start_tstep = timestep;
+        m_tune_window_start_updates = m_updates;
+        return;
+        }
+
+    unsigned int steps = timestep - m_tune_window_start_tstep;
+    if (m_updates - m_tune_window_start_updates < 5 && steps < 5000)
+        return;
+
+    double time_per_step = double(now - m_tune_window_start_time) / double(steps);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &time_per_step, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+    #endif
+
+    m_exec_conf->msg->notice(6) << "nlist: r_buff = " << m_r_buff << " took " << time_per_step/1e6
+                                << " ms per step" << endl;
+
+    if (m_tune_best_time < 0.0 || time_per_step < m_tune_best_time)
+        {
+        m_tune_best_time = time_per_step;
+        m_tune_best_r_buff = m_r_buff;
+        m_tune_failures = 0;
+        }
+    else
+        {
+        // try the other direction, and take smaller steps once both failed
+        m_tune_dir = -m_tune_dir;
+        m_tune_failures++;
+        if (m_tune_failures == 2)
+            {
+            m_tune_step *= Scalar(0.5);
+            m_tune_failures = 0;
+            }
+        }
+
+    m_tune_window_open = false;
+
+    if (m_tune_step < Scalar(0.02))
+        {
+        m_tune_r_buff = false;
+        m_exec_conf->msg->notice(2) << "nlist: Tuned r_buff = " << m_tune_best_r_buff << endl;
+        if (m_r_buff != m_tune_best_r_buff)
+            setRBuff(m_tune_best_r_buff);
+        return;
+        }
+
+    // keep r_buff between 1% and 100% of the largest cutoff
+    Scalar r_buff = m_tune_best_r_buff * (Scalar(1.0) + Scalar(m_tune_dir) * m_tune_step);
+    Scalar r_cut_max = getMaxRCut();
+    if (r_buff < Scalar(0.01)*r_cut_max)
+        r_buff = Scalar(0.01)*r_cut_max;
+    if (r_buff > r_cut_max)
+        r_buff = r_cut_max;
+
+    setRBuff(r_buff);
+    }
+
 /*! Generic statistics that apply to any neighbor list, like the number of updates,
     average number of neighbors, etc... are printed to stdout. Derived classes should
     print any pertinient information they see fit to.
@@ -1182,16 +1416,60 @@ void NeighborList::printStats()
     m_exec_conf->msg->notice(1) << "n_neigh_min: " << n_neigh_min << " / n_neigh_max: " << n_neigh_max << " / n_neigh_avg: " << n_neigh_avg << endl;
 
     m_exec_conf->msg->notice(1) << "shortest rebuild period: " << getSmallestRebuild() << endl;
+
+    if (m_adaptive)
+        m_exec_conf->msg->notice(1) << m_distance_checks << " distance checks (adaptive)" << endl;
     }
 
 void NeighborList::resetStats()
     {
     m_updates = m_forced_updates = m_dangerous_updates = 0;
+    m_distance_checks = 0;
+
+    // the time between runs does not belong to a timing window
+    m_tune_window_open = false;
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
     }
 
+/*! NeighborList provides
+    - \b time_nlist - wall clock time (in seconds) spent checking and building the list since the last log write
+    - \b nlist_builds - number of builds since the last log write
+
+    Under MPI, the maximum over all ranks is reported.
+*/
+std::vector< std::string > NeighborList::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_nlist");
+    result.push_back("nlist_builds");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar NeighborList::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    Scalar value(0.0);
+    if (quantity == "time_nlist")
+        value = m_compute_timer.getIntervalSeconds(timestep);
+    else if (quantity == "nlist_builds")
+        value = Scalar(m_build_counter.getInterval(timestep));
+    else
+        {
+        m_exec_conf->msg->error() << "nlist: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+    return value;
+    }
+
 unsigned int NeighborList::getSmallestRebuild()
     {
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
@@ -1450,6 +1728,9 @@ void export_NeighborList()
                      .def("setRCutPair", &NeighborList::setRCutPair)
                      .def("setRBuff", &NeighborList::setRBuff)
                      .def("setEvery", &NeighborList::setEvery)
+                     .def("setAdaptive", &NeighborList::setAdaptive)
+                     .def("setTuneRBuff", &NeighborList::setTuneRBuff)
+                     .def("getRBuff", &NeighborList::getRBuff)
                      .def("setStorageMode", &NeighborList::setStorageMode)
                      .def("addExclusion", &NeighborList::addExclusion)
                      .def("clearExclusions", &NeighborList::clearExclusions)
@@ -54,6 +54,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GPUVector.h"
 #include "GPUFlags.h"
 #include "Index1D.h"
+#include "ClockSource.h"
 
 #include <boost/shared_ptr.hpp>
 #include <boost/signals2.hpp>
@@ -134,6 +135,19 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     setEvery takes a dist_check parameter. When dist_check=True, the above described behavior is followed. When
     dist_check is false, the nlist is built exactly m_every steps. This is intended for use in profiling only.
 
+    In adaptive mode (setAdaptive()), the distance check records the largest displacement as a fraction of the
+    allowed one. Assuming that this fraction grows linearly from the last build, the next check is scheduled a safety
+    fraction of the predicted remaining steps ahead and the checks in between are skipped. If a rebuild shows that the
+    limit was already exceeded on a skipped step, the build is counted as dangerous and the safety fraction is halved.
+    m_every remains the minimum number of steps between a build and the next check. Because the step at which the
+    limit was crossed is itself estimated by linear extrapolation of the displacement, a particle that moved out and
+    back between two checks is not detected, and the dangerous build count can be too low. Without adaptive mode the
+    check stops at the first particle that exceeds the limit and skips the extra reduction.
+
+    With setTuneRBuff(), the buffer radius is tuned while the simulation runs. The wall time per step is measured over
+    windows of several rebuilds and r_buff is moved in the direction that lowers it, halving the step size whenever
+    neither direction improves on the best value, until it converges.
+
     \b Exclusions:
 
     Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
@@ -219,6 +233,23 @@ class NeighborList : public Compute
             return m_storage_mode;
             }
 
+        //! Enable or disable adaptive scheduling of the distance checks
+        void setAdaptive(bool adaptive)
+            {
+            m_adaptive = adaptive;
+            m_adaptive_safety = Scalar(0.5);
+            m_next_check_tstep = 0;
+            }
+
+        //! Enable or disable the online tuning of r_buff
+        void setTuneRBuff(bool tune);
+
+        //! Get the buffer radius
+        Scalar getRBuff()
+            {
+            return m_r_buff;
+            }
+
         //! Get the maximum of all rcut
         Scalar getMaxRCut()
             {
@@ -264,6 +295,12 @@ class NeighborList : public Compute
         //! Gets the shortest rebuild period this nlist has experienced since a call to resetStats
         unsigned int getSmallestRebuild();
 
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
         // @}
         //! \name Get data
         // @{
@@ -453,6 +490,12 @@ class NeighborList : public Compute
             return m_updates + m_forced_updates;
             }
 
+        //! Get the number of distance checks performed since the last resetStats()
+        int64_t getNumDistanceChecks()
+            {
+            return m_distance_checks;
+            }
+
 
 #ifdef ENABLE_MPI
         //! Set the communicator to use
@@ -504,6 +547,7 @@ class NeighborList : public Compute
         GPUArray<unsigned int> m_nlist;      //!< Neighbor list data
         GPUArray<unsigned int> m_n_neigh;    //!< Number of neighbors for each particle
         GPUArray<Scalar4> m_last_pos;        //!< coordinates of last updated particle positions
+        Scalar m_max_disp_ratio;             //!< Largest displacement over the allowed one in the last distance check (< 0 if unknown)
         Scalar3 m_last_L;                    //!< Box lengths at last update
         Scalar3 m_last_L_local;              //!< Local Box lengths at last update
 
@@ -562,6 +606,8 @@ class NeighborList : public Compute
             // exclusions require ghost particle tags
             CommFlags flags(0);
             if (m_exclusions_set) flags[comm_flag::tag] = 1;
+            // body filtering requires ghost particle body ids
+            if (m_filter_body) flags[comm_flag::body] = 1;
             return flags;
             }
         #endif
@@ -591,10 +637,38 @@ class NeighborList : public Compute
         bool m_last_check_result;          //!< Last result of rebuild check
         unsigned int m_every; //!< No update checks will be performed until m_every steps after the last one
         std::vector<unsigned int> m_update_periods;    //!< Steps between updates
+        int64_t m_distance_checks;         //!< Number of distance checks performed
+        PerformanceCounter m_build_counter; //!< Number of builds, reported per logging interval
+
+        bool m_adaptive;                   //!< True if the distance checks are scheduled adaptively
+        Scalar m_adaptive_safety;          //!< Fraction of the predicted steps to the next build that may be skipped
+        unsigned int m_next_check_tstep;   //!< Next time step to check in adaptive mode
+
+        bool m_tune_r_buff;                //!< True while r_buff is being tuned
+        bool m_tune_window_open;           //!< True if a timing window has been started
+        ClockSource m_tune_clock;          //!< Clock for timing the windows
+        int64_t m_tune_window_start_time;  //!< Clock time at the start of the window
+        unsigned int m_tune_window_start_tstep; //!< Time step at the start of the window
+        int64_t m_tune_window_start_updates;    //!< Number of builds at the start of the window
+        double m_tune_best_time;           //!< Best time per step measured so far (< 0 if none)
+        Scalar m_tune_best_r_buff;         //!< r_buff that gave the best time per step
+        Scalar m_tune_step;                //!< Relative change of r_buff tried next
+        int m_tune_dir;                    //!< Direction of the next change (+1 or -1)
+        unsigned int m_tune_failures;      //!< Number of consecutive tries that did not improve
 
         //! Test if the list needs updating
         bool needsUpdating(unsigned int timestep);
 
+        //! Squared displacement of a particle since the last build
+        Scalar particleDisplacementSq(unsigned int i, const Scalar4 *pos, const Scalar4 *last_pos,
+            const Scalar *rcut_max, const BoxDim& box, const Scalar3& lambda, Scalar lambda_min, Scalar& maxsq) const;
+
+        //! Schedule the next distance check in adaptive mode
+        bool scheduleDistanceCheck(unsigned int timestep, unsigned int prev_checked_tstep, bool result);
+
+        //! Time the current window and update r_buff when it is complete
+        void tuneRBuff(unsigned int timestep);
+
         //! Reallocate internal neighbor list data structures
         void reallocate();
         
@@ -216,6 +216,18 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
+
+            // minimum image separations to every particle in the bin, in one batch
+            if (size > m_dx.size())
+                m_dx.resize(size);
+            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+                {
+                const Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                m_dx[cur_offset] = my_pos - make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                }
+            if (size > 0)
+                box.minImageArray(&m_dx[0], size);
+
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
                 Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
@@ -235,9 +247,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                 if (excluded)
                     continue;
 
-                Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
+                const Scalar3& dx = m_dx[cur_offset];
 
                 Scalar r_list = r_cut + m_r_buff;
                 Scalar sqshift = Scalar(0.0);
@@ -52,6 +52,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NeighborList.h"
 #include "CellList.h"
 
+#include <vector>
+
 /*! \file NeighborListBinned.h
     \brief Declares the NeighborListBinned class
 */
@@ -91,6 +93,7 @@ class NeighborListBinned : public NeighborList
 
     protected:
         boost::shared_ptr<CellList> m_cl;   //!< The cell list
+        std::vector<Scalar3> m_dx;          //!< Separations to the particles of one neighboring bin
 
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
@@ -201,6 +201,8 @@ void PotentialExternal<evaluator>::computeForces(unsigned int timestep)
 
     const BoxDim& box = m_pdata->getGlobalBox();
     PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    bool compute_energy = flags[pdata_flag::potential_energy];
 
     if (flags[pdata_flag::external_field_virial])
         {
@@ -251,11 +253,17 @@ void PotentialExternal<evaluator>::computeForces(unsigned int timestep)
         h_force.data[idx].x = F.x;
         h_force.data[idx].y = F.y;
         h_force.data[idx].z = F.z;
-        h_force.data[idx].w = energy;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k*m_virial_pitch+idx]  = virial[k];
+        if (compute_energy)
+            h_force.data[idx].w = energy;
+        if (compute_virial)
+            for (int k = 0; k < 6; k++)
+                h_virial.data[k*m_virial_pitch+idx]  = virial[k];
         }
 
+    // let ForceCompute know that the energies need to be recomputed if requested later
+    if (!compute_energy)
+        m_energy_skipped = true;
+
 
     if (m_prof)
         m_prof->pop();
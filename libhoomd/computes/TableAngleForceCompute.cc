@@ -75,7 +75,7 @@ using namespace std;
 TableAngleForceCompute::TableAngleForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TableAngleForceCompute" << endl;
 
@@ -153,6 +153,54 @@ void TableAngleForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    // and the cubic coefficients, if they are in use
+    if (m_cubic)
+        {
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::readwrite);
+        table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                           h_tables.data + m_table_value(0, type),
+                           m_table_width,
+                           Scalar(M_PI)/Scalar(m_table_width - 1));
+        }
+    }
+
+/*! \param cubic True to interpolate with cubic Hermite polynomials, false for linear interpolation
+
+    The coefficients are only allocated while cubic interpolation is selected. They are computed from the tables set
+    so far here, and updated by later calls to setTable().
+*/
+void TableAngleForceCompute::setCubicInterpolation(bool cubic)
+    {
+    if (cubic && m_table_width < 2)
+        {
+        m_exec_conf->msg->error() << "angle.table: Cubic interpolation needs a table width of at least 2" << endl;
+        throw runtime_error("Error initializing TableAngleForceCompute");
+        }
+
+    if (cubic && !m_cubic)
+        {
+        // one set of coefficients per interval between table points
+        unsigned int n_types = m_angle_data->getNTypes();
+        GPUArray<Scalar4> coeffs((m_table_width - 1) * n_types, m_exec_conf);
+        m_coeffs.swap(coeffs);
+
+        ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::overwrite);
+        for (unsigned int type = 0; type < n_types; type++)
+            table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                               h_tables.data + m_table_value(0, type),
+                               m_table_width,
+                               Scalar(M_PI)/Scalar(m_table_width - 1));
+        }
+    else if (!cubic)
+        {
+        // release the coefficients
+        GPUArray<Scalar4> coeffs;
+        m_coeffs.swap(coeffs);
+        }
+
+    m_cubic = cubic;
     }
 
 /*! TableAngleForceCompute provides
@@ -212,6 +260,7 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
 
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::read);
 
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
@@ -294,20 +343,32 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
         /// Here we use the table!!
         unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         unsigned int value_i = floor(value_f);
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (m_cubic)
+            {
+            // guard against round off placing the angle in the (nonexistent) interval past the end
+            if (value_i > m_table_width - 2)
+                value_i = m_table_width - 2;
+            Scalar f = value_f - Scalar(value_i);
+            table_hermite_eval(h_coeffs.data[(m_table_width - 1) * angle_type + value_i], f, Scalar(1.0) / delta_th, V, T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
+            // unpack the data
+            Scalar V0 = VT0.x;
+            Scalar V1 = VT1.x;
+            Scalar T0 = VT0.y;
+            Scalar T1 = VT1.y;
+
+            // compute the linear interpolation coefficient
+            Scalar f = value_f - Scalar(value_i);
+
+            // interpolate to get V and T;
+            V = V0 + f * (V1 - V0);
+            T = T0 + f * (T1 - T0);
+            }
 
         Scalar a =  T*s_abbc;
         Scalar a11 = a*c_abbc/rsqab;
@@ -379,5 +440,6 @@ void export_TableAngleForceCompute()
     class_<TableAngleForceCompute, boost::shared_ptr<TableAngleForceCompute>, bases<ForceCompute>, boost::noncopyable >
     ("TableAngleForceCompute", init< boost::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableAngleForceCompute::setTable)
+    .def("setCubicInterpolation", &TableAngleForceCompute::setCubicInterpolation)
     ;
     }
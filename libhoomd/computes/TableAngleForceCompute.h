@@ -53,6 +53,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BondedGroupData.h"
 #include "Index1D.h"
 #include "GPUArray.h"
+#include "TableInterpolation.h"
 
 #include <boost/shared_ptr.hpp>
 
@@ -92,6 +93,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - thmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - thmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    setCubicInterpolation() selects cubic Hermite interpolation instead, see TablePotential. It is only available on
+    the CPU.
     \ingroup computes
 */
 class TableAngleForceCompute : public ForceCompute
@@ -111,6 +115,9 @@ class TableAngleForceCompute : public ForceCompute
                               const std::vector<Scalar> &T
                               );
 
+        //! Select cubic Hermite (true) or linear (false) interpolation
+        virtual void setCubicInterpolation(bool cubic);
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -136,6 +143,8 @@ class TableAngleForceCompute : public ForceCompute
         unsigned int m_table_width;                 //!< Width of the tables in memory
         GPUArray<Scalar2> m_tables;                  //!< Stored V and T tables
         Index2D m_table_value;                      //!< Index table helper
+        GPUArray<Scalar4> m_coeffs;                 //!< Cubic Hermite coefficients for each table interval
+        bool m_cubic;                               //!< True if cubic interpolation is used
         std::string m_log_name;                     //!< Cached log name
 
         //! Actually compute the forces
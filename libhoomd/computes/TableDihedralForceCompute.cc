@@ -76,7 +76,7 @@ using namespace std;
 TableDihedralForceCompute::TableDihedralForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TableDihedralForceCompute" << endl;
 
@@ -142,6 +142,54 @@ void TableDihedralForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    // and the cubic coefficients, if they are in use
+    if (m_cubic)
+        {
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::readwrite);
+        table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                           h_tables.data + m_table_value(0, type),
+                           m_table_width,
+                           Scalar(2.0*M_PI)/Scalar(m_table_width - 1));
+        }
+    }
+
+/*! \param cubic True to interpolate with cubic Hermite polynomials, false for linear interpolation
+
+    The coefficients are only allocated while cubic interpolation is selected. They are computed from the tables set
+    so far here, and updated by later calls to setTable().
+*/
+void TableDihedralForceCompute::setCubicInterpolation(bool cubic)
+    {
+    if (cubic && m_table_width < 2)
+        {
+        m_exec_conf->msg->error() << "dihedral.table: Cubic interpolation needs a table width of at least 2" << endl;
+        throw runtime_error("Error initializing TableDihedralForceCompute");
+        }
+
+    if (cubic && !m_cubic)
+        {
+        // one set of coefficients per interval between table points
+        unsigned int n_types = m_dihedral_data->getNTypes();
+        GPUArray<Scalar4> coeffs((m_table_width - 1) * n_types, m_exec_conf);
+        m_coeffs.swap(coeffs);
+
+        ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::overwrite);
+        for (unsigned int type = 0; type < n_types; type++)
+            table_hermite_fill(h_coeffs.data + (m_table_width - 1) * type,
+                               h_tables.data + m_table_value(0, type),
+                               m_table_width,
+                               Scalar(2.0*M_PI)/Scalar(m_table_width - 1));
+        }
+    else if (!cubic)
+        {
+        // release the coefficients
+        GPUArray<Scalar4> coeffs;
+        m_coeffs.swap(coeffs);
+        }
+
+    m_cubic = cubic;
     }
 
 /*! TableDihedralForceCompute provides
@@ -201,6 +249,7 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
 
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::read);
 
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
@@ -324,20 +373,32 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         /// Here we use the table!!
         unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         unsigned int value_i = value_f;
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (m_cubic)
+            {
+            // guard against round off placing the angle in the (nonexistent) interval past the end
+            if (value_i > m_table_width - 2)
+                value_i = m_table_width - 2;
+            Scalar f = value_f - Scalar(value_i);
+            table_hermite_eval(h_coeffs.data[(m_table_width - 1) * dihedral_type + value_i], f, Scalar(1.0) / delta_phi, V, T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
+            // unpack the data
+            Scalar V0 = VT0.x;
+            Scalar V1 = VT1.x;
+            Scalar T0 = VT0.y;
+            Scalar T1 = VT1.y;
+
+            // compute the linear interpolation coefficient
+            Scalar f = value_f - Scalar(value_i);
+
+            // interpolate to get V and T;
+            V = V0 + f * (V1 - V0);
+            T = T0 + f * (T1 - T0);
+            }
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab),vec3<Scalar>(dcbm));
@@ -404,5 +465,6 @@ void export_TableDihedralForceCompute()
     class_<TableDihedralForceCompute, boost::shared_ptr<TableDihedralForceCompute>, bases<ForceCompute>, boost::noncopyable >
     ("TableDihedralForceCompute", init< boost::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableDihedralForceCompute::setTable)
+    .def("setCubicInterpolation", &TableDihedralForceCompute::setCubicInterpolation)
     ;
     }
@@ -73,7 +73,7 @@ TablePotential::TablePotential(boost::shared_ptr<SystemDefinition> sysdef,
                                boost::shared_ptr<NeighborList> nlist,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_nlist(nlist), m_table_width(table_width)
+        : ForceCompute(sysdef), m_nlist(nlist), m_table_width(table_width), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TablePotential" << endl;
 
@@ -91,15 +91,7 @@ TablePotential::TablePotential(boost::shared_ptr<SystemDefinition> sysdef,
     m_ntypes = m_pdata->getNTypes();
     assert(m_ntypes > 0);
 
-    // allocate storage for the tables and parameters
-    Index2DUpperTriangular table_index(m_ntypes);
-    GPUArray<Scalar2> tables(m_table_width, table_index.getNumElements(), m_exec_conf);
-    m_tables.swap(tables);
-    GPUArray<Scalar4> params(table_index.getNumElements(), m_exec_conf);
-    m_params.swap(params);
-
-    assert(!m_tables.isNull());
-    assert(!m_params.isNull());
+    allocateTables();
 
     m_log_name = std::string("pair_table_energy") + log_suffix;
 
@@ -126,7 +118,11 @@ void TablePotential::slotNumTypesChange()
     if ((2*m_pdata->getNTypes()-1) == m_params.getNumElements())
         return;
 
+    allocateTables();
+    }
 
+void TablePotential::allocateTables()
+    {
     // allocate storage for the tables and parameters
     Index2DUpperTriangular table_index(m_ntypes);
     GPUArray<Scalar2> tables(m_table_width, table_index.getNumElements(), m_exec_conf);
@@ -136,6 +132,55 @@ void TablePotential::slotNumTypesChange()
 
     assert(!m_tables.isNull());
     assert(!m_params.isNull());
+
+    if (m_cubic)
+        allocateCoeffs();
+    }
+
+/*! Allocates one set of cubic Hermite coefficients per interval between table points and computes them from the
+    current tables.
+*/
+void TablePotential::allocateCoeffs()
+    {
+    unsigned int n_tables = m_params.getNumElements();
+    GPUArray<Scalar4> coeffs((m_table_width - 1) * n_tables, m_exec_conf);
+    m_coeffs.swap(coeffs);
+
+    Index2D table_value(m_table_width);
+    Index2D coeff_value(m_table_width - 1);
+    ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::overwrite);
+    for (unsigned int cur_table_index = 0; cur_table_index < n_tables; cur_table_index++)
+        table_hermite_fill(h_coeffs.data + coeff_value(0, cur_table_index),
+                           h_tables.data + table_value(0, cur_table_index),
+                           m_table_width,
+                           h_params.data[cur_table_index].z);
+    }
+
+/*! \param cubic True to interpolate with cubic Hermite polynomials, false for linear interpolation
+
+    The coefficients are only allocated while cubic interpolation is selected. They are computed from the tables set
+    so far here, and updated by later calls to setTable().
+*/
+void TablePotential::setCubicInterpolation(bool cubic)
+    {
+    if (cubic && m_table_width < 2)
+        {
+        m_exec_conf->msg->error() << "pair.table: Cubic interpolation needs a table width of at least 2" << endl;
+        throw runtime_error("Error initializing TablePotential");
+        }
+
+    if (cubic && !m_cubic)
+        allocateCoeffs();
+    else if (!cubic)
+        {
+        // release the coefficients
+        GPUArray<Scalar4> coeffs;
+        m_coeffs.swap(coeffs);
+        }
+
+    m_cubic = cubic;
     }
 
 /*! \param typ1 First particle type index in the pair to set
@@ -188,6 +233,17 @@ void TablePotential::setTable(unsigned int typ1,
         h_tables.data[table_value(i, cur_table_index)].x = V[i];
         h_tables.data[table_value(i, cur_table_index)].y = F[i];
         }
+
+    // and the cubic coefficients, if they are in use
+    if (m_cubic)
+        {
+        ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::readwrite);
+        Index2D coeff_value(m_table_width - 1);
+        table_hermite_fill(h_coeffs.data + coeff_value(0, cur_table_index),
+                           h_tables.data + table_value(0, cur_table_index),
+                           m_table_width,
+                           h_params.data[cur_table_index].z);
+        }
     }
 
 /*! TablePotential provides
@@ -227,6 +283,13 @@ void TablePotential::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push("Table pair");
 
+    if (m_cubic)
+        {
+        computeForcesCubic();
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -393,11 +456,189 @@ void TablePotential::computeForces(unsigned int timestep)
     }
 
 //! Exports the TablePotential class to python
+/*! Cubic Hermite variant of computeForces(). The table lookups for the neighbors of each particle are collected
+    first and then evaluated in one batch with table_hermite_eval_batch(), so that the polynomial evaluation
+    runs over contiguous arrays.
+*/
+void TablePotential::computeForcesCubic()
+    {
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    // access the neighbor list
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    // access the particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // get a local copy of the simulation box too
+    const BoxDim& box = m_pdata->getBox();
+
+    // access the table data
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+
+    // index calculation helpers
+    Index2DUpperTriangular table_index(m_ntypes);
+    Index2D coeff_value(m_table_width - 1);
+    unsigned int max_interval = m_table_width - 2;
+
+    // for each particle
+    for (int i = 0; i < (int) m_pdata->getN(); i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int head_i = h_head_list.data[i];
+        assert(typei < m_pdata->getNTypes());
+
+        // collect the table lookups of all neighbors within range
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        if (m_batch_k.size() < size)
+            {
+            m_batch_k.resize(size);
+            m_batch_dx.resize(size);
+            m_batch_r.resize(size);
+            m_batch_idx.resize(size);
+            m_batch_t.resize(size);
+            m_batch_inv_dx.resize(size);
+            m_batch_V.resize(size);
+            m_batch_F.resize(size);
+            }
+
+        unsigned int n_batch = 0;
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int k = h_nlist.data[head_i + j];
+            assert(k < m_pdata->getN() + m_pdata->getNGhosts());
+
+            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+            Scalar3 dx = box.minImage(pi - pk);
+
+            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+            assert(typej < m_pdata->getNTypes());
+
+            unsigned int cur_table_index = table_index(typei, typej);
+            Scalar4 params = h_params.data[cur_table_index];
+            Scalar rmin = params.x;
+            Scalar rmax = params.y;
+            Scalar delta_r = params.z;
+
+            Scalar r = sqrt(dot(dx, dx));
+
+            // only compute the force if the particles are within the region defined by V
+            if (r < rmax && r >= rmin)
+                {
+                Scalar value_f = (r - rmin) / delta_r;
+                unsigned int value_i = (unsigned int)floor(value_f);
+                // guard against round off placing r in the (nonexistent) interval past the end
+                if (value_i > max_interval)
+                    value_i = max_interval;
+
+                m_batch_k[n_batch] = k;
+                m_batch_dx[n_batch] = dx;
+                m_batch_r[n_batch] = r;
+                m_batch_idx[n_batch] = coeff_value(value_i, cur_table_index);
+                m_batch_t[n_batch] = value_f - Scalar(value_i);
+                m_batch_inv_dx[n_batch] = Scalar(1.0) / delta_r;
+                n_batch++;
+                }
+            }
+
+        // evaluate all lookups at once
+        if (n_batch > 0)
+            table_hermite_eval_batch(h_coeffs.data,
+                                     &m_batch_idx[0],
+                                     &m_batch_t[0],
+                                     &m_batch_inv_dx[0],
+                                     n_batch,
+                                     &m_batch_V[0],
+                                     &m_batch_F[0]);
+
+        // initialize current particle force, potential energy, and virial to 0
+        Scalar3 fi = make_scalar3(0,0,0);
+        Scalar pei = 0.0;
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        for (unsigned int l = 0; l < n_batch; l++)
+            {
+            Scalar3 dx = m_batch_dx[l];
+            Scalar r = m_batch_r[l];
+            unsigned int k = m_batch_k[l];
+
+            // convert to standard variables used by the other pair computes in HOOMD-blue
+            Scalar forcemag_divr = Scalar(0.0);
+            if (r > Scalar(0.0))
+                forcemag_divr = m_batch_F[l] / r;
+            Scalar pair_eng = Scalar(0.5) * m_batch_V[l];
+
+            // compute the virial
+            Scalar forcemag_div2r = Scalar(0.5) * forcemag_divr;
+            virialxxi += forcemag_div2r*dx.x*dx.x;
+            virialxyi += forcemag_div2r*dx.x*dx.y;
+            virialxzi += forcemag_div2r*dx.x*dx.z;
+            virialyyi += forcemag_div2r*dx.y*dx.y;
+            virialyzi += forcemag_div2r*dx.y*dx.z;
+            virialzzi += forcemag_div2r*dx.z*dx.z;
+
+            // add the force, potential energy and virial to the particle i
+            fi += dx*forcemag_divr;
+            pei += pair_eng;
+
+            // add the force to particle j if we are using the third law
+            // only add force to local particles
+            if (third_law && k < m_pdata->getN())
+                {
+                unsigned int mem_idx = k;
+                h_force.data[mem_idx].x -= dx.x*forcemag_divr;
+                h_force.data[mem_idx].y -= dx.y*forcemag_divr;
+                h_force.data[mem_idx].z -= dx.z*forcemag_divr;
+                h_force.data[mem_idx].w += pair_eng;
+                h_virial.data[0*m_virial_pitch+mem_idx] += forcemag_div2r * dx.x * dx.x;
+                h_virial.data[1*m_virial_pitch+mem_idx] += forcemag_div2r * dx.x * dx.y;
+                h_virial.data[2*m_virial_pitch+mem_idx] += forcemag_div2r * dx.x * dx.z;
+                h_virial.data[3*m_virial_pitch+mem_idx] += forcemag_div2r * dx.y * dx.y;
+                h_virial.data[4*m_virial_pitch+mem_idx] += forcemag_div2r * dx.y * dx.z;
+                h_virial.data[5*m_virial_pitch+mem_idx] += forcemag_div2r * dx.z * dx.z;
+                }
+            }
+
+        // finally, increment the force, potential energy and virial for particle i
+        unsigned int mem_idx = i;
+        h_force.data[mem_idx].x += fi.x;
+        h_force.data[mem_idx].y += fi.y;
+        h_force.data[mem_idx].z += fi.z;
+        h_force.data[mem_idx].w += pei;
+        h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
+        h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
+        h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
+        h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
+        h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
+        h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+        }
+    }
+
 void export_TablePotential()
     {
     class_<TablePotential, boost::shared_ptr<TablePotential>, bases<ForceCompute>, boost::noncopyable >
     ("TablePotential", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<NeighborList>, unsigned int, const std::string& >())
     .def("setTable", &TablePotential::setTable)
+    .def("setCubicInterpolation", &TablePotential::setCubicInterpolation)
     ;
 
     class_<std::vector<Scalar> >("std_vector_scalar")
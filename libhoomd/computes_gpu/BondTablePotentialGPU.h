@@ -92,6 +92,18 @@ class BondTablePotentialGPU : public BondTablePotential
             m_tuner->setEnabled(enable);
             }
 
+        //! Cubic interpolation is not implemented on the GPU
+        /*! \param cubic True to request cubic interpolation
+        */
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            if (cubic)
+                {
+                m_exec_conf->msg->error() << "bond.table: Cubic interpolation is not supported on the GPU" << std::endl;
+                throw std::runtime_error("Error initializing BondTablePotentialGPU");
+                }
+            }
+
     private:
         boost::scoped_ptr<Autotuner> m_tuner; //!< Autotuner for block size
         GPUArray<unsigned int> m_flags;       //!< Flags set during the kernel execution
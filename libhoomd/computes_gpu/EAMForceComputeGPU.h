@@ -96,6 +96,18 @@ class EAMForceComputeGPU : public EAMForceCompute
             m_tuner->setEnabled(enable);
             }
 
+        //! Cubic interpolation is not implemented on the GPU
+        /*! \param cubic True to request cubic interpolation
+        */
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            if (cubic)
+                {
+                m_exec_conf->msg->error() << "pair.eam: Cubic interpolation is not supported on the GPU" << std::endl;
+                throw std::runtime_error("Error initializing EAMForceComputeGPU");
+                }
+            }
+
     protected:
         EAMTexInterData eam_data;                   //!< Undocumented parameter
         EAMtex eam_tex_data;                        //!< Undocumented parameter
@@ -93,6 +93,18 @@ class TablePotentialGPU : public TablePotential
             m_tuner->setEnabled(enable);
             }
 
+        //! Cubic interpolation is not implemented on the GPU
+        /*! \param cubic True to request cubic interpolation
+        */
+        virtual void setCubicInterpolation(bool cubic)
+            {
+            if (cubic)
+                {
+                m_exec_conf->msg->error() << "pair.table: Cubic interpolation is not supported on the GPU" << std::endl;
+                throw std::runtime_error("Error initializing TablePotentialGPU");
+                }
+            }
+
     private:
         boost::scoped_ptr<Autotuner> m_tuner; //!< Autotuner for block size
 
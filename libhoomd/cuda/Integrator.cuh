@@ -61,7 +61,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! struct to pack up several force and virial arrays for addition
 /*! To keep the argument count down to gpu_integrator_sum_accel, up to 6 force/virial array pairs are packed up in this
     struct for addition to the net force/virial in a single kernel call. If there is not a multiple of 5 forces to sum,
-    set some of the pointers to NULL and they will be ignored.
+    set some of the pointers to NULL and they will be ignored. The force and torque (but not the energy or virial) of
+    each array are multiplied by its weight, which defaults to 1.
 */
 struct gpu_force_list
     {
@@ -70,7 +71,8 @@ struct gpu_force_list
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL),
           t0(NULL), t1(NULL), t2(NULL), t3(NULL), t4(NULL), t5(NULL),
           v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0),
+          w0(1), w1(1), w2(1), w3(1), w4(1), w5(1)
           {
           }
 
@@ -101,6 +103,13 @@ struct gpu_force_list
     unsigned int vpitch3; //!< Pitch of virial array 3
     unsigned int vpitch4; //!< Pitch of virial array 4
     unsigned int vpitch5; //!< Pitch of virial array 5
+
+    Scalar w0; //!< Weight of force and torque array 0
+    Scalar w1; //!< Weight of force and torque array 1
+    Scalar w2; //!< Weight of force and torque array 2
+    Scalar w3; //!< Weight of force and torque array 3
+    Scalar w4; //!< Weight of force and torque array 4
+    Scalar w5; //!< Weight of force and torque array 5
  };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
@@ -103,6 +103,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
        box boundaries. It does this only for dimensions that are set periodic
 
     \note minImage() and wrap() only work for particles that have moved up to 1 box image out of the box.
+
+    CPU kernels that process many vectors at once should use the batch versions minImageArray(), wrapArray() and
+    makeFractionArray(). They select the code path once per call: orthorhombic boxes that are periodic in all
+    directions (see isOrthorhombicPeriodic()) take a branch free loop based on fast::rint() that the compiler
+    vectorizes, other boxes use a branch free version of the general formula or fall back to the scalar method.
 */
 struct BoxDim
     {
@@ -273,6 +278,13 @@ struct BoxDim
             return m_yz;
             }
 
+        //! Test if the box is orthorhombic and periodic in all directions
+        HOSTDEVICE bool isOrthorhombicPeriodic() const
+            {
+            return m_periodic.x && m_periodic.y && m_periodic.z &&
+                   m_xy == Scalar(0.0) && m_xz == Scalar(0.0) && m_yz == Scalar(0.0);
+            }
+
         //! Compute fractional coordinates, allowing for a ghost layer
         /*! \param v Vector to scale
             \param ghost_width Width of extra ghost padding layer to take into account (along reciprocal lattice directions)
@@ -503,6 +515,148 @@ struct BoxDim
             w.z = v.z;
             }
 
+        #ifndef NVCC
+        //! Compute the minimum image of an array of vectors
+        /*! \param v Vectors to convert, replaced by their minimum image obeying the periodic settings
+            \param n Number of vectors
+
+            Unlike minImage(), the vectors may extend any number of images beyond the box.
+        */
+        void minImageArray(Scalar3 *v, unsigned int n) const
+            {
+            const Scalar3 L = m_L;
+
+            if (isOrthorhombicPeriodic())
+                {
+                const Scalar3 Linv = m_Linv;
+                for (unsigned int i = 0; i < n; i++)
+                    {
+                    v[i].x -= L.x * fast::rint(v[i].x * Linv.x);
+                    v[i].y -= L.y * fast::rint(v[i].y * Linv.y);
+                    v[i].z -= L.z * fast::rint(v[i].z * Linv.z);
+                    }
+                }
+            else
+                {
+                // non-periodic directions get a zero image
+                const Scalar3 Linv = make_scalar3(m_periodic.x ? m_Linv.x : Scalar(0.0),
+                                                  m_periodic.y ? m_Linv.y : Scalar(0.0),
+                                                  m_periodic.z ? m_Linv.z : Scalar(0.0));
+                for (unsigned int i = 0; i < n; i++)
+                    {
+                    Scalar3 w = v[i];
+
+                    Scalar img = fast::rint(w.z * Linv.z);
+                    w.z -= L.z * img;
+                    w.y -= L.z * m_yz * img;
+                    w.x -= L.z * m_xz * img;
+
+                    img = fast::rint(w.y * Linv.y);
+                    w.y -= L.y * img;
+                    w.x -= L.y * m_xy * img;
+
+                    w.x -= L.x * fast::rint(w.x * Linv.x);
+                    v[i] = w;
+                    }
+                }
+            }
+
+        //! Wrap an array of positions back into the box
+        /*! \param pos Positions to wrap (the 4th element is left alone)
+            \param img Images of the positions, updated to reflect the new images. May be NULL.
+            \param n Number of positions
+
+            Orthorhombic, fully periodic boxes wrap positions that are any number of images out of the box. Other
+            boxes are wrapped with wrap(), and the positions must not extend more than 1 image beyond the box.
+        */
+        void wrapArray(Scalar4 *pos, int3 *img, unsigned int n) const
+            {
+            if (! isOrthorhombicPeriodic())
+                {
+                for (unsigned int i = 0; i < n; i++)
+                    {
+                    int3 tmp = make_int3(0,0,0);
+                    wrap(pos[i], img ? img[i] : tmp);
+                    }
+                return;
+                }
+
+            const Scalar3 L = m_L;
+            const Scalar3 Linv = m_Linv;
+            const Scalar3 lo = m_lo;
+            const Scalar3 hi = m_hi;
+            const Scalar3 origin = (m_hi + m_lo)/Scalar(2.0);
+
+            for (unsigned int i = 0; i < n; i++)
+                {
+                Scalar4 p = pos[i];
+                Scalar3 s = make_scalar3(fast::rint((p.x - origin.x) * Linv.x),
+                                         fast::rint((p.y - origin.y) * Linv.y),
+                                         fast::rint((p.z - origin.z) * Linv.z));
+                p.x -= L.x * s.x;
+                p.y -= L.y * s.y;
+                p.z -= L.z * s.z;
+
+                // rint() rounds ties to even, and the subtraction may round onto a boundary: move those
+                // positions into [lo, hi) like wrap() does
+                Scalar up = (p.x >= hi.x) ? Scalar(1.0) : ((p.x < lo.x) ? Scalar(-1.0) : Scalar(0.0));
+                p.x -= L.x * up;
+                s.x += up;
+                up = (p.y >= hi.y) ? Scalar(1.0) : ((p.y < lo.y) ? Scalar(-1.0) : Scalar(0.0));
+                p.y -= L.y * up;
+                s.y += up;
+                up = (p.z >= hi.z) ? Scalar(1.0) : ((p.z < lo.z) ? Scalar(-1.0) : Scalar(0.0));
+                p.z -= L.z * up;
+                s.z += up;
+
+                pos[i] = p;
+                if (img)
+                    {
+                    img[i].x += int(s.x);
+                    img[i].y += int(s.y);
+                    img[i].z += int(s.z);
+                    }
+                }
+            }
+
+        //! Compute fractional coordinates of an array of positions, allowing for a ghost layer
+        /*! \param pos Positions (the 4th element is ignored)
+            \param f Fractional coordinates (output), see makeFraction()
+            \param n Number of positions
+            \param ghost_width Width of extra ghost padding layer to take into account
+        */
+        void makeFractionArray(const Scalar4 *pos, Scalar3 *f, unsigned int n,
+                               const Scalar3& ghost_width=make_scalar3(0.0,0.0,0.0)) const
+            {
+            // fold the ghost layer into a single scale and offset per direction
+            const Scalar3 ghost_frac = ghost_width/getNearestPlaneDistance();
+            const Scalar3 scale = m_Linv/(make_scalar3(1,1,1)+Scalar(2.0)*ghost_frac);
+            const Scalar3 offset = ghost_frac/(make_scalar3(1,1,1)+Scalar(2.0)*ghost_frac) - m_lo*scale;
+
+            if (m_xy == Scalar(0.0) && m_xz == Scalar(0.0) && m_yz == Scalar(0.0))
+                {
+                for (unsigned int i = 0; i < n; i++)
+                    {
+                    f[i].x = pos[i].x * scale.x + offset.x;
+                    f[i].y = pos[i].y * scale.y + offset.y;
+                    f[i].z = pos[i].z * scale.z + offset.z;
+                    }
+                }
+            else
+                {
+                const Scalar tilt_x = m_xz - m_yz*m_xy;
+                for (unsigned int i = 0; i < n; i++)
+                    {
+                    Scalar x = pos[i].x - tilt_x*pos[i].z - m_xy*pos[i].y;
+                    Scalar y = pos[i].y - m_yz*pos[i].z;
+                    f[i].x = x * scale.x + offset.x;
+                    f[i].y = y * scale.y + offset.y;
+                    f[i].z = pos[i].z * scale.z + offset.z;
+                    }
+                }
+            }
+        #endif
+
         //! Get the periodic image a vector belongs to
         /*! \param v The vector to check
             \returns the integer coordinates of the periodic image
@@ -0,0 +1,271 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file CompressedTrajectoryReader.cc
+    \brief Defines the CompressedTrajectoryReader class
+*/
+
+#include "CompressedTrajectoryReader.h"
+
+#include "num_util.h"
+
+#include <stdexcept>
+#include <fstream>
+#include <string.h>
+
+#include <boost/python.hpp>
+using namespace boost::python;
+using namespace std;
+
+/*! \param exec_conf Execution configuration
+    \param fname File to read
+*/
+CompressedTrajectoryReader::CompressedTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                                       const std::string &fname)
+    : m_exec_conf(exec_conf), m_fname(fname), m_end_of_frames(0), m_decoded_frame(-1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CompressedTrajectoryReader: " << fname << endl;
+
+    ifstream file(fname.c_str(), ios::in | ios::binary);
+    if (!file.good())
+        {
+        m_exec_conf->msg->error() << "Unable to open " << fname << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+
+    string error;
+    if (!hctReadIndex(file, m_header, m_index, m_end_of_frames, error))
+        {
+        m_exec_conf->msg->error() << fname << ": " << error << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+    file.close();
+
+    // frames are read from a mapping of the file, which covers the frames found by hctReadIndex() even if the file
+    // is still being written
+    m_file = boost::shared_ptr<MappedFile>(new MappedFile(m_exec_conf->msg, fname));
+    if (m_file->getSize() < m_end_of_frames)
+        {
+        m_exec_conf->msg->error() << fname << ": file was truncated while opening it" << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+
+    m_exec_conf->msg->notice(3) << fname << ": " << m_index.size() << " frames of " << m_header.N << " particles"
+                                << endl;
+    }
+
+/*! \param frame Index of the frame
+*/
+void CompressedTrajectoryReader::checkFrame(unsigned int frame) const
+    {
+    if (frame >= m_index.size())
+        {
+        m_exec_conf->msg->error() << m_fname << ": frame " << frame << " out of range, the file has "
+                                  << m_index.size() << " frames" << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+    }
+
+/*! \param frame Index of the frame
+    \returns The time step of the frame
+*/
+unsigned int CompressedTrajectoryReader::getTimeStep(unsigned int frame) const
+    {
+    checkFrame(frame);
+    return (unsigned int)m_index[frame].timestep;
+    }
+
+/*! \param frame Index of the frame
+    \param header Header of the frame (output)
+*/
+void CompressedTrajectoryReader::readFrameHeader(unsigned int frame, hct_frame_header& header) const
+    {
+    checkFrame(frame);
+
+    uint64_t offset = m_index[frame].offset;
+    bool valid = offset + sizeof(hct_frame_header) <= m_end_of_frames;
+    if (valid)
+        {
+        memcpy(&header, m_file->getData() + offset, sizeof(hct_frame_header));
+        valid = header.magic == HCT_FRAME_MAGIC
+                && header.payload_bytes <= m_end_of_frames - offset - sizeof(hct_frame_header);
+        }
+
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << m_fname << ": corrupt header of frame " << frame << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+    }
+
+/*! \param frame Index of the frame
+    \returns The simulation box of the frame
+*/
+BoxDim CompressedTrajectoryReader::getBox(unsigned int frame) const
+    {
+    hct_frame_header header;
+    readFrameHeader(frame, header);
+
+    BoxDim box(Scalar(header.box[0]), Scalar(header.box[1]), Scalar(header.box[2]));
+    box.setTiltFactors(Scalar(header.box[3]), Scalar(header.box[4]), Scalar(header.box[5]));
+    return box;
+    }
+
+/*! \param frame Index of the frame
+
+    Decoding continues from the last decoded frame when there is no keyframe in between, otherwise it starts at the
+    closest keyframe before \a frame.
+*/
+void CompressedTrajectoryReader::decodeFrame(unsigned int frame)
+    {
+    checkFrame(frame);
+
+    if (m_decoded_frame == int(frame))
+        return;
+
+    // find the closest keyframe
+    int start = int(frame);
+    while (start >= 0 && !(m_index[start].flags & HCT_KEYFRAME))
+        start--;
+
+    if (start < 0)
+        {
+        m_exec_conf->msg->error() << m_fname << ": no keyframe before frame " << frame << endl;
+        throw runtime_error("Error reading compressed trajectory file");
+        }
+
+    if (m_decoded_frame >= start && m_decoded_frame < int(frame))
+        start = m_decoded_frame + 1;
+
+    // the decoded positions are invalid until the loop completes
+    m_decoded_frame = -1;
+
+    for (unsigned int cur = start; cur <= frame; cur++)
+        {
+        hct_frame_header header;
+        readFrameHeader(cur, header);
+
+        // readFrameHeader() checked that the payload is inside the mapping
+        const unsigned char *payload = m_file->getData() + m_index[cur].offset + sizeof(hct_frame_header);
+        if (!hctDecodeFrame(payload, header.payload_bytes, m_header.N, header.flags & HCT_KEYFRAME, m_q))
+            {
+            m_exec_conf->msg->error() << m_fname << ": corrupt data in frame " << cur << endl;
+            throw runtime_error("Error reading compressed trajectory file");
+            }
+        }
+
+    m_decoded_frame = int(frame);
+    }
+
+/*! \param frame Index of the frame
+    \param pos Positions of the particles in the frame (output)
+*/
+void CompressedTrajectoryReader::readPositions(unsigned int frame, std::vector< vec3<double> >& pos)
+    {
+    decodeFrame(frame);
+
+    unsigned int N = m_header.N;
+    double precision = m_header.precision;
+    pos.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pos[i].x = m_q[i] * precision;
+        pos[i].y = m_q[N + i] * precision;
+        pos[i].z = m_q[2*N + i] * precision;
+        }
+    }
+
+/*! \param frame Index of the frame
+    \returns A new numpy array with the positions of the particles in the frame
+*/
+PyObject* CompressedTrajectoryReader::getPositionsNP(unsigned int frame)
+    {
+    std::vector< vec3<double> > pos;
+    readPositions(frame, pos);
+
+    std::vector<intp> dims(2);
+    dims[0] = pos.size();
+    dims[1] = 3;
+    if (pos.size() == 0)
+        return num_util::makeNum(dims, NPY_DOUBLE);
+    return num_util::makeNum((double*)&pos[0], dims);
+    }
+
+/*! \param frame Index of the frame, frames out of range are ignored
+
+    Prefetches the frame and, if it is not a keyframe, the frames back to the closest keyframe that decoding it needs.
+*/
+void CompressedTrajectoryReader::prefetch(unsigned int frame) const
+    {
+    if (frame >= m_index.size())
+        return;
+
+    int start = int(frame);
+    while (start > 0 && !(m_index[start].flags & HCT_KEYFRAME) && start > m_decoded_frame + 1)
+        start--;
+
+    uint64_t end = (frame + 1 < m_index.size()) ? m_index[frame+1].offset : m_end_of_frames;
+    m_file->prefetch(m_index[start].offset, end - m_index[start].offset);
+    }
+
+void export_CompressedTrajectoryReader()
+    {
+    class_< CompressedTrajectoryReader, boost::shared_ptr<CompressedTrajectoryReader>, boost::noncopyable >
+    ("CompressedTrajectoryReader", init<boost::shared_ptr<const ExecutionConfiguration>, const string&>())
+    .def("getNumFrames", &CompressedTrajectoryReader::getNumFrames)
+    .def("getN", &CompressedTrajectoryReader::getN)
+    .def("getPrecision", &CompressedTrajectoryReader::getPrecision)
+    .def("getTimeStep", &CompressedTrajectoryReader::getTimeStep)
+    .def("getBox", &CompressedTrajectoryReader::getBox)
+    .def("getPositionsNP", &CompressedTrajectoryReader::getPositionsNP)
+    .def("prefetch", &CompressedTrajectoryReader::prefetch)
+    ;
+    }
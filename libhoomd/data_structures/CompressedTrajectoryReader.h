@@ -0,0 +1,148 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file CompressedTrajectoryReader.h
+    \brief Declares the CompressedTrajectoryReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __COMPRESSED_TRAJECTORY_READER_H__
+#define __COMPRESSED_TRAJECTORY_READER_H__
+
+#include "ExecutionConfiguration.h"
+#include "BoxDim.h"
+#include "TrajectoryCodec.h"
+#include "MappedFile.h"
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <Python.h>
+
+//! Reads compressed trajectory files
+/*! CompressedTrajectoryReader reads the files written by CompressedDumpWriter (see \ref page_hct_format). The frame
+    table is read when the file is opened. Frames can be read in any order, reading a frame decodes all frames from
+    the closest keyframe before it. Reading the frames in sequence decodes every frame only once.
+
+    The file is mapped into memory (see MappedFile) and frames are decoded directly from the mapping.
+
+    \ingroup data_structs
+*/
+class CompressedTrajectoryReader : boost::noncopyable
+    {
+    public:
+        //! Open a file and read its frame table
+        CompressedTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &fname);
+
+        //! Get the number of frames in the file
+        unsigned int getNumFrames() const
+            {
+            return (unsigned int)m_index.size();
+            }
+
+        //! Get the number of particles in every frame
+        unsigned int getN() const
+            {
+            return m_header.N;
+            }
+
+        //! Get the quantization step of the positions
+        Scalar getPrecision() const
+            {
+            return Scalar(m_header.precision);
+            }
+
+        //! Get the time step of a frame
+        unsigned int getTimeStep(unsigned int frame) const;
+
+        //! Get the simulation box of a frame
+        BoxDim getBox(unsigned int frame) const;
+
+        //! Read the positions of a frame
+        void readPositions(unsigned int frame, std::vector< vec3<double> >& pos);
+
+        //! Read the positions of a frame into a N x 3 numpy array
+        PyObject* getPositionsNP(unsigned int frame);
+
+        //! Start reading a frame in the background
+        void prefetch(unsigned int frame) const;
+
+    private:
+        boost::shared_ptr<const ExecutionConfiguration> m_exec_conf;   //!< Messages are written through this
+        std::string m_fname;                    //!< Name of the file
+        boost::shared_ptr<MappedFile> m_file;   //!< The mapped file
+        hct_file_header m_header;               //!< Header of the file
+        std::vector<hct_index_entry> m_index;   //!< Frame table
+        uint64_t m_end_of_frames;               //!< File offset behind the last frame
+
+        std::vector<int> m_q;                   //!< Quantized positions of the last decoded frame
+        int m_decoded_frame;                    //!< Index of the last decoded frame, -1 if none
+
+        //! Check the frame index
+        void checkFrame(unsigned int frame) const;
+
+        //! Read the header of a frame
+        void readFrameHeader(unsigned int frame, hct_frame_header& header) const;
+
+        //! Decode a frame into m_q
+        void decodeFrame(unsigned int frame);
+    };
+
+//! Exports CompressedTrajectoryReader to python
+void export_CompressedTrajectoryReader();
+
+#endif
@@ -0,0 +1,312 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file DCDTrajectoryReader.cc
+    \brief Defines the DCDTrajectoryReader class
+*/
+
+#include "DCDTrajectoryReader.h"
+
+#include "num_util.h"
+
+#include <stdexcept>
+#include <string.h>
+
+#include <boost/python.hpp>
+using namespace boost::python;
+using namespace std;
+
+//! Size of the Fortran record markers around every block of a DCD file
+const uint64_t DCD_MARKER_BYTES = 4;
+
+//! Size of the unit cell block (6 doubles) of a frame
+const uint64_t DCD_UNITCELL_BYTES = 48;
+
+//! Helper function to read an integer at a file offset
+/*! \param data Start of the file
+    \param offset Offset of the integer
+*/
+static unsigned int read_int(const unsigned char *data, uint64_t offset)
+    {
+    unsigned int val;
+    memcpy(&val, data + offset, sizeof(unsigned int));
+    return val;
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname File to read
+*/
+DCDTrajectoryReader::DCDTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                         const std::string &fname)
+    : m_exec_conf(exec_conf), m_N(0), m_num_frames(0), m_start_timestep(0), m_period(0), m_first_frame(0),
+      m_frame_bytes(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DCDTrajectoryReader: " << fname << endl;
+
+    m_file = boost::shared_ptr<MappedFile>(new MappedFile(m_exec_conf->msg, fname));
+    const unsigned char *data = m_file->getData();
+    uint64_t size = m_file->getSize();
+
+    // the first record holds "CORD" and 20 control integers
+    if (size < 92 || read_int(data, 0) != 84 || memcmp(data + 4, "CORD", 4) != 0 || read_int(data, 88) != 84)
+        {
+        if (size >= 4 && read_int(data, 0) == 0x54000000)
+            m_exec_conf->msg->error() << fname << ": DCD files with a different byte order are not supported"
+                                      << endl;
+        else
+            m_exec_conf->msg->error() << fname << ": not a DCD file" << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+
+    unsigned int header_frames = read_int(data, 8);
+    m_start_timestep = read_int(data, 12);
+    m_period = read_int(data, 16);
+    bool has_unitcell = read_int(data, 48) != 0;
+    bool has_4d = read_int(data, 52) != 0;
+
+    if (!has_unitcell || has_4d)
+        {
+        m_exec_conf->msg->error() << fname << ": only DCD files with unit cell information and 3 dimensional "
+                                  << "coordinates (as written by dump.dcd) are supported" << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+
+    // skip the title record
+    uint64_t offset = 92;
+    if (size < offset + DCD_MARKER_BYTES)
+        {
+        m_exec_conf->msg->error() << fname << ": truncated DCD header" << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+    unsigned int title_bytes = read_int(data, offset);
+    offset += title_bytes + 2*DCD_MARKER_BYTES;
+
+    // the number of particles
+    if (size < offset + 12 || read_int(data, offset) != 4 || read_int(data, offset + 8) != 4)
+        {
+        m_exec_conf->msg->error() << fname << ": truncated DCD header" << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+    m_N = read_int(data, offset + 4);
+    m_first_frame = offset + 12;
+
+    // every frame is a unit cell block followed by the x, y and z blocks
+    m_frame_bytes = DCD_UNITCELL_BYTES + 2*DCD_MARKER_BYTES + 3*(uint64_t(m_N)*sizeof(float) + 2*DCD_MARKER_BYTES);
+    m_num_frames = (unsigned int)((size - m_first_frame) / m_frame_bytes);
+
+    if (m_num_frames < header_frames)
+        m_exec_conf->msg->warning() << fname << ": the header lists " << header_frames << " frames, but only "
+                                    << m_num_frames << " are complete" << endl;
+
+    m_exec_conf->msg->notice(3) << fname << ": " << m_num_frames << " frames of " << m_N << " particles" << endl;
+    }
+
+/*! \param frame Index of the frame
+    \returns The file offset of the frame
+*/
+uint64_t DCDTrajectoryReader::getFrameOffset(unsigned int frame) const
+    {
+    if (frame >= m_num_frames)
+        {
+        m_exec_conf->msg->error() << m_file->getName() << ": frame " << frame << " out of range, the file has "
+                                  << m_num_frames << " frames" << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+
+    return m_first_frame + uint64_t(frame)*m_frame_bytes;
+    }
+
+/*! \param frame Index of the frame
+    \param dim Direction (0, 1 or 2 for x, y and z)
+    \returns A pointer to the coordinates in the mapped file
+*/
+const float *DCDTrajectoryReader::getCoordinates(unsigned int frame, unsigned int dim) const
+    {
+    uint64_t offset = getFrameOffset(frame) + DCD_UNITCELL_BYTES + 2*DCD_MARKER_BYTES
+                      + dim*(uint64_t(m_N)*sizeof(float) + 2*DCD_MARKER_BYTES);
+
+    if (read_int(m_file->getData(), offset) != m_N*sizeof(float))
+        {
+        m_exec_conf->msg->error() << m_file->getName() << ": corrupt coordinates in frame " << frame << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+
+    return (const float *)(m_file->getData() + offset + DCD_MARKER_BYTES);
+    }
+
+/*! \param frame Index of the frame
+    \returns The time step of the frame
+*/
+unsigned int DCDTrajectoryReader::getTimeStep(unsigned int frame) const
+    {
+    getFrameOffset(frame);
+    return m_start_timestep + frame*m_period;
+    }
+
+/*! \param frame Index of the frame
+    \returns The simulation box of the frame
+
+    The unit cell of a frame holds the lengths a, b, c of the lattice vectors and the angles between them. DCDDumpWriter
+    and CHARMM store the cosines of the angles, other programs store the angles in degrees.
+*/
+BoxDim DCDTrajectoryReader::getBox(unsigned int frame) const
+    {
+    uint64_t offset = getFrameOffset(frame);
+    if (read_int(m_file->getData(), offset) != DCD_UNITCELL_BYTES)
+        {
+        m_exec_conf->msg->error() << m_file->getName() << ": corrupt unit cell in frame " << frame << endl;
+        throw runtime_error("Error reading DCD file");
+        }
+
+    double unitcell[6];
+    memcpy(unitcell, m_file->getData() + offset + DCD_MARKER_BYTES, DCD_UNITCELL_BYTES);
+    double a = unitcell[0];
+    double b = unitcell[2];
+    double c = unitcell[5];
+    double cos_gamma = unitcell[1];
+    double cos_beta = unitcell[3];
+    double cos_alpha = unitcell[4];
+
+    if (fabs(cos_alpha) > 1.0 || fabs(cos_beta) > 1.0 || fabs(cos_gamma) > 1.0)
+        {
+        cos_alpha = cos(cos_alpha*M_PI/180.0);
+        cos_beta = cos(cos_beta*M_PI/180.0);
+        cos_gamma = cos(cos_gamma*M_PI/180.0);
+        }
+
+    // lattice vectors a1 = (Lx, 0, 0), a2 = (xy Ly, Ly, 0), a3 = (xz Lz, yz Lz, Lz)
+    double bx = b*cos_gamma;
+    double Ly = sqrt(b*b - bx*bx);
+    double cx = c*cos_beta;
+    double cy = (b*c*cos_alpha - bx*cx)/Ly;
+    double Lz = sqrt(c*c - cx*cx - cy*cy);
+
+    BoxDim box = BoxDim(Scalar(a), Scalar(Ly), Scalar(Lz));
+    box.setTiltFactors(Scalar(bx/Ly), Scalar(cx/Lz), Scalar(cy/Lz));
+    return box;
+    }
+
+/*! \param frame Index of the frame
+    \returns A view of the frame
+*/
+DCDFrameView DCDTrajectoryReader::getFrame(unsigned int frame) const
+    {
+    DCDFrameView view;
+    view.timestep = getTimeStep(frame);
+    view.box = getBox(frame);
+    view.N = m_N;
+    view.x = getCoordinates(frame, 0);
+    view.y = getCoordinates(frame, 1);
+    view.z = getCoordinates(frame, 2);
+    return view;
+    }
+
+/*! \param frame Index of the frame, frames out of range are ignored
+*/
+void DCDTrajectoryReader::prefetch(unsigned int frame) const
+    {
+    if (frame < m_num_frames)
+        m_file->prefetch(getFrameOffset(frame), m_frame_bytes);
+    }
+
+//! Destructor of the capsule that keeps the mapping of a numpy array alive
+static void release_mapping(PyObject *capsule)
+    {
+    delete (boost::shared_ptr<MappedFile> *)PyCapsule_GetPointer(capsule, NULL);
+    }
+
+/*! \param frame Index of the frame
+    \returns A read only N x 3 numpy array of float32
+
+    The array refers to the coordinates in the mapped file, without a copy: the x, y and z blocks of a frame are
+    separated by a constant distance, which is the stride of the second dimension. The array keeps the mapping alive,
+    so it stays valid after the reader is deleted.
+*/
+PyObject* DCDTrajectoryReader::getPositionsNP(unsigned int frame) const
+    {
+    DCDFrameView view = getFrame(frame);
+
+    npy_intp dims[2] = {npy_intp(m_N), 3};
+    npy_intp strides[2] = {npy_intp(sizeof(float)), npy_intp((const char *)view.y - (const char *)view.x)};
+
+    PyObject *arr = PyArray_New(&PyArray_Type, 2, dims, NPY_FLOAT, strides, (void *)view.x, 0, 0, NULL);
+    if (!arr)
+        throw_error_already_set();
+
+    PyObject *capsule = PyCapsule_New(new boost::shared_ptr<MappedFile>(m_file), NULL, release_mapping);
+    if (!capsule)
+        {
+        Py_DECREF(arr);
+        throw_error_already_set();
+        }
+
+    // PyArray_SetBaseObject steals the reference to the capsule
+    if (PyArray_SetBaseObject((PyArrayObject *)arr, capsule) != 0)
+        {
+        Py_DECREF(arr);
+        throw_error_already_set();
+        }
+
+    return arr;
+    }
+
+void export_DCDTrajectoryReader()
+    {
+    class_< DCDTrajectoryReader, boost::shared_ptr<DCDTrajectoryReader>, boost::noncopyable >
+    ("DCDTrajectoryReader", init<boost::shared_ptr<const ExecutionConfiguration>, const string&>())
+    .def("getNumFrames", &DCDTrajectoryReader::getNumFrames)
+    .def("getN", &DCDTrajectoryReader::getN)
+    .def("getTimeStep", &DCDTrajectoryReader::getTimeStep)
+    .def("getBox", &DCDTrajectoryReader::getBox)
+    .def("prefetch", &DCDTrajectoryReader::prefetch)
+    .def("getPositionsNP", &DCDTrajectoryReader::getPositionsNP)
+    ;
+    }
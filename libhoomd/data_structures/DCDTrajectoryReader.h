@@ -0,0 +1,196 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file DCDTrajectoryReader.h
+    \brief Declares the DCDTrajectoryReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __DCD_TRAJECTORY_READER_H__
+#define __DCD_TRAJECTORY_READER_H__
+
+#include "ExecutionConfiguration.h"
+#include "ParticleData.h"
+#include "BoxDim.h"
+#include "MappedFile.h"
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <Python.h>
+
+//! A frame of a DCD file
+/*! The coordinate pointers point into the memory mapping of the file, they stay valid as long as the reader that
+    returned the view exists. Coordinates are in the order in which the particles were written (by tag for files
+    written by dump.dcd).
+*/
+struct DCDFrameView
+    {
+    unsigned int timestep;      //!< Time step of the frame
+    BoxDim box;                 //!< Simulation box of the frame
+    unsigned int N;             //!< Number of particles
+    const float *x;             //!< x coordinates of the particles
+    const float *y;             //!< y coordinates of the particles
+    const float *z;             //!< z coordinates of the particles
+    };
+
+//! Reads DCD files without copying the coordinates
+/*! DCDTrajectoryReader maps the file into memory (see MappedFile). All frames of a DCD file have the same size, so
+    any frame can be located directly from its index without reading the ones before it. getFrame() returns pointers to
+    the coordinates in the mapping, and getPositionsNP() wraps them in a read only numpy array. Pages of the file are
+    read when the coordinates are first accessed, so that the cost of analyzing a trajectory is bounded by the
+    bandwidth of the file system instead of parsing. Use prefetch() to start reading the next frame of a strided
+    iteration while the current one is processed.
+
+    Only files with unit cell information (as written by DCDDumpWriter) are supported. The number of frames is
+    determined from the size of the file, so an incomplete last frame of a simulation that did not end cleanly is
+    ignored.
+
+    \ingroup data_structs
+*/
+class DCDTrajectoryReader : boost::noncopyable
+    {
+    public:
+        //! Open a file and read its header
+        DCDTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &fname);
+
+        //! Get the number of frames in the file
+        unsigned int getNumFrames() const
+            {
+            return m_num_frames;
+            }
+
+        //! Get the number of particles in every frame
+        unsigned int getN() const
+            {
+            return m_N;
+            }
+
+        //! Get the time step of a frame
+        unsigned int getTimeStep(unsigned int frame) const;
+
+        //! Get the simulation box of a frame
+        BoxDim getBox(unsigned int frame) const;
+
+        //! Get a view of a frame
+        DCDFrameView getFrame(unsigned int frame) const;
+
+        //! Copy the positions of a frame into a snapshot
+        template<class Real>
+        void readSnapshot(unsigned int frame, SnapshotParticleData<Real>& snapshot) const;
+
+        //! Start reading a frame in the background
+        void prefetch(unsigned int frame) const;
+
+        //! Tell the operating system how the frames are going to be accessed
+        void setAccessPattern(MappedFile::accessPattern pattern)
+            {
+            m_file->setAccessPattern(pattern);
+            }
+
+        //! Get the positions of a frame as a read only N x 3 numpy array that refers to the file data
+        PyObject* getPositionsNP(unsigned int frame) const;
+
+    private:
+        boost::shared_ptr<const ExecutionConfiguration> m_exec_conf;   //!< Messages are written through this
+        boost::shared_ptr<MappedFile> m_file;   //!< The mapped file
+        unsigned int m_N;                       //!< Number of particles
+        unsigned int m_num_frames;              //!< Number of complete frames in the file
+        unsigned int m_start_timestep;          //!< Time step of the first frame
+        unsigned int m_period;                  //!< Number of time steps between frames
+        uint64_t m_first_frame;                 //!< File offset of the first frame
+        uint64_t m_frame_bytes;                 //!< Size of a frame in bytes
+
+        //! Get the file offset of a frame
+        uint64_t getFrameOffset(unsigned int frame) const;
+
+        //! Get the coordinate block of a frame
+        const float *getCoordinates(unsigned int frame, unsigned int dim) const;
+    };
+
+/*! \param frame Index of the frame
+    \param snapshot Snapshot to copy the positions to
+
+    The snapshot is resized to the number of particles in the file if necessary, fields other than the positions and
+    images are left untouched. Positions are wrapped back into the box of the frame and the images are set
+    accordingly, so that files written with unwrapped coordinates give the same snapshot as those without.
+*/
+template<class Real>
+void DCDTrajectoryReader::readSnapshot(unsigned int frame, SnapshotParticleData<Real>& snapshot) const
+    {
+    DCDFrameView view = getFrame(frame);
+
+    if (snapshot.size != view.N)
+        snapshot.resize(view.N);
+
+    for (unsigned int i = 0; i < view.N; i++)
+        {
+        Scalar3 p = make_scalar3(view.x[i], view.y[i], view.z[i]);
+
+        // the coordinates may be any number of images away from the box
+        int3 img = view.box.getImage(p);
+        p = view.box.shift(p, make_int3(-img.x, -img.y, -img.z));
+        view.box.wrap(p, img);
+
+        snapshot.pos[i] = vec3<Real>(p.x, p.y, p.z);
+        snapshot.image[i] = img;
+        }
+    }
+
+//! Exports DCDTrajectoryReader to python
+void export_DCDTrajectoryReader();
+
+#endif
@@ -103,6 +103,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
     if (!msg)
         msg = boost::shared_ptr<Messenger>(new Messenger());
 
+    m_host_arena.reset(new HostArena(msg));
+
     msg->notice(5) << "Constructing ExecutionConfiguration: " << gpu_id << " " << min_cpu << " " << ignore_display << endl;
     exec_mode = mode;
 
@@ -746,6 +748,7 @@ void export_ExecutionConfiguration()
                          .def("isCUDAEnabled", &ExecutionConfiguration::isCUDAEnabled)
                          .def("setCUDAErrorChecking", &ExecutionConfiguration::setCUDAErrorChecking)
                          .def("getGPUName", &ExecutionConfiguration::getGPUName)
+                         .def("setHostMemoryPolicy", &ExecutionConfiguration::setHostMemoryPolicy)
                          .def_readonly("n_cpu", &ExecutionConfiguration::n_cpu)
                          .def_readonly("msg", &ExecutionConfiguration::msg)
 #ifdef ENABLE_CUDA
@@ -770,6 +773,12 @@ void export_ExecutionConfiguration()
     .value("AUTO", ExecutionConfiguration::AUTO)
     ;
 
+    enum_<HostArena::hugePageMode>("hugePageMode")
+    .value("none", HostArena::no_huge_pages)
+    .value("transparent", HostArena::transparent_huge_pages)
+    .value("explicit", HostArena::explicit_huge_pages)
+    ;
+
     // allow classes to take shared_ptr<const ExecutionConfiguration> arguments
     implicitly_convertible<boost::shared_ptr<ExecutionConfiguration>, boost::shared_ptr<const ExecutionConfiguration> >();
     }
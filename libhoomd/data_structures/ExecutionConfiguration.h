@@ -59,6 +59,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #ifdef ENABLE_CUDA
 #include <cuda.h>
@@ -67,6 +68,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "Messenger.h"
+#include "HostArena.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -238,6 +240,23 @@ struct ExecutionConfiguration : boost::noncopyable
         }
     #endif
 
+    //! Returns the caching allocator for host memory
+    HostArena& getHostArena() const
+        {
+        return *m_host_arena;
+        }
+
+    //! Set the placement policy for large host arrays
+    /*! \param huge_pages Huge page mode
+        \param first_touch Set to true to let the OpenMP threads first touch the pages of large arrays
+
+        The policy applies to arrays allocated after the call. See HostArena for details.
+    */
+    void setHostMemoryPolicy(HostArena::hugePageMode huge_pages, bool first_touch)
+        {
+        m_host_arena->setPolicy(huge_pages, first_touch);
+        }
+
     #ifdef ENABLE_CUDA
     //! Returns the cached allocator for temporary allocations
     const CachedAllocator& getCachedAllocator() const
@@ -283,6 +302,8 @@ private:
 
     unsigned int m_rank;                   //!< Rank of this processor (0 if running in single-processor mode)
 
+    boost::scoped_ptr<HostArena> m_host_arena; //!< Caching allocator for host memory
+
     #ifdef ENABLE_CUDA
     CachedAllocator *m_cached_alloc;       //!< Cached allocator for temporary allocations
     #endif
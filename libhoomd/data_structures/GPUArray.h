@@ -371,6 +371,11 @@ template<class T> class GPUArray
         inline void memcpyHostToDevice(bool async) const;
 #endif
 
+        //! Helper function to allocate host memory
+        inline T* allocateHostMemory(unsigned int num_bytes);
+        //! Helper function to free host memory
+        inline void freeHostMemory(T *ptr);
+
         //! Helper function to resize host array
         inline T* resizeHostArray(unsigned int num_elements);
 
@@ -664,14 +669,7 @@ template<class T> void GPUArray<T>::allocate()
     assert(h_data == NULL);
 
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_data, 32, m_num_elements*sizeof(T));
-    if (retval != 0)
-        {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
-        }
+    h_data = allocateHostMemory(m_num_elements*sizeof(T));
 
 #ifdef ENABLE_CUDA
     assert(d_data == NULL);
@@ -725,7 +723,7 @@ template<class T> void GPUArray<T>::deallocate()
         }
 #endif
 
-    free(h_data);
+    freeHostMemory(h_data);
 
     // set pointers to NULL
     h_data = NULL;
@@ -991,6 +989,34 @@ template<class T> T* GPUArray<T>::aquire(const access_location::Enum location, c
         }
     }
 
+/*! \param num_bytes Number of bytes to allocate
+    \returns A pointer to host memory aligned to 32 bytes
+
+    Memory comes from the HostArena of the execution configuration, which reuses previously freed blocks.
+*/
+template<class T> T* GPUArray<T>::allocateHostMemory(unsigned int num_bytes)
+    {
+    if (m_exec_conf)
+        return (T *)m_exec_conf->getHostArena().allocate(num_bytes);
+
+    // at minimum, alignment needs to be 32 bytes for AVX
+    T *ptr = NULL;
+    int retval = posix_memalign((void**)&ptr, 32, num_bytes);
+    if (retval != 0)
+        throw std::runtime_error("Error allocating GPUArray.");
+    return ptr;
+    }
+
+/*! \param ptr Host memory obtained from allocateHostMemory()
+*/
+template<class T> void GPUArray<T>::freeHostMemory(T *ptr)
+    {
+    if (m_exec_conf)
+        m_exec_conf->getHostArena().deallocate(ptr);
+    else
+        free(ptr);
+    }
+
 /*! \post Memory on the host is resized, the newly allocated part of the array
  *        is reset to zero
  *! \returns a pointer to the newly allocated memory area
@@ -1000,19 +1026,19 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
     // if not allocated, do nothing
     if (isNull()) return NULL;
 
-    // allocate resized array
-    T *h_tmp = NULL;
-
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_tmp, 32, num_elements*sizeof(T));
-    if (retval != 0)
+    // without CUDA, keep the current block if it is large enough and not much too large
+    if (m_exec_conf && !m_exec_conf->isCUDAEnabled()
+        && m_exec_conf->getHostArena().fitsInPlace(h_data, num_elements*sizeof(T)))
         {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
+        // clear the newly exposed part of the array
+        if (num_elements > m_num_elements)
+            memset(h_data + m_num_elements, 0, sizeof(T)*(num_elements - m_num_elements));
+        return h_data;
         }
 
+    // allocate resized array
+    T *h_tmp = allocateHostMemory(num_elements*sizeof(T));
+
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
         {
@@ -1035,7 +1061,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
         }
 #endif
 
-    free(h_data);
+    freeHostMemory(h_data);
     h_data = h_tmp;
 
 #ifdef ENABLE_CUDA
@@ -1054,18 +1080,8 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
 template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned int new_pitch, unsigned int height, unsigned int new_height )
     {
     // allocate resized array
-    T *h_tmp = NULL;
-
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
     unsigned int size = new_pitch*new_height*sizeof(T);
-    int retval = posix_memalign((void**)&h_tmp, 32, size);
-    if (retval != 0)
-        {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
-        }
+    T *h_tmp = allocateHostMemory(size);
 
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1093,7 +1109,7 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
         }
 #endif
 
-    free(h_data);
+    freeHostMemory(h_data);
     h_data = h_tmp;
 
 #ifdef ENABLE_CUDA
@@ -1223,26 +1223,35 @@ void ParticleData::takeSnapshot(SnapshotParticleData<Real> &snapshot)
             unsigned int n_ranks = m_exec_conf->getNRanks();
             assert(rtag_map_proc.size() == n_ranks);
 
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
+            // create a single table of the rank and index of every particle, indexed by tag
+            // (the buffers are reused from the previous snapshot)
+            unsigned int ntags = getMaximumTag() + 1;
+            ScopedHostAllocation<unsigned int> tag_rank(m_exec_conf->getHostArena(), ntags);
+            ScopedHostAllocation<unsigned int> tag_idx(m_exec_conf->getHostArena(), ntags);
+            std::fill(tag_rank.data, tag_rank.data + ntags, NOT_LOCAL);
+
             std::map<unsigned int, unsigned int>::iterator it;
             for (unsigned int irank = 0; irank < n_ranks; ++irank)
                 for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::pair<unsigned int, std::pair<unsigned int, unsigned int> >(
-                        it->first, std::pair<unsigned int, unsigned int>(irank, it->second)));
+                    {
+                    tag_rank.data[it->first] = irank;
+                    tag_idx.data[it->first] = it->second;
+                    }
 
             // add particles to snapshot
             assert(m_tag_set.size() == getNGlobal());
             std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
 
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
             for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
                 {
                 unsigned int tag = *tag_set_it;
                 assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
 
-                if (rank_rtag_it == rank_rtag_map.end())
+                // rank contains the processor rank on which the particle was found
+                unsigned int rank = tag_rank.data[tag];
+                unsigned int idx = tag_idx.data[tag];
+
+                if (rank == NOT_LOCAL)
                     {
                     m_exec_conf->msg->error()
                         << endl << "Could not find particle " << tag << " on any processor. "
@@ -1250,11 +1259,6 @@ void ParticleData::takeSnapshot(SnapshotParticleData<Real> &snapshot)
                     throw std::runtime_error("Error gathering ParticleData");
                     }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
-
                 snapshot.pos[snap_id] = vec3<Real>(pos_proc[rank][idx]);
                 snapshot.vel[snap_id] = vec3<Real>(vel_proc[rank][idx]);
                 snapshot.accel[snap_id] = vec3<Real>(accel_proc[rank][idx]);
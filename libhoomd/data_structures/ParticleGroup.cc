@@ -64,6 +64,10 @@ using namespace boost;
 #include <iostream>
 using namespace std;
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /*! \file ParticleGroup.cc
     \brief Defines the ParticleGroup and related classes
 */
@@ -91,6 +95,24 @@ bool ParticleSelector::isSelected(unsigned int tag) const
     return false;
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+
+    The base class calls isSelected() for every local particle. Derived classes should override this method with a
+    direct loop over the particle data.
+*/
+void ParticleSelector::selectLocal(unsigned char *selected) const
+    {
+    unsigned int N = m_pdata->getN();
+    std::vector<unsigned int> tags(N);
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        std::copy(h_tag.data, h_tag.data + N, tags.begin());
+        }
+
+    for (unsigned int idx = 0; idx < N; idx++)
+        selected[idx] = isSelected(tags[idx]);
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleSelectorAll
 
@@ -110,6 +132,13 @@ bool ParticleSelectorAll::isSelected(unsigned int tag) const
     return m_pdata->isParticleLocal(tag);
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorAll::selectLocal(unsigned char *selected) const
+    {
+    memset(selected, 1, sizeof(unsigned char)*m_pdata->getN());
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleSelectorTag
 
@@ -143,6 +172,20 @@ bool ParticleSelectorTag::isSelected(unsigned int tag) const
     return (m_tag_min <= tag && tag <= m_tag_max);
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorTag::selectLocal(unsigned char *selected) const
+    {
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
+        {
+        unsigned int tag = h_tag.data[idx];
+        selected[idx] = (m_tag_min <= tag && tag <= m_tag_max);
+        }
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleSelectorType
 
@@ -190,6 +233,20 @@ bool ParticleSelectorType::isSelected(unsigned int tag) const
     return result;
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorType::selectLocal(unsigned char *selected) const
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
+        {
+        unsigned int typ = __scalar_as_int(h_postype.data[idx].w);
+        selected[idx] = (m_typ_min <= typ && typ <= m_typ_max);
+        }
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleSelectorRigid
 
@@ -222,6 +279,17 @@ bool ParticleSelectorRigid::isSelected(unsigned int tag) const
     return result;
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorRigid::selectLocal(unsigned char *selected) const
+    {
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
+        selected[idx] = ((h_body.data[idx] != NO_BODY) == m_rigid);
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleSelectorCuboid
 
@@ -266,6 +334,90 @@ bool ParticleSelectorCuboid::isSelected(unsigned int tag) const
     return result;
     }
 
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorCuboid::selectLocal(unsigned char *selected) const
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    #pragma omp parallel for schedule(static)
+    for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
+        {
+        Scalar4 postype = h_postype.data[idx];
+        selected[idx] = (m_min.x <= postype.x && postype.x < m_max.x &&
+                         m_min.y <= postype.y && postype.y < m_max.y &&
+                         m_min.z <= postype.z && postype.z < m_max.z);
+        }
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+// ParticleSelectorCombination
+
+/*! \param sysdef System the particles are to be selected from
+    \param a First selector
+    \param b Second selector
+    \param op Set operation to combine the selections with
+*/
+ParticleSelectorCombination::ParticleSelectorCombination(boost::shared_ptr<SystemDefinition> sysdef,
+                                                         boost::shared_ptr<ParticleSelector> a,
+                                                         boost::shared_ptr<ParticleSelector> b,
+                                                         Operation op)
+    : ParticleSelector(sysdef), m_a(a), m_b(b), m_op(op)
+    {
+    assert(m_a);
+    assert(m_b);
+    }
+
+/*! \param tag Tag of the particle to check
+    \returns true if the combination of both selections selects the particle
+*/
+bool ParticleSelectorCombination::isSelected(unsigned int tag) const
+    {
+    bool a = m_a->isSelected(tag);
+    bool b = m_b->isSelected(tag);
+
+    switch (m_op)
+        {
+        case set_union:
+            return a || b;
+        case set_intersection:
+            return a && b;
+        case set_difference:
+            return a && !b;
+        }
+    return false;
+    }
+
+/*! \param selected One byte per local particle index (output), set to 1 if the particle is selected
+*/
+void ParticleSelectorCombination::selectLocal(unsigned char *selected) const
+    {
+    int N = (int)m_pdata->getN();
+    std::vector<unsigned char> selected_b(N);
+
+    m_a->selectLocal(selected);
+    m_b->selectLocal(N ? &selected_b.front() : NULL);
+
+    switch (m_op)
+        {
+        case set_union:
+            #pragma omp parallel for schedule(static)
+            for (int idx = 0; idx < N; idx++)
+                selected[idx] = selected[idx] | selected_b[idx];
+            break;
+        case set_intersection:
+            #pragma omp parallel for schedule(static)
+            for (int idx = 0; idx < N; idx++)
+                selected[idx] = selected[idx] & selected_b[idx];
+            break;
+        case set_difference:
+            #pragma omp parallel for schedule(static)
+            for (int idx = 0; idx < N; idx++)
+                selected[idx] = selected[idx] & !selected_b[idx];
+            break;
+        }
+    }
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleGroup
 
@@ -406,13 +558,17 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         vector<unsigned int> member_tags;
 
             {
-            // loop through local particles and select those that match selection criterium
+            // evaluate the selection for all local particles at once
+            unsigned int N = m_pdata->getN();
+            std::vector<unsigned char> selected(N);
+            m_selector->selectLocal(N ? &selected.front() : NULL);
+
+            // collect the tags of the selected particles
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-            for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            for (unsigned int idx = 0; idx < N; ++idx)
                 {
-                unsigned int tag = h_tag.data[idx];
-                if (m_selector->isSelected(tag))
-                    member_tags.push_back(tag);
+                if (selected[idx])
+                    member_tags.push_back(h_tag.data[idx]);
                 }
             }
 
@@ -674,8 +830,10 @@ void ParticleGroup::buildTagHash() const
     // reset member ship flags
     memset(h_is_member_tag.data, 0, sizeof(unsigned char)*(m_pdata->getRTags().size()));
 
-    unsigned int num_members = m_member_tags.getNumElements();
-    for (unsigned int member = 0; member < num_members; member++)
+    // every member tag is distinct, so the loop can be split between threads
+    int num_members = m_member_tags.getNumElements();
+    #pragma omp parallel for schedule(static)
+    for (int member = 0; member < num_members; member++)
         {
         h_is_member_tag.data[h_member_tags.data[member]] = 1;
         }
@@ -707,16 +865,51 @@ void ParticleGroup::rebuildIndexList() const
         ArrayHandle<unsigned int> h_member_idx(m_member_idx, access_location::host, access_mode::readwrite);
         unsigned int nparticles = m_pdata->getN();
         unsigned int cur_member = 0;
-        for (unsigned int idx = 0; idx < nparticles; idx ++)
+
+        // every thread flags and compacts one contiguous range of indices, the compacted ranges are written one
+        // after the other so that the index list is in index order for any number of threads
+        #ifdef _OPENMP
+        std::vector<unsigned int> thread_members(omp_get_max_threads()+1, 0);
+        #else
+        std::vector<unsigned int> thread_members(2, 0);
+        #endif
+
+        #pragma omp parallel
             {
-            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned char is_member = h_is_member_tag.data[h_tag.data[idx]];
-            h_is_member.data[idx] =  is_member;
-            if (is_member)
+            unsigned int n_threads = 1;
+            unsigned int thread = 0;
+            #ifdef _OPENMP
+            n_threads = omp_get_num_threads();
+            thread = omp_get_thread_num();
+            #endif
+
+            unsigned int begin = (unsigned int)((unsigned long long)nparticles * thread / n_threads);
+            unsigned int end = (unsigned int)((unsigned long long)nparticles * (thread+1) / n_threads);
+
+            unsigned int n_members = 0;
+            for (unsigned int idx = begin; idx < end; idx++)
                 {
-                h_member_idx.data[cur_member] = idx;
-                cur_member++;
+                assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+                unsigned char is_member = h_is_member_tag.data[h_tag.data[idx]];
+                h_is_member.data[idx] = is_member;
+                n_members += is_member;
                 }
+            thread_members[thread+1] = n_members;
+
+            #pragma omp barrier
+
+            unsigned int offset = 0;
+            for (unsigned int i = 0; i <= thread; i++)
+                offset += thread_members[i];
+
+            for (unsigned int idx = begin; idx < end; idx++)
+                {
+                if (h_is_member.data[idx])
+                    h_member_idx.data[offset++] = idx;
+                }
+
+            if (thread == n_threads - 1)
+                cur_member = offset;
             }
 
         m_num_local_members = cur_member;
@@ -773,6 +966,8 @@ void export_ParticleGroup()
             .def("groupIntersection", &ParticleGroup::groupIntersection)
             .def("groupDifference", &ParticleGroup::groupDifference)
             .def("updateMemberTags", &ParticleGroup::updateMemberTags)
+            .def("getSelector", &ParticleGroup::getSelector)
+            .def("getUpdateTags", &ParticleGroup::getUpdateTags)
             ;
 
     class_<ParticleSelector, boost::shared_ptr<ParticleSelector>, boost::noncopyable>
@@ -799,4 +994,27 @@ void export_ParticleGroup()
     class_<ParticleSelectorCuboid, boost::shared_ptr<ParticleSelectorCuboid>, bases<ParticleSelector>, boost::noncopyable>
         ("ParticleSelectorCuboid", init< boost::shared_ptr<SystemDefinition>, Scalar3, Scalar3 >())
         ;
+
+    class_<ParticleSelectorCombination, boost::shared_ptr<ParticleSelectorCombination>, bases<ParticleSelector>,
+           boost::noncopyable>
+        ("ParticleSelectorCombination", no_init)
+        ;
+
+    class_<ParticleSelectorUnion, boost::shared_ptr<ParticleSelectorUnion>, bases<ParticleSelectorCombination>,
+           boost::noncopyable>
+        ("ParticleSelectorUnion", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<ParticleSelector>,
+                                        boost::shared_ptr<ParticleSelector> >())
+        ;
+
+    class_<ParticleSelectorIntersection, boost::shared_ptr<ParticleSelectorIntersection>,
+           bases<ParticleSelectorCombination>, boost::noncopyable>
+        ("ParticleSelectorIntersection", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<ParticleSelector>,
+                                               boost::shared_ptr<ParticleSelector> >())
+        ;
+
+    class_<ParticleSelectorDifference, boost::shared_ptr<ParticleSelectorDifference>,
+           bases<ParticleSelectorCombination>, boost::noncopyable>
+        ("ParticleSelectorDifference", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<ParticleSelector>,
+                                             boost::shared_ptr<ParticleSelector> >())
+        ;
     }
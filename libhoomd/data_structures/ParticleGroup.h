@@ -82,6 +82,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
     In parallel simulations, isSelected() should return false if the requested particle with tag 'tag' is not local.
 
+    ParticleGroup does not call isSelected() for every particle. It calls selectLocal() once, which evaluates the
+    selection for all local particles at once. The base class implementation falls back to isSelected(), derived
+    classes override it with a loop over the particle data arrays that has no virtual calls and no tag lookups.
+
     The base class isSelected() method will simply reject all particles. Derived classes will implement specific
     selection semantics.
 */
@@ -95,6 +99,9 @@ class ParticleSelector
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
 
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
+
     protected:
         boost::shared_ptr<SystemDefinition> m_sysdef;   //!< The system definition assigned to this selector
         boost::shared_ptr<ParticleData> m_pdata;        //!< The particle data from m_sysdef, stored as a convenience
@@ -111,6 +118,9 @@ class ParticleSelectorAll : public ParticleSelector
 
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
     };
 
 
@@ -124,6 +134,9 @@ class ParticleSelectorTag : public ParticleSelector
 
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
     protected:
         unsigned int m_tag_min;     //!< Minimum tag to select
         unsigned int m_tag_max;     //!< Maximum tag to select (inclusive)
@@ -139,6 +152,9 @@ class ParticleSelectorType : public ParticleSelector
 
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
     protected:
         unsigned int m_typ_min;     //!< Minimum type to select
         unsigned int m_typ_max;     //!< Maximum type to select (inclusive)
@@ -154,6 +170,9 @@ class ParticleSelectorCuboid : public ParticleSelector
 
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
     protected:
         Scalar3 m_min;     //!< Minimum type to select (inclusive)
         Scalar3 m_max;     //!< Maximum type to select (exclusive)
@@ -169,10 +188,83 @@ class ParticleSelectorRigid : public ParticleSelector
 
         //! Test if a particle meets the selection criteria
         virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
     protected:
         bool m_rigid;   //!< true if we should select rigid boides, false if we should select non-rigid particles
     };
 
+//! Base class for selectors that combine two other selectors
+/*! The two selections are evaluated over all local particles and combined element by element in a single pass, so
+    nested combinations still need only one selectLocal() call per leaf selector.
+*/
+class ParticleSelectorCombination : public ParticleSelector
+    {
+    public:
+        //! Set operation to combine the selections with
+        enum Operation
+            {
+            set_union,
+            set_intersection,
+            set_difference
+            };
+
+        //! Constructs the selector
+        ParticleSelectorCombination(boost::shared_ptr<SystemDefinition> sysdef,
+                                    boost::shared_ptr<ParticleSelector> a,
+                                    boost::shared_ptr<ParticleSelector> b,
+                                    Operation op);
+        virtual ~ParticleSelectorCombination() {}
+
+        //! Test if a particle meets the selection criteria
+        virtual bool isSelected(unsigned int tag) const;
+
+        //! Test all local particles
+        virtual void selectLocal(unsigned char *selected) const;
+
+    protected:
+        boost::shared_ptr<ParticleSelector> m_a;    //!< First selector
+        boost::shared_ptr<ParticleSelector> m_b;    //!< Second selector
+        Operation m_op;                             //!< Set operation
+    };
+
+//! Select particles that are selected by either of two selectors
+class ParticleSelectorUnion : public ParticleSelectorCombination
+    {
+    public:
+        //! Constructs the selector
+        ParticleSelectorUnion(boost::shared_ptr<SystemDefinition> sysdef,
+                              boost::shared_ptr<ParticleSelector> a,
+                              boost::shared_ptr<ParticleSelector> b)
+            : ParticleSelectorCombination(sysdef, a, b, set_union)
+            { }
+    };
+
+//! Select particles that are selected by both of two selectors
+class ParticleSelectorIntersection : public ParticleSelectorCombination
+    {
+    public:
+        //! Constructs the selector
+        ParticleSelectorIntersection(boost::shared_ptr<SystemDefinition> sysdef,
+                                     boost::shared_ptr<ParticleSelector> a,
+                                     boost::shared_ptr<ParticleSelector> b)
+            : ParticleSelectorCombination(sysdef, a, b, set_intersection)
+            { }
+    };
+
+//! Select particles that are selected by the first but not by the second selector
+class ParticleSelectorDifference : public ParticleSelectorCombination
+    {
+    public:
+        //! Constructs the selector
+        ParticleSelectorDifference(boost::shared_ptr<SystemDefinition> sysdef,
+                                   boost::shared_ptr<ParticleSelector> a,
+                                   boost::shared_ptr<ParticleSelector> b)
+            : ParticleSelectorCombination(sysdef, a, b, set_difference)
+            { }
+    };
+
 //! Describes a group of particles
 /*! \b Overview
 
@@ -304,6 +396,20 @@ class ParticleGroup
             return h_handle.data[idx] == 1;
             }
 
+        //! Get the selector the group was built from
+        /*! \returns The selector, or a null pointer if the group was built from a list of tags
+        */
+        boost::shared_ptr<ParticleSelector> getSelector() const
+            {
+            return m_selector;
+            }
+
+        //! Test if the group updates its members when particles are added or removed
+        bool getUpdateTags() const
+            {
+            return m_update_tags;
+            }
+
         //! Direct access to the index list
         /*! \returns A GPUArray for directly accessing the index list, intended for use in using groups on the GPU
             \note The caller \b must \b not write to or change the array.
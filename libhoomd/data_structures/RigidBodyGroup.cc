@@ -51,6 +51,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "RigidBodyGroup.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 #include <vector>
 using namespace std;
 
@@ -98,6 +102,13 @@ RigidBodyGroup::RigidBodyGroup(boost::shared_ptr<SystemDefinition> sysdef, boost
 
     }
 
+#ifdef ENABLE_MPI
+    // with domain decomposition, the group only contains the local particles of a body
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &particle_count.front(), m_rdata->getNumBodies(), MPI_UNSIGNED, MPI_SUM,
+            m_exec_conf->getMPICommunicator());
+#endif
+
     // validate that all bodies are completely selected
     // also count up the number of selected bodies
     unsigned int n_selected_bodies = 0;
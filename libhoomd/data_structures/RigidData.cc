@@ -61,6 +61,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <math.h>
 #include <boost/python.hpp>
 #include <algorithm>
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#include <climits>
+#include <map>
+#include <string.h>
+#endif
 using namespace boost::python;
 
 using namespace boost;
@@ -77,7 +84,7 @@ using namespace std;
     \post All data members in RigidData are completely initialized from the given info in \a particle_data
 */
 RigidData::RigidData(boost::shared_ptr<ParticleData> particle_data)
-    : m_pdata(particle_data), m_n_bodies(0), m_ndof(0)
+    : m_pdata(particle_data), m_n_bodies(0), m_ndof(0), m_nglobal(0)
     {
     // leave arrays initialized to NULL. There are currently 0 bodies and their
     // initialization is delayed because we cannot reasonably determine when that initialization
@@ -100,10 +107,9 @@ RigidData::~RigidData()
     }
 
 
-/*! \pre m_body_size has been filled with values
-    \pre m_particle_tags has been filled with values
-    \pre m_particle_indices has been allocated
-    \post m_particle_indices is updated to match the current sorting of the particle data
+/*! \pre m_body_offset and m_body_particle_tags have been filled with values
+    \post m_body_particle_indices (and m_particle_indices, if allocated) are updated to match the current sorting
+          of the particle data
 */
 void RigidData::recalcIndices()
     {
@@ -112,47 +118,68 @@ void RigidData::recalcIndices()
 
     // sanity check
     assert(m_pdata);
-    assert(!m_particle_tags.isNull());
-    assert(!m_particle_indices.isNull());
-//  assert(m_n_bodies <= m_particle_tags.getPitch());
-//  assert(m_n_bodies <= m_particle_indices.getPitch());
-//  printf("m_n_bodies = %d; particle tags pitch = %d\n", m_n_bodies, m_particle_tags.getPitch());
-
+    assert(!m_body_particle_tags.isNull());
+    assert(!m_body_particle_indices.isNull());
     assert(m_n_bodies == m_body_size.getNumElements());
 
+    unsigned int nparticles = m_pdata->getN();
+    unsigned int n_body_particles = m_body_particle_tags.getNumElements();
+
+    // the padded arrays are only kept for the GPU code
+    bool padded = !m_particle_indices.isNull();
+
+    // with domain decomposition, the number of local particles changes when particles migrate
+    if (padded && m_particle_offset.getNumElements() < nparticles)
+        m_particle_offset.resize(nparticles);
+
+    if (m_rigid_particle_indices.getNumElements() < n_body_particles)
+        m_rigid_particle_indices.resize(n_body_particles);
+
     // get the particle data
     ArrayHandle< unsigned int > h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     // get all the rigid data we need
-    ArrayHandle<unsigned int> tags(m_particle_tags, access_location::host, access_mode::read);
-    unsigned int tags_pitch = m_particle_tags.getPitch();
-
-    ArrayHandle<unsigned int> indices(m_particle_indices, access_location::host, access_mode::readwrite);
-    unsigned int indices_pitch = m_particle_indices.getPitch();
+    ArrayHandle<unsigned int> h_body_offset(m_body_offset, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_tags(m_body_particle_tags, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(m_body_particle_indices, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> rigid_particle_indices(m_rigid_particle_indices, access_location::host, access_mode::readwrite);
 
+    // translate the tags to the current indices
+    unsigned int ridx = 0;
+    for (unsigned int k = 0; k < n_body_particles; k++)
+        {
+        unsigned int pidx = h_rtag.data[h_body_tags.data[k]];
 
-    ArrayHandle<unsigned int> body_size(m_body_size, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_particle_offset(m_particle_offset, access_location::host, access_mode::readwrite);
+        // particles owned by another rank (or present only as ghosts) are not integrated here
+        if (pidx >= nparticles)
+            pidx = NO_INDEX;
+        else
+            rigid_particle_indices.data[ridx++] = pidx;
 
-    // for each body
-    unsigned int ridx = 0;
-    for (unsigned int body = 0; body < m_n_bodies; body++)
+        h_body_indices.data[k] = pidx;
+        }
+
+    m_num_particles = ridx;
+
+    if (padded)
         {
-        // for each particle in this body
-        unsigned int len = body_size.data[body];
-        assert(body <= m_particle_tags.getHeight() && body <= m_particle_indices.getHeight());
-        assert(len <= tags_pitch && len <= indices_pitch);
+        // mirror the indices into the padded layout
+        ArrayHandle<unsigned int> indices(m_particle_indices, access_location::host, access_mode::readwrite);
+        unsigned int indices_pitch = m_particle_indices.getPitch();
+        ArrayHandle<unsigned int> h_particle_offset(m_particle_offset, access_location::host, access_mode::readwrite);
 
-        for (unsigned int i = 0; i < len; i++)
+        for (unsigned int body = 0; body < m_n_bodies; body++)
             {
-            // translate the tag to the current index
-            unsigned int tag = tags.data[body*tags_pitch + i];
-            unsigned int pidx = h_rtag.data[tag];
-            indices.data[body*indices_pitch + i] = pidx;
-            h_particle_offset.data[pidx] = i;
+            unsigned int start = h_body_offset.data[body];
+            assert(h_body_offset.data[body+1] - start <= indices_pitch);
 
-            rigid_particle_indices.data[ridx++] = pidx;
+            for (unsigned int k = start; k < h_body_offset.data[body+1]; k++)
+                {
+                unsigned int pidx = h_body_indices.data[k];
+                indices.data[body*indices_pitch + k - start] = pidx;
+                if (pidx != NO_INDEX)
+                    h_particle_offset.data[pidx] = k - start;
+                }
             }
         }
 
@@ -188,7 +215,21 @@ void RigidData::initializeData()
     ArrayHandle< unsigned int > h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_p_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-    BoxDim box = m_pdata->getBox();
+    ArrayHandle<Scalar3> h_p_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+    // positions are stored in global coordinates, also with domain decomposition
+    BoxDim box = m_pdata->getGlobalBox();
+
+    bool distributed = false;
+#ifdef ENABLE_MPI
+    // with domain decomposition, every rank holds the complete rigid body data and the contributions of
+    // the constituent particles are summed up over all ranks
+    distributed = m_pdata->getDomainDecomposition();
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+#endif
+
+    // the data may be re-initialized, e.g. after the particles have been distributed
+    m_ndof = 0;
 
     // determine the number of rigid bodies
     unsigned int maxbody = 0;
@@ -207,6 +248,17 @@ void RigidData::initializeData()
             }
         }
 
+#ifdef ENABLE_MPI
+    if (distributed)
+        {
+        int found = found_body ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_LOR, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &maxbody, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &minbody, 1, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+        found_body = found;
+        }
+#endif
+
     if (found_body)
         {
         m_n_bodies = maxbody + 1;   // h_body.data[j] is numbered from 0
@@ -243,8 +295,6 @@ void RigidData::initializeData()
     GPUArray<Scalar4> force(m_n_bodies, m_pdata->getExecConf());
     GPUArray<Scalar4> torque(m_n_bodies, m_pdata->getExecConf());
 
-    GPUArray<unsigned int> particle_offset(m_pdata->getN(), m_pdata->getExecConf());
-
     m_body_dof.swap(body_dof);
     m_body_mass.swap(body_mass);
     m_body_size.swap(body_size);
@@ -263,7 +313,7 @@ void RigidData::initializeData()
     m_force.swap(force);
     m_torque.swap(torque);
 
-    m_particle_offset.swap(particle_offset);
+    m_nglobal = m_pdata->getNGlobal();
 
     {
     // determine the largest size of rigid bodies (nmax)
@@ -278,12 +328,26 @@ void RigidData::initializeData()
             body_size_handle.data[body]++;
         }
 
+#ifdef ENABLE_MPI
+    if (distributed)
+        MPI_Allreduce(MPI_IN_PLACE, body_size_handle.data, m_n_bodies, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+#endif
+
     // determine the maximum number of particles in a rigid body
     m_nmax = 0;
     for (unsigned int body = 0; body < m_n_bodies; body++)
         if (m_nmax < body_size_handle.data[body])
             m_nmax = body_size_handle.data[body];
 
+    // the constituents of body i are stored at [body_offset[i], body_offset[i+1]) in the compact arrays
+    GPUArray<unsigned int> body_offset(m_n_bodies+1, m_pdata->getExecConf());
+    m_body_offset.swap(body_offset);
+    ArrayHandle<unsigned int> h_body_offset(m_body_offset, access_location::host, access_mode::overwrite);
+    h_body_offset.data[0] = 0;
+    for (unsigned int body = 0; body < m_n_bodies; body++)
+        h_body_offset.data[body+1] = h_body_offset.data[body] + body_size_handle.data[body];
+    unsigned int n_body_particles = h_body_offset.data[m_n_bodies];
+
     // determine body_mass, inertia tensor, com and vel
     GPUArray<Scalar> inertia(6, m_n_bodies, m_pdata->getExecConf()); // the inertia tensor is symmetric, therefore we only need to store 6 elements
     ArrayHandle<Scalar> inertia_handle(inertia, access_location::host, access_mode::readwrite);
@@ -328,6 +392,25 @@ void RigidData::initializeData()
             nominal_body_image[body] = h_image.data[j];
         }
 
+#ifdef ENABLE_MPI
+    if (distributed)
+        {
+        // agree on one image per body, bodies without local particles do not contribute
+        std::vector<int> image_buf(3*m_n_bodies, INT_MAX);
+        for (unsigned int j = 0; j < nparticles; j++)
+            {
+            unsigned int body = h_body.data[j];
+            if (body == NO_BODY) continue;
+            image_buf[3*body] = nominal_body_image[body].x;
+            image_buf[3*body+1] = nominal_body_image[body].y;
+            image_buf[3*body+2] = nominal_body_image[body].z;
+            }
+        MPI_Allreduce(MPI_IN_PLACE, &image_buf.front(), 3*m_n_bodies, MPI_INT, MPI_MIN, mpi_comm);
+        for (unsigned int body = 0; body < m_n_bodies; body++)
+            nominal_body_image[body] = make_int3(image_buf[3*body], image_buf[3*body+1], image_buf[3*body+2]);
+        }
+#endif
+
     // compute the center of mass for each body by summing up mass * \vec{r} for each particle in the body
     ArrayHandle< Scalar4 > h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     for (unsigned int j = 0; j < m_pdata->getN(); j++)
@@ -349,6 +432,14 @@ void RigidData::initializeData()
         com_handle.data[body].z += mass_one * unwrapped.z;
         }
 
+#ifdef ENABLE_MPI
+    if (distributed)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, body_mass_handle.data, m_n_bodies, MPI_HOOMD_SCALAR, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, com_handle.data, 4*m_n_bodies, MPI_HOOMD_SCALAR, MPI_SUM, mpi_comm);
+        }
+#endif
+
     // complete the COM calculation by dividing by the mass of the body
     // for the moment, this is left in nominal unwrapped coordinates (it may be slightly outside the box) to enable
     // computation of the moment of inertia. This will be corrected after the moment of inertia is computed.
@@ -378,7 +469,6 @@ void RigidData::initializeData()
 
         unsigned int body = h_body.data[j];
         Scalar mass_one = h_vel.data[j].w;
-        unsigned int tag = h_tag.data[j];
 
         // unwrap all particles in a body to the same image
         int3 shift = make_int3(h_image.data[j].x - nominal_body_image[body].x,
@@ -401,7 +491,7 @@ void RigidData::initializeData()
         // take into account the partile inertia moments
         // get the original particle orientation and inertia tensor from input
         porientation = h_p_orientation.data[j];
-        pinertia = m_pdata->getMomentsOfInertia(tag);
+        pinertia = h_p_inertia.data[j];
 
         exyzFromQuaternion(porientation, ex, ey, ez);
 
@@ -436,6 +526,11 @@ void RigidData::initializeData()
         inertia_handle.data[inertia_pitch * body + 5] += Ispace[0][2];
         }
 
+#ifdef ENABLE_MPI
+    if (distributed)
+        MPI_Allreduce(MPI_IN_PLACE, inertia_handle.data, inertia_pitch*m_n_bodies, MPI_HOOMD_SCALAR, MPI_SUM, mpi_comm);
+#endif
+
     // allocate temporary arrays: revision needed!
     Scalar **matrix, *evalues, **evectors;
     matrix = new Scalar*[3];
@@ -527,57 +622,76 @@ void RigidData::initializeData()
     delete [] matrix;
 
 
-    // allocate nmax by m_n_bodies arrays, swap to member variables then use array handles to access
-    GPUArray<unsigned int> particle_tags(m_nmax, m_n_bodies,  m_pdata->getExecConf());
-    m_particle_tags.swap(particle_tags);
-    ArrayHandle<unsigned int> particle_tags_handle(m_particle_tags, access_location::host, access_mode::readwrite);
-    unsigned int particle_tags_pitch = m_particle_tags.getPitch();
-
-    GPUArray<unsigned int> particle_indices(m_nmax, m_n_bodies, m_pdata->getExecConf());
-    m_particle_indices.swap(particle_indices);
-    ArrayHandle<unsigned int> particle_indices_handle(m_particle_indices, access_location::host, access_mode::readwrite);
-    unsigned int particle_indices_pitch = m_particle_indices.getPitch();
+    // allocate the compact per-constituent arrays, swap to member variables then use array handles to access
+    GPUArray<unsigned int> body_particle_tags(n_body_particles, m_pdata->getExecConf());
+    m_body_particle_tags.swap(body_particle_tags);
+    ArrayHandle<unsigned int> h_body_tags(m_body_particle_tags, access_location::host, access_mode::overwrite);
 
-    for (unsigned int j = 0; j < m_n_bodies; j++)
-        for (unsigned int local = 0; local < particle_indices_pitch; local++)
-            particle_indices_handle.data[j * particle_indices_pitch + local] = NO_INDEX; // initialize with a sentinel value
+    GPUArray<unsigned int> body_particle_indices(n_body_particles, m_pdata->getExecConf());
+    m_body_particle_indices.swap(body_particle_indices);
 
-    GPUArray<Scalar4> particle_pos(m_nmax, m_n_bodies, m_pdata->getExecConf());
-    m_particle_pos.swap(particle_pos);
-    ArrayHandle<Scalar4> particle_pos_handle(m_particle_pos, access_location::host, access_mode::readwrite);
-    unsigned int particle_pos_pitch = m_particle_pos.getPitch();
+    GPUArray<Scalar4> body_particle_pos(n_body_particles, m_pdata->getExecConf());
+    m_body_particle_pos.swap(body_particle_pos);
+    ArrayHandle<Scalar4> h_body_pos(m_body_particle_pos, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> particle_orientation(m_nmax, m_n_bodies, m_pdata->getExecConf());
-    m_particle_orientation.swap(particle_orientation);
-    ArrayHandle<Scalar4> h_particle_orientation(m_particle_orientation, access_location::host, access_mode::readwrite);
+    GPUArray<Scalar4> body_particle_orientation(n_body_particles, m_pdata->getExecConf());
+    m_body_particle_orientation.swap(body_particle_orientation);
+    ArrayHandle<Scalar4> h_body_orientation(m_body_particle_orientation, access_location::host, access_mode::readwrite);
 
     GPUArray<unsigned int> local_indices(m_n_bodies, m_pdata->getExecConf());
     ArrayHandle<unsigned int> local_indices_handle(local_indices, access_location::host, access_mode::readwrite);
     for (unsigned int body = 0; body < m_n_bodies; body++)
         local_indices_handle.data[body] = 0;
 
-    // Now set the m_nmax according to the actual pitches to avoid dublicating rounding up (e.g. if m_nmax is rounded up to 16 here,
-    // then in the GPUArray constructor the pitch is rounded up once more to be 32.
-    m_nmax = particle_tags_pitch;
+#ifdef ENABLE_MPI
+    // the particles of a body are spread over several ranks, number them globally by ascending tag
+    std::map<unsigned int, unsigned int> global_localidx;
+    if (distributed)
+        {
+        memset(h_body_pos.data, 0, sizeof(Scalar4)*n_body_particles);
+        memset(h_body_orientation.data, 0, sizeof(Scalar4)*n_body_particles);
+
+        std::vector<uint2> local_members;
+        for (unsigned int j = 0; j < nparticles; j++)
+            if (h_body.data[j] != NO_BODY)
+                local_members.push_back(make_uint2(h_body.data[j], h_tag.data[j]));
+
+        std::vector< std::vector<uint2> > members_proc;
+        all_gather_v(local_members, members_proc, mpi_comm);
 
-    //tally up how many particles belong to rigid bodies
-    unsigned int rigid_particle_count = 0;
+        std::vector< std::pair<unsigned int, unsigned int> > members;
+        for (unsigned int i = 0; i < members_proc.size(); i++)
+            for (unsigned int k = 0; k < members_proc[i].size(); k++)
+                members.push_back(std::make_pair(members_proc[i][k].x, members_proc[i][k].y));
+        std::sort(members.begin(), members.end());
 
-    // determine the particle indices and particle tags
+        for (unsigned int k = 0; k < members.size(); k++)
+            {
+            unsigned int body = members[k].first;
+            unsigned int current_localidx = local_indices_handle.data[body]++;
+            h_body_tags.data[h_body_offset.data[body] + current_localidx] = members[k].second;
+            global_localidx[members[k].second] = current_localidx;
+            }
+        }
+#endif
+
+    // determine the particle tags and the body frame positions and orientations
     for (unsigned int j = 0; j < m_pdata->getN(); j++)
         {
         if (h_body.data[j] == NO_BODY) continue;
 
-        rigid_particle_count++;
-
         // get the corresponding body
         unsigned int body = h_body.data[j];
         // get the current index in the body
         unsigned int current_localidx = local_indices_handle.data[body];
-        // set the particle index to be this value
-        particle_indices_handle.data[body * particle_indices_pitch + current_localidx] = j;
+#ifdef ENABLE_MPI
+        if (distributed)
+            current_localidx = global_localidx[h_tag.data[j]];
+#endif
+        unsigned int idx = h_body_offset.data[body] + current_localidx;
+
         // set the particle tag to be the tag of this particle
-        particle_tags_handle.data[body * particle_tags_pitch + current_localidx] = h_tag.data[j];
+        h_body_tags.data[idx] = h_tag.data[j];
 
         // determine the particle position in the body frame
         // with ex_space, ey_space and ex_space vectors computed from the diagonalization
@@ -592,25 +706,91 @@ void RigidData::initializeData()
         Scalar dy = unwrapped.y - com_handle.data[body].y;
         Scalar dz = unwrapped.z - com_handle.data[body].z;
 
-        unsigned int idx = body * particle_pos_pitch + current_localidx;
-        particle_pos_handle.data[idx].x = dx * ex_space_handle.data[body].x + dy * ex_space_handle.data[body].y +
+        h_body_pos.data[idx].x = dx * ex_space_handle.data[body].x + dy * ex_space_handle.data[body].y +
                 dz * ex_space_handle.data[body].z;
-        particle_pos_handle.data[idx].y = dx * ey_space_handle.data[body].x + dy * ey_space_handle.data[body].y +
+        h_body_pos.data[idx].y = dx * ey_space_handle.data[body].x + dy * ey_space_handle.data[body].y +
                 dz * ey_space_handle.data[body].z;
-        particle_pos_handle.data[idx].z = dx * ez_space_handle.data[body].x + dy * ez_space_handle.data[body].y +
+        h_body_pos.data[idx].z = dx * ez_space_handle.data[body].x + dy * ez_space_handle.data[body].y +
                 dz * ez_space_handle.data[body].z;
+        h_body_pos.data[idx].w = Scalar(0.0);
 
-        // initialize h_particle_orientation.data[idx] here from the initial particle orientation. This means
+        // initialize h_body_orientation.data[idx] here from the initial particle orientation. This means
         // reading the intial particle orientation from ParticleData and translating it backwards into the body frame
         Scalar4 qc;
         quatconj(orientation_handle.data[body], qc);
 
         porientation = h_p_orientation.data[j];
-        quatquat(qc, porientation, h_particle_orientation.data[idx]);
-        normalize(h_particle_orientation.data[idx]);
+        quatquat(qc, porientation, h_body_orientation.data[idx]);
+        normalize(h_body_orientation.data[idx]);
 
         // increment the current index by one
-        local_indices_handle.data[body]++;
+        if (!distributed)
+            local_indices_handle.data[body]++;
+        }
+
+#ifdef ENABLE_MPI
+    if (distributed)
+        {
+        // every body frame position and orientation has been set by exactly one rank
+        MPI_Allreduce(MPI_IN_PLACE, h_body_pos.data, 4*n_body_particles, MPI_HOOMD_SCALAR, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, h_body_orientation.data, 4*n_body_particles, MPI_HOOMD_SCALAR, MPI_SUM, mpi_comm);
+        }
+#endif
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // the GPU kernels process one body per thread block and use the nmax by m_n_bodies padded layout
+        GPUArray<unsigned int> particle_tags(m_nmax, m_n_bodies,  m_pdata->getExecConf());
+        m_particle_tags.swap(particle_tags);
+        ArrayHandle<unsigned int> particle_tags_handle(m_particle_tags, access_location::host, access_mode::readwrite);
+        unsigned int particle_tags_pitch = m_particle_tags.getPitch();
+
+        GPUArray<unsigned int> particle_indices(m_nmax, m_n_bodies, m_pdata->getExecConf());
+        m_particle_indices.swap(particle_indices);
+        ArrayHandle<unsigned int> particle_indices_handle(m_particle_indices, access_location::host, access_mode::readwrite);
+        unsigned int particle_indices_pitch = m_particle_indices.getPitch();
+
+        GPUArray<Scalar4> particle_pos(m_nmax, m_n_bodies, m_pdata->getExecConf());
+        m_particle_pos.swap(particle_pos);
+        ArrayHandle<Scalar4> particle_pos_handle(m_particle_pos, access_location::host, access_mode::readwrite);
+        unsigned int particle_pos_pitch = m_particle_pos.getPitch();
+
+        GPUArray<Scalar4> particle_orientation(m_nmax, m_n_bodies, m_pdata->getExecConf());
+        m_particle_orientation.swap(particle_orientation);
+        ArrayHandle<Scalar4> h_particle_orientation(m_particle_orientation, access_location::host, access_mode::readwrite);
+        unsigned int particle_orientation_pitch = m_particle_orientation.getPitch();
+
+        GPUArray<unsigned int> particle_offset(m_pdata->getN(), m_pdata->getExecConf());
+        m_particle_offset.swap(particle_offset);
+
+        for (unsigned int body = 0; body < m_n_bodies; body++)
+            {
+            for (unsigned int local = 0; local < particle_indices_pitch; local++)
+                particle_indices_handle.data[body * particle_indices_pitch + local] = NO_INDEX; // initialize with a sentinel value
+
+            for (unsigned int k = h_body_offset.data[body]; k < h_body_offset.data[body+1]; k++)
+                {
+                unsigned int local = k - h_body_offset.data[body];
+                particle_tags_handle.data[body * particle_tags_pitch + local] = h_body_tags.data[k];
+                particle_pos_handle.data[body * particle_pos_pitch + local] = h_body_pos.data[k];
+                h_particle_orientation.data[body * particle_orientation_pitch + local] = h_body_orientation.data[k];
+                }
+            }
+
+        // Now set the m_nmax according to the actual pitches to avoid dublicating rounding up (e.g. if m_nmax is rounded up to 16 here,
+        // then in the GPUArray constructor the pitch is rounded up once more to be 32.
+        m_nmax = particle_tags_pitch;
+        }
+    else
+        {
+        // release the padded arrays of a previous initialization
+        GPUArray<unsigned int> particle_tags, particle_indices, particle_offset;
+        GPUArray<Scalar4> particle_pos, particle_orientation;
+        m_particle_tags.swap(particle_tags);
+        m_particle_indices.swap(particle_indices);
+        m_particle_pos.swap(particle_pos);
+        m_particle_orientation.swap(particle_orientation);
+        m_particle_offset.swap(particle_offset);
         }
 
     // now that all computations using nominally unwrapped coordinates are done, put the COM into the simulation box
@@ -620,9 +800,8 @@ void RigidData::initializeData()
         }
 
     //initialize rigid_particle_indices
-    GPUArray<unsigned int> rigid_particle_indices(rigid_particle_count, m_pdata->getExecConf());
+    GPUArray<unsigned int> rigid_particle_indices(n_body_particles, m_pdata->getExecConf());
     m_rigid_particle_indices.swap(rigid_particle_indices);
-    m_num_particles = rigid_particle_count;
 
     GPUArray<Scalar4> particle_oldpos(m_pdata->getN(), m_pdata->getExecConf());
     m_particle_oldpos.swap(particle_oldpos);
@@ -661,25 +840,23 @@ void RigidData::setRV(bool set_x)
 void RigidData::setRVCPU(bool set_x)
     {
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     // access to the force
     const GPUArray< Scalar4 >& net_force = m_pdata->getNetForce();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
 
     // rigid body handles
-    ArrayHandle<unsigned int> body_size_handle(m_body_size, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> com(m_com, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> vel_handle(m_vel, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> angvel_handle(m_angvel, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> orientation_handle(m_orientation, access_location::host, access_mode::read);
     ArrayHandle<int3> body_image_handle(m_body_image, access_location::host, access_mode::read);
 
-    ArrayHandle<unsigned int> particle_indices_handle(m_particle_indices, access_location::host, access_mode::read);
-    unsigned int indices_pitch = m_particle_indices.getPitch();
-    ArrayHandle<Scalar4> particle_pos_handle(m_particle_pos, access_location::host, access_mode::read);
-    unsigned int particle_pos_pitch = m_particle_pos.getPitch();
-    ArrayHandle<Scalar4> particle_orientation(m_particle_orientation, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_offset(m_body_offset, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(m_body_particle_indices, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_pos(m_body_particle_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_orientation(m_body_particle_orientation, access_location::host, access_mode::read);
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -687,32 +864,27 @@ void RigidData::setRVCPU(bool set_x)
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_p_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
 
-    Scalar4 ex_space, ey_space, ez_space;
-
-    // for each body of all the bodies
+    // every particle belongs to exactly one body, so the bodies can be processed independently
+    #pragma omp parallel for schedule(static)
     for (unsigned int body = 0; body < m_n_bodies; body++)
         {
+        Scalar4 ex_space, ey_space, ez_space;
         exyzFromQuaternion(orientation_handle.data[body], ex_space, ey_space, ez_space);
 
-        unsigned int len = body_size_handle.data[body];
         // for each particle
-        for (unsigned int j = 0; j < len; j++)
+        for (unsigned int k = h_body_offset.data[body]; k < h_body_offset.data[body+1]; k++)
             {
             // get the actual index of particle in the particle arrays
-            unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
-            // get the index of particle in the current rigid body in the particle_pos array
-            unsigned int localidx = body * particle_pos_pitch + j;
+            unsigned int pidx = h_body_indices.data[k];
+            // skip particles that are not local to this rank
+            if (pidx == NO_INDEX)
+                continue;
 
             // project the position in the body frame to the space frame: xr = rotation_matrix * particle_pos
-            Scalar xr = ex_space.x * particle_pos_handle.data[localidx].x
-                        + ey_space.x * particle_pos_handle.data[localidx].y
-                        + ez_space.x * particle_pos_handle.data[localidx].z;
-            Scalar yr = ex_space.y * particle_pos_handle.data[localidx].x
-                        + ey_space.y * particle_pos_handle.data[localidx].y
-                        + ez_space.y * particle_pos_handle.data[localidx].z;
-            Scalar zr = ex_space.z * particle_pos_handle.data[localidx].x
-                        + ey_space.z * particle_pos_handle.data[localidx].y
-                        + ez_space.z * particle_pos_handle.data[localidx].z;
+            Scalar4 ppos = h_body_pos.data[k];
+            Scalar xr = ex_space.x * ppos.x + ey_space.x * ppos.y + ez_space.x * ppos.z;
+            Scalar yr = ex_space.y * ppos.x + ey_space.y * ppos.y + ez_space.y * ppos.z;
+            Scalar zr = ex_space.z * ppos.x + ey_space.z * ppos.y + ez_space.z * ppos.z;
 
             if (set_x)
                 {
@@ -731,7 +903,7 @@ void RigidData::setRVCPU(bool set_x)
 
                 // update the particle orientation: q_i = quat[body] * particle_quat
                 Scalar4 porientation;
-                quatquat(orientation_handle.data[body], particle_orientation.data[localidx], porientation);
+                quatquat(orientation_handle.data[body], h_body_orientation.data[k], porientation);
                 normalize(porientation);
                 h_p_orientation.data[pidx] = porientation;
                 }
@@ -1086,6 +1258,13 @@ void RigidData::computeVirialCorrectionEnd(Scalar deltaT)
 */
 void RigidData::computeVirialCorrectionStartCPU()
     {
+    // the number of local particles may have grown through particle migration
+    if (m_particle_oldpos.getNumElements() < m_pdata->getN())
+        {
+        m_particle_oldpos.resize(m_pdata->getN());
+        m_particle_oldvel.resize(m_pdata->getN());
+        }
+
     // get access to the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
@@ -1115,7 +1294,7 @@ void RigidData::computeVirialCorrectionEndCPU(Scalar deltaT)
     unsigned int virial_pitch = m_pdata->getNetVirial().getPitch();
     ArrayHandle<Scalar4> h_net_force( m_pdata->getNetForce(), access_location::host, access_mode::read);
 
-    BoxDim box = m_pdata->getBox(); // SRR: box for minimum images
+    BoxDim box = m_pdata->getGlobalBox(); // SRR: box for minimum images
 
     // loop through all the particles and compute the virial correction to each one
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
@@ -1205,10 +1384,29 @@ void RigidData::computeVirialCorrectionEndGPU(Scalar deltaT)
     }
 #endif
 
-/*! \param snapshot SnapshotRigidData to initialize from
+/*! \param snapshot_in SnapshotRigidData to initialize from (only read on rank zero with domain decomposition)
  */
-void RigidData::initializeFromSnapshot(const SnapshotRigidData& snapshot)
+void RigidData::initializeFromSnapshot(const SnapshotRigidData& snapshot_in)
     {
+    const SnapshotRigidData *snapshot_ptr = &snapshot_in;
+#ifdef ENABLE_MPI
+    // with domain decomposition, only rank zero holds the snapshot, but every rank keeps all bodies
+    SnapshotRigidData snapshot_all;
+    if (m_pdata->getDomainDecomposition())
+        {
+        if (m_exec_conf->getRank() == 0)
+            snapshot_all = snapshot_in;
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        bcast(snapshot_all.size, 0, mpi_comm);
+        bcast(snapshot_all.com, 0, mpi_comm);
+        bcast(snapshot_all.vel, 0, mpi_comm);
+        bcast(snapshot_all.angmom, 0, mpi_comm);
+        bcast(snapshot_all.body_image, 0, mpi_comm);
+        snapshot_ptr = &snapshot_all;
+        }
+#endif
+    const SnapshotRigidData& snapshot = *snapshot_ptr;
+
     // check that all fields in the snapshot have correct length
     if (m_exec_conf->getRank() == 0 && !snapshot.validate())
         {
@@ -1267,7 +1465,7 @@ void RigidData::takeSnapshot(SnapshotRigidData& snapshot) const
 
 void RigidData::slotGlobalParticleNumberChange()
     {
-    if (m_particle_offset.getNumElements() != 0 && m_pdata->getNGlobal() != m_particle_offset.getNumElements())
+    if (m_n_bodies != 0 && m_pdata->getNGlobal() != m_nglobal)
         {
         throw std::runtime_error("Changing particle number with rigid bodies is unsupported.");
         }
@@ -133,6 +133,12 @@ struct SnapshotRigidData
     be able to process 1 body in each block with one particle in each thread, performing any sums as
     reductions.
 
+    The padded 2D arrays waste memory when the body sizes differ a lot, and they are only allocated when the GPU is
+    used. All CPU code works on a compact (CSR) copy of the same per-particle data: the particles of body \b b are
+    stored at positions getBodyOffsets()[b] to getBodyOffsets()[b+1]-1 of getBodyParticleTags(),
+    getBodyParticleIndices(), getBodyParticlePos() and getBodyParticleOrientation(). Particles that are not local
+    to this rank have the index NO_INDEX.
+
     \ingroup data_structs
 */
 class RigidData
@@ -174,26 +180,51 @@ class RigidData
             {
             return m_body_size;
             }
-        //! Get the m_particle_tags
+        //! Get the m_particle_tags (padded layout, only allocated when running on the GPU)
         const GPUArray<unsigned int>& getParticleTags()
             {
             return m_particle_tags;
             }
-        //! Get m_particle_indices
+        //! Get m_particle_indices (padded layout, only allocated when running on the GPU)
         const GPUArray<unsigned int>& getParticleIndices()
             {
             return m_particle_indices;
             }
-        //! Get m_particle_pos
+        //! Get m_particle_pos (padded layout, only allocated when running on the GPU)
         const GPUArray<Scalar4>& getParticlePos()
             {
             return m_particle_pos;
             }
-        //! Get m_particle_orientation
+        //! Get m_particle_orientation (padded layout, only allocated when running on the GPU)
         const GPUArray<Scalar4>& getParticleOrientation()
             {
             return m_particle_orientation;
             }
+        //! Get the offsets of the bodies in the compact per-particle arrays (getNumBodies()+1 elements)
+        const GPUArray<unsigned int>& getBodyOffsets()
+            {
+            return m_body_offset;
+            }
+        //! Get the particle tags of all bodies in compact storage
+        const GPUArray<unsigned int>& getBodyParticleTags()
+            {
+            return m_body_particle_tags;
+            }
+        //! Get the particle indices of all bodies in compact storage
+        const GPUArray<unsigned int>& getBodyParticleIndices()
+            {
+            return m_body_particle_indices;
+            }
+        //! Get the particle positions in the body frame of all bodies in compact storage
+        const GPUArray<Scalar4>& getBodyParticlePos()
+            {
+            return m_body_particle_pos;
+            }
+        //! Get the particle orientations in the body frame of all bodies in compact storage
+        const GPUArray<Scalar4>& getBodyParticleOrientation()
+            {
+            return m_body_particle_orientation;
+            }
         //! Get m_mass
         const GPUArray<Scalar>& getBodyMass()
             {
@@ -214,7 +245,7 @@ class RigidData
             {
             return m_particle_oldvel;
             }
-        //! Get m_particle_offset
+        //! Get m_particle_offset (only allocated when running on the GPU)
         const GPUArray<unsigned int>& getParticleOffset()
             {
             return m_particle_offset;
@@ -491,6 +522,7 @@ class RigidData
         unsigned int m_n_bodies;                    //!< Number of rigid bodies in the data structure
         unsigned int m_nmax;                        //!< Maximum number of particles in a rigid body
         unsigned int m_ndof;                        //!< Total number degrees of freedom of rigid bodies
+        unsigned int m_nglobal;                     //!< Global number of particles at initialization
         GPUArray<unsigned int> m_body_dof;          //!< n_bodies length 1D array of body DOF
         GPUArray<Scalar> m_body_mass;               //!< n_bodies length 1D array of body mass
         GPUArray<Scalar4> m_moment_inertia;         //!< n_bodies length 1D array of moments of inertia in the body frame
@@ -500,6 +532,11 @@ class RigidData
         GPUArray<Scalar4> m_particle_orientation;   //!< n_max by n_bodies 2D array listing native particle orientations in the body frame
         GPUArray<unsigned int> m_particle_indices;  //!< n_max by n_bodies 2D array listing particle indices belonging to bodies (updated when particles are resorted)
         GPUArray<unsigned int> m_particle_offset;   //!< n_particles by 1 array listing the offset of each particle in its body
+        GPUArray<unsigned int> m_body_offset;       //!< n_bodies+1 length 1D array of the offsets of the bodies in the compact arrays
+        GPUArray<unsigned int> m_body_particle_tags;      //!< Compact array of the particle tags belonging to bodies
+        GPUArray<unsigned int> m_body_particle_indices;   //!< Compact array of the particle indices belonging to bodies
+        GPUArray<Scalar4> m_body_particle_pos;            //!< Compact array of the particle positions in the body frame
+        GPUArray<Scalar4> m_body_particle_orientation;    //!< Compact array of the particle orientations in the body frame
         //@}
 
         //! \name dynamic data members (updated via integration)
@@ -143,7 +143,13 @@ SystemDefinition::SystemDefinition(boost::shared_ptr< SnapshotSystemData<Real> >
 
     // If the initializer is from a binary file, then this reads in the body COM, velocities, angular momenta and body images;
     // otherwise, nothing is done here.
-    if (snapshot->rigid_data.size) m_rigid_data->initializeFromSnapshot(snapshot->rigid_data);
+    bool has_rigid_snapshot = snapshot->rigid_data.size;
+    #ifdef ENABLE_MPI
+    // only rank zero holds the snapshot
+    if (m_particle_data->getDomainDecomposition())
+        bcast(has_rigid_snapshot, 0, exec_conf->getMPICommunicator());
+    #endif
+    if (has_rigid_snapshot) m_rigid_data->initializeFromSnapshot(snapshot->rigid_data);
 
     m_angle_data = boost::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
 
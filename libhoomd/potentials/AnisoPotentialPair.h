@@ -55,6 +55,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/python.hpp>
 
@@ -161,6 +162,7 @@ protected:
         GPUArray<param_type> m_params;   //!< Pair parameters per type pair
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        std::vector<Scalar3> m_dx;                  //!< Separations to the neighbors of one particle
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -344,15 +346,24 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+        // calculate dr_ji for all neighbors and apply periodic boundary conditions in one batch
+        if (size > m_dx.size())
+            m_dx.resize(size);
+        Scalar3 *dx_all = size > 0 ? &m_dx[0] : NULL;
         for (unsigned int k = 0; k < size; k++)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int j = h_nlist.data[myHead + k];
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            dx_all[k] = pi - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            }
+        box.minImageArray(dx_all, size);
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+        for (unsigned int k = 0; k < size; k++)
+            {
+            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+            unsigned int j = h_nlist.data[myHead + k];
+            Scalar3 dx = dx_all[k];
             Scalar4 quat_j = h_orientation.data[j];
 
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
@@ -367,9 +378,6 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
             if (aniso_evaluator::needsCharge())
                 qj = h_charge.data[j];
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
             // get parameters for this type pair
             unsigned int typpair_idx = m_typpair_idx(typei, typej);
             param_type param = h_params.data[typpair_idx];
@@ -229,6 +229,7 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    bool compute_energy = flags[pdata_flag::potential_energy];
 
     Scalar bond_virial[6];
     for (unsigned int i = 0; i< 6; i++)
@@ -329,7 +330,8 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_b].x += force_divr * dx.x;
                 h_force.data[idx_b].y += force_divr * dx.y;
                 h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                if (compute_energy)
+                    h_force.data[idx_b].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
@@ -340,7 +342,8 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_a].x -= force_divr * dx.x;
                 h_force.data[idx_a].y -= force_divr * dx.y;
                 h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                if (compute_energy)
+                    h_force.data[idx_a].w += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
@@ -353,6 +356,10 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             }
         }
 
+    // let ForceCompute know that the energies need to be recomputed if requested later
+    if (!compute_energy)
+        m_energy_skipped = true;
+
     if (m_prof) m_prof->pop();
     }
 
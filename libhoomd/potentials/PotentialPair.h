@@ -59,12 +59,14 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/bind.hpp>
 #include "num_util.h"
 #include <boost/python/stl_iterator.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include "HOOMDMath.h"
 #include "Index1D.h"
 #include "GPUArray.h"
 #include "ForceCompute.h"
 #include "NeighborList.h"
+#include "PotentialPairFused.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -120,6 +122,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    Several pair potentials that share a neighbor list can be evaluated in a single pass over it by registering them
+    with a PotentialPairFused (see setFusedCompute()). computeForces() then defers to the fused compute, which calls
+    computeFusedParticle() with the precomputed neighbor separations of each particle.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independantly.
@@ -127,7 +133,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     \sa export_PotentialPair()
 */
 template < class evaluator >
-class PotentialPair : public ForceCompute
+class PotentialPair : public ForceCompute, public FusedPairPotential
     {
     public:
         //! Param type from evaluator
@@ -180,6 +186,21 @@ class PotentialPair : public ForceCompute
         Scalar computeEnergyBetweenSetsPythonList(  PyObject* tags1,
                                                     PyObject* tags2);
 
+        //! Evaluate this potential in the fused neighbor list pass of another compute
+        virtual void setFusedCompute(boost::shared_ptr<PotentialPairFused> fused);
+
+        //! Start a fused pass
+        virtual void beginFusedPass(bool compute_energy, bool compute_virial, bool third_law);
+
+        //! Accumulate the forces between one particle and its neighbors in a fused pass
+        virtual void computeFusedParticle(const FusedPairNeighbors& neighbors)
+            {
+            (this->*m_fused_kernel)(neighbors);
+            }
+
+        //! Finish a fused pass
+        virtual void endFusedPass();
+
     protected:
         boost::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
@@ -189,10 +210,139 @@ class PotentialPair : public ForceCompute
         GPUArray<param_type> m_params;              //!< Pair parameters per type pair
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        std::string m_time_log_name;                //!< Cached log name of the compute time
+
+        //! Array handles held for the duration of a fused pass
+        struct FusedPassData
+            {
+            //! Acquire all arrays needed in a fused pass
+            FusedPassData(const GPUArray<Scalar4>& force, const GPUArray<Scalar>& virial,
+                          const GPUArray<Scalar>& diameter, const GPUArray<Scalar>& charge,
+                          const GPUArray<Scalar>& ronsq, const GPUArray<Scalar>& rcutsq,
+                          const GPUArray<param_type>& params, unsigned int _N, unsigned int _virial_pitch)
+                : h_force(force, access_location::host, access_mode::overwrite),
+                  h_virial(virial, access_location::host, access_mode::overwrite),
+                  h_diameter(diameter, access_location::host, access_mode::read),
+                  h_charge(charge, access_location::host, access_mode::read),
+                  h_ronsq(ronsq, access_location::host, access_mode::read),
+                  h_rcutsq(rcutsq, access_location::host, access_mode::read),
+                  h_params(params, access_location::host, access_mode::read),
+                  N(_N), virial_pitch(_virial_pitch)
+                {
+                }
+
+            ArrayHandle<Scalar4> h_force;           //!< Force and energy
+            ArrayHandle<Scalar> h_virial;           //!< Virial
+            ArrayHandle<Scalar> h_diameter;         //!< Particle diameters
+            ArrayHandle<Scalar> h_charge;           //!< Particle charges
+            ArrayHandle<Scalar> h_ronsq;            //!< ron squared per type pair
+            ArrayHandle<Scalar> h_rcutsq;           //!< Cutoff radius squared per type pair
+            ArrayHandle<param_type> h_params;       //!< Pair parameters per type pair
+            unsigned int N;                         //!< Number of local particles
+            unsigned int virial_pitch;              //!< Pitch of the virial array
+            };
+
+        //! Type of the specialized per particle kernels used in a fused pass
+        typedef void (PotentialPair<evaluator>::*fused_kernel_t)(const FusedPairNeighbors& neighbors);
+
+        boost::shared_ptr<PotentialPairFused> m_fused;  //!< Fused compute evaluating this potential (if any)
+        boost::scoped_ptr<FusedPassData> m_fused_pass;  //!< Array handles of the current fused pass
+        fused_kernel_t m_fused_kernel;                  //!< Per particle kernel of the current fused pass
+        std::vector<Scalar3> m_dx;                      //!< Separations to the neighbors of one particle
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Dispatch the force loop for a given shift mode
+        template< unsigned int shift_mode >
+        void computeForcesShiftMode(bool compute_energy, bool compute_virial, bool third_law);
+
+        //! Force loop specialized on the run time options
+        template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial,
+                  unsigned int third_law >
+        void computeForcesKernel();
+
+        //! Select the per particle kernel of a fused pass for a given shift mode
+        template< unsigned int shift_mode >
+        void selectFusedKernel(bool compute_energy, bool compute_virial, bool third_law);
+
+        //! Per particle kernel of a fused pass, specialized on the run time options
+        template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial,
+                  unsigned int third_law >
+        void computeFusedParticleKernel(const FusedPairNeighbors& neighbors);
+
+        //! Force, potential energy and virial accumulated on one particle
+        struct PairSums
+            {
+            //! Start from zero
+            PairSums() : pe(Scalar(0.0))
+                {
+                f = make_scalar3(0, 0, 0);
+                for (unsigned int k = 0; k < 6; k++)
+                    virial[k] = Scalar(0.0);
+                }
+
+            Scalar3 f;          //!< Force
+            Scalar pe;          //!< Potential energy
+            Scalar virial[6];   //!< Virial tensor (xx, xy, xz, yy, yz, zz)
+            };
+
+        //! Evaluate a single pair and accumulate the result, shared by the regular and the fused force loops
+        template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial,
+                  unsigned int third_law >
+        inline void computePair(unsigned int j, unsigned int typpair_idx, const Scalar3& dx, Scalar rsq,
+                                Scalar di, Scalar dj, Scalar qi, Scalar qj, const param_type *params,
+                                const Scalar *rcutsq_array, const Scalar *ronsq_array, unsigned int N,
+                                Scalar4 *force, Scalar *virial, unsigned int virial_pitch, PairSums& sums);
+
+        //! Add the sums of particle i to the force and virial arrays
+        template< unsigned int compute_virial >
+        static inline void storeSums(unsigned int i, const PairSums& sums, Scalar4 *force, Scalar *virial,
+                                     unsigned int virial_pitch)
+            {
+            force[i].x += sums.f.x;
+            force[i].y += sums.f.y;
+            force[i].z += sums.f.z;
+            force[i].w += sums.pe;
+            if (compute_virial)
+                {
+                for (unsigned int k = 0; k < 6; k++)
+                    virial[k*virial_pitch+i] += sums.virial[k];
+                }
+            }
+
+        //! Apply XPLOR smoothing to a pair force and energy
+        /*! \param rsq Distance squared
+            \param ronsq r_on squared
+            \param rcutsq r_cut squared
+            \param force_divr Force divided by r (modified in place)
+            \param pair_eng Pair energy (modified in place)
+        */
+        static inline void applyXPLOR(Scalar rsq, Scalar ronsq, Scalar rcutsq, Scalar& force_divr, Scalar& pair_eng)
+            {
+            if (rsq >= ronsq && rsq < rcutsq)
+                {
+                // Implement XPLOR smoothing (FLOPS: 16)
+                Scalar old_pair_eng = pair_eng;
+                Scalar old_force_divr = force_divr;
+
+                // calculate 1.0 / (xplor denominator)
+                Scalar xplor_denom_inv =
+                    Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                           (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                // make modifications to the old pair energy and force
+                pair_eng = old_pair_eng * s;
+                // note: I'm not sure why the minus sign needs to be there: my notes have a +
+                // But this is verified correct via plotting
+                force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                }
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -228,7 +378,8 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(boost::shared_ptr<SystemDefinition> sysdef,
                                                 boost::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes()),
+      m_fused_kernel(NULL)
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
@@ -245,6 +396,7 @@ PotentialPair< evaluator >::PotentialPair(boost::shared_ptr<SystemDefinition> sy
     // initialize name
     m_prof_name = std::string("Pair ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
+    m_time_log_name = std::string("time_pair_") + evaluator::getName() + log_suffix;
 
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_num_type_change_connection = m_pdata->connectNumTypesChange(boost::bind(&PotentialPair<evaluator>::slotNumTypesChange, this));
@@ -255,6 +407,9 @@ PotentialPair< evaluator >::~PotentialPair()
     {
     m_exec_conf->msg->notice(5) << "Destroying PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
+    if (m_fused)
+        m_fused->removePotential(this);
+
     m_num_type_change_connection.disconnect();
     }
 
@@ -323,6 +478,9 @@ void PotentialPair< evaluator >::setRon(unsigned int typ1, unsigned int typ2, Sc
 
 /*! PotentialPair provides:
      - \c pair_"name"_energy
+     - \c time_pair_"name", the wall clock time (in seconds) spent computing the forces since the last log write,
+       excluding the neighbor list update. The single pass of a PotentialPairFused is counted for the potential
+       that triggers it.
     where "name" is replaced with evaluator::getName()
 */
 template< class evaluator >
@@ -330,6 +488,7 @@ std::vector< std::string > PotentialPair< evaluator >::getProvidedLogQuantities(
     {
     std::vector<std::string> list;
     list.push_back(m_log_name);
+    list.push_back(m_time_log_name);
     return list;
     }
 
@@ -344,6 +503,15 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
         compute(timestep);
         return calcEnergySum();
         }
+    else if (quantity == m_time_log_name)
+        {
+        Scalar t = m_compute_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
     else
         {
         this->m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": " << quantity << " is not a valid log quantity"
@@ -356,10 +524,24 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
     that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    The run time options (shift mode, energy and virial computation and use of the third law) are checked once here
+    and the matching instantiation of computeForcesKernel() is called, so that the inner pair loop is free of mode
+    branches. Per particle energies are only computed when pdata_flag::potential_energy is set.
 */
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     {
+    // a fused compute walks the neighbor list for all of its potentials at once
+    if (m_fused)
+        {
+        m_fused->computeFor(this, timestep);
+
+        if (!m_pdata->getFlags()[pdata_flag::potential_energy])
+            m_energy_skipped = true;
+        return;
+        }
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -370,36 +552,120 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    bool compute_energy = flags[pdata_flag::potential_energy];
+
+    switch (m_shift_mode)
+        {
+        case no_shift:
+            computeForcesShiftMode<no_shift>(compute_energy, compute_virial, third_law);
+            break;
+        case shift:
+            computeForcesShiftMode<shift>(compute_energy, compute_virial, third_law);
+            break;
+        case xplor:
+            computeForcesShiftMode<xplor>(compute_energy, compute_virial, third_law);
+            break;
+        default:
+            m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": Invalid energy shift mode "
+                                      << m_shift_mode << std::endl;
+            throw std::runtime_error("Error computing pair forces");
+        }
+
+    // let ForceCompute know that the energies need to be recomputed if requested later
+    if (!compute_energy)
+        m_energy_skipped = true;
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param compute_energy Set to true to compute the per particle energies
+    \param compute_virial Set to true to compute the virial
+    \param third_law Set to true when the neighbor list is stored in half mode
+
+    \tparam shift_mode Energy shift mode (one of energyShiftMode)
+*/
+template< class evaluator >
+template< unsigned int shift_mode >
+void PotentialPair< evaluator >::computeForcesShiftMode(bool compute_energy, bool compute_virial, bool third_law)
+    {
+    if (compute_energy)
+        {
+        if (compute_virial)
+            {
+            if (third_law)
+                computeForcesKernel<shift_mode, 1, 1, 1>();
+            else
+                computeForcesKernel<shift_mode, 1, 1, 0>();
+            }
+        else
+            {
+            if (third_law)
+                computeForcesKernel<shift_mode, 1, 0, 1>();
+            else
+                computeForcesKernel<shift_mode, 1, 0, 0>();
+            }
+        }
+    else
+        {
+        if (compute_virial)
+            {
+            if (third_law)
+                computeForcesKernel<shift_mode, 0, 1, 1>();
+            else
+                computeForcesKernel<shift_mode, 0, 1, 0>();
+            }
+        else
+            {
+            if (third_law)
+                computeForcesKernel<shift_mode, 0, 0, 1>();
+            else
+                computeForcesKernel<shift_mode, 0, 0, 0>();
+            }
+        }
+    }
+
+/*! \tparam shift_mode Energy shift mode (one of energyShiftMode)
+    \tparam compute_energy When non-zero, the per particle energies are computed. When zero, the energy terms are
+            not accumulated and the compiler can drop their evaluation from the inlined evaluator.
+    \tparam compute_virial When non-zero, the virial tensor is computed
+    \tparam third_law When non-zero, forces are also applied to local neighbors j (half neighbor list)
+
+    Whether the evaluator needs diameters and charges is already known at compile time through
+    evaluator::needsDiameter() and evaluator::needsCharge(), so those branches are resolved by the compiler as well.
+*/
+template< class evaluator >
+template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law >
+void PotentialPair< evaluator >::computeForcesKernel()
+    {
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-//     Index2D nli = m_nlist->getNListIndexer();
     ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-
     //force arrays
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
 
-
     const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    const unsigned int N = m_pdata->getN();
+    const unsigned int virial_pitch = m_virial_pitch;
 
     // need to start from a zero force, energy and virial
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    for (int i = 0; i < (int)N; i++)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -417,27 +683,29 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             qi = h_charge.data[i];
 
         // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
+        PairSums sums;
 
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+        // calculate dr_ji for all neighbors and apply periodic boundary conditions in one batch
+        if (size > m_dx.size())
+            m_dx.resize(size);
+        Scalar3 *dx_all = size > 0 ? &m_dx[0] : NULL;
         for (unsigned int k = 0; k < size; k++)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int j = h_nlist.data[myHead + k];
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            dx_all[k] = pi - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            }
+        box.minImageArray(dx_all, size);
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+        for (unsigned int k = 0; k < size; k++)
+            {
+            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+            unsigned int j = h_nlist.data[myHead + k];
+            const Scalar3 dx = dx_all[k];
 
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
             unsigned int typej = __scalar_as_int(h_pos.data[j].w);
@@ -451,126 +719,284 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             if (evaluator::needsCharge())
                 qj = h_charge.data[j];
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
             // calculate r_ij squared (FLOPS: 5)
             Scalar rsq = dot(dx, dx);
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+            computePair<shift_mode, compute_energy, compute_virial, third_law>(j, m_typpair_idx(typei, typej), dx, rsq,
+                di, dj, qi, qj, h_params.data, h_rcutsq.data, h_ronsq.data, N, h_force.data, h_virial.data,
+                virial_pitch, sums);
+            }
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+        // finally, increment the force, potential energy and virial for particle i
+        storeSums<compute_virial>(i, sums, h_force.data, h_virial.data, virial_pitch);
+        }
+    }
+
+/*! \param j Index of the neighbor
+    \param typpair_idx Index of the type pair in the parameter arrays
+    \param dx Minimum image separation r_i - r_j
+    \param rsq Squared length of \a dx
+    \param di Diameter of particle i (if needed by the evaluator)
+    \param dj Diameter of particle j (if needed by the evaluator)
+    \param qi Charge of particle i (if needed by the evaluator)
+    \param qj Charge of particle j (if needed by the evaluator)
+    \param params Pair parameters
+    \param rcutsq_array Squared cutoff radii
+    \param ronsq_array Squared XPLOR onset radii
+    \param N Number of local particles
+    \param force Force array (particle j is updated when third_law is set)
+    \param virial Virial array (particle j is updated when third_law is set)
+    \param virial_pitch Pitch of \a virial
+    \param sums Force, energy and virial of particle i (updated)
+
+    The template parameters have the same meaning as in computeForcesKernel().
+*/
+template< class evaluator >
+template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law >
+inline void PotentialPair< evaluator >::computePair(unsigned int j, unsigned int typpair_idx, const Scalar3& dx,
+    Scalar rsq, Scalar di, Scalar dj, Scalar qi, Scalar qj, const param_type *params, const Scalar *rcutsq_array,
+    const Scalar *ronsq_array, unsigned int N, Scalar4 *force, Scalar *virial, unsigned int virial_pitch,
+    PairSums& sums)
+    {
+    // get parameters for this type pair
+    param_type param = params[typpair_idx];
+    Scalar rcutsq = rcutsq_array[typpair_idx];
+    Scalar ronsq = Scalar(0.0);
+    if (shift_mode == xplor)
+        ronsq = ronsq_array[typpair_idx];
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    // the shift only changes the energy, so it is skipped when energies are not needed
+    bool energy_shift = false;
+    if (compute_energy && shift_mode == shift)
+        energy_shift = true;
+    else if (compute_energy && shift_mode == xplor)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // compute the force and potential energy
+    Scalar force_divr = Scalar(0.0);
+    Scalar pair_eng = Scalar(0.0);
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    if (evaluated)
+        {
+        // modify the potential for xplor shifting (the smoothed force depends on the energy)
+        if (shift_mode == xplor)
+            applyXPLOR(rsq, ronsq, rcutsq, force_divr, pair_eng);
+
+        Scalar force_div2r = force_divr * Scalar(0.5);
+        // add the force, potential energy and virial to the particle i
+        // (FLOPS: 8)
+        sums.f += dx*force_divr;
+        if (compute_energy)
+            sums.pe += pair_eng * Scalar(0.5);
+        if (compute_virial)
+            {
+            sums.virial[0] += force_div2r*dx.x*dx.x;
+            sums.virial[1] += force_div2r*dx.x*dx.y;
+            sums.virial[2] += force_div2r*dx.x*dx.z;
+            sums.virial[3] += force_div2r*dx.y*dx.y;
+            sums.virial[4] += force_div2r*dx.y*dx.z;
+            sums.virial[5] += force_div2r*dx.z*dx.z;
+            }
+
+        // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+        // only add force to local particles
+        if (third_law && j < N)
+            {
+            force[j].x -= dx.x*force_divr;
+            force[j].y -= dx.y*force_divr;
+            force[j].z -= dx.z*force_divr;
+            if (compute_energy)
+                force[j].w += pair_eng * Scalar(0.5);
+            if (compute_virial)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
+                virial[0*virial_pitch+j] += force_div2r*dx.x*dx.x;
+                virial[1*virial_pitch+j] += force_div2r*dx.x*dx.y;
+                virial[2*virial_pitch+j] += force_div2r*dx.x*dx.z;
+                virial[3*virial_pitch+j] += force_div2r*dx.y*dx.y;
+                virial[4*virial_pitch+j] += force_div2r*dx.y*dx.z;
+                virial[5*virial_pitch+j] += force_div2r*dx.z*dx.z;
                 }
+            }
+        }
+    }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+/*! \param fused Fused compute to register with, or a null pointer to compute this potential on its own again
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+    All potentials registered with the same PotentialPairFused must use its neighbor list.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::setFusedCompute(boost::shared_ptr<PotentialPairFused> fused)
+    {
+    if (fused && fused->getNeighborList() != m_nlist)
+        {
+        m_exec_conf->msg->error() << "pair." << evaluator::getName()
+                                  << ": Cannot fuse pair potentials that use different neighbor lists" << std::endl;
+        throw std::runtime_error("Error setting up fused pair potential");
+        }
 
-            if (evaluated)
-                {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
+    if (m_fused)
+        m_fused->removePotential(this);
 
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+    m_fused = fused;
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+    if (m_fused)
+        m_fused->addPotential(this);
+    }
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
+/*! \param compute_energy Set to true to compute the per particle energies
+    \param compute_virial Set to true to compute the virial
+    \param third_law Set to true when the neighbor list is stored in half mode
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
-                    {
-                    virialxxi += force_div2r*dx.x*dx.x;
-                    virialxyi += force_div2r*dx.x*dx.y;
-                    virialxzi += force_div2r*dx.x*dx.z;
-                    virialyyi += force_div2r*dx.y*dx.y;
-                    virialyzi += force_div2r*dx.y*dx.z;
-                    virialzzi += force_div2r*dx.z*dx.z;
-                    }
+    Acquires and zeroes the force and virial arrays and selects the matching per particle kernel. The arrays stay
+    acquired until endFusedPass().
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::beginFusedPass(bool compute_energy, bool compute_virial, bool third_law)
+    {
+    if (m_prof) m_prof->push(m_prof_name);
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                // only add force to local particles
-                if (third_law && j < m_pdata->getN())
-                    {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
-                        {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
-                        }
-                    }
-                }
-            }
+    m_fused_pass.reset(new FusedPassData(m_force, m_virial, m_pdata->getDiameters(), m_pdata->getCharges(),
+                                         m_ronsq, m_rcutsq, m_params, m_pdata->getN(), m_virial_pitch));
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+    // need to start from a zero force, energy and virial
+    memset((void*)m_fused_pass->h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)m_fused_pass->h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    switch (m_shift_mode)
+        {
+        case no_shift:
+            selectFusedKernel<no_shift>(compute_energy, compute_virial, third_law);
+            break;
+        case shift:
+            selectFusedKernel<shift>(compute_energy, compute_virial, third_law);
+            break;
+        case xplor:
+            selectFusedKernel<xplor>(compute_energy, compute_virial, third_law);
+            break;
+        default:
+            m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": Invalid energy shift mode "
+                                      << m_shift_mode << std::endl;
+            throw std::runtime_error("Error computing pair forces");
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! Releases the arrays acquired in beginFusedPass()
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::endFusedPass()
+    {
+    m_fused_pass.reset();
+    m_fused_kernel = NULL;
+    }
+
+/*! \param compute_energy Set to true to compute the per particle energies
+    \param compute_virial Set to true to compute the virial
+    \param third_law Set to true when the neighbor list is stored in half mode
+
+    \tparam shift_mode Energy shift mode (one of energyShiftMode)
+*/
+template< class evaluator >
+template< unsigned int shift_mode >
+void PotentialPair< evaluator >::selectFusedKernel(bool compute_energy, bool compute_virial, bool third_law)
+    {
+    typedef PotentialPair<evaluator> P;
+    if (compute_energy)
+        {
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            if (third_law)
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 1, 1, 1>;
+            else
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 1, 1, 0>;
+            }
+        else
+            {
+            if (third_law)
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 1, 0, 1>;
+            else
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 1, 0, 0>;
             }
         }
+    else
+        {
+        if (compute_virial)
+            {
+            if (third_law)
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 0, 1, 1>;
+            else
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 0, 1, 0>;
+            }
+        else
+            {
+            if (third_law)
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 0, 0, 1>;
+            else
+                m_fused_kernel = &P::template computeFusedParticleKernel<shift_mode, 0, 0, 0>;
+            }
+        }
+    }
 
-    if (m_prof) m_prof->pop();
+/*! \param neighbors Neighbors of the particle, with precomputed separations
+
+    This is the body of the particle loop in computeForcesKernel(), reading the neighbor geometry from \a neighbors
+    instead of the particle positions. Both evaluate the pairs with computePair(). The template parameters have the
+    same meaning.
+*/
+template< class evaluator >
+template< unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law >
+void PotentialPair< evaluator >::computeFusedParticleKernel(const FusedPairNeighbors& neighbors)
+    {
+    FusedPassData& pass = *m_fused_pass;
+    const unsigned int i = neighbors.i;
+    const unsigned int typei = neighbors.typei;
+    assert(typei < m_pdata->getNTypes());
+
+    // access diameter and charge (if needed)
+    Scalar di = Scalar(0.0);
+    Scalar qi = Scalar(0.0);
+    if (evaluator::needsDiameter())
+        di = pass.h_diameter.data[i];
+    if (evaluator::needsCharge())
+        qi = pass.h_charge.data[i];
+
+    // initialize current particle force, potential energy, and virial to 0
+    PairSums sums;
+
+    for (unsigned int k = 0; k < neighbors.n_neigh; k++)
+        {
+        const unsigned int j = neighbors.j[k];
+        const unsigned int typej = neighbors.typej[k];
+        assert(typej < m_pdata->getNTypes());
+
+        Scalar dj = Scalar(0.0);
+        Scalar qj = Scalar(0.0);
+        if (evaluator::needsDiameter())
+            dj = pass.h_diameter.data[j];
+        if (evaluator::needsCharge())
+            qj = pass.h_charge.data[j];
+
+        computePair<shift_mode, compute_energy, compute_virial, third_law>(j, m_typpair_idx(typei, typej),
+            neighbors.dx[k], neighbors.rsq[k], di, dj, qi, qj, pass.h_params.data, pass.h_rcutsq.data,
+            pass.h_ronsq.data, pass.N, pass.h_force.data, pass.h_virial.data, pass.virial_pitch, sums);
+        }
+
+    // finally, increment the force, potential energy and virial for particle i
+    storeSums<compute_virial>(i, sums, pass.h_force.data, pass.h_virial.data, pass.virial_pitch);
     }
 
 #ifdef ENABLE_MPI
@@ -778,6 +1204,7 @@ template < class T > void export_PotentialPair(const std::string& name)
                   .def("setRon", &T::setRon)
                   .def("setShiftMode", &T::setShiftMode)
                   .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
+                  .def("setFusedCompute", &T::setFusedCompute)
                   ;
 
     boost::python::enum_<typename T::energyShiftMode>("energyShiftMode")
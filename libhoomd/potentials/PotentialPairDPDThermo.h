@@ -105,6 +105,18 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         //! Set the temperature
         virtual void setT(boost::shared_ptr<Variant> T);
 
+        //! Fused neighbor list passes are not supported by the DPD thermostat
+        virtual void setFusedCompute(boost::shared_ptr<PotentialPairFused> fused)
+            {
+            if (fused)
+                {
+                this->m_exec_conf->msg->error() << "pair." << evaluator::getName()
+                                                << ": The DPD thermostat cannot be fused with other pair potentials"
+                                                << std::endl;
+                throw std::runtime_error("Error setting up fused pair potential");
+                }
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -191,7 +203,13 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*this->m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*this->m_virial.getNumElements());
 
+    // Special Potential Pair DPD Requirements
+    const Scalar currentTemp = m_T->getValue(timestep);
+
     // for each particle
+    // the random force on a pair only depends on the tags, so particles can be split between threads as long as
+    // every thread only writes to its own particles (full neighbor list)
+    #pragma omp parallel for schedule(guided) if(!third_law)
     for (int i = 0; i < (int)this->m_pdata->getN(); i++)
         {
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
@@ -257,9 +275,6 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
             Scalar pair_eng = Scalar(0.0);
             evaluator eval(rsq, rcutsq, param);
 
-            // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->getValue(timestep);
-
             // set seed using global tags
             unsigned int tagi = h_tag.data[i];
             unsigned int tagj = h_tag.data[j];
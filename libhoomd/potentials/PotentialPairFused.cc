@@ -0,0 +1,244 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+#include "PotentialPairFused.h"
+
+#include <boost/python.hpp>
+using namespace boost::python;
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/*! \file PotentialPairFused.cc
+    \brief Contains code for the PotentialPairFused class
+*/
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighbor list shared by all potentials that will be registered
+*/
+PotentialPairFused::PotentialPairFused(boost::shared_ptr<SystemDefinition> sysdef,
+                                       boost::shared_ptr<NeighborList> nlist)
+    : Compute(sysdef), m_nlist(nlist), m_pass_timestep(0), m_pass_valid(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PotentialPairFused" << endl;
+
+    assert(m_nlist);
+    }
+
+PotentialPairFused::~PotentialPairFused()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialPairFused" << endl;
+    }
+
+/*! \param potential Potential to register
+    The caller is responsible for unregistering the potential with removePotential() before it is destroyed.
+*/
+void PotentialPairFused::addPotential(FusedPairPotential *potential)
+    {
+    assert(potential);
+    if (find(m_potentials.begin(), m_potentials.end(), potential) != m_potentials.end())
+        return;
+
+    m_potentials.push_back(potential);
+    m_consumed.push_back(true);
+    m_pass_valid = false;
+    }
+
+/*! \param potential Potential to unregister
+*/
+void PotentialPairFused::removePotential(FusedPairPotential *potential)
+    {
+    vector<FusedPairPotential *>::iterator it = find(m_potentials.begin(), m_potentials.end(), potential);
+    if (it == m_potentials.end())
+        return;
+
+    m_consumed.erase(m_consumed.begin() + (it - m_potentials.begin()));
+    m_potentials.erase(it);
+    m_pass_valid = false;
+    }
+
+/*! \param potential Registered potential that requests its forces
+    \param timestep Current time step
+
+    A new pass is computed unless the last pass was done at \a timestep and \a potential has not used it yet. A
+    potential that is computed twice in the same time step (e.g. to obtain energies that were skipped) therefore
+    triggers a new pass, which also refreshes the other potentials.
+*/
+void PotentialPairFused::computeFor(FusedPairPotential *potential, unsigned int timestep)
+    {
+    vector<FusedPairPotential *>::iterator it = find(m_potentials.begin(), m_potentials.end(), potential);
+    if (it == m_potentials.end())
+        {
+        m_exec_conf->msg->error() << "pair.fuse: Potential is not registered with this fused pair compute" << endl;
+        throw runtime_error("Error computing fused pair forces");
+        }
+    unsigned int idx = (unsigned int)(it - m_potentials.begin());
+
+    if (!m_pass_valid || m_pass_timestep != timestep || m_consumed[idx])
+        computePass(timestep);
+
+    m_consumed[idx] = true;
+    }
+
+/*! \param timestep Current time step
+*/
+void PotentialPairFused::compute(unsigned int timestep)
+    {
+    if (!shouldCompute(timestep))
+        return;
+
+    computePass(timestep);
+    }
+
+/*! \param timestep Current time step
+*/
+void PotentialPairFused::computePass(unsigned int timestep)
+    {
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    if (m_prof) m_prof->push("Pair fused");
+
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    bool compute_energy = flags[pdata_flag::potential_energy];
+
+    for (unsigned int p = 0; p < m_potentials.size(); p++)
+        m_potentials[p]->beginFusedPass(compute_energy, compute_virial, third_law);
+
+        {
+        // access the neighbor list, particle data, and system box
+        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+        const BoxDim& box = m_pdata->getGlobalBox();
+        const unsigned int N = m_pdata->getN();
+
+        FusedPairNeighbors neighbors;
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int head = h_head_list.data[i];
+            const unsigned int size = h_n_neigh.data[i];
+
+            if (size > m_scratch_j.size())
+                {
+                m_scratch_j.resize(size);
+                m_scratch_typej.resize(size);
+                m_scratch_dx.resize(size);
+                m_scratch_rsq.resize(size);
+                }
+
+            // compute the neighbor geometry once for all potentials
+            for (unsigned int k = 0; k < size; k++)
+                {
+                unsigned int j = h_nlist.data[head + k];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                Scalar4 postypej = h_pos.data[j];
+                m_scratch_j[k] = j;
+                m_scratch_typej[k] = __scalar_as_int(postypej.w);
+                m_scratch_dx[k] = pi - make_scalar3(postypej.x, postypej.y, postypej.z);
+                }
+
+            if (size > 0)
+                box.minImageArray(&m_scratch_dx[0], size);
+
+            for (unsigned int k = 0; k < size; k++)
+                m_scratch_rsq[k] = dot(m_scratch_dx[k], m_scratch_dx[k]);
+
+            neighbors.i = i;
+            neighbors.typei = __scalar_as_int(h_pos.data[i].w);
+            neighbors.n_neigh = size;
+            if (size > 0)
+                {
+                neighbors.j = &m_scratch_j[0];
+                neighbors.typej = &m_scratch_typej[0];
+                neighbors.dx = &m_scratch_dx[0];
+                neighbors.rsq = &m_scratch_rsq[0];
+                }
+            else
+                {
+                neighbors.j = NULL;
+                neighbors.typej = NULL;
+                neighbors.dx = NULL;
+                neighbors.rsq = NULL;
+                }
+
+            for (unsigned int p = 0; p < m_potentials.size(); p++)
+                m_potentials[p]->computeFusedParticle(neighbors);
+            }
+        }
+
+    for (unsigned int p = 0; p < m_potentials.size(); p++)
+        m_potentials[p]->endFusedPass();
+
+    m_pass_timestep = timestep;
+    m_pass_valid = true;
+    fill(m_consumed.begin(), m_consumed.end(), false);
+
+    if (m_prof) m_prof->pop();
+    }
+
+void export_PotentialPairFused()
+    {
+    class_< PotentialPairFused, boost::shared_ptr<PotentialPairFused>, bases<Compute>, boost::noncopyable >
+    ("PotentialPairFused", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<NeighborList> >())
+    .def("getNumPotentials", &PotentialPairFused::getNumPotentials)
+    ;
+    }
@@ -0,0 +1,174 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+#include "Compute.h"
+#include "NeighborList.h"
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+/*! \file PotentialPairFused.h
+    \brief Declares a class that evaluates several pair potentials in a single pass over a neighbor list
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __POTENTIAL_PAIR_FUSED_H__
+#define __POTENTIAL_PAIR_FUSED_H__
+
+//! Neighbors of a single particle, as handed to the potentials in a fused pass
+/*! The separation vectors are already wrapped into the box with minImage(). Neighbor k of particle \a i has index
+    \a j[k], type \a typej[k], separation \a dx[k] = r_i - r_j and squared distance \a rsq[k].
+*/
+struct FusedPairNeighbors
+    {
+    unsigned int i;                 //!< Index of the particle
+    unsigned int typei;             //!< Type of the particle
+    unsigned int n_neigh;           //!< Number of neighbors
+    const unsigned int *j;          //!< Indices of the neighbors
+    const unsigned int *typej;      //!< Types of the neighbors
+    const Scalar3 *dx;              //!< Minimum image separation r_i - r_j
+    const Scalar *rsq;              //!< Squared distance
+    };
+
+//! Interface of pair potentials that can be evaluated by PotentialPairFused
+/*! A fused pass calls beginFusedPass() on every potential, then computeFusedParticle() once per local particle and
+    finally endFusedPass(). Implementations hold their array handles between beginFusedPass() and endFusedPass().
+    \ingroup computes
+*/
+class FusedPairPotential
+    {
+    public:
+        virtual ~FusedPairPotential() {}
+
+        //! Start a fused pass (zero and acquire the force arrays)
+        /*! \param compute_energy True if per particle energies are to be computed
+            \param compute_virial True if the virial is to be computed
+            \param third_law True if the neighbor list is stored in half mode
+        */
+        virtual void beginFusedPass(bool compute_energy, bool compute_virial, bool third_law) = 0;
+
+        //! Accumulate the forces between one particle and its neighbors
+        virtual void computeFusedParticle(const FusedPairNeighbors& neighbors) = 0;
+
+        //! Finish a fused pass (release the force arrays)
+        virtual void endFusedPass() = 0;
+    };
+
+//! Evaluates several pair potentials in a single pass over a shared neighbor list
+/*! Every PotentialPair makes its own pass over the neighbor list, reading the positions and computing the minimum
+    image separation for every pair. When several pair potentials use the same neighbor list, PotentialPairFused
+    walks the list once, computes the separations of each particle's neighbors into a small scratch buffer and hands
+    that to every registered potential in turn. Each potential still accumulates into its own force and virial arrays,
+    so logging, energy flags and integration work exactly as without fusion.
+
+    Potentials register through PotentialPair::setFusedCompute(). Their computeForces() then calls computeFor(), which
+    runs a fused pass if the potential has already consumed the results of the last one (or the timestep changed).
+    Thus one pass serves all registered potentials in a time step, whatever order they are computed in.
+
+    \ingroup computes
+*/
+class PotentialPairFused : public Compute
+    {
+    public:
+        //! Constructor
+        PotentialPairFused(boost::shared_ptr<SystemDefinition> sysdef,
+                           boost::shared_ptr<NeighborList> nlist);
+
+        //! Destructor
+        virtual ~PotentialPairFused();
+
+        //! Get the neighbor list
+        boost::shared_ptr<NeighborList> getNeighborList() const
+            {
+            return m_nlist;
+            }
+
+        //! Register a potential
+        void addPotential(FusedPairPotential *potential);
+
+        //! Unregister a potential
+        void removePotential(FusedPairPotential *potential);
+
+        //! Get the number of registered potentials
+        unsigned int getNumPotentials() const
+            {
+            return (unsigned int)m_potentials.size();
+            }
+
+        //! Make sure the forces of a potential are up to date
+        void computeFor(FusedPairPotential *potential, unsigned int timestep);
+
+        //! Evaluate all registered potentials
+        virtual void compute(unsigned int timestep);
+
+    protected:
+        boost::shared_ptr<NeighborList> m_nlist;            //!< The neighbor list shared by all potentials
+        std::vector<FusedPairPotential *> m_potentials;     //!< Registered potentials
+        std::vector<bool> m_consumed;                       //!< True if a potential has used the last pass
+        unsigned int m_pass_timestep;                       //!< Timestep of the last pass
+        bool m_pass_valid;                                  //!< False if no pass has been done yet
+
+        std::vector<unsigned int> m_scratch_j;              //!< Neighbor indices of the current particle
+        std::vector<unsigned int> m_scratch_typej;          //!< Neighbor types of the current particle
+        std::vector<Scalar3> m_scratch_dx;                  //!< Neighbor separations of the current particle
+        std::vector<Scalar> m_scratch_rsq;                  //!< Neighbor distances squared of the current particle
+
+        //! Walk the neighbor list once and evaluate all registered potentials
+        void computePass(unsigned int timestep);
+    };
+
+//! Exports the PotentialPairFused class to python
+void export_PotentialPairFused();
+
+#endif
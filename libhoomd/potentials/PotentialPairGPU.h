@@ -120,6 +120,17 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! Fused neighbor list passes are not supported on the GPU
+        virtual void setFusedCompute(boost::shared_ptr<PotentialPairFused> fused)
+            {
+            if (fused)
+                {
+                this->m_exec_conf->msg->error() << "pair." << evaluator::getName()
+                                                << ": Fused pair potentials are not supported on the GPU" << std::endl;
+                throw std::runtime_error("Error setting up fused pair potential");
+                }
+            }
+
         #ifdef ENABLE_MPI
         /*! Precompute the pair force without rebuilding the neighbor list
          *
@@ -61,6 +61,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BondedGroupData.h"
 #include "Initializers.h"
 #include "HOOMDInitializer.h"
+#include "CompressedTrajectoryReader.h"
+#include "DCDTrajectoryReader.h"
 #include "RandomGenerator.h"
 #include "Compute.h"
 #include "CellList.h"
@@ -96,8 +98,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PDBDumpWriter.h"
 #include "MOL2DumpWriter.h"
 #include "DCDDumpWriter.h"
+#include "CompressedDumpWriter.h"
 #include "Logger.h"
 #include "MSDAnalyzer.h"
+#include "RDFAnalyzer.h"
+#include "StructureFactorAnalyzer.h"
 #include "CallbackAnalyzer.h"
 #include "Updater.h"
 #include "Integrator.h"
@@ -132,6 +137,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PotentialPairDPDThermo.h"
 #include "EvaluatorTersoff.h"
 #include "PotentialPair.h"
+#include "PotentialPairFused.h"
 #include "PotentialTersoff.h"
 #include "PPPMForceCompute.h"
 #include "AllExternalPotentials.h"
@@ -189,6 +195,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Communicator.h"
 #include "DomainDecomposition.h"
 #include "LoadBalancer.h"
+#include "ReplicaExchangeUpdater.h"
 
 #ifdef ENABLE_CUDA
 #include "CommunicatorGPU.h"
@@ -500,6 +507,7 @@ BOOST_PYTHON_MODULE(hoomd)
     .def(vector_indexing_suite<std::vector<Scalar3> >());
 
     InstallSIGINTHandler();
+    def("install_checkpoint_handler", &InstallCheckpointHandler);
 
     // utils
     export_hoomd_math_functions();
@@ -524,6 +532,8 @@ BOOST_PYTHON_MODULE(hoomd)
     export_RandomInitializer();
     export_SimpleCubicInitializer();
     export_HOOMDInitializer();
+    export_CompressedTrajectoryReader();
+    export_DCDTrajectoryReader();
     export_RandomGenerator();
 
     // computes
@@ -556,6 +566,7 @@ BOOST_PYTHON_MODULE(hoomd)
     export_PotentialPair<PotentialPairZBL> ("PotentialPairZBL");
     export_PotentialTersoff<PotentialTripletTersoff> ("PotentialTersoff");
     export_PotentialPair<PotentialPairMie>("PotentialPairMie");
+    export_PotentialPairFused();
     export_tersoff_params();
     export_AnisoPotentialPair<AnisoPotentialPairGB> ("AnisoPotentialPairGB");
     export_AnisoPotentialPair<AnisoPotentialPairDipole> ("AnisoPotentialPairDipole");
@@ -644,9 +655,12 @@ BOOST_PYTHON_MODULE(hoomd)
     export_POSDumpWriter();
     export_PDBDumpWriter();
     export_DCDDumpWriter();
+    export_CompressedDumpWriter();
     export_MOL2DumpWriter();
     export_Logger();
     export_MSDAnalyzer();
+    export_RDFAnalyzer();
+    export_StructureFactorAnalyzer();
     export_CallbackAnalyzer();
     export_ParticleGroup();
 
@@ -701,6 +715,7 @@ BOOST_PYTHON_MODULE(hoomd)
     export_Communicator();
     export_DomainDecomposition();
     export_LoadBalancer();
+    export_ReplicaExchangeUpdater();
 #ifdef ENABLE_CUDA
     export_CommunicatorGPU();
     export_LoadBalancerGPU();
@@ -56,6 +56,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "System.h"
 #include "SignalHandler.h"
+#include "HOOMDDumpWriter.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -81,7 +82,8 @@ PyObject* walltimeLimitExceptionTypeObj = 0;
 System::System(boost::shared_ptr<SystemDefinition> sysdef, unsigned int initial_tstep)
         : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep), m_cur_tps(0),
         m_last_status_time(0), m_last_status_tstep(initial_tstep), m_quiet_run(false),
-        m_profile(false), m_stats_period(10)
+        m_profile(false), m_stats_period(10), m_checkpoint_margin(0.0), m_checkpoint_written(false),
+        m_checkpoint_tstep(0)
     {
     // sanity check
     assert(m_sysdef);
@@ -438,6 +440,9 @@ void System::setCommunicator(boost::shared_ptr<Communicator> comm)
 
     run() can be called as many times as the user wishes:
     each time, it will continue at the time step where it left off.
+
+    The python GIL is released for the duration of the run so that python threads can execute concurrently.
+    Calls into python (\a callback, variable periods, CallbackAnalyzer) re-acquire it with a ScopedGILAcquire.
 */
 
 void System::run(unsigned int nsteps, unsigned int cb_frequency,
@@ -486,6 +491,12 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
     resetStats();
 
+    // evaluate the callback object before releasing the GIL
+    bool has_callback = callback;
+
+    // allow python threads to run while the simulation runs
+    ScopedGILRelease gil_release;
+
     // catch exceptions during simulation
     try
         {
@@ -510,6 +521,45 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             // check the clock and output a status line if needed
             uint64_t cur_time = m_clk.getTime();
 
+            // write a checkpoint and end the run if requested by a signal, or when the time limit is close
+            if (m_checkpoint_writer && m_cur_tstep % limit_multiple == 0)
+                {
+                unsigned int checkpoint = g_checkpoint_recvd ? 1 : 0;
+
+                if (limit_hours != 0.0f)
+                    {
+                    int64_t time_limit = int64_t((limit_hours - m_checkpoint_margin) * 3600.0 * 1e9);
+                    if (int64_t(cur_time) - initial_time > time_limit)
+                        checkpoint = 1;
+                    }
+
+                if (walltime_stop != NULL)
+                    {
+                    time_t end_time = atoi(walltime_stop);
+                    time_t predict_time = time(NULL) + time_t(m_checkpoint_margin * 3600.0);
+
+                    // predict when the next limit_multiple will be reached
+                    if (m_cur_tps != Scalar(0))
+                        predict_time += time_t(Scalar(limit_multiple) / m_cur_tps);
+
+                    if (predict_time >= end_time)
+                        checkpoint = 1;
+                    }
+
+                #ifdef ENABLE_MPI
+                // if any processor wants to write a checkpoint, write it on all processors
+                if (m_comm)
+                    MPI_Allreduce(MPI_IN_PLACE, &checkpoint, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+                #endif
+
+                if (checkpoint)
+                    {
+                    writeCheckpoint();
+                    m_exec_conf->msg->notice(2) << "Ending run at time step " << m_cur_tstep << " after writing a checkpoint" << endl;
+                    break;
+                    }
+                }
+
             // check if the time limit has exceeded
             if (limit_hours != 0.0f)
                 {
@@ -564,11 +614,17 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
             // execute python callback, if present and needed
             // a negative return value indicates immediate end of run.
-            if (callback && (cb_frequency > 0) && (m_cur_tstep % cb_frequency == 0))
+            if (has_callback && (cb_frequency > 0) && (m_cur_tstep % cb_frequency == 0))
                 {
-                boost::python::object rv = callback(m_cur_tstep);
-                extract<int> extracted_rv(rv);
-                if (extracted_rv.check() && extracted_rv() < 0)
+                bool end_run = false;
+                    {
+                    ScopedGILAcquire gil;
+                    boost::python::object rv = callback(m_cur_tstep);
+                    extract<int> extracted_rv(rv);
+                    end_run = extracted_rv.check() && extracted_rv() < 0;
+                    }
+
+                if (end_run)
                     {
                     m_exec_conf->msg->notice(2) << "End of run requested by python callback at step "
                          << m_cur_tstep << " / " << m_end_tstep << endl;
@@ -596,7 +652,10 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
                 {
                 if (analyzer->shouldExecute(m_cur_tstep))
+                    {
+                    PerformanceRegion region(analyzer->m_analyzer->getAnalyzeTimer());
                     analyzer->m_analyzer->analyze(m_cur_tstep);
+                    }
                 }
 
             // execute updaters
@@ -604,7 +663,10 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             for (updater =  m_updaters.begin(); updater != m_updaters.end(); ++updater)
                 {
                 if (updater->shouldExecute(m_cur_tstep))
+                    {
+                    PerformanceRegion region(updater->m_updater->getUpdateTimer());
                     updater->m_updater->update(m_cur_tstep);
+                    }
                 }
 
             // look ahead to the next time step and see which analyzers and updaters will be executed
@@ -613,7 +675,10 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
             // execute the integrator
             if (m_integrator)
+                {
+                PerformanceRegion region(m_integrator->getUpdateTimer());
                 m_integrator->update(m_cur_tstep);
+                }
 
             // quit if cntrl-C was pressed
             if (g_sigint_recvd)
@@ -662,8 +727,9 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
     m_last_status_tstep = m_cur_tstep;
 
     // execute python callback, if present and needed
-    if (callback && (cb_frequency == 0))
+    if (has_callback && (cb_frequency == 0))
         {
+        ScopedGILAcquire gil;
         callback(m_cur_tstep);
         }
 
@@ -689,6 +755,8 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         printStats();
 
     // throw a WalltimeLimitReached exception if we timed out, but only if the user is using the HOOMD_WALLTIME_STOP feature
+    gil_release.restore();
+
     if (timeout_end_run && walltime_stop != NULL)
         {
         PyErr_SetString(walltimeLimitExceptionTypeObj, "HOOMD_WALLTIME_STOP reached");
@@ -703,8 +771,8 @@ void System::enableProfiler(bool enable)
     m_profile = enable;
     }
 
-/*! \param logger Logger to register computes and updaters with
-    All computes and updaters registered with the system are also registerd with the logger.
+/*! \param logger Logger to register computes, updaters and analyzers with
+    All computes, updaters and analyzers registered with the system are also registerd with the logger.
 */
 void System::registerLogger(boost::shared_ptr<Logger> logger)
     {
@@ -717,6 +785,11 @@ void System::registerLogger(boost::shared_ptr<Logger> logger)
     for (updater = m_updaters.begin(); updater != m_updaters.end(); ++updater)
         logger->registerUpdater(updater->m_updater);
 
+    // analyzers
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        logger->registerAnalyzer(analyzer->m_analyzer);
+
     // computes
     map< string, boost::shared_ptr<Compute> >::iterator compute;
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
@@ -730,6 +803,33 @@ void System::setStatsPeriod(unsigned int seconds)
     m_stats_period = seconds;
     }
 
+/*! \param writer Restart file writer for the checkpoints (NULL to disable checkpoints)
+    \param margin_hours Time before the end of the run time limit at which the checkpoint is written
+
+    A run ends with a checkpoint when a signal installed with InstallCheckpointHandler() arrives, or when less than
+    \a margin_hours remain of \a limit_hours or of the time set in HOOMD_WALLTIME_STOP. The conditions are checked
+    at the time steps that are a multiple of \a limit_multiple (see run()).
+*/
+void System::setCheckpoint(boost::shared_ptr<HOOMDDumpWriter> writer, double margin_hours)
+    {
+    m_checkpoint_writer = writer;
+    m_checkpoint_margin = margin_hours;
+    }
+
+/*! The checkpoint is written only once per time step, so that runs that end immediately do not rewrite it.
+*/
+void System::writeCheckpoint()
+    {
+    if (m_checkpoint_written && m_checkpoint_tstep == m_cur_tstep)
+        return;
+
+    m_exec_conf->msg->notice(2) << "Writing checkpoint at time step " << m_cur_tstep << endl;
+    m_checkpoint_writer->writeRestart(m_cur_tstep);
+
+    m_checkpoint_written = true;
+    m_checkpoint_tstep = m_cur_tstep;
+    }
+
 /*! \param enable Enable/disable autotuning
     \param period period (approximate) in time steps when returning occurs
 */
@@ -818,6 +918,9 @@ void System::printStats()
     map< string, boost::shared_ptr<Compute> >::iterator compute;
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
         compute->second->printStats();
+
+    // host memory allocations
+    m_exec_conf->getHostArena().printStats();
     }
 
 void System::resetStats()
@@ -941,6 +1044,7 @@ void export_System()
 
     .def("registerLogger", &System::registerLogger)
     .def("setStatsPeriod", &System::setStatsPeriod)
+    .def("setCheckpoint", &System::setCheckpoint)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
     .def("enableQuietRun", &System::enableQuietRun)
@@ -54,6 +54,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Compute.h"
 #include "Integrator.h"
 #include "Logger.h"
+#include "ScopedGIL.h"
 
 #include <string>
 #include <vector>
@@ -69,6 +70,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class Communicator;
 #endif
 
+class HOOMDDumpWriter;
+
 /*! \file System.h
     \brief Declares the System class and associated helper classes
 */
@@ -204,6 +207,9 @@ class System
         //! Sets the statistics period
         void setStatsPeriod(unsigned int seconds);
 
+        //! Sets the writer for checkpoints at the end of a job
+        void setCheckpoint(boost::shared_ptr<HOOMDDumpWriter> writer, double margin_hours);
+
         //! Get the average TPS from the last run
         Scalar getLastTPS() const
             {
@@ -255,8 +261,12 @@ class System
                     {
                     if (m_is_variable_period)
                         {
-                        boost::python::object pynext = m_update_func(m_n);
-                        int next = (int)boost::python::extract<float>(pynext) + m_created_tstep;
+                        int next;
+                            {
+                            ScopedGILAcquire gil;
+                            boost::python::object pynext = m_update_func(m_n);
+                            next = (int)boost::python::extract<float>(pynext) + m_created_tstep;
+                            }
 
                         if (next < 0)
                             {
@@ -362,8 +372,12 @@ class System
                     {
                     if (m_is_variable_period)
                         {
-                        boost::python::object pynext = m_update_func(m_n);
-                        int next = (int)boost::python::extract<float>(pynext) + m_created_tstep;
+                        int next;
+                            {
+                            ScopedGILAcquire gil;
+                            boost::python::object pynext = m_update_func(m_n);
+                            next = (int)boost::python::extract<float>(pynext) + m_created_tstep;
+                            }
 
                         if (next < 0)
                             {
@@ -463,6 +477,14 @@ class System
         bool m_profile;         //!< True if runs should be profiled
         unsigned int m_stats_period; //!< Number of seconds between statistics output lines
 
+        boost::shared_ptr<HOOMDDumpWriter> m_checkpoint_writer; //!< Writer for checkpoints at the end of a job
+        double m_checkpoint_margin;     //!< Time (in hours) before the end of the time limit to write the checkpoint
+        bool m_checkpoint_written;      //!< True if a checkpoint has been written
+        unsigned int m_checkpoint_tstep;    //!< Time step of the last checkpoint
+
+        //! Write a checkpoint at the current time step
+        void writeCheckpoint();
+
         // --------- Steps in the simulation run implemented in helper functions
         //! Sets up m_profiler and attaches/detaches to/from all computes, updaters, and analyzers
         void setupProfiling();
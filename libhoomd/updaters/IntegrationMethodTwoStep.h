@@ -204,6 +204,18 @@ class IntegrationMethodTwoStep : boost::noncopyable
             return Scalar(0.0);
             }
 
+        //! Get the temperature set point of a thermostatted method
+        /*! \param timestep Current time step
+            \param T Set to the temperature set point at \a timestep, if the method has one
+            \returns true if the method controls the temperature
+
+            The base class returns false. Thermostatted methods override this to report their set point.
+        */
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+            {
+            return false;
+            }
+
         //! Change the timestep
         void setDeltaT(Scalar deltaT);
 
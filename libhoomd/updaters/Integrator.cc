@@ -74,7 +74,8 @@ using namespace std;
 /*! \param sysdef System to update
     \param deltaT Time step to use
 */
-Integrator::Integrator(boost::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(boost::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
+    : Updater(sysdef), m_deltaT(deltaT), m_respa_offset(0)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -97,6 +98,7 @@ void Integrator::addForceCompute(boost::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
+    m_force_periods.push_back(1);
     fc->setDeltaT(m_deltaT);
     }
 
@@ -115,6 +117,7 @@ void Integrator::addForceConstraint(boost::shared_ptr<ForceConstraint> fc)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_force_periods.clear();
     m_constraint_forces.clear();
     }
 
@@ -171,6 +174,10 @@ unsigned int Integrator::getNDOFRemoved()
         - tilt factors xy, xz, yz
         - momentum
         - particle number N
+        - time_integrate, the wall clock time (in seconds) spent in update() since the last log write, excluding the
+          force computes, neighbor list and communication it triggers
+        - time_comm and ghost_count (see Communicator::getProvidedLogQuantities()), which are 0 without domain
+          decomposition
 
     See Logger for more information on what this is about.
 */
@@ -186,6 +193,9 @@ std::vector< std::string > Integrator::getProvidedLogQuantities()
     result.push_back("yz");
     result.push_back("momentum");
     result.push_back("N");
+    result.push_back("time_integrate");
+    result.push_back("time_comm");
+    result.push_back("ghost_count");
     return result;
     }
 
@@ -258,6 +268,23 @@ Scalar Integrator::getLogValue(const std::string& quantity, unsigned int timeste
         {
         return (Scalar) m_pdata->getNGlobal();
         }
+    else if (quantity == "time_integrate")
+        {
+        Scalar t = m_update_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
+    else if (quantity == "time_comm" || quantity == "ghost_count")
+        {
+#ifdef ENABLE_MPI
+        if (m_comm)
+            return m_comm->getLogValue(quantity, timestep);
+#endif
+        return Scalar(0.0);
+        }
     else
         {
         m_exec_conf->msg->error() << "integrate.*: " << quantity << " is not a valid log quantity for Integrator" << endl;
@@ -339,6 +366,37 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     return Scalar(p_tot);
     }
 
+/*! \param i Index of the force in \a m_forces
+    \param timestep Current time step of the simulation
+    \param weight Factor to multiply the force and torque of the force compute with when summing the net force
+    \returns true if the force needs to be computed and summed on this step
+
+    A force with an evaluation period of \a p > 1 is computed on every \a p'th step (counted from \a m_respa_offset)
+    and enters the net force with a weight of \a p. Between those steps it is skipped, unless the potential energy or
+    virial is requested. In that case it is computed, but only its energy and virial are summed (\a weight = 0).
+*/
+bool Integrator::getForceWeight(unsigned int i, unsigned int timestep, Scalar& weight)
+    {
+    assert(i < m_force_periods.size());
+    unsigned int period = m_force_periods[i];
+    if (period == 1)
+        {
+        weight = Scalar(1.0);
+        return true;
+        }
+
+    if ((timestep - m_respa_offset) % period == 0)
+        {
+        weight = Scalar(period);
+        return true;
+        }
+
+    PDataFlags flags = m_pdata->getFlags();
+    weight = Scalar(0.0);
+    return flags[pdata_flag::potential_energy] || flags[pdata_flag::pressure_tensor]
+        || flags[pdata_flag::isotropic_virial];
+    }
+
 /*! \param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
@@ -346,9 +404,19 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // determine which forces are active on this step
+    std::vector<unsigned int> active;
+    std::vector<Scalar> weights;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        Scalar weight;
+        if (getForceWeight(i, timestep, weight))
+            {
+            m_forces[i]->compute(timestep);
+            active.push_back(i);
+            weights.push_back(weight);
+            }
+        }
 
     if (m_prof)
         {
@@ -381,13 +449,16 @@ void Integrator::computeNetForce(unsigned int timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        for (unsigned int cur_force = 0; cur_force < active.size(); cur_force++)
             {
+            boost::shared_ptr<ForceCompute> force_compute = m_forces[active[cur_force]];
+            Scalar weight = weights[cur_force];
+
             //phasing out ForceDataArrays
-            //ForceDataArrays force_arrays = (*force_compute)->acquire();
-            GPUArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GPUArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GPUArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
+            //ForceDataArrays force_arrays = force_compute->acquire();
+            GPUArray<Scalar4>& h_force_array = force_compute->getForceArray();
+            GPUArray<Scalar>& h_virial_array = force_compute->getVirialArray();
+            GPUArray<Scalar4>& h_torque_array = force_compute->getTorqueArray();
 
             ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
             ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
@@ -396,14 +467,14 @@ void Integrator::computeNetForce(unsigned int timestep)
             unsigned int virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += weight*h_force.data[j].x;
+                h_net_force.data[j].y += weight*h_force.data[j].y;
+                h_net_force.data[j].z += weight*h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += weight*h_torque.data[j].x;
+                h_net_torque.data[j].y += weight*h_torque.data[j].y;
+                h_net_torque.data[j].z += weight*h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
@@ -413,7 +484,7 @@ void Integrator::computeNetForce(unsigned int timestep)
                 }
 
             for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
+                external_virial[k] += force_compute->getExternalVirial(k);
             }
         }
 
@@ -502,11 +573,19 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         throw runtime_error("Error computing accelerations");
         }
 
-    // compute all the normal forces first
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // compute all the normal forces active on this step first
+    std::vector<unsigned int> active;
+    std::vector<Scalar> weights;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        Scalar weight;
+        if (getForceWeight(i, timestep, weight))
+            {
+            m_forces[i]->compute(timestep);
+            active.push_back(i);
+            weights.push_back(weight);
+            }
+        }
 
     if (m_prof)
         {
@@ -538,7 +617,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (active.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             cudaMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -551,86 +630,92 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < active.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GPUArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GPUArray<Scalar4>& d_force_array0 = m_forces[active[cur_force]]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GPUArray<Scalar>& d_virial_array0 = m_forces[active[cur_force]]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GPUArray<Scalar4>& d_torque_array0 = m_forces[active[cur_force]]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.w0 = weights[cur_force];
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < active.size())
                 {
-                const GPUArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array1 = m_forces[active[cur_force+1]]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array1 = m_forces[active[cur_force+1]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array1 = m_forces[active[cur_force+1]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.w1 = weights[cur_force+1];
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < active.size())
                 {
-                const GPUArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array2 = m_forces[active[cur_force+2]]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array2 = m_forces[active[cur_force+2]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array2 = m_forces[active[cur_force+2]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.w2 = weights[cur_force+2];
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < active.size())
                 {
-                const GPUArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array3 = m_forces[active[cur_force+3]]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array3 = m_forces[active[cur_force+3]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array3 = m_forces[active[cur_force+3]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.w3 = weights[cur_force+3];
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < active.size())
                 {
-                const GPUArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array4 = m_forces[active[cur_force+4]]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array4 = m_forces[active[cur_force+4]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array4 = m_forces[active[cur_force+4]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.w4 = weights[cur_force+4];
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < active.size())
                 {
-                const GPUArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array5 = m_forces[active[cur_force+5]]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array5 = m_forces[active[cur_force+5]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array5 = m_forces[active[cur_force+5]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.w5 = weights[cur_force+5];
                 }
 
             // clear on the first iteration only
@@ -654,9 +739,9 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
 
     // add up external virials
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
+    for (unsigned int cur_force = 0; cur_force < active.size(); cur_force ++)
         for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
+            external_virial[k] += m_forces[active[cur_force]]->getExternalVirial(k);
 
     for (unsigned int k = 0; k < 6; k++)
         m_pdata->setExternalVirial(k, external_virial[k]);
@@ -837,6 +922,79 @@ void Integrator::prepRun(unsigned int timestep)
     {
     }
 
+/*! \param timestep Current time step of the simulation
+
+    The forces have usually already been evaluated for \a timestep at the end of the previous step. Updaters that
+    replace the whole particle configuration (such as ReplicaExchangeUpdater) call this method to evaluate all forces
+    active on \a timestep again for the new configuration and update the net force and virial.
+*/
+void Integrator::recomputeNetForce(unsigned int timestep)
+    {
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // the new configuration needs new ghost particles
+        m_comm->forceMigrate();
+        m_comm->communicate(timestep);
+        }
+#endif
+
+    // computeNetForce() does not recompute forces that have already been evaluated on this step
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        Scalar weight;
+        if (getForceWeight(i, timestep, weight))
+            m_forces[i]->forceCompute(timestep);
+        }
+
+    std::vector< boost::shared_ptr<ForceConstraint> >::iterator force_constraint;
+    for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
+        (*force_constraint)->forceCompute(timestep);
+
+#ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        computeNetForceGPU(timestep);
+    else
+#endif
+        computeNetForce(timestep);
+    }
+
+/*! Force computes skip the per particle energies on time steps where no analyzer or updater requests them, so the
+    energy component of the net force is only valid on those steps. computeNetEnergy() lets every force compute catch
+    up on skipped energies and sums the energies of all forces, including those with an evaluation period > 1, into
+    the net force. The force components and the virial are not changed.
+*/
+void Integrator::computeNetEnergy()
+    {
+    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
+    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        (*force_compute)->ensureEnergyComputed();
+
+    std::vector< boost::shared_ptr<ForceConstraint> >::iterator force_constraint;
+    for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
+        (*force_constraint)->ensureEnergyComputed();
+
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
+    unsigned int nparticles = m_pdata->getN();
+
+    for (unsigned int j = 0; j < nparticles; j++)
+        h_net_force.data[j].w = Scalar(0.0);
+
+    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        {
+        ArrayHandle<Scalar4> h_force((*force_compute)->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int j = 0; j < nparticles; j++)
+            h_net_force.data[j].w += h_force.data[j].w;
+        }
+
+    for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
+        {
+        ArrayHandle<Scalar4> h_force((*force_constraint)->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int j = 0; j < nparticles; j++)
+            h_net_force.data[j].w += h_force.data[j].w;
+        }
+    }
+
 #ifdef ENABLE_MPI
 /*! \param tstep Time step for which to determine the flags
 
@@ -876,11 +1034,13 @@ void Integrator::setCommunicator(boost::shared_ptr<Communicator> comm)
 
 void Integrator::computeCallback(unsigned int timestep)
     {
-    // pre-compute all active forces
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+    // pre-compute all forces active on this step
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        Scalar weight;
+        if (getForceWeight(i, timestep, weight))
+            m_forces[i]->preCompute(timestep);
+        }
 
     // pre-compute all active constraint forces
     std::vector< boost::shared_ptr<ForceConstraint> >::iterator force_constraint;
@@ -916,5 +1076,6 @@ void export_Integrator()
     .def("setDeltaT", &Integrator::setDeltaT)
     .def("getNDOF", &Integrator::getNDOF)
     .def("getRotationalNDOF", &Integrator::getRotationalNDOF)
+    .def("computeNetEnergy", &Integrator::computeNetEnergy)
     ;
     }
@@ -93,6 +93,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getNDOF().
 
+    Each ForceCompute is evaluated every step by default. Derived integrators may assign a longer evaluation period
+    to a force in \a m_force_periods (multiple time step integration). A force with period \a p is then only
+    evaluated on every \a p'th step counted from \a m_respa_offset and its force and torque enter the net force
+    multiplied by \a p, so that a velocity Verlet style integrator applies it as an impulse. See getForceWeight().
+
     Integrators take "ownership" of the particle's accellerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -166,6 +171,24 @@ class Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Recompute the net force after the particle configuration has been replaced
+        void recomputeNetForce(unsigned int timestep);
+
+        //! Sum the per particle energies of all forces into the net force
+        void computeNetEnergy();
+
+        //! Get the temperature set point of the integration
+        /*! \param timestep Current time step
+            \param T Set to the temperature set point at \a timestep, if there is one
+            \returns true if the integrator controls the temperature
+
+            The base class returns false.
+        */
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+            {
+            return false;
+            }
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -182,6 +205,12 @@ class Integrator : public Updater
 
         std::vector< boost::shared_ptr<ForceConstraint> > m_constraint_forces;    //!< List of all the constraints
 
+        std::vector<unsigned int> m_force_periods;  //!< Evaluation period (in steps) of each entry in m_forces
+        unsigned int m_respa_offset;                //!< Time step at which all force periods are in phase
+
+        //! Determine how a force contributes to the net force on this step
+        bool getForceWeight(unsigned int i, unsigned int timestep, Scalar& weight);
+
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
 
@@ -357,6 +357,9 @@ void IntegratorTwoStep::prepRun(unsigned int timestep)
         m_first_step = false;
         m_prepared = true;
 
+        // all force periods start in phase on the first step
+        m_respa_offset = timestep;
+
 #ifdef ENABLE_MPI
         if (m_comm)
             {
@@ -383,6 +386,33 @@ void IntegratorTwoStep::prepRun(unsigned int timestep)
         }
     }
 
+/*! \param fc Force compute, previously added with addForceCompute()
+    \param period Evaluate \a fc every \a period time steps
+
+    The period is reset to 1 when the force computes are removed with removeForceComputes().
+*/
+void IntegratorTwoStep::setForcePeriod(boost::shared_ptr<ForceCompute> fc, unsigned int period)
+    {
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: force evaluation period must be at least 1" << endl;
+        throw runtime_error("Error setting force period");
+        }
+
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (m_forces[i] == fc)
+            {
+            m_force_periods[i] = period;
+            return;
+            }
+        }
+
+    m_exec_conf->msg->error() << "integrate.mode_standard: cannot set the period of a force that is not added"
+                              << endl;
+    throw runtime_error("Error setting force period");
+    }
+
 /*! Return the combined flags of all integration methods.
 */
 PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
@@ -400,6 +430,36 @@ PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
     return flags;
     }
 
+/*! \param timestep Current time step
+    \param T Set to the common temperature set point of all thermostatted methods
+    \returns true if at least one method controls the temperature
+
+    It is an error if two methods thermostat their groups to different temperatures.
+*/
+bool IntegratorTwoStep::getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+    {
+    bool found = false;
+
+    std::vector< boost::shared_ptr<IntegrationMethodTwoStep> >::iterator method;
+    for (method = m_methods.begin(); method != m_methods.end(); ++method)
+        {
+        Scalar T_method;
+        if (!(*method)->getTemperatureSetPoint(timestep, T_method))
+            continue;
+
+        if (found && T_method != T)
+            {
+            m_exec_conf->msg->error() << "integrate.mode_standard: Integration methods have different temperature "
+                                      << "set points (" << T << " and " << T_method << ")" << endl;
+            throw runtime_error("Error getting the temperature set point");
+            }
+        T = T_method;
+        found = true;
+        }
+
+    return found;
+    }
+
 #ifdef ENABLE_MPI
 //! Set the communicator to use
 void IntegratorTwoStep::setCommunicator(boost::shared_ptr<Communicator> comm)
@@ -432,6 +492,7 @@ void export_IntegratorTwoStep()
         .def("addIntegrationMethod", &IntegratorTwoStep::addIntegrationMethod)
         .def("removeAllIntegrationMethods", &IntegratorTwoStep::removeAllIntegrationMethods)
         .def("setAnisotropicMode", &IntegratorTwoStep::setAnisotropicMode)
+        .def("setForcePeriod", &IntegratorTwoStep::setForcePeriod)
         ;
 
     enum_<IntegratorTwoStep::AnisotropicMode>("IntegratorAnisotropicMode")
@@ -76,6 +76,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     To ensure that the user does not make a mistake and specify more than one method operating on a single particle,
     the particle groups are checked for intersections whenever a new method is added in addIntegrationMethod()
 
+    Slowly varying forces can be evaluated less often than every step with setForcePeriod() (impulse r-RESPA
+    multiple time step integration). A force with period \a p is evaluated every \a p steps, counted from the
+    first step of the first run, and enters the net force multiplied by \a p. The half step kicks of the velocity
+    Verlet style integration methods at the end of step \a n and the beginning of step \a n+1 then apply the
+    impulse \a p*deltaT*F/2 each. Integration methods need no knowledge of the force periods.
+
     \ingroup updaters
 */
 class IntegratorTwoStep : public Integrator
@@ -124,12 +130,18 @@ class IntegratorTwoStep : public Integrator
         //! Set the anisotropic mode of the integrator
         virtual void setAnisotropicMode(AnisotropicMode mode);
 
+        //! Set the number of time steps between evaluations of a force
+        void setForcePeriod(boost::shared_ptr<ForceCompute> fc, unsigned int period);
+
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
         //! Get needed pdata flags
         virtual PDataFlags getRequestedPDataFlags();
 
+        //! Get the temperature set point of the thermostatted integration methods
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T);
+
 #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -0,0 +1,359 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file ReplicaExchangeUpdater.cc
+    \brief Defines the ReplicaExchangeUpdater class
+*/
+
+#ifdef ENABLE_MPI
+#include "ReplicaExchangeUpdater.h"
+#include "saruprng.h"
+
+#include <boost/python.hpp>
+using namespace boost::python;
+
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param thermo ComputeThermo to evaluate the potential energy with
+    \param integrator Integrator used to recompute the forces after an exchange (and to read the temperature from)
+    \param seed Seed for the acceptance test (must be the same on all partitions)
+    \param hamiltonian Set to true if the replicas differ in their potential energy function
+*/
+ReplicaExchangeUpdater::ReplicaExchangeUpdater(boost::shared_ptr<SystemDefinition> sysdef,
+                                               boost::shared_ptr<ComputeThermo> thermo,
+                                               boost::shared_ptr<Integrator> integrator,
+                                               unsigned int seed,
+                                               bool hamiltonian)
+        : Updater(sysdef), m_thermo(thermo), m_integrator(integrator), m_seed(seed),
+          m_hamiltonian(hamiltonian), m_n_calls(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ReplicaExchangeUpdater" << endl;
+
+    if (m_exec_conf->getNPartitions() < 2)
+        {
+        m_exec_conf->msg->error() << "update.replica_exchange: At least two partitions are required" << endl;
+        throw runtime_error("Error initializing ReplicaExchangeUpdater");
+        }
+
+    resetStats();
+    }
+
+ReplicaExchangeUpdater::~ReplicaExchangeUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ReplicaExchangeUpdater" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Attempts to swap the configuration with the lower or upper neighbor partition, depending on the parity of the
+    partition index and the number of previous calls. Partitions without a partner in this round return immediately.
+*/
+void ReplicaExchangeUpdater::update(unsigned int timestep)
+    {
+    unsigned int partition = m_exec_conf->getPartition();
+    unsigned int n_partitions = m_exec_conf->getNPartitions();
+
+    // even pairs on even calls, odd pairs on odd calls
+    bool up = ((partition + m_n_calls) % 2 == 0);
+    m_n_calls++;
+
+    if ((up && partition + 1 >= n_partitions) || (!up && partition == 0))
+        return;
+
+    unsigned int partner = up ? partition + 1 : partition - 1;
+    unsigned int lower = up ? partition : partner;
+
+    if (m_sysdef->getRigidData()->getNumBodies() > 0)
+        {
+        m_exec_conf->msg->error() << "update.replica_exchange: Rigid bodies are not supported" << endl;
+        throw runtime_error("Error in replica exchange");
+        }
+
+    if (m_prof) m_prof->push(m_exec_conf, "replica exchange");
+
+    // make sure both replicas agree on the system size
+    unsigned int N = m_pdata->getNGlobal();
+    unsigned int N_partner = N;
+    exchange(&N_partner, 1, partner, true);
+    if (N_partner != N)
+        {
+        m_exec_conf->msg->error() << "update.replica_exchange: Partition " << partner << " has " << N_partner
+                                  << " particles, expected " << N << endl;
+        throw runtime_error("Error in replica exchange");
+        }
+
+    // the temperature of this replica is the set point of its thermostat
+    Scalar T;
+    if (!m_integrator->getTemperatureSetPoint(timestep, T))
+        {
+        m_exec_conf->msg->error() << "update.replica_exchange: The integrator has no thermostatted integration method"
+                                  << endl;
+        throw runtime_error("Error in replica exchange");
+        }
+
+    m_thermo->compute(timestep);
+    Scalar U = m_thermo->getPotentialEnergy();
+
+    SnapshotParticleData<Scalar> snap(N);
+    m_pdata->takeSnapshot(snap);
+    BoxDim box = m_pdata->getGlobalBox();
+
+    // both partners draw the same random number
+    Saru saru(m_seed, timestep, lower);
+    Scalar r = saru.d(0,1);
+
+    bool accept;
+    Scalar T_partner;
+    if (!m_hamiltonian)
+        {
+        // temperature replica exchange only needs the energies to decide
+        Scalar buf[2] = {U, T};
+        exchange(buf, 2, partner, true);
+        T_partner = buf[1];
+
+        Scalar delta = (Scalar(1.0)/T - Scalar(1.0)/T_partner) * (U - buf[0]);
+        accept = (delta >= Scalar(0.0) || r < exp(delta));
+
+        if (accept)
+            {
+            exchangeConfiguration(snap, box, partner);
+            loadConfiguration(snap, box, timestep);
+            }
+        }
+    else
+        {
+        // evaluate the own potential on the configuration of the partner
+        SnapshotParticleData<Scalar> snap_own = snap;
+        BoxDim box_own = box;
+        exchangeConfiguration(snap, box, partner);
+        loadConfiguration(snap, box, timestep);
+
+        m_thermo->forceCompute(timestep);
+        Scalar U_cross = m_thermo->getPotentialEnergy();
+
+        Scalar buf[3] = {U, U_cross, T};
+        exchange(buf, 3, partner, true);
+        T_partner = buf[2];
+
+        Scalar delta = (U - U_cross)/T + (buf[0] - buf[1])/T_partner;
+        accept = (delta >= Scalar(0.0) || r < exp(delta));
+
+        if (!accept)
+            loadConfiguration(snap_own, box_own, timestep);
+        }
+
+    if (accept)
+        {
+        // the new configuration was equilibrated at the temperature of the partner
+        scaleVelocities(sqrt(T/T_partner));
+        }
+
+    m_n_attempts[up ? 1 : 0]++;
+    if (accept)
+        m_n_accepted[up ? 1 : 0]++;
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param data Buffer to send, overwritten with the data received from the partner
+    \param n Number of elements in \a data
+    \param partner Partition to exchange with
+    \param broadcast If true, distribute the received data to all ranks in the partition
+
+    Only the root ranks of the two partitions communicate.
+*/
+template<class T>
+void ReplicaExchangeUpdater::exchange(T *data, unsigned int n, unsigned int partner, bool broadcast)
+    {
+    if (m_exec_conf->isRoot())
+        {
+        int partner_root = partner * m_exec_conf->getNRanks();
+        MPI_Status status;
+        MPI_Sendrecv_replace(data, n*sizeof(T), MPI_BYTE, partner_root, 0, partner_root, 0, MPI_COMM_WORLD, &status);
+        }
+
+    if (broadcast)
+        MPI_Bcast(data, n*sizeof(T), MPI_BYTE, 0, m_exec_conf->getMPICommunicator());
+    }
+
+/*! \param snap Snapshot of this replica, overwritten with the snapshot of the partner
+    \param box Global box of this replica, overwritten with the box of the partner
+    \param partner Partition to exchange with
+
+    The snapshot is only populated on the root rank, so only the box is broadcast. Particle types, masses, charges
+    and diameters are assumed to be identical in all replicas and are not exchanged.
+*/
+void ReplicaExchangeUpdater::exchangeConfiguration(SnapshotParticleData<Scalar>& snap,
+                                                   BoxDim& box,
+                                                   unsigned int partner)
+    {
+    unsigned int N = snap.size;
+    if (m_exec_conf->isRoot())
+        {
+        exchange(&snap.pos[0], N, partner, false);
+        exchange(&snap.vel[0], N, partner, false);
+        exchange(&snap.accel[0], N, partner, false);
+        exchange(&snap.image[0], N, partner, false);
+        exchange(&snap.orientation[0], N, partner, false);
+        exchange(&snap.angmom[0], N, partner, false);
+        }
+
+    Scalar3 L = box.getL();
+    Scalar buf[6] = {L.x, L.y, L.z, box.getTiltFactorXY(), box.getTiltFactorXZ(), box.getTiltFactorYZ()};
+    exchange(buf, 6, partner, true);
+
+    box.setL(make_scalar3(buf[0], buf[1], buf[2]));
+    box.setTiltFactors(buf[3], buf[4], buf[5]);
+    }
+
+/*! \param snap Snapshot to load
+    \param box Global box to set
+    \param timestep Current time step of the simulation
+*/
+void ReplicaExchangeUpdater::loadConfiguration(const SnapshotParticleData<Scalar>& snap,
+                                               const BoxDim& box,
+                                               unsigned int timestep)
+    {
+    m_pdata->setGlobalBox(box);
+    m_pdata->initializeFromSnapshot(snap);
+    m_integrator->recomputeNetForce(timestep);
+    }
+
+/*! \param factor Scale factor to apply
+*/
+void ReplicaExchangeUpdater::scaleVelocities(Scalar factor)
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        h_vel.data[i].x *= factor;
+        h_vel.data[i].y *= factor;
+        h_vel.data[i].z *= factor;
+
+        h_angmom.data[i].x *= factor;
+        h_angmom.data[i].y *= factor;
+        h_angmom.data[i].z *= factor;
+        h_angmom.data[i].w *= factor;
+        }
+    }
+
+/*! The acceptance ratios with the lower and the upper neighbor partition are provided.
+*/
+std::vector< std::string > ReplicaExchangeUpdater::getProvidedLogQuantities()
+    {
+    vector<string> list;
+    list.push_back("replica_exchange_acceptance_down");
+    list.push_back("replica_exchange_acceptance_up");
+    return list;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar ReplicaExchangeUpdater::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    unsigned int i;
+    if (quantity == "replica_exchange_acceptance_down")
+        i = 0;
+    else if (quantity == "replica_exchange_acceptance_up")
+        i = 1;
+    else
+        {
+        m_exec_conf->msg->error() << "update.replica_exchange: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+
+    if (m_n_attempts[i] == 0)
+        return Scalar(0.0);
+    return Scalar(m_n_accepted[i]) / Scalar(m_n_attempts[i]);
+    }
+
+void ReplicaExchangeUpdater::printStats()
+    {
+    if (m_exec_conf->msg->getNoticeLevel() < 1)
+        return;
+
+    unsigned int partition = m_exec_conf->getPartition();
+    m_exec_conf->msg->notice(1) << "-- Replica exchange stats (partition " << partition << "):" << endl;
+    if (m_n_attempts[0] > 0)
+        m_exec_conf->msg->notice(1) << "with partition " << partition-1 << ": " << m_n_accepted[0] << " / "
+                                    << m_n_attempts[0] << " accepted" << endl;
+    if (m_n_attempts[1] > 0)
+        m_exec_conf->msg->notice(1) << "with partition " << partition+1 << ": " << m_n_accepted[1] << " / "
+                                    << m_n_attempts[1] << " accepted" << endl;
+    }
+
+/*! Zero the counters.
+*/
+void ReplicaExchangeUpdater::resetStats()
+    {
+    m_n_attempts[0] = m_n_attempts[1] = 0;
+    m_n_accepted[0] = m_n_accepted[1] = 0;
+    }
+
+void export_ReplicaExchangeUpdater()
+    {
+    class_<ReplicaExchangeUpdater, boost::shared_ptr<ReplicaExchangeUpdater>, bases<Updater>, boost::noncopyable>
+    ("ReplicaExchangeUpdater", init< boost::shared_ptr<SystemDefinition>,
+                                     boost::shared_ptr<ComputeThermo>,
+                                     boost::shared_ptr<Integrator>,
+                                     unsigned int,
+                                     bool >())
+    ;
+    }
+#endif // ENABLE_MPI
@@ -0,0 +1,171 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file ReplicaExchangeUpdater.h
+    \brief Declares an updater that exchanges configurations between MPI partitions
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_MPI
+
+#ifndef __REPLICAEXCHANGEUPDATER_H__
+#define __REPLICAEXCHANGEUPDATER_H__
+
+#include "Updater.h"
+#include "ComputeThermo.h"
+#include "Integrator.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+//! Exchanges configurations between replicas running in different MPI partitions
+/*! Every partition (see ExecutionConfiguration::getPartition()) runs one replica of the system. Every time the updater
+    is executed, neighboring partitions attempt to swap their configurations. Even and odd pairs of partitions
+    (0-1, 2-3, ... and 1-2, 3-4, ...) alternate on consecutive exchange attempts.
+
+    In temperature replica exchange, the replicas differ only in the temperature set point \a T, which is read from
+    the thermostatted integration methods of the Integrator (see Integrator::getTemperatureSetPoint()). The swap of the
+    configurations \f$ x_i \f$ and \f$ x_j \f$ is accepted with probability
+    \f[ \min\left(1, \exp\left[(\beta_i - \beta_j)(U_i - U_j)\right]\right) \f]
+    where \f$ \beta = 1/T \f$ and \f$ U \f$ is the potential energy reported by the ComputeThermo.
+
+    In Hamiltonian replica exchange, each partition may also use a different potential energy function. The
+    configurations are swapped first, each replica evaluates its own potential energy \f$ U_i(x_j) \f$ on the
+    configuration of its partner, and the swap is accepted with probability
+    \f[ \min\left(1, \exp\left[-\beta_i (U_i(x_j) - U_i(x_i)) - \beta_j (U_j(x_i) - U_j(x_j))\right]\right) \f]
+    Rejected swaps restore the original configuration.
+
+    Only the root ranks of the two partners exchange messages (point to point on MPI_COMM_WORLD), the data is then
+    distributed within each partition. Both partners draw the same random number from a Saru stream seeded with the
+    time step and the lower partition index, so they reach the same decision without sending it. The velocities of an
+    accepted configuration are rescaled by \f$ \sqrt{T_i/T_j} \f$.
+
+    Only the particle configuration and the box are exchanged. The state of the thermostat and barostat (e.g. the
+    Nose-Hoover \f$ \xi \f$ and \f$ \eta \f$ of TwoStepNVT, or the barostat momenta of TwoStepNPTMTK) stays with
+    the partition, like the temperature set point. After a swap, these variables are no longer in equilibrium with the
+    configuration and relax on the time scale \a tau of the thermostat, so the exchange period should be long compared
+    to \a tau. Stochastic thermostats (TwoStepLangevin, TwoStepBD) carry no state.
+
+    Replica exchange replaces the whole particle configuration, so the Integrator is needed to recompute the net force
+    after a swap. All partitions must hold the same number of particles, and rigid bodies are not supported.
+
+    \ingroup updaters
+*/
+class ReplicaExchangeUpdater : public Updater
+    {
+    public:
+        //! Constructor
+        ReplicaExchangeUpdater(boost::shared_ptr<SystemDefinition> sysdef,
+                               boost::shared_ptr<ComputeThermo> thermo,
+                               boost::shared_ptr<Integrator> integrator,
+                               unsigned int seed,
+                               bool hamiltonian);
+
+        //! Destructor
+        virtual ~ReplicaExchangeUpdater();
+
+        //! Attempt an exchange with a neighboring partition
+        virtual void update(unsigned int timestep);
+
+        //! Returns a list of log quantities this updater calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        //! Print the acceptance statistics
+        virtual void printStats();
+
+        //! Reset the acceptance statistics
+        virtual void resetStats();
+
+        //! The potential energy is needed on exchange steps
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags(0);
+            flags[pdata_flag::potential_energy] = 1;
+            return flags;
+            }
+
+    private:
+        boost::shared_ptr<ComputeThermo> m_thermo;  //!< Computes the potential energy
+        boost::shared_ptr<Integrator> m_integrator; //!< Integrator to recompute the forces with after a swap
+        unsigned int m_seed;                        //!< Seed for the acceptance test
+        bool m_hamiltonian;                         //!< True if the replicas differ in their potential energy function
+
+        unsigned int m_n_calls;                     //!< Number of exchange attempts so far (alternates the pairing)
+        unsigned int m_n_attempts[2];               //!< Exchange attempts with the lower [0] and upper [1] partition
+        unsigned int m_n_accepted[2];               //!< Accepted exchanges with the lower [0] and upper [1] partition
+
+        //! Swap a buffer with the partner partition
+        template<class T>
+        void exchange(T *data, unsigned int n, unsigned int partner, bool broadcast);
+
+        //! Swap the configuration with the partner partition
+        void exchangeConfiguration(SnapshotParticleData<Scalar>& snap, BoxDim& box, unsigned int partner);
+
+        //! Replace the current configuration and recompute the forces
+        void loadConfiguration(const SnapshotParticleData<Scalar>& snap, const BoxDim& box, unsigned int timestep);
+
+        //! Scale all particle velocities and angular momenta
+        void scaleVelocities(Scalar factor);
+    };
+
+//! Export the ReplicaExchangeUpdater to python
+void export_ReplicaExchangeUpdater();
+
+#endif // __REPLICAEXCHANGEUPDATER_H__
+#endif // ENABLE_MPI
@@ -178,8 +178,18 @@ void SFCPackUpdater::applySortOrder()
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
 
-    // construct a temporary holding array for the sorted data
-    Scalar4 *scal4_tmp = new Scalar4[m_pdata->getN()];
+    // construct temporary holding arrays for the sorted data, reusing the buffers of the previous sort
+    HostArena& arena = m_exec_conf->getHostArena();
+    ScopedHostAllocation<Scalar4> scal4_buf(arena, m_pdata->getN());
+    ScopedHostAllocation<Scalar3> scal3_buf(arena, m_pdata->getN());
+    ScopedHostAllocation<Scalar> scal_buf(arena, m_pdata->getN());
+    ScopedHostAllocation<int3> int3_buf(arena, m_pdata->getN());
+    ScopedHostAllocation<unsigned int> uint_buf(arena, m_pdata->getN());
+    Scalar4 *scal4_tmp = scal4_buf.data;
+    Scalar3 *scal3_tmp = scal3_buf.data;
+    Scalar *scal_tmp = scal_buf.data;
+    int3 *int3_tmp = int3_buf.data;
+    unsigned int *uint_tmp = uint_buf.data;
 
     // sort positions and types
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
@@ -193,14 +203,12 @@ void SFCPackUpdater::applySortOrder()
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         h_vel.data[i] = scal4_tmp[i];
 
-    Scalar3 *scal3_tmp = new Scalar3[m_pdata->getN()];
     // sort accelerations
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         scal3_tmp[i] = h_accel.data[m_sort_order[i]];
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         h_accel.data[i] = scal3_tmp[i];
 
-    Scalar *scal_tmp  = new Scalar[m_pdata->getN()];
     // sort charge
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         scal_tmp[i] = h_charge.data[m_sort_order[i]];
@@ -268,14 +276,12 @@ void SFCPackUpdater::applySortOrder()
         }
 
     // sort image
-    int3 *int3_tmp = new int3[m_pdata->getN()];
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         int3_tmp[i] = h_image.data[m_sort_order[i]];
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         h_image.data[i] = int3_tmp[i];
 
     // sort body
-    unsigned int *uint_tmp = new unsigned int[m_pdata->getN()];
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         uint_tmp[i] = h_body.data[m_sort_order[i]];
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
@@ -292,13 +298,6 @@ void SFCPackUpdater::applySortOrder()
         {
         h_rtag.data[h_tag.data[i]] = i;
         }
-
-    delete[] scal_tmp;
-    delete[] scal4_tmp;
-    delete[] scal3_tmp;
-    delete[] uint_tmp;
-    delete[] int3_tmp;
-
     }
 
 //! x walking table for the hilbert curve
@@ -648,6 +647,37 @@ void SFCPackUpdater::writeTraversalOrder(const std::string& fname, const vector<
         }
     }
 
+/*! SFCPackUpdater provides
+    - \b time_sort - wall clock time (in seconds) spent sorting the particles since the last log write
+*/
+std::vector< std::string > SFCPackUpdater::getProvidedLogQuantities()
+    {
+    vector<string> result;
+    result.push_back("time_sort");
+    return result;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar SFCPackUpdater::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "time_sort")
+        {
+        Scalar t = m_update_timer.getIntervalSeconds(timestep);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        return t;
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "sorter: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+    }
+
 void export_SFCPackUpdater()
     {
     class_<SFCPackUpdater, boost::shared_ptr<SFCPackUpdater>, bases<Updater>, boost::noncopyable>
@@ -104,6 +104,12 @@ class SFCPackUpdater : public Updater
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
+        //! Returns a list of log quantities this updater calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
         //! Set the grid dimension
         /*! \param grid New grid dimension to set
             \note It is automatically rounded up to the nearest power of 2
@@ -50,7 +50,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Maintainer: joaander
 
 #include "TwoStepBD.h"
-#include "saruprng.h"
+#include "RandomNumbers.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -113,23 +113,25 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
 
-    // initialize the RNG
-    Saru saru(m_seed, timestep, 0xffaabb);
-
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // every particle draws from its own random number stream, so the loop can be split between threads
+    #pragma omp parallel for schedule(static)
+    for (int group_idx = 0; group_idx < (int)group_size; group_idx++)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
+        unsigned int j = h_index_array.data[group_idx];
 
         // compute the random force
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz =  saru.s<Scalar>(-1,1);
+        PhiloxGenerator rng(m_seed, rng_stream::bd, timestep, h_tag.data[j]);
+        Scalar rx = rng.normal<Scalar>();
+        Scalar ry = rng.normal<Scalar>();
+        Scalar rz = rng.normal<Scalar>();
 
         Scalar gamma;
         if (m_use_lambda)
@@ -140,9 +142,8 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
             gamma = h_gamma.data[type];
             }
 
-        // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
-        // it is not the dimensionality of the system
-        Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*currentTemp/m_deltaT);
+        // compute the bd force
+        Scalar coeff = fast::sqrt(Scalar(2.0)*gamma*currentTemp/m_deltaT);
         Scalar Fr_x = rx*coeff;
         Scalar Fr_y = ry*coeff;
         Scalar Fr_z = rz*coeff;
@@ -161,10 +162,10 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
         // draw a new random velocity for particle j
         Scalar mass =  h_vel.data[j].w;
         Scalar sigma = fast::sqrt(currentTemp/mass);
-        h_vel.data[j].x = gaussian_rng(saru, sigma);
-        h_vel.data[j].y = gaussian_rng(saru, sigma);
+        h_vel.data[j].x = rng.normal<Scalar>()*sigma;
+        h_vel.data[j].y = rng.normal<Scalar>()*sigma;
         if (D > 2)
-            h_vel.data[j].z = gaussian_rng(saru, sigma);
+            h_vel.data[j].z = rng.normal<Scalar>()*sigma;
         else
             h_vel.data[j].z = 0;
         }
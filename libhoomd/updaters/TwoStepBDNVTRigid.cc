@@ -239,10 +239,13 @@ void TwoStepBDNVTRigid::integrateStepTwo(unsigned int timestep)
     ArrayHandle<Scalar4> angmom_handle(m_rigid_data->getAngMom(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> angvel_handle(m_rigid_data->getAngVel(), access_location::host, access_mode::readwrite);
 
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
+
     // 2nd step: final integration
+    #pragma omp parallel for schedule(static)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        unsigned int body = h_body_group.data[group_idx];
 
         Scalar dtfm = m_dt_half / body_mass_handle.data[body];
         vel_handle.data[body].x += dtfm * force_handle.data[body].x;
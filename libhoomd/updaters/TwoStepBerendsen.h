@@ -85,6 +85,17 @@ class TwoStepBerendsen : public IntegrationMethodTwoStep
             m_T = T;
             }
 
+        //! Get the temperature set point
+        /*! \param timestep Current time step
+            \param T Set to the temperature set point at \a timestep
+            \returns true
+        */
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+            {
+            T = m_T->getValue(timestep);
+            return true;
+            }
+
         //! Update the tau value
         //! \param tau New time constant to set
         virtual void setTau(Scalar tau)
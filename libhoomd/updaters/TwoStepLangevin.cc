@@ -50,7 +50,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Maintainer: joaander
 
 #include "TwoStepLangevin.h"
-#include "saruprng.h"
+#include "RandomNumbers.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -189,27 +189,30 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
 
     // grab some initial variables
     const Scalar currentTemp = m_T->getValue(timestep);
     const unsigned int D = Scalar(m_sysdef->getNDimensions());
-    // initialize the RNG
-    Saru saru(m_seed, timestep);
 
     // energy transferred over this time step
     Scalar bd_energy_transfer = 0;
 
     // a(t+deltaT) gets modified with the bd forces
     // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // every particle draws from its own random number stream, so the loop can be split between threads
+    #pragma omp parallel for schedule(static) reduction(+:bd_energy_transfer)
+    for (int group_idx = 0; group_idx < (int)group_size; group_idx++)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
+        unsigned int j = h_index_array.data[group_idx];
 
         // first, calculate the BD forces
-        // Generate three random numbers
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz =  saru.s<Scalar>(-1,1);
+        // Generate three Gaussian random numbers
+        PhiloxGenerator rng(m_seed, rng_stream::langevin, timestep, h_tag.data[j]);
+        Scalar rx = rng.normal<Scalar>();
+        Scalar ry = rng.normal<Scalar>();
+        Scalar rz = rng.normal<Scalar>();
 
         Scalar gamma;
         if (m_use_lambda)
@@ -221,7 +224,7 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
             }
 
         // compute the bd force
-        Scalar coeff = fast::sqrt(Scalar(6.0) *gamma*currentTemp/m_deltaT);
+        Scalar coeff = fast::sqrt(Scalar(2.0) *gamma*currentTemp/m_deltaT);
         Scalar bd_fx = rx*coeff - gamma*h_vel.data[j].x;
         Scalar bd_fy = ry*coeff - gamma*h_vel.data[j].y;
         Scalar bd_fz = rz*coeff - gamma*h_vel.data[j].z;
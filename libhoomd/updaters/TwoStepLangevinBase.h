@@ -89,6 +89,17 @@ class TwoStepLangevinBase : public IntegrationMethodTwoStep
             m_T = T;
             }
 
+        //! Get the temperature set point
+        /*! \param timestep Current time step
+            \param T Set to the temperature set point at \a timestep
+            \returns true
+        */
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+            {
+            T = m_T->getValue(timestep);
+            return true;
+            }
+
         //! Sets gamma for a given particle type
         void setGamma(unsigned int typ, Scalar gamma);
 
@@ -54,6 +54,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/python.hpp>
 #include <math.h>
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 using namespace std;
 using namespace boost::python;
 
@@ -160,11 +164,9 @@ void TwoStepNHRigid::setup()
     {
     // rigid data handles
     ArrayHandle<Scalar> body_mass_handle(m_rigid_data->getBodyMass(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> body_size_handle(m_rigid_data->getBodySize(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> particle_indices_handle(m_rigid_data->getParticleIndices(), access_location::host, access_mode::read);
-    unsigned int indices_pitch = m_rigid_data->getParticleIndices().getPitch();
-    ArrayHandle<Scalar4> particle_pos_handle(m_rigid_data->getParticlePos(), access_location::host, access_mode::read);
-    unsigned int particle_pos_pitch = m_rigid_data->getParticlePos().getPitch();
+    ArrayHandle<unsigned int> h_body_offset(m_rigid_data->getBodyOffsets(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(m_rigid_data->getBodyParticleIndices(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_pos(m_rigid_data->getBodyParticlePos(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> com_handle(m_rigid_data->getCOM(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> vel_handle(m_rigid_data->getVel(), access_location::host, access_mode::readwrite);
@@ -245,11 +247,13 @@ void TwoStepNHRigid::setup()
         unsigned int body = m_body_group->getMemberIndex(group_idx);
 
         // for each particle
-        unsigned int len = body_size_handle.data[body];
-        for (unsigned int j = 0; j < len; j++)
+        for (unsigned int k = h_body_offset.data[body]; k < h_body_offset.data[body+1]; k++)
             {
             // get the index of particle in the particle arrays
-            unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
+            unsigned int pidx = h_body_indices.data[k];
+            // the particle belongs to another rank
+            if (pidx == NO_INDEX)
+                continue;
 
             // get the particle mass
             Scalar mass_one = h_vel.data[pidx].w;
@@ -268,16 +272,13 @@ void TwoStepNHRigid::setup()
             force_handle.data[body].z += fz;
 
             // Torque = r x f (all are in the space frame)
-            unsigned int localidx = body * particle_pos_pitch + j;
-            Scalar rx = ex_space_handle.data[body].x * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].x * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].x * particle_pos_handle.data[localidx].z;
-            Scalar ry = ex_space_handle.data[body].y * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].y * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].y * particle_pos_handle.data[localidx].z;
-            Scalar rz = ex_space_handle.data[body].z * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].z * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].z * particle_pos_handle.data[localidx].z;
+            Scalar4 ppos = h_body_pos.data[k];
+            Scalar rx = ex_space_handle.data[body].x * ppos.x + ey_space_handle.data[body].x * ppos.y
+                    + ez_space_handle.data[body].x * ppos.z;
+            Scalar ry = ex_space_handle.data[body].y * ppos.x + ey_space_handle.data[body].y * ppos.y
+                    + ez_space_handle.data[body].y * ppos.z;
+            Scalar rz = ex_space_handle.data[body].z * ppos.x + ey_space_handle.data[body].z * ppos.y
+                    + ez_space_handle.data[body].z * ppos.z;
 
             Scalar tx = h_net_torque.data[pidx].x;
             Scalar ty = h_net_torque.data[pidx].y;
@@ -295,6 +296,14 @@ void TwoStepNHRigid::setup()
 
         }
 
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        Scalar4 *body_data[] = {vel_handle.data, force_handle.data, torque_handle.data, angmom_handle.data};
+        reduceBodyVectors(body_data, 4);
+        }
+#endif
+
     m_akin_t = m_akin_r = Scalar(0.0);
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
@@ -388,6 +397,11 @@ void TwoStepNHRigid::setup()
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         if (h_body.data[i] == NO_BODY) non_rigid_count++;
 
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &non_rigid_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+#endif
+
     unsigned int rigid_dof = m_sysdef->getRigidData()->getNumDOF();
     m_dof = m_dimension * non_rigid_count + rigid_dof;
 
@@ -415,7 +429,7 @@ void TwoStepNHRigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NH rigid step 1");
 
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     Scalar tmp, scale_r;
     Scalar3 scale_t, scale_v;
@@ -470,15 +484,18 @@ void TwoStepNHRigid::integrateStepOne(unsigned int timestep)
     ArrayHandle<Scalar4> ez_space_handle(m_rigid_data->getEzSpace(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> conjqm_handle(m_rigid_data->getConjqm(), access_location::host, access_mode::readwrite);
 
-    Scalar4 mbody, tbody, fquat;
-    Scalar dtfm;
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
 
-    // for each body
+    Scalar akin_t = Scalar(0.0), akin_r = Scalar(0.0);
+
+    // the bodies are advanced independently of each other
+    #pragma omp parallel for schedule(static) reduction(+:akin_t,akin_r)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        unsigned int body = h_body_group.data[group_idx];
 
-        dtfm = m_dt_half / body_mass_handle.data[body];
+        Scalar4 mbody, tbody, fquat;
+        Scalar dtfm = m_dt_half / body_mass_handle.data[body];
         vel_handle.data[body].x += dtfm * force_handle.data[body].x;
         vel_handle.data[body].y += dtfm * force_handle.data[body].y;
         vel_handle.data[body].z += dtfm * force_handle.data[body].z;
@@ -488,9 +505,9 @@ void TwoStepNHRigid::integrateStepOne(unsigned int timestep)
             vel_handle.data[body].x *= scale_t.x;
             vel_handle.data[body].y *= scale_t.y;
             vel_handle.data[body].z *= scale_t.z;
-            tmp = vel_handle.data[body].x * vel_handle.data[body].x + vel_handle.data[body].y * vel_handle.data[body].y +
-                  vel_handle.data[body].z * vel_handle.data[body].z;
-            m_akin_t += body_mass_handle.data[body] * tmp;
+            Scalar vsq = vel_handle.data[body].x * vel_handle.data[body].x + vel_handle.data[body].y * vel_handle.data[body].y +
+                         vel_handle.data[body].z * vel_handle.data[body].z;
+            akin_t += body_mass_handle.data[body] * vsq;
             }
 
         // step 1.2 - update xcm by full step
@@ -551,7 +568,7 @@ void TwoStepNHRigid::integrateStepOne(unsigned int timestep)
                                    ex_space_handle.data[body], ey_space_handle.data[body],
                                    ez_space_handle.data[body], angvel_handle.data[body]);
 
-            m_akin_r += angmom_handle.data[body].x * angvel_handle.data[body].x
+            akin_r += angmom_handle.data[body].x * angvel_handle.data[body].x
                     + angmom_handle.data[body].y * angvel_handle.data[body].y
                     + angmom_handle.data[body].z * angvel_handle.data[body].z;
             }
@@ -574,7 +591,11 @@ void TwoStepNHRigid::integrateStepOne(unsigned int timestep)
             }
         }
 
-
+    if (m_tstat || m_pstat)
+        {
+        m_akin_t += akin_t;
+        m_akin_r += akin_r;
+        }
     } // out of scope for handles
 
     if (m_pstat)
@@ -653,14 +674,18 @@ void TwoStepNHRigid::integrateStepTwo(unsigned int timestep)
     ArrayHandle<Scalar4> angvel_handle(m_rigid_data->getAngVel(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> conjqm_handle(m_rigid_data->getConjqm(), access_location::host, access_mode::readwrite);
 
-    Scalar4 mbody, tbody, fquat;
-    Scalar dtfm;
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
+
+    Scalar akin_t = Scalar(0.0), akin_r = Scalar(0.0);
 
     // 2nd step: final integration
+    #pragma omp parallel for schedule(static) reduction(+:akin_t,akin_r)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
-        dtfm = m_dt_half / body_mass_handle.data[body];
+        unsigned int body = h_body_group.data[group_idx];
+
+        Scalar4 mbody, tbody, fquat;
+        Scalar dtfm = m_dt_half / body_mass_handle.data[body];
 
         if (m_tstat || m_pstat)
             {
@@ -693,12 +718,12 @@ void TwoStepNHRigid::integrateStepTwo(unsigned int timestep)
                                    angvel_handle.data[body]);
             if (m_pstat)
                 {
-                m_akin_t += body_mass_handle.data[body] * (vel_handle.data[body].x * vel_handle.data[body].x +
-                                                           vel_handle.data[body].y * vel_handle.data[body].y +
-                                                           vel_handle.data[body].z * vel_handle.data[body].z);
-                m_akin_r += angmom_handle.data[body].x * angvel_handle.data[body].x +
-                            angmom_handle.data[body].y * angvel_handle.data[body].y +
-                            angmom_handle.data[body].z * angvel_handle.data[body].z;
+                akin_t += body_mass_handle.data[body] * (vel_handle.data[body].x * vel_handle.data[body].x +
+                                                         vel_handle.data[body].y * vel_handle.data[body].y +
+                                                         vel_handle.data[body].z * vel_handle.data[body].z);
+                akin_r += angmom_handle.data[body].x * angvel_handle.data[body].x +
+                          angmom_handle.data[body].y * angvel_handle.data[body].y +
+                          angmom_handle.data[body].z * angvel_handle.data[body].z;
                 }
             }
         else
@@ -716,6 +741,12 @@ void TwoStepNHRigid::integrateStepTwo(unsigned int timestep)
                                    angvel_handle.data[body]);
             }
         }
+
+    if (m_pstat)
+        {
+        m_akin_t += akin_t;
+        m_akin_r += akin_r;
+        }
     } // out of scope for handles
 
     if (m_pstat)
@@ -801,12 +832,9 @@ void TwoStepNHRigid::computeForceAndTorque(unsigned int timestep)
     ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::read);
 
     // rigid data handles
-    ArrayHandle<unsigned int> body_size_handle(m_rigid_data->getBodySize(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> com_handle(m_rigid_data->getCOM(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> particle_indices_handle(m_rigid_data->getParticleIndices(), access_location::host, access_mode::read);
-    unsigned int indices_pitch = m_rigid_data->getParticleIndices().getPitch();
-    ArrayHandle<Scalar4> particle_pos_handle(m_rigid_data->getParticlePos(), access_location::host, access_mode::read);
-    unsigned int particle_pos_pitch = m_rigid_data->getParticlePos().getPitch();
+    ArrayHandle<unsigned int> h_body_offset(m_rigid_data->getBodyOffsets(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(m_rigid_data->getBodyParticleIndices(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_body_pos(m_rigid_data->getBodyParticlePos(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> ex_space_handle(m_rigid_data->getExSpace(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> ey_space_handle(m_rigid_data->getEySpace(), access_location::host, access_mode::read);
@@ -815,31 +843,29 @@ void TwoStepNHRigid::computeForceAndTorque(unsigned int timestep)
     ArrayHandle<Scalar4> force_handle(m_rigid_data->getForce(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> torque_handle(m_rigid_data->getTorque(), access_location::host, access_mode::readwrite);
 
-    // reset all forces and torques
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
+
+    // each body is summed up by a single thread
+    #pragma omp parallel for schedule(static)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        unsigned int body = h_body_group.data[group_idx];
 
-        force_handle.data[body].x = Scalar(0.0);
-        force_handle.data[body].y = Scalar(0.0);
-        force_handle.data[body].z = Scalar(0.0);
+        Scalar4 ex_space = ex_space_handle.data[body];
+        Scalar4 ey_space = ey_space_handle.data[body];
+        Scalar4 ez_space = ez_space_handle.data[body];
 
-        torque_handle.data[body].x = Scalar(0.0);
-        torque_handle.data[body].y = Scalar(0.0);
-        torque_handle.data[body].z = Scalar(0.0);
-        }
-
-    // for each body
-    for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
-        {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        Scalar3 force = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        Scalar3 torque = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
         // for each particle
-        unsigned int len = body_size_handle.data[body];
-        for (unsigned int j = 0; j < len; j++)
+        for (unsigned int k = h_body_offset.data[body]; k < h_body_offset.data[body+1]; k++)
             {
             // get the actual index of particle in the particle arrays
-            unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
+            unsigned int pidx = h_body_indices.data[k];
+            // the particle belongs to another rank
+            if (pidx == NO_INDEX)
+                continue;
 
             // access the force on the particle
             Scalar fx = h_net_force.data[pidx].x;
@@ -853,32 +879,77 @@ void TwoStepNHRigid::computeForceAndTorque(unsigned int timestep)
             Scalar ty = h_net_torque.data[pidx].y;
             Scalar tz = h_net_torque.data[pidx].z;
 
-            force_handle.data[body].x += fx;
-            force_handle.data[body].y += fy;
-            force_handle.data[body].z += fz;
+            force.x += fx;
+            force.y += fy;
+            force.z += fz;
 
             // torque = r x f
-            unsigned int localidx = body * particle_pos_pitch + j;
-            Scalar rx = ex_space_handle.data[body].x * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].x * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].x * particle_pos_handle.data[localidx].z;
-            Scalar ry = ex_space_handle.data[body].y * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].y * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].y * particle_pos_handle.data[localidx].z;
-            Scalar rz = ex_space_handle.data[body].z * particle_pos_handle.data[localidx].x
-                    + ey_space_handle.data[body].z * particle_pos_handle.data[localidx].y
-                    + ez_space_handle.data[body].z * particle_pos_handle.data[localidx].z;
-
-            torque_handle.data[body].x += ry * fz - rz * fy + tx;
-            torque_handle.data[body].y += rz * fx - rx * fz + ty;
-            torque_handle.data[body].z += rx * fy - ry * fx + tz;
+            Scalar4 ppos = h_body_pos.data[k];
+            Scalar rx = ex_space.x * ppos.x + ey_space.x * ppos.y + ez_space.x * ppos.z;
+            Scalar ry = ex_space.y * ppos.x + ey_space.y * ppos.y + ez_space.y * ppos.z;
+            Scalar rz = ex_space.z * ppos.x + ey_space.z * ppos.y + ez_space.z * ppos.z;
+
+            torque.x += ry * fz - rz * fy + tx;
+            torque.y += rz * fx - rx * fz + ty;
+            torque.z += rx * fy - ry * fx + tz;
             }
+
+        force_handle.data[body].x = force.x;
+        force_handle.data[body].y = force.y;
+        force_handle.data[body].z = force.z;
+
+        torque_handle.data[body].x = torque.x;
+        torque_handle.data[body].y = torque.y;
+        torque_handle.data[body].z = torque.z;
         }
 
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        Scalar4 *body_data[] = {force_handle.data, torque_handle.data};
+        reduceBodyVectors(body_data, 2);
+        }
+#endif
+
     if (m_prof)
         m_prof->pop();
     }
 
+#ifdef ENABLE_MPI
+/*! \param data Per-body arrays (indexed by body id) to sum up
+    \param n_arrays Number of arrays in  data
+
+    Every rank integrates all bodies in the group, but only holds the contributions of its local particles.
+    The x, y and z components of the group bodies are summed over all ranks in a single reduction.
+*/
+void TwoStepNHRigid::reduceBodyVectors(Scalar4 **data, unsigned int n_arrays)
+    {
+    std::vector<Scalar> buf(3*n_arrays*m_n_bodies);
+
+    for (unsigned int i = 0; i < n_arrays; i++)
+        for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
+            {
+            unsigned int body = m_body_group->getMemberIndex(group_idx);
+            unsigned int offs = 3*(i*m_n_bodies + group_idx);
+            buf[offs] = data[i][body].x;
+            buf[offs+1] = data[i][body].y;
+            buf[offs+2] = data[i][body].z;
+            }
+
+    MPI_Allreduce(MPI_IN_PLACE, &buf.front(), buf.size(), MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+
+    for (unsigned int i = 0; i < n_arrays; i++)
+        for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
+            {
+            unsigned int body = m_body_group->getMemberIndex(group_idx);
+            unsigned int offs = 3*(i*m_n_bodies + group_idx);
+            data[i][body].x = buf[offs];
+            data[i][body].y = buf[offs+1];
+            data[i][body].z = buf[offs+2];
+            }
+    }
+#endif
+
 /*! Checks that every particle in the group is valid. This method may be called by anyone wishing to make this
     error check.
 
@@ -1105,7 +1176,7 @@ void TwoStepNHRigid::update_nh_barostat(Scalar akin_t, Scalar akin_r)
     Scalar volume, scale, f_epsilon;
 
     // get box
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     if (m_dimension == 2)
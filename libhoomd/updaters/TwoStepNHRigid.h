@@ -286,6 +286,11 @@ class TwoStepNHRigid : public IntegrationMethodTwoStep
         void deallocate_tchain();
         void deallocate_pchain();
 
+#ifdef ENABLE_MPI
+        //! Sum per-body vectors of the bodies in the group over all ranks
+        void reduceBodyVectors(Scalar4 **data, unsigned int n_arrays);
+#endif
+
         //! Names of log variables
         std::vector<std::string> m_log_names;
     };
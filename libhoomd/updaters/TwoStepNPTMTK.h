@@ -127,6 +127,17 @@ class TwoStepNPTMTK : public IntegrationMethodTwoStep
             m_T = T;
             }
 
+        //! Get the temperature set point
+        /*! \param timestep Current time step
+            \param T Set to the temperature set point at \a timestep
+            \returns true
+        */
+        virtual bool getTemperatureSetPoint(unsigned int timestep, Scalar& T)
+            {
+            T = m_T->getValue(timestep);
+            return true;
+            }
+
         //! Update the pressure
         /*! \param P New pressure to set
         */
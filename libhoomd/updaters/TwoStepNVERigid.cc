@@ -111,7 +111,7 @@ void TwoStepNVERigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NVE rigid step 1");
 
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     // now we can get on with the velocity verlet: initial integration
     {
@@ -132,15 +132,17 @@ void TwoStepNVERigid::integrateStepOne(unsigned int timestep)
     ArrayHandle<Scalar4> ey_space_handle(m_rigid_data->getEySpace(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> ez_space_handle(m_rigid_data->getEzSpace(), access_location::host, access_mode::readwrite);
 
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
+
     Scalar dt_half = 0.5 * m_deltaT;
-    Scalar dtfm;
 
-    // for each body
+    // the bodies are advanced independently of each other
+    #pragma omp parallel for schedule(static)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        unsigned int body = h_body_group.data[group_idx];
 
-        dtfm = dt_half / body_mass_handle.data[body];
+        Scalar dtfm = dt_half / body_mass_handle.data[body];
         vel_handle.data[body].x += dtfm * force_handle.data[body].x;
         vel_handle.data[body].y += dtfm * force_handle.data[body].y;
         vel_handle.data[body].z += dtfm * force_handle.data[body].z;
@@ -204,15 +206,17 @@ void TwoStepNVERigid::integrateStepTwo(unsigned int timestep)
     ArrayHandle<Scalar4> angmom_handle(m_rigid_data->getAngMom(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> angvel_handle(m_rigid_data->getAngVel(), access_location::host, access_mode::readwrite);
 
+    ArrayHandle<unsigned int> h_body_group(m_body_group->getIndexArray(), access_location::host, access_mode::read);
+
     Scalar dt_half = 0.5 * m_deltaT;
-    Scalar dtfm;
 
     // 2nd step: final integration
+    #pragma omp parallel for schedule(static)
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
-        unsigned int body = m_body_group->getMemberIndex(group_idx);
+        unsigned int body = h_body_group.data[group_idx];
 
-        dtfm = dt_half / body_mass_handle.data[body];
+        Scalar dtfm = dt_half / body_mass_handle.data[body];
         vel_handle.data[body].x += dtfm * force_handle.data[body].x;
         vel_handle.data[body].y += dtfm * force_handle.data[body].y;
         vel_handle.data[body].z += dtfm * force_handle.data[body].z;
@@ -51,6 +51,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "SystemDefinition.h"
 #include "Profiler.h"
+#include "PerformanceCounter.h"
 
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
@@ -174,6 +175,14 @@ class Updater : boost::noncopyable
             return PDataFlags(0);
             }
 
+        //! Get the counter of the wall clock time spent in update()
+        /*! System times every call to update() with this counter. Derived classes can provide it as a log quantity.
+        */
+        PerformanceCounter& getUpdateTimer()
+            {
+            return m_update_timer;
+            }
+
 #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -192,6 +201,7 @@ class Updater : boost::noncopyable
         boost::shared_ptr<Communicator> m_comm;             //!< The communicator this updater is to use
 #endif
         boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Stored shared ptr to the execution configuration
+        PerformanceCounter m_update_timer;  //!< Wall clock time spent in update()
     };
 
 //! Export the Updater class to python
@@ -51,7 +51,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "TwoStepBDGPU.cuh"
 
-#include "saruprngCUDA.h"
+#include "RandomNumbers.h"
 
 #include <assert.h>
 
@@ -84,8 +84,8 @@ extern __shared__ Scalar s_gammas[];
 
     This kernel is implemented in a very similar manner to gpu_nve_step_one_kernel(), see it for design details.
 
-    Random number generation is done per thread with Saru's 3-seed constructor. The seeds are, the time step,
-    the particle tag, and the user-defined seed.
+    Random number generation is done per thread with a PhiloxGenerator keyed on the user-defined seed, the time
+    step, and the particle tag. The CPU implementation draws the same numbers.
 
     This kernel must be launched with enough dynamic shared memory per block to read in d_gamma
 */
@@ -136,10 +136,10 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
         unsigned int ptag = d_tag[idx];
 
         // compute the random force
-        SaruGPU saru(ptag, timestep + seed, 0x9977665);
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz =  saru.s<Scalar>(-1,1);
+        PhiloxGenerator rng(seed, rng_stream::bd, timestep, ptag);
+        Scalar rx = rng.normal<Scalar>();
+        Scalar ry = rng.normal<Scalar>();
+        Scalar rz = rng.normal<Scalar>();
 
         // calculate the magnitude of the random force
         Scalar gamma;
@@ -155,9 +155,8 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
             gamma = s_gammas[typ];
             }
 
-        // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
-        // it is not the dimensionality of the system
-        Scalar coeff = fast::sqrt(Scalar(3.0)*Scalar(2.0)*gamma*T/deltaT);
+        // compute the bd force
+        Scalar coeff = fast::sqrt(Scalar(2.0)*gamma*T/deltaT);
         Scalar Fr_x = rx*coeff;
         Scalar Fr_y = ry*coeff;
         Scalar Fr_z = rz*coeff;
@@ -176,10 +175,10 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
         // draw a new random velocity for particle j
         Scalar mass = vel.w;
         Scalar sigma = fast::sqrt(T/mass);
-        vel.x = gaussian_rng(saru, sigma);
-        vel.y = gaussian_rng(saru, sigma);
+        vel.x = rng.normal<Scalar>()*sigma;
+        vel.y = rng.normal<Scalar>()*sigma;
         if (D > 2)
-            vel.z = gaussian_rng(saru, sigma);
+            vel.z = rng.normal<Scalar>()*sigma;
         else
             vel.z = 0;
 
@@ -51,7 +51,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "TwoStepLangevinGPU.cuh"
 
-#include "saruprngCUDA.h"
+#include "RandomNumbers.h"
 
 #include <assert.h>
 
@@ -90,8 +90,8 @@ extern __shared__ Scalar bdtally_sdata[];
 
     This kernel will tally the energy transfer from the bd thermal reservoir and the particle system
 
-    Random number generation is done per thread with Saru's 3-seed constructor. The seeds are, the time step,
-    the particle tag, and the user-defined seed.
+    Random number generation is done per thread with a PhiloxGenerator keyed on the user-defined seed, the time
+    step, and the particle tag. The CPU implementation draws the same numbers.
 
     This kernel must be launched with enough dynamic shared memory per block to read in d_gamma
 */
@@ -159,15 +159,15 @@ void gpu_langevin_step_two_kernel(const Scalar4 *d_pos,
             gamma = s_gammas[typ];
             }
 
-        Scalar coeff = sqrtf(Scalar(6.0) * gamma * T / deltaT);
+        Scalar coeff = sqrtf(Scalar(2.0) * gamma * T / deltaT);
         Scalar3 bd_force = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
         //Initialize the Random Number Generator and generate the 3 random numbers
-        SaruGPU s(ptag, timestep + seed); // 2 dimensional seeding
+        PhiloxGenerator rng(seed, rng_stream::langevin, timestep, ptag);
 
-        Scalar randomx=s.s<Scalar>(-1.0, 1.0);
-        Scalar randomy=s.s<Scalar>(-1.0, 1.0);
-        Scalar randomz=s.s<Scalar>(-1.0, 1.0);
+        Scalar randomx=rng.normal<Scalar>();
+        Scalar randomy=rng.normal<Scalar>();
+        Scalar randomz=rng.normal<Scalar>();
 
         bd_force.x = randomx*coeff - gamma*vel.x;
         bd_force.y = randomy*coeff - gamma*vel.y;
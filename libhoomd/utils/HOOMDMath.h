@@ -426,6 +426,34 @@ inline HOSTDEVICE double acos(double x)
     {
     return ::acos(x);
     }
+
+//! Round x to the nearest integer (ties to even)
+/*! On the CPU, this adds and subtracts 1.5*2^23, so that the FPU rounds away the fraction. Unlike ::rintf(), this
+    compiles to two additions on every x86-64 target (roundss needs SSE4.1), and loops over arrays vectorize.
+    \note Only valid for |x| < 2^22, and not with -ffast-math
+*/
+inline HOSTDEVICE float rint(float x)
+    {
+    #ifdef __CUDA_ARCH__
+    return ::rintf(x);
+    #else
+    const float magic = 12582912.0f;
+    return (x + magic) - magic;
+    #endif
+    }
+
+//! Round x to the nearest integer (ties to even)
+/*! \note Only valid for |x| < 2^51, and not with -ffast-math
+*/
+inline HOSTDEVICE double rint(double x)
+    {
+    #ifdef __CUDA_ARCH__
+    return ::rint(x);
+    #else
+    const double magic = 6755399441055744.0;
+    return (x + magic) - magic;
+    #endif
+    }
 }
 
 //! Maximum accuracy math routines
@@ -0,0 +1,388 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HostArena.cc
+    \brief Defines the HostArena class
+*/
+
+#include "HostArena.h"
+
+#include <stdlib.h>
+#include <stdexcept>
+#include <cassert>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+//! Size of a huge page (2 MB on x86-64)
+const size_t HUGE_PAGE_BYTES = 2u*1024u*1024u;
+
+//! Size of a base page, the granularity of first touch placement
+const size_t BASE_PAGE_BYTES = 4096u;
+
+/*! \param msg Messenger for errors and statistics
+    \param max_cached_bytes Cache size that triggers releasing blocks
+*/
+HostArena::HostArena(boost::shared_ptr<Messenger> msg, size_t max_cached_bytes)
+    : m_msg(msg), m_max_cached_bytes(max_cached_bytes), m_bytes_in_use(0), m_bytes_cached(0), m_peak_bytes(0),
+      m_n_allocs(0), m_n_hits(0), m_n_system_allocs(0), m_n_system_frees(0), m_huge_pages(no_huge_pages),
+      m_first_touch(false), m_large_block_bytes(HUGE_PAGE_BYTES), m_n_huge_page_blocks(0)
+    {
+    }
+
+/*! All cached blocks are freed. There are no blocks in use at this point, since every GPUArray holds a reference
+    to the ExecutionConfiguration that owns the arena.
+*/
+HostArena::~HostArena()
+    {
+    assert(m_allocated_blocks.size() == 0);
+    releaseCached(0);
+    }
+
+/*! \param num_bytes Number of bytes requested
+    \returns The size class of the request, i.e. the capacity of the block that serves it
+
+    Size classes are 64 bytes and above that four equally spaced classes per power of two.
+*/
+size_t HostArena::getSizeClass(size_t num_bytes)
+    {
+    if (num_bytes <= 64)
+        return 64;
+
+    // largest power of two that is not larger than num_bytes
+    size_t p = 64;
+    while (p <= num_bytes/2)
+        p *= 2;
+
+    size_t step = p/4;
+    return (num_bytes + step - 1)/step*step;
+    }
+
+/*! \param num_bytes Number of bytes requested
+    \returns A pointer to a block aligned to 32 bytes with a capacity of getSizeClass(num_bytes)
+
+    A zero sized request returns the smallest block, like posix_memalign does.
+*/
+void *HostArena::allocate(size_t num_bytes)
+    {
+    size_t size_class = getSizeClass(num_bytes);
+    char *ptr = NULL;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_n_allocs++;
+
+    free_blocks_type::iterator it = m_free_blocks.find(size_class);
+    if (it != m_free_blocks.end() && it->second.size())
+        {
+        ptr = it->second.back();
+        it->second.pop_back();
+        m_bytes_cached -= size_class;
+        m_n_hits++;
+        }
+    else
+        {
+        ptr = systemAllocate(size_class);
+        if (ptr == NULL)
+            {
+            // give the cached memory back and try again before giving up
+            releaseCached(0);
+            ptr = systemAllocate(size_class);
+            }
+
+        if (ptr == NULL)
+            {
+            m_msg->error() << "Error allocating aligned memory (" << float(size_class)/1024.0f/1024.0f << " MB)"
+                           << endl;
+            throw runtime_error("Error allocating host memory");
+            }
+
+        m_n_system_allocs++;
+        }
+
+    m_allocated_blocks.insert(make_pair(ptr, size_class));
+    m_bytes_in_use += size_class;
+    if (m_bytes_in_use + m_bytes_cached > m_peak_bytes)
+        m_peak_bytes = m_bytes_in_use + m_bytes_cached;
+
+    return ptr;
+    }
+
+/*! \param ptr Block to release (NULL is ignored)
+
+    The block is kept in the cache for reuse. If the cache grows beyond the maximum, the largest cached blocks are
+    returned to the system until the cache is down to half the maximum.
+*/
+void HostArena::deallocate(void *ptr)
+    {
+    if (ptr == NULL)
+        return;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    allocated_blocks_type::iterator it = m_allocated_blocks.find((char *)ptr);
+    if (it == m_allocated_blocks.end())
+        {
+        m_msg->error() << "HostArena: releasing a block that was not allocated by this arena" << endl;
+        throw runtime_error("Error freeing host memory");
+        }
+
+    size_t size_class = it->second;
+    m_allocated_blocks.erase(it);
+    m_bytes_in_use -= size_class;
+
+    m_free_blocks[size_class].push_back((char *)ptr);
+    m_bytes_cached += size_class;
+
+    if (m_bytes_cached > m_max_cached_bytes)
+        releaseCached(m_max_cached_bytes/2);
+    }
+
+/*! \param ptr Block obtained from allocate()
+    \param num_bytes New number of bytes to store in the block
+    \returns true if the block can be kept
+
+    A block is kept while it is large enough and \a num_bytes is at least a quarter of its capacity. Shrinking below
+    that gives the block back so that the memory can be reused.
+*/
+bool HostArena::fitsInPlace(void *ptr, size_t num_bytes)
+    {
+    size_t capacity = getCapacity(ptr);
+    return num_bytes <= capacity && num_bytes >= capacity/4;
+    }
+
+/*! \param ptr Block obtained from allocate()
+    \returns The capacity of the block in bytes, 0 if the block was not allocated by this arena
+*/
+size_t HostArena::getCapacity(void *ptr)
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    allocated_blocks_type::iterator it = m_allocated_blocks.find((char *)ptr);
+    if (it == m_allocated_blocks.end())
+        return 0;
+
+    return it->second;
+    }
+
+/*! \param max_cached_bytes Cache size that triggers releasing blocks
+*/
+void HostArena::setMaxCachedBytes(size_t max_cached_bytes)
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_max_cached_bytes = max_cached_bytes;
+
+    if (m_bytes_cached > m_max_cached_bytes)
+        releaseCached(m_max_cached_bytes/2);
+    }
+
+void HostArena::trim()
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+    releaseCached(0);
+    }
+
+/*! \param target Number of cached bytes to keep at most
+    \pre m_mutex is locked by the caller
+*/
+void HostArena::releaseCached(size_t target)
+    {
+    // largest blocks first, they are the least likely to be requested again
+    free_blocks_type::reverse_iterator it = m_free_blocks.rbegin();
+    while (m_bytes_cached > target && it != m_free_blocks.rend())
+        {
+        while (m_bytes_cached > target && it->second.size())
+            {
+            systemFree(it->second.back(), it->first);
+            it->second.pop_back();
+            m_bytes_cached -= it->first;
+            m_n_system_frees++;
+            }
+        ++it;
+        }
+    }
+
+/*! \param num_bytes Size of the block (a size class)
+    \returns The new block, or NULL if the system is out of memory
+    \pre m_mutex is locked by the caller
+*/
+char *HostArena::systemAllocate(size_t num_bytes)
+    {
+    char *ptr = NULL;
+    bool large = num_bytes >= m_large_block_bytes;
+
+    #if defined(__linux__) && defined(MAP_HUGETLB)
+    if (large && m_huge_pages == explicit_huge_pages)
+        {
+        size_t map_bytes = (num_bytes + HUGE_PAGE_BYTES - 1)/HUGE_PAGE_BYTES*HUGE_PAGE_BYTES;
+        void *mapped = mmap(NULL, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapped != MAP_FAILED)
+            {
+            ptr = (char *)mapped;
+            m_mapped_blocks.insert(ptr);
+            m_n_huge_page_blocks++;
+            }
+        else
+            {
+            m_msg->warning() << "HostArena: no pages left in the huge page pool, using transparent huge pages" << endl;
+            m_huge_pages = transparent_huge_pages;
+            }
+        }
+    #endif
+
+    if (ptr == NULL)
+        {
+        // at minimum, alignment needs to be 32 bytes for AVX
+        // large blocks are aligned to the huge page size so that every full huge page in them can be backed by one
+        size_t alignment = (large && m_huge_pages != no_huge_pages) ? HUGE_PAGE_BYTES : 32;
+        int retval = posix_memalign((void**)&ptr, alignment, num_bytes);
+        if (retval != 0)
+            return NULL;
+
+        #if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (large && m_huge_pages != no_huge_pages)
+            {
+            if (madvise(ptr, num_bytes/HUGE_PAGE_BYTES*HUGE_PAGE_BYTES, MADV_HUGEPAGE) == 0)
+                m_n_huge_page_blocks++;
+            }
+        #endif
+        }
+
+    #ifdef ENABLE_OPENMP
+    if (large && m_first_touch)
+        {
+        // place every page on the NUMA node of the thread that processes it in a static schedule
+        int n_pages = (int)((num_bytes + BASE_PAGE_BYTES - 1)/BASE_PAGE_BYTES);
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n_pages; i++)
+            ptr[size_t(i)*BASE_PAGE_BYTES] = 0;
+        }
+    #endif
+
+    m_n_system_allocs++;
+    return ptr;
+    }
+
+/*! \param ptr Block obtained from systemAllocate()
+    \param num_bytes Size of the block
+    \pre m_mutex is locked by the caller
+*/
+void HostArena::systemFree(char *ptr, size_t num_bytes)
+    {
+    #ifdef __linux__
+    std::set<char *>::iterator it = m_mapped_blocks.find(ptr);
+    if (it != m_mapped_blocks.end())
+        {
+        m_mapped_blocks.erase(it);
+        munmap(ptr, (num_bytes + HUGE_PAGE_BYTES - 1)/HUGE_PAGE_BYTES*HUGE_PAGE_BYTES);
+        return;
+        }
+    #endif
+
+    free(ptr);
+    }
+
+/*! \param huge_pages Huge page mode for large blocks
+    \param first_touch Set to true to let the OpenMP threads first touch the pages of large blocks
+    \param threshold Size in bytes from which on a block is large
+
+    The policy applies to blocks allocated from the system from now on.
+*/
+void HostArena::setPolicy(hugePageMode huge_pages, bool first_touch, size_t threshold)
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    #ifndef __linux__
+    if (huge_pages != no_huge_pages)
+        {
+        m_msg->warning() << "HostArena: huge pages are only supported on linux, ignoring" << endl;
+        huge_pages = no_huge_pages;
+        }
+    #endif
+
+    #ifndef ENABLE_OPENMP
+    if (first_touch)
+        {
+        m_msg->warning() << "HostArena: first touch placement requires a build with ENABLE_OPENMP, ignoring" << endl;
+        first_touch = false;
+        }
+    #endif
+
+    m_huge_pages = huge_pages;
+    m_first_touch = first_touch;
+    m_large_block_bytes = threshold;
+
+    m_msg->notice(3) << "HostArena: huge pages "
+                     << (huge_pages == explicit_huge_pages ? "explicit" :
+                         (huge_pages == transparent_huge_pages ? "transparent" : "off"))
+                     << ", first touch " << (first_touch ? "on" : "off") << " for blocks of at least "
+                     << float(threshold)/1024.0f/1024.0f << " MB" << endl;
+    }
+
+void HostArena::printStats()
+    {
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    if (m_n_allocs == 0)
+        return;
+
+    m_msg->notice(6) << "HostArena: " << m_n_allocs << " allocations, " << m_n_hits << " served from the cache ("
+                     << (unsigned int)(100.0*double(m_n_hits)/double(m_n_allocs) + 0.5) << "%)" << endl;
+    m_msg->notice(6) << "HostArena: " << m_n_system_allocs << " system allocations, " << m_n_system_frees
+                     << " system frees" << endl;
+    m_msg->notice(6) << "HostArena: in use " << float(m_bytes_in_use)/1024.0f/1024.0f << " MB, cached "
+                     << float(m_bytes_cached)/1024.0f/1024.0f << " MB, peak "
+                     << float(m_peak_bytes)/1024.0f/1024.0f << " MB" << endl;
+    if (m_n_huge_page_blocks)
+        m_msg->notice(6) << "HostArena: " << m_n_huge_page_blocks << " blocks allocated with huge pages" << endl;
+    }
@@ -0,0 +1,256 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HostArena.h
+    \brief Declares the HostArena class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __HOST_ARENA_H__
+#define __HOST_ARENA_H__
+
+#include "Messenger.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cstddef>
+
+//! Caching allocator for host memory
+/*! Every resize of a GPUArray used to allocate a new block with posix_memalign, copy the data and free the old one.
+    ParticleData holds more than 15 per-particle arrays, and under MPI the local number of particles changes every
+    time particles migrate, so the same handful of block sizes is allocated and freed over and over again.
+
+    HostArena keeps blocks that are released in a cache and hands them out again on the next request of the same size
+    class. Requests are rounded up to a size class: the classes are spaced four per power of two, so at most 25% of a
+    block is unused. Blocks are always aligned to 32 bytes (for AVX).
+
+    Released blocks stay in the cache until the cached bytes exceed the maximum set with setMaxCachedBytes(). Then the
+    largest cached blocks are returned to the system until the cache is down to half of the maximum. Together with
+    fitsInPlace(), which lets a GPUArray keep its block while it shrinks to no less than a quarter of the capacity,
+    this hysteresis prevents the memory from being freed and allocated again when N fluctuates around a class
+    boundary.
+
+    <b>Placement policy</b>
+
+    setPolicy() controls how blocks of at least a threshold size (2 MB by default) are obtained from the system:
+     - With \c transparent_huge_pages, large blocks are aligned to 2 MB and marked with madvise(MADV_HUGEPAGE), so
+       that the kernel backs them with transparent huge pages even when the system setting is \c madvise. This cuts
+       the TLB misses of loops that gather neighbor data from all over the particle arrays.
+     - With \c explicit_huge_pages, large blocks are mapped from the hugetlbfs pool (MAP_HUGETLB). If the pool is
+       empty, a warning is printed once and transparent huge pages are used instead.
+     - With first touch enabled, the pages of a new large block are touched by the OpenMP threads in a static
+       schedule, before anything else writes to them. Linux places each page on the NUMA node of the thread that
+       first touches it, and the static schedule over pages gives every thread the same share of every array that
+       a static schedule over particles gives it in the threaded force loops. Without first touch, all pages end up
+       on the node of the main thread, which zeroes the arrays. First touch needs a build with ENABLE_OPENMP.
+
+    The policy only applies to blocks allocated from the system after it is set, so it should be set before the
+    system is initialized. Cached blocks keep their placement when they are reused.
+
+    The arena is owned by the ExecutionConfiguration, all methods are thread safe. Statistics are printed with
+    printStats() at notice level 6.
+
+    ScopedHostAllocation is a helper for temporary buffers of plain old data.
+*/
+class HostArena : boost::noncopyable
+    {
+    public:
+        //! Huge page modes for large blocks
+        enum hugePageMode
+            {
+            no_huge_pages,              //!< Use the system page size
+            transparent_huge_pages,     //!< Request transparent huge pages with madvise
+            explicit_huge_pages         //!< Map huge pages from the hugetlbfs pool
+            };
+
+        //! Constructor
+        HostArena(boost::shared_ptr<Messenger> msg, size_t max_cached_bytes=256u*1024u*1024u);
+
+        //! Destructor
+        ~HostArena();
+
+        //! Allocate a block of at least \a num_bytes bytes
+        void *allocate(size_t num_bytes);
+
+        //! Release a block obtained from allocate()
+        void deallocate(void *ptr);
+
+        //! Test if a block can be kept for a new size
+        bool fitsInPlace(void *ptr, size_t num_bytes);
+
+        //! Get the usable size of a block in bytes
+        size_t getCapacity(void *ptr);
+
+        //! Set the maximum number of bytes kept in cached blocks
+        void setMaxCachedBytes(size_t max_cached_bytes);
+
+        //! Return all cached blocks to the system
+        void trim();
+
+        //! Set the placement policy for large blocks
+        void setPolicy(hugePageMode huge_pages, bool first_touch, size_t threshold=2u*1024u*1024u);
+
+        //! Get the huge page mode
+        hugePageMode getHugePageMode()
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            return m_huge_pages;
+            }
+
+        //! Get whether large blocks are first touched by the OpenMP threads
+        bool getFirstTouch()
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            return m_first_touch;
+            }
+
+        //! Get the number of bytes in blocks handed out
+        size_t getBytesInUse()
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            return m_bytes_in_use;
+            }
+
+        //! Get the number of bytes in cached blocks
+        size_t getBytesCached()
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            return m_bytes_cached;
+            }
+
+        //! Get the number of allocations served from the cache
+        unsigned int getNumHits()
+            {
+            boost::mutex::scoped_lock lock(m_mutex);
+            return m_n_hits;
+            }
+
+        //! Print allocation statistics
+        void printStats();
+
+        //! Get the size class of a request
+        static size_t getSizeClass(size_t num_bytes);
+
+    private:
+        typedef std::map<size_t, std::vector<char *> > free_blocks_type;    //!< Cached blocks by size class
+        typedef std::map<char *, size_t> allocated_blocks_type;             //!< Size classes of blocks handed out
+
+        boost::shared_ptr<Messenger> m_msg;     //!< Messenger for errors and statistics
+        boost::mutex m_mutex;                   //!< Protects all members below
+
+        free_blocks_type m_free_blocks;         //!< Cached blocks
+        allocated_blocks_type m_allocated_blocks; //!< Blocks handed out
+
+        size_t m_max_cached_bytes;              //!< Cache size that triggers releasing blocks
+        size_t m_bytes_in_use;                  //!< Bytes in blocks handed out
+        size_t m_bytes_cached;                  //!< Bytes in cached blocks
+        size_t m_peak_bytes;                    //!< Maximum of m_bytes_in_use + m_bytes_cached
+
+        unsigned int m_n_allocs;                //!< Number of calls to allocate()
+        unsigned int m_n_hits;                  //!< Number of allocations served from the cache
+        unsigned int m_n_system_allocs;         //!< Number of blocks allocated from the system
+        unsigned int m_n_system_frees;          //!< Number of blocks returned to the system
+
+        hugePageMode m_huge_pages;              //!< Huge page mode for large blocks
+        bool m_first_touch;                     //!< True if large blocks are first touched by the OpenMP threads
+        size_t m_large_block_bytes;             //!< Threshold size of large blocks
+        std::set<char *> m_mapped_blocks;       //!< Blocks mapped from the hugetlbfs pool
+        unsigned int m_n_huge_page_blocks;      //!< Number of large blocks allocated with huge pages
+
+        //! Return cached blocks to the system until at most \a target bytes are cached
+        void releaseCached(size_t target);
+
+        //! Allocate a block from the system according to the placement policy
+        char *systemAllocate(size_t num_bytes);
+
+        //! Return a block to the system
+        void systemFree(char *ptr, size_t num_bytes);
+    };
+
+//! A temporary buffer from a HostArena
+/*! The buffer is returned to the arena when the ScopedHostAllocation goes out of scope. The elements are not
+    constructed or cleared, so \a T must be plain old data.
+*/
+template<class T>
+class ScopedHostAllocation : boost::noncopyable
+    {
+    public:
+        //! Constructor
+        /*! \param arena Arena to allocate from
+            \param num_elements Number of elements in the buffer
+        */
+        ScopedHostAllocation(HostArena& arena, unsigned int num_elements)
+            : m_arena(arena)
+            {
+            data = (T *)m_arena.allocate(sizeof(T)*num_elements);
+            }
+
+        //! Destructor
+        ~ScopedHostAllocation()
+            {
+            m_arena.deallocate(data);
+            }
+
+        T *data;    //!< The buffer
+
+    private:
+        HostArena& m_arena; //!< The arena the buffer came from
+    };
+
+#endif
@@ -0,0 +1,149 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file MappedFile.cc
+    \brief Defines the MappedFile class
+*/
+
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+using namespace std;
+
+/*! \param msg Messenger to write errors to
+    \param fname File to map
+*/
+MappedFile::MappedFile(boost::shared_ptr<const Messenger> msg, const std::string& fname)
+    : m_msg(msg), m_fname(fname), m_data(NULL), m_size(0)
+    {
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+        m_msg->error() << "Unable to open " << fname << ": " << strerror(errno) << endl;
+        throw runtime_error("Error mapping file");
+        }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        {
+        m_msg->error() << "Unable to get the size of " << fname << ": " << strerror(errno) << endl;
+        close(fd);
+        throw runtime_error("Error mapping file");
+        }
+    m_size = st.st_size;
+
+    // mmap() fails for empty files, leave m_data NULL
+    if (m_size > 0)
+        {
+        void *mapped = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
+            {
+            m_msg->error() << "Unable to map " << fname << ": " << strerror(errno) << endl;
+            close(fd);
+            throw runtime_error("Error mapping file");
+            }
+        m_data = (unsigned char *)mapped;
+        }
+
+    // the mapping stays valid after the file is closed
+    close(fd);
+    }
+
+MappedFile::~MappedFile()
+    {
+    if (m_data)
+        munmap(m_data, m_size);
+    }
+
+/*! \param pattern Expected access pattern
+
+    This is only a hint, failures are ignored.
+*/
+void MappedFile::setAccessPattern(accessPattern pattern)
+    {
+    if (!m_data)
+        return;
+
+    int advice = MADV_NORMAL;
+    if (pattern == sequential)
+        advice = MADV_SEQUENTIAL;
+    else if (pattern == random)
+        advice = MADV_RANDOM;
+
+    madvise(m_data, m_size, advice);
+    }
+
+/*! \param offset First byte of the range
+    \param num_bytes Size of the range
+
+    Used by readers to request the next frame of a strided iteration while the current one is processed. This is only
+    a hint, failures are ignored.
+*/
+void MappedFile::prefetch(uint64_t offset, uint64_t num_bytes) const
+    {
+    if (!m_data || offset >= m_size)
+        return;
+    if (num_bytes > m_size - offset)
+        num_bytes = m_size - offset;
+
+    // madvise() needs a page aligned start address
+    uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t start = offset / page_size * page_size;
+    madvise(m_data + start, num_bytes + (offset - start), MADV_WILLNEED);
+    }
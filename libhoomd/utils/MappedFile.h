@@ -0,0 +1,128 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file MappedFile.h
+    \brief Declares the MappedFile class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include "Messenger.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include <stdint.h>
+#include <string>
+
+//! Read only memory mapping of a whole file
+/*! Trajectory readers map the file instead of reading it through a stream, so that frame data can be used in place
+    without copying it into a buffer first. Pages are read in by the operating system on first access and can be
+    dropped again under memory pressure, so files much larger than the memory of the node can be mapped.
+
+    The mapping reflects the size of the file when it was opened; data appended later is not visible.
+
+    \ingroup utils
+*/
+class MappedFile : boost::noncopyable
+    {
+    public:
+        //! Expected access pattern, see setAccessPattern()
+        enum accessPattern
+            {
+            normal,         //!< No particular pattern
+            sequential,     //!< Pages are read in order, read ahead aggressively
+            random          //!< Pages are read in random order, do not read ahead
+            };
+
+        //! Map a file
+        MappedFile(boost::shared_ptr<const Messenger> msg, const std::string& fname);
+
+        //! Unmap the file
+        ~MappedFile();
+
+        //! Get the first byte of the file
+        const unsigned char *getData() const
+            {
+            return m_data;
+            }
+
+        //! Get the size of the file in bytes
+        uint64_t getSize() const
+            {
+            return m_size;
+            }
+
+        //! Get the name of the file
+        const std::string& getName() const
+            {
+            return m_fname;
+            }
+
+        //! Tell the operating system how the file is going to be accessed
+        void setAccessPattern(accessPattern pattern);
+
+        //! Start reading a range of the file in the background
+        void prefetch(uint64_t offset, uint64_t num_bytes) const;
+
+    private:
+        boost::shared_ptr<const Messenger> m_msg;   //!< Messages are written through this
+        std::string m_fname;                        //!< Name of the file
+        unsigned char *m_data;                      //!< Start of the mapping (NULL for empty files)
+        uint64_t m_size;                            //!< Size of the mapping
+    };
+
+#endif
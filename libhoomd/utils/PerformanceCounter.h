@@ -0,0 +1,212 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file PerformanceCounter.h
+    \brief Declares the PerformanceCounter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __PERFORMANCE_COUNTER_H__
+#define __PERFORMANCE_COUNTER_H__
+
+#include "ClockSource.h"
+#include "HOOMDMath.h"
+
+#include <boost/utility.hpp>
+
+//! Accumulates wall clock time or event counts for output as log quantities
+/*! PerformanceCounter is a lightweight accumulator that classes embed to expose where the time goes during a run()
+    through the Logger. Timed regions are bracketed with begin() and end(), events are counted with add(). Both
+    only read the clock and add to an integer, so counters can be left on in production runs.
+
+    Timed regions nest: while a region is open, time spent in a region of another counter begun inside it is
+    attributed to the inner counter only. For example, the neighbor list build triggered from within a pair force
+    compute is counted as neighbor list time and not as pair time, so the logged times add up to the time of the
+    step. Counters must only be begun and ended from the main thread, preferably through a PerformanceRegion.
+
+    The value reported to the logger is the amount accumulated since the previous log write (see getInterval()), so
+    each line in a log file gives the time spent (or the number of events) in that logging interval. Multiple
+    requests for the same time step return the same value. When two loggers with different periods log the same
+    quantity, each one sees the amount accumulated since the most recent request by either of them.
+
+    On the GPU, kernel launches are asynchronous and the time measured is that of the host code. Timings are only
+    meaningful there when profiling (which synchronizes after every kernel) is enabled.
+
+    \ingroup utils
+*/
+class PerformanceCounter
+    {
+    public:
+        //! Constructs a zeroed counter
+        PerformanceCounter()
+            : m_parent(NULL), m_start(0), m_total(0), m_last_total(0), m_interval(0), m_last_timestep(0),
+              m_sampled(false)
+            {
+            }
+
+        //! Start timing a region
+        /*! The enclosing region, if any, is paused until end() is called
+        */
+        void begin()
+            {
+            int64_t now = clock().getTime();
+            m_parent = active();
+            if (m_parent)
+                m_parent->m_total += now - m_parent->m_start;
+            m_start = now;
+            active() = this;
+            }
+
+        //! Stop timing a region and add the elapsed time to the total
+        /*! The enclosing region, if any, is resumed
+        */
+        void end()
+            {
+            int64_t now = clock().getTime();
+            m_total += now - m_start;
+            active() = m_parent;
+            if (m_parent)
+                m_parent->m_start = now;
+            m_parent = NULL;
+            }
+
+        //! Count events
+        /*! \param n Number of events to add
+        */
+        void add(int64_t n=1)
+            {
+            m_total += n;
+            }
+
+        //! Get the total accumulated since construction
+        int64_t getTotal() const
+            {
+            return m_total;
+            }
+
+        //! Get the amount accumulated since the previous request at a different time step
+        /*! \param timestep Current time step
+        */
+        int64_t getInterval(unsigned int timestep)
+            {
+            if (!m_sampled || timestep != m_last_timestep)
+                {
+                m_interval = m_total - m_last_total;
+                m_last_total = m_total;
+                m_last_timestep = timestep;
+                m_sampled = true;
+                }
+            return m_interval;
+            }
+
+        //! Get the time accumulated since the previous request in seconds
+        /*! \param timestep Current time step
+        */
+        Scalar getIntervalSeconds(unsigned int timestep)
+            {
+            return Scalar(double(getInterval(timestep)) / 1e9);
+            }
+
+    private:
+        PerformanceCounter *m_parent; //!< Region that was open when begin() was called
+        int64_t m_start;            //!< Time at which the current region started (or was resumed)
+        int64_t m_total;            //!< Total accumulated time (in ns) or event count
+        int64_t m_last_total;       //!< Total at the previous sample
+        int64_t m_interval;         //!< Value returned by the previous sample
+        unsigned int m_last_timestep; //!< Time step of the previous sample
+        bool m_sampled;             //!< True once getInterval() has been called
+
+        //! The clock shared by all counters
+        static const ClockSource& clock()
+            {
+            static ClockSource clk;
+            return clk;
+            }
+
+        //! The innermost open region
+        static PerformanceCounter*& active()
+            {
+            static PerformanceCounter *counter = NULL;
+            return counter;
+            }
+    };
+
+//! Times a region with a PerformanceCounter for the lifetime of the object
+/*! The region is closed on every exit from the enclosing scope, including early returns and exceptions, which
+    keeps the nesting of counters consistent.
+    \ingroup utils
+*/
+class PerformanceRegion : boost::noncopyable
+    {
+    public:
+        //! Begin the region
+        /*! \param counter Counter to accumulate the time in
+        */
+        PerformanceRegion(PerformanceCounter& counter)
+            : m_counter(counter)
+            {
+            m_counter.begin();
+            }
+
+        //! End the region
+        ~PerformanceRegion()
+            {
+            m_counter.end();
+            }
+
+    private:
+        PerformanceCounter& m_counter; //!< Counter the time is accumulated in
+    };
+
+#endif
@@ -0,0 +1,252 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+#ifndef __RANDOM_NUMBERS_H__
+#define __RANDOM_NUMBERS_H__
+
+/*! \file RandomNumbers.h
+    \brief Defines a counter based random number generator for stochastic integrators and forces
+    \details Saru streams seeded once per time step produce numbers that depend on the order in which the particles
+    are processed, so results change with the number of threads, ranks, or a particle sort. A counter based generator
+    is a pure function of its key and counter instead. Keying every particle (or pair) on (seed, stream, time step,
+    tag) gives each of them its own stream, and the results are independent of the execution configuration.
+
+    Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11) is used. One evaluation of the
+    block function produces four 32 bit words, which are handed out one at a time. It has no branches and no state
+    besides the counter, so the same code runs on the host and the device and loops over particles vectorize and
+    thread freely.
+*/
+
+#include "HOOMDMath.h"
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#undef DEVICE
+#ifdef NVCC
+#define DEVICE __host__ __device__
+#else
+#define DEVICE
+#endif
+
+//! Stream identifiers for the users of PhiloxGenerator
+/*! Every user of PhiloxGenerator draws from a different stream so that methods sharing a seed do not produce
+    correlated noise.
+*/
+struct rng_stream
+    {
+    //! The enum
+    enum Enum
+        {
+        langevin = 0x4c414e47,
+        bd,
+        dpd
+        };
+    };
+
+//! Multiply two 32 bit words and return the high and low word of the result
+DEVICE inline void philox_mulhilo(unsigned int a, unsigned int b, unsigned int& hi, unsigned int& lo)
+    {
+    #ifdef __CUDA_ARCH__
+    hi = __umulhi(a, b);
+    lo = a*b;
+    #else
+    unsigned long long p = (unsigned long long)a * (unsigned long long)b;
+    hi = (unsigned int)(p >> 32);
+    lo = (unsigned int)p;
+    #endif
+    }
+
+//! Evaluate the Philox4x32-10 block function
+/*! \param ctr Counter (input), random words (output)
+    \param key Key
+    \ingroup utils
+*/
+DEVICE inline void philox4x32_10(unsigned int ctr[4], const unsigned int key[2])
+    {
+    unsigned int k0 = key[0];
+    unsigned int k1 = key[1];
+
+    for (unsigned int r = 0; r < 10; r++)
+        {
+        unsigned int hi0, lo0, hi1, lo1;
+        philox_mulhilo(0xD2511F53, ctr[0], hi0, lo0);
+        philox_mulhilo(0xCD9E8D57, ctr[2], hi1, lo1);
+
+        unsigned int c0 = hi1 ^ ctr[1] ^ k0;
+        unsigned int c2 = hi0 ^ ctr[3] ^ k1;
+        ctr[0] = c0;
+        ctr[1] = lo1;
+        ctr[2] = c2;
+        ctr[3] = lo0;
+
+        // bump the key (Weyl sequence)
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+        }
+    }
+
+//! Convert a random word to a uniform number in (0,1)
+/*! Both end points are excluded so that the result can be passed to log().
+    \ingroup utils
+*/
+template<class Real> DEVICE inline Real rng_u01(unsigned int u);
+
+//! Convert a random word to a uniform float in (0,1)
+template<> DEVICE inline float rng_u01<float>(unsigned int u)
+    {
+    // 23 bits + 0.5 are still exactly representable below 1
+    return (float(u >> 9) + 0.5f) * (1.0f/8388608.0f);
+    }
+
+//! Convert a random word to a uniform double in (0,1)
+template<> DEVICE inline double rng_u01<double>(unsigned int u)
+    {
+    return (double(u) + 0.5) * (1.0/4294967296.0);
+    }
+
+//! Counter based random number generator
+/*! A PhiloxGenerator is a lightweight object that is constructed where the numbers are needed, just like Saru:
+    \code
+    PhiloxGenerator rng(seed, rng_stream::langevin, timestep, tag);
+    Scalar rx = rng.normal<Scalar>();
+    \endcode
+    The numbers drawn only depend on the constructor arguments and the number of previous draws. The two ids
+    identify the particle (or the pair of particles) the numbers are drawn for; they should be particle tags, not
+    indices, so that the results do not depend on the order of the particles in memory.
+
+    Each evaluation of the block function produces 4 words. normal() uses the Box-Muller transform on two words and
+    returns both Gaussian numbers of the pair, so a block yields 4 uniform or 4 Gaussian numbers.
+
+    \ingroup utils
+*/
+class PhiloxGenerator
+    {
+    public:
+        //! Construct a generator
+        /*! \param seed User seed
+            \param stream Identifies the user of the generator (see rng_stream)
+            \param timestep Current time step
+            \param id0 First id (particle tag)
+            \param id1 Second id (second particle tag for pairs)
+        */
+        DEVICE PhiloxGenerator(unsigned int seed,
+                               unsigned int stream,
+                               unsigned int timestep,
+                               unsigned int id0,
+                               unsigned int id1=0)
+            : m_block(0), m_next(4), m_has_normal(false)
+            {
+            m_key[0] = seed;
+            m_key[1] = stream;
+            m_ctr[0] = timestep;
+            m_ctr[1] = id0;
+            m_ctr[2] = id1;
+            }
+
+        //! Draw a random 32 bit word
+        DEVICE unsigned int u32()
+            {
+            if (m_next == 4)
+                {
+                m_words[0] = m_block;
+                m_words[1] = m_ctr[0];
+                m_words[2] = m_ctr[1];
+                m_words[3] = m_ctr[2];
+                philox4x32_10(m_words, m_key);
+                m_block++;
+                m_next = 0;
+                }
+            return m_words[m_next++];
+            }
+
+        //! Draw a uniform random number in (a,b)
+        /*! \param a Lower limit
+            \param b Upper limit
+        */
+        template<class Real>
+        DEVICE Real s(Real a, Real b)
+            {
+            return a + (b-a)*rng_u01<Real>(u32());
+            }
+
+        //! Draw a Gaussian random number with zero mean and unit variance
+        template<class Real>
+        DEVICE Real normal()
+            {
+            if (m_has_normal)
+                {
+                m_has_normal = false;
+                return Real(m_normal);
+                }
+
+            Real u1 = rng_u01<Real>(u32());
+            Real u2 = rng_u01<Real>(u32());
+            Real r = fast::sqrt(Real(-2.0)*log(u1));
+            Real phi = Real(2.0*M_PI)*u2;
+
+            m_normal = r*fast::sin(phi);
+            m_has_normal = true;
+            return r*fast::cos(phi);
+            }
+
+    private:
+        unsigned int m_key[2];      //!< Key (seed, stream)
+        unsigned int m_ctr[3];      //!< Fixed part of the counter (time step, ids)
+        unsigned int m_block;       //!< Index of the next block
+        unsigned int m_words[4];    //!< Words of the current block
+        unsigned int m_next;        //!< Next unused word in m_words
+        bool m_has_normal;          //!< True if m_normal holds an unused Gaussian number
+        Scalar m_normal;            //!< Second Gaussian number of the last Box-Muller pair
+    };
+
+#undef DEVICE
+
+#endif // __RANDOM_NUMBERS_H__
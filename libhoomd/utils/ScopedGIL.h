@@ -0,0 +1,141 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file ScopedGIL.h
+    \brief Declares helpers that release and acquire the python global interpreter lock
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __SCOPED_GIL_H__
+#define __SCOPED_GIL_H__
+
+#include <boost/python.hpp>
+#include <boost/utility.hpp>
+
+//! Releases the python global interpreter lock for the lifetime of the object
+/*! System::run() releases the GIL for the duration of the run so that python threads (such as the worker of an
+    asynchronous CallbackAnalyzer) can execute while the simulation runs. Any code that calls into python while the
+    lock is released must hold a ScopedGILAcquire.
+
+    When the interpreter is not initialized (as in the unit tests) or the calling thread does not hold the GIL,
+    ScopedGILRelease does nothing.
+*/
+class ScopedGILRelease : boost::noncopyable
+    {
+    public:
+        //! Release the GIL
+        ScopedGILRelease() : m_state(NULL)
+            {
+            if (!Py_IsInitialized())
+                return;
+
+            #if PY_VERSION_HEX >= 0x03040000
+            bool held = PyGILState_Check();
+            #else
+            bool held = (_PyThreadState_Current == PyGILState_GetThisThreadState());
+            #endif
+            if (held)
+                m_state = PyEval_SaveThread();
+            }
+
+        //! Re-acquire the GIL
+        ~ScopedGILRelease()
+            {
+            restore();
+            }
+
+        //! Re-acquire the GIL before the object goes out of scope
+        void restore()
+            {
+            if (m_state)
+                {
+                PyEval_RestoreThread(m_state);
+                m_state = NULL;
+                }
+            }
+
+    private:
+        PyThreadState *m_state; //!< Saved thread state, NULL if the GIL was not released
+    };
+
+//! Acquires the python global interpreter lock for the lifetime of the object
+/*! ScopedGILAcquire may be used from any thread, and also when the GIL is already held by the calling thread.
+    It does nothing when the interpreter is not initialized.
+*/
+class ScopedGILAcquire : boost::noncopyable
+    {
+    public:
+        //! Acquire the GIL
+        ScopedGILAcquire() : m_acquired(false)
+            {
+            if (Py_IsInitialized())
+                {
+                m_state = PyGILState_Ensure();
+                m_acquired = true;
+                }
+            }
+
+        //! Release the GIL
+        ~ScopedGILAcquire()
+            {
+            if (m_acquired)
+                PyGILState_Release(m_state);
+            }
+
+    private:
+        PyGILState_STATE m_state;   //!< State returned by PyGILState_Ensure()
+        bool m_acquired;            //!< True if the GIL was acquired
+    };
+
+#endif
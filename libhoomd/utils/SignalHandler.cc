@@ -101,3 +101,22 @@ void InstallSIGINTHandler()
     else
         prev_sigint_handler = NULL;
     }
+
+volatile sig_atomic_t g_checkpoint_recvd = 0;
+
+//! The signal handler for checkpoint requests
+extern "C" void checkpoint_handler(int sig)
+    {
+    g_checkpoint_recvd = sig;
+    }
+
+/*! \param sig Signal to handle
+
+    After this call, \a sig no longer terminates the program. Instead, \c g_checkpoint_recvd is set to \a sig and the
+    current run ends with a checkpoint (see System::setCheckpoint()).
+*/
+void InstallCheckpointHandler(int sig)
+    {
+    if (signal(sig, checkpoint_handler) == SIG_ERR)
+        cerr << "Error setting signal handler" << endl;
+    }
@@ -71,4 +71,13 @@ extern volatile sig_atomic_t g_sigint_recvd;
 //! Installs the signal handler
 void InstallSIGINTHandler();
 
+//! Value set to the signal number if a signal requesting a checkpoint has occured
+/*! System::run() writes a checkpoint and ends the run when it reads this value as non-zero. The value is not reset,
+    so that any further runs end immediately as well.
+*/
+extern volatile sig_atomic_t g_checkpoint_recvd;
+
+//! Installs a signal handler that requests a checkpoint
+void InstallCheckpointHandler(int sig);
+
 #endif
@@ -0,0 +1,197 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+#ifndef __TABLE_INTERPOLATION_H__
+#define __TABLE_INTERPOLATION_H__
+
+/*! \file TableInterpolation.h
+    \brief Defines the cubic Hermite interpolation engine shared by the tabulated potentials
+    \details Tabulated potentials store V and F = -dV/dx at evenly spaced points. Linear interpolation of V and F
+    separately needs very fine tables for good energy conservation, because the interpolated F is not the derivative
+    of the interpolated V. The cubic Hermite interpolant through V with slopes -F is C1 continuous, its error is
+    O(dx^4) in V and O(dx^3) in F, and the force is consistent with the energy.
+
+    The coefficients of the cubic on each interval i, V(t) = c.x + c.y t + c.z t^2 + c.w t^3 with
+    t = (x - x_i)/dx in [0,1], are stored interleaved in one Scalar4 per interval. A single load then provides
+    everything needed for an evaluation. Rows of width-1 intervals are laid out one type (pair) after the other,
+    like the V/F tables themselves.
+*/
+
+#include "HOOMDMath.h"
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#undef DEVICE
+#ifdef NVCC
+#define DEVICE __host__ __device__
+#else
+#define DEVICE
+#endif
+
+//! Compute the cubic Hermite coefficients for one table interval
+/*! \param V0 Value at the start of the interval
+    \param V1 Value at the end of the interval
+    \param dV0 Derivative dV/dx at the start of the interval
+    \param dV1 Derivative dV/dx at the end of the interval
+    \param dx Width of the interval
+    \returns Coefficients of the polynomial in t = (x-x0)/dx
+    \ingroup utils
+*/
+DEVICE inline Scalar4 table_hermite_coeffs(Scalar V0, Scalar V1, Scalar dV0, Scalar dV1, Scalar dx)
+    {
+    Scalar m0 = dV0 * dx;
+    Scalar m1 = dV1 * dx;
+    return make_scalar4(V0,
+                        m0,
+                        Scalar(3.0)*(V1 - V0) - Scalar(2.0)*m0 - m1,
+                        Scalar(2.0)*(V0 - V1) + m0 + m1);
+    }
+
+//! Evaluate a cubic Hermite interval
+/*! \param c Coefficients of the interval
+    \param t Fractional position in the interval, in [0,1]
+    \param inv_dx Inverse width of the interval
+    \param V Interpolated value (output)
+    \param F Interpolated -dV/dx (output)
+    \ingroup utils
+*/
+DEVICE inline void table_hermite_eval(const Scalar4& c, Scalar t, Scalar inv_dx, Scalar& V, Scalar& F)
+    {
+    V = c.x + t*(c.y + t*(c.z + t*c.w));
+    F = -(c.y + t*(Scalar(2.0)*c.z + Scalar(3.0)*t*c.w)) * inv_dx;
+    }
+
+//! Evaluate a batch of cubic Hermite table lookups
+/*! \param coeffs Coefficient table
+    \param idx Index of the interval into \a coeffs for each lookup
+    \param t Fractional position in the interval for each lookup
+    \param inv_dx Inverse interval width for each lookup
+    \param n Number of lookups
+    \param V Interpolated values (output)
+    \param F Interpolated -dV/dx (output)
+
+    The coefficients are gathered first, so that the polynomial evaluation runs over contiguous arrays and can be
+    vectorized by the compiler. Callers collect the lookups of e.g. one particle's neighbors and evaluate them at once.
+    \ingroup utils
+*/
+inline void table_hermite_eval_batch(const Scalar4 *coeffs,
+                                     const unsigned int *idx,
+                                     const Scalar *t,
+                                     const Scalar *inv_dx,
+                                     unsigned int n,
+                                     Scalar *V,
+                                     Scalar *F)
+    {
+    const unsigned int block_size = 16;
+    Scalar c0[block_size], c1[block_size], c2[block_size], c3[block_size];
+
+    for (unsigned int start = 0; start < n; start += block_size)
+        {
+        unsigned int m = (n - start < block_size) ? n - start : block_size;
+
+        // gather
+        for (unsigned int l = 0; l < m; l++)
+            {
+            Scalar4 c = coeffs[idx[start + l]];
+            c0[l] = c.x;
+            c1[l] = c.y;
+            c2[l] = c.z;
+            c3[l] = c.w;
+            }
+
+        // evaluate
+        for (unsigned int l = 0; l < m; l++)
+            {
+            Scalar tl = t[start + l];
+            V[start + l] = c0[l] + tl*(c1[l] + tl*(c2[l] + tl*c3[l]));
+            F[start + l] = -(c1[l] + tl*(Scalar(2.0)*c2[l] + Scalar(3.0)*tl*c3[l])) * inv_dx[start + l];
+            }
+        }
+    }
+
+//! Fill the cubic Hermite coefficients of one table row from interleaved V and F = -dV/dx values
+/*! \param coeffs First of the \a width - 1 coefficients of the row (output)
+    \param VF Table of \a width values, V in x and F in y
+    \param width Number of points in the table
+    \param dx Spacing of the points
+    \ingroup utils
+*/
+inline void table_hermite_fill(Scalar4 *coeffs, const Scalar2 *VF, unsigned int width, Scalar dx)
+    {
+    for (unsigned int i = 0; i + 1 < width; i++)
+        coeffs[i] = table_hermite_coeffs(VF[i].x, VF[i+1].x, -VF[i].y, -VF[i+1].y, dx);
+    }
+
+//! Fill the cubic Hermite coefficients of one table row from values only
+/*! \param coeffs First of the \a width - 1 coefficients of the row (output)
+    \param V Table of \a width values
+    \param width Number of points in the table
+    \param dx Spacing of the points
+
+    The derivatives at the points are estimated with central differences (one sided at the ends), which results
+    in a Catmull-Rom spline.
+    \ingroup utils
+*/
+inline void table_hermite_fill_values(Scalar4 *coeffs, const Scalar *V, unsigned int width, Scalar dx)
+    {
+    if (width < 2)
+        return;
+
+    Scalar inv_dx = Scalar(1.0) / dx;
+    for (unsigned int i = 0; i + 1 < width; i++)
+        {
+        Scalar dV0 = (i == 0) ? (V[1] - V[0]) * inv_dx : (V[i+1] - V[i-1]) * Scalar(0.5) * inv_dx;
+        Scalar dV1 = (i + 2 == width) ? (V[i+1] - V[i]) * inv_dx : (V[i+2] - V[i]) * Scalar(0.5) * inv_dx;
+        coeffs[i] = table_hermite_coeffs(V[i], V[i+1], dV0, dV1, dx);
+        }
+    }
+
+#endif // __TABLE_INTERPOLATION_H__
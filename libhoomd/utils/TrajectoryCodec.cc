@@ -0,0 +1,305 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file TrajectoryCodec.cc
+    \brief Defines the position coder of compressed trajectory files
+*/
+
+#include "TrajectoryCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+//! Map a signed integer to an unsigned one, small magnitudes to small values
+static inline unsigned int zigzag(int v)
+    {
+    unsigned int u = (unsigned int)v;
+    return (u << 1) ^ (v < 0 ? 0xffffffffu : 0u);
+    }
+
+//! Inverse of zigzag()
+static inline int unzigzag(unsigned int u)
+    {
+    return (int)((u >> 1) ^ (0u - (u & 1u)));
+    }
+
+void hctEncode(const int *values, unsigned int n, std::vector<unsigned char>& out)
+    {
+    unsigned int zz[HCT_BLOCK_SIZE];
+
+    for (unsigned int start = 0; start < n; start += HCT_BLOCK_SIZE)
+        {
+        unsigned int n_block = std::min(HCT_BLOCK_SIZE, n - start);
+
+        // find the number of bits needed by the largest value in the block
+        unsigned int all_bits = 0;
+        for (unsigned int i = 0; i < n_block; i++)
+            {
+            zz[i] = zigzag(values[start + i]);
+            all_bits |= zz[i];
+            }
+
+        unsigned int width = 0;
+        while (width < 32 && (all_bits >> width) != 0)
+            width++;
+
+        out.push_back((unsigned char)width);
+
+        // pack the values, least significant bits first
+        uint64_t acc = 0;
+        unsigned int n_acc = 0;
+        for (unsigned int i = 0; i < n_block; i++)
+            {
+            acc |= uint64_t(zz[i]) << n_acc;
+            n_acc += width;
+            while (n_acc >= 8)
+                {
+                out.push_back((unsigned char)(acc & 0xff));
+                acc >>= 8;
+                n_acc -= 8;
+                }
+            }
+
+        if (n_acc > 0)
+            out.push_back((unsigned char)(acc & 0xff));
+        }
+    }
+
+const unsigned char *hctDecode(const unsigned char *in, const unsigned char *end, int *values, unsigned int n)
+    {
+    for (unsigned int start = 0; start < n; start += HCT_BLOCK_SIZE)
+        {
+        unsigned int n_block = std::min(HCT_BLOCK_SIZE, n - start);
+
+        if (in >= end)
+            return NULL;
+
+        unsigned int width = *in++;
+        if (width > 32)
+            return NULL;
+
+        size_t n_bytes = (size_t(n_block) * width + 7) / 8;
+        if (size_t(end - in) < n_bytes)
+            return NULL;
+
+        uint64_t mask = (uint64_t(1) << width) - 1;
+        uint64_t acc = 0;
+        unsigned int n_acc = 0;
+        for (unsigned int i = 0; i < n_block; i++)
+            {
+            while (n_acc < width)
+                {
+                acc |= uint64_t(*in++) << n_acc;
+                n_acc += 8;
+                }
+
+            values[start + i] = unzigzag((unsigned int)(acc & mask));
+            acc >>= width;
+            n_acc -= width;
+            }
+        }
+
+    return in;
+    }
+
+void hctEncodeFrame(const std::vector<int>& q,
+                    const std::vector<int>& q_prev,
+                    unsigned int N,
+                    bool keyframe,
+                    std::vector<unsigned char>& payload)
+    {
+    payload.clear();
+    // reserve for 16 bits per coordinate, which is typical at a precision of 1e-3
+    payload.reserve(size_t(N) * 6 + 64);
+
+    std::vector<int> delta(N);
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        const int *cur = &q[0] + size_t(d) * N;
+        if (keyframe)
+            {
+            int prev = 0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                delta[i] = cur[i] - prev;
+                prev = cur[i];
+                }
+            }
+        else
+            {
+            const int *prev = &q_prev[0] + size_t(d) * N;
+            for (unsigned int i = 0; i < N; i++)
+                delta[i] = cur[i] - prev[i];
+            }
+
+        if (N > 0)
+            hctEncode(&delta[0], N, payload);
+        }
+    }
+
+bool hctDecodeFrame(const unsigned char *payload,
+                    uint64_t payload_bytes,
+                    unsigned int N,
+                    bool keyframe,
+                    std::vector<int>& q)
+    {
+    q.resize(size_t(N) * 3);
+    if (N == 0)
+        return true;
+
+    std::vector<int> delta(N);
+    const unsigned char *in = payload;
+    const unsigned char *end = payload + payload_bytes;
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        in = hctDecode(in, end, &delta[0], N);
+        if (!in)
+            return false;
+
+        int *cur = &q[0] + size_t(d) * N;
+        if (keyframe)
+            {
+            int prev = 0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                prev += delta[i];
+                cur[i] = prev;
+                }
+            }
+        else
+            {
+            for (unsigned int i = 0; i < N; i++)
+                cur[i] += delta[i];
+            }
+        }
+
+    return in == end;
+    }
+
+bool hctReadIndex(std::istream& file,
+                  hct_file_header& header,
+                  std::vector<hct_index_entry>& index,
+                  uint64_t& end_of_frames,
+                  std::string& error)
+    {
+    index.clear();
+
+    file.seekg(0, ios::end);
+    uint64_t file_size = file.tellg();
+    file.seekg(0, ios::beg);
+
+    file.read((char *)&header, sizeof(hct_file_header));
+    if (!file.good() || memcmp(header.magic, HCT_FILE_MAGIC, sizeof(HCT_FILE_MAGIC)) != 0)
+        {
+        error = "not a compressed trajectory file";
+        return false;
+        }
+    if (header.version != HCT_VERSION)
+        {
+        error = "unsupported version of the compressed trajectory format";
+        return false;
+        }
+
+    // read the index at the end of the file
+    if (file_size >= sizeof(hct_file_header) + sizeof(hct_trailer))
+        {
+        hct_trailer trailer;
+        file.seekg(file_size - sizeof(hct_trailer));
+        file.read((char *)&trailer, sizeof(hct_trailer));
+
+        if (file.good() && memcmp(trailer.magic, HCT_INDEX_MAGIC, sizeof(HCT_INDEX_MAGIC)) == 0
+            && trailer.index_offset >= sizeof(hct_file_header)
+            && trailer.index_offset + trailer.n_frames * sizeof(hct_index_entry) + sizeof(hct_trailer) == file_size)
+            {
+            index.resize(trailer.n_frames);
+            file.seekg(trailer.index_offset);
+            if (trailer.n_frames > 0)
+                file.read((char *)&index[0], trailer.n_frames * sizeof(hct_index_entry));
+
+            if (file.good())
+                {
+                end_of_frames = trailer.index_offset;
+                return true;
+                }
+
+            index.clear();
+            }
+        }
+
+    // without a valid index, scan the frame headers
+    file.clear();
+    uint64_t offset = sizeof(hct_file_header);
+    while (offset + sizeof(hct_frame_header) <= file_size)
+        {
+        hct_frame_header frame_header;
+        file.seekg(offset);
+        file.read((char *)&frame_header, sizeof(hct_frame_header));
+
+        if (!file.good() || frame_header.magic != HCT_FRAME_MAGIC
+            || frame_header.payload_bytes > file_size - offset - sizeof(hct_frame_header))
+            break;
+
+        hct_index_entry entry;
+        entry.offset = offset;
+        entry.timestep = frame_header.timestep;
+        entry.flags = frame_header.flags;
+        entry.reserved = 0;
+        index.push_back(entry);
+
+        offset += sizeof(hct_frame_header) + frame_header.payload_bytes;
+        }
+
+    file.clear();
+    end_of_frames = offset;
+    return true;
+    }
@@ -0,0 +1,210 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file TrajectoryCodec.h
+    \brief Declares the file layout and the position coder of compressed trajectory files
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __TRAJECTORY_CODEC_H__
+#define __TRAJECTORY_CODEC_H__
+
+#include <stdint.h>
+
+#include <istream>
+#include <string>
+#include <vector>
+
+/*! \page page_hct_format Compressed trajectory file format
+
+    Compressed trajectory files (written by CompressedDumpWriter) store particle positions quantized to a fixed
+    precision \a p, i.e. the integer q = floor(x/p + 1/2) for every coordinate x. All values are little endian.
+
+    The file starts with an hct_file_header, followed by the frames. Every frame is an hct_frame_header followed by
+    \a payload_bytes of coded positions. The payload holds the x, y and z coordinates of all particles (in tag order),
+    each coded with hctEncode(). In a keyframe, the coded values are the differences between consecutive particles,
+    in the other frames they are the differences to the same particle in the previous frame. Reading a frame starts
+    at the closest keyframe before it.
+
+    A complete file ends with the index: an array of hct_index_entry, one for each frame, followed by an hct_trailer.
+    Files without an index (e.g. from a simulation that did not end cleanly) can still be read by scanning the frame
+    headers.
+*/
+
+//! Magic string at the beginning of a compressed trajectory file
+const char HCT_FILE_MAGIC[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'T', '\0'};
+
+//! Magic string at the end of the index
+const char HCT_INDEX_MAGIC[8] = {'H', 'C', 'T', 'I', 'N', 'D', 'E', 'X'};
+
+//! Magic number at the beginning of every frame
+const uint32_t HCT_FRAME_MAGIC = 0x46544348;
+
+//! Version of the file format
+const uint32_t HCT_VERSION = 1;
+
+//! Flag of a keyframe in hct_frame_header::flags
+const uint32_t HCT_KEYFRAME = 1;
+
+//! Number of values that share a bit width in hctEncode()
+const unsigned int HCT_BLOCK_SIZE = 128;
+
+//! Largest magnitude of a quantized coordinate
+/*! Differences of two quantized coordinates must fit into 32 bits.
+*/
+const int HCT_MAX_QUANTIZED = 1 << 30;
+
+//! Header at the beginning of a compressed trajectory file
+struct hct_file_header
+    {
+    char magic[8];                      //!< HCT_FILE_MAGIC
+    uint32_t version;                   //!< HCT_VERSION
+    uint32_t N;                         //!< Number of particles in every frame
+    double precision;                   //!< Quantization step of the positions
+    uint32_t keyframe_interval;         //!< Number of frames between keyframes when the file was written
+    uint32_t reserved;                  //!< Unused, always 0
+    };
+
+//! Header of a frame
+struct hct_frame_header
+    {
+    uint32_t magic;                     //!< HCT_FRAME_MAGIC
+    uint32_t flags;                     //!< HCT_KEYFRAME for keyframes
+    uint64_t timestep;                  //!< Time step of the frame
+    double box[6];                      //!< Lx, Ly, Lz, xy, xz and yz of the simulation box
+    uint64_t payload_bytes;             //!< Size of the coded positions that follow the header
+    };
+
+//! Entry of the index at the end of the file
+struct hct_index_entry
+    {
+    uint64_t offset;                    //!< File offset of the frame header
+    uint64_t timestep;                  //!< Time step of the frame
+    uint32_t flags;                     //!< Flags of the frame
+    uint32_t reserved;                  //!< Unused, always 0
+    };
+
+//! Trailer at the end of the file
+struct hct_trailer
+    {
+    uint64_t index_offset;              //!< File offset of the first index entry
+    uint64_t n_frames;                  //!< Number of index entries
+    char magic[8];                      //!< HCT_INDEX_MAGIC
+    };
+
+//! Code an array of integers
+/*! \param values Values to code
+    \param n Number of values
+    \param out Vector to append the coded values to
+
+    The values are zigzag coded (small magnitudes map to small unsigned integers) and packed into blocks of
+    HCT_BLOCK_SIZE values. Every block starts with one byte holding the number of bits that the largest value in the
+    block needs, followed by the bits of all values in the block.
+*/
+void hctEncode(const int *values, unsigned int n, std::vector<unsigned char>& out);
+
+//! Decode an array of integers coded with hctEncode()
+/*! \param in First byte of the coded values
+    \param end End of the input buffer
+    \param values Array to write the \a n values to
+    \param n Number of values
+    \returns A pointer behind the last byte read, or NULL if the input is corrupt
+*/
+const unsigned char *hctDecode(const unsigned char *in, const unsigned char *end, int *values, unsigned int n);
+
+//! Code the positions of a frame
+/*! \param q Quantized positions, all x, then all y, then all z coordinates
+    \param q_prev Quantized positions of the previous frame (ignored for keyframes)
+    \param N Number of particles
+    \param keyframe True if the frame is coded without reference to the previous frame
+    \param payload Vector to write the coded positions to
+*/
+void hctEncodeFrame(const std::vector<int>& q,
+                    const std::vector<int>& q_prev,
+                    unsigned int N,
+                    bool keyframe,
+                    std::vector<unsigned char>& payload);
+
+//! Decode the positions of a frame
+/*! \param payload Coded positions
+    \param payload_bytes Size of \a payload
+    \param N Number of particles
+    \param keyframe True if the frame is a keyframe
+    \param q Quantized positions of the previous frame on input (ignored for keyframes), of this frame on output
+    \returns false if the payload is corrupt
+*/
+bool hctDecodeFrame(const unsigned char *payload,
+                    uint64_t payload_bytes,
+                    unsigned int N,
+                    bool keyframe,
+                    std::vector<int>& q);
+
+//! Read the header and the frame table of a compressed trajectory file
+/*! \param file Stream to read from
+    \param header Header of the file (output)
+    \param index One entry for every complete frame in the file (output)
+    \param end_of_frames File offset behind the last complete frame (output)
+    \param error Description of the problem when the file cannot be read (output)
+    \returns false if \a file is not a compressed trajectory file
+
+    The frame table is read from the index at the end of the file. Without a valid index, the frame headers are
+    scanned instead and an incomplete last frame is ignored.
+*/
+bool hctReadIndex(std::istream& file,
+                  hct_file_header& header,
+                  std::vector<hct_index_entry>& index,
+                  uint64_t& end_of_frames,
+                  std::string& error);
+
+#endif
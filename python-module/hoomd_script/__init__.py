@@ -268,6 +268,12 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     if not quiet:
         globals.msg.notice(1, "** starting run **\n");
     globals.system.run(int(tsteps), callback_period, callback, limit_hours, int(limit_multiple));
+
+    # wait until asynchronous callbacks have processed all samples of this run
+    for a in globals.analyzers:
+        if isinstance(a, analyze.callback):
+            a.cpp_analyzer.flush();
+
     if not quiet:
         globals.msg.notice(1, "** run complete **\n");
 
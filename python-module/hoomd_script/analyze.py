@@ -55,6 +55,9 @@ import sys;
 from hoomd_script import util;
 from hoomd_script import init;
 from hoomd_script import meta;
+from hoomd_script import nlist as nl;
+from hoomd_script import group as hs_group;
+from hoomd_script import data;
 
 ## \package hoomd_script.analyze
 # \brief Commands that %analyze the system and provide some output
@@ -420,6 +423,19 @@ class imd(_analyzer):
 #   - **nvt_rigid_xi_t**_groupname (integrate.nvt_rigid) - NVT momentum rescaling factor \f$ \xi_1^t \f$
 #   - **nvt_rigid_xi_r**_groupname (integrate.nvt_rigid) - NVT angular momentum rescaling factor \f$ \xi_1^r \f$
 #
+# - Performance counters. Times are the wall clock time (in seconds) spent since the previous line of the log, and
+#   the maximum over all ranks in MPI runs. Time spent in a neighbor list build or force compute that is triggered
+#   from another part of the step is only counted for the neighbor list or force compute.
+#   - **time_integrate** - Integration, excluding force computes, neighbor list and communication
+#   - **time_pair_lj** (pair.lj) - Evaluation of the pair forces (**time_pair_gauss** for pair.gauss, etc...)
+#   - **time_nlist** - Neighbor list distance checks and builds
+#   - **nlist_builds** - Number of neighbor list builds
+#   - **time_comm** - MPI communication (0 without domain decomposition)
+#   - **ghost_count** - Total number of ghost particles (0 without domain decomposition)
+#   - **time_sort** - Particle sorting
+#   - **time_dump_xml** (dump.xml) - Writing xml files (taking the snapshot with \a background=True)
+#   - **time_dump_dcd** (dump.dcd) - Writing dcd frames
+#
 # Additionally, the following commands can be provided user-defined names that are appended as suffixes to the
 # logged quantitiy (e.g. with \c pair.lj(r_cut=2.5, \c name="alpha"), the logged quantity would be pair_lj_energy_alpha).
 # - All pair potentials
@@ -699,16 +715,255 @@ class msd(_analyzer):
         if delimiter:
             self.cpp_analyzer.setDelimiter(delimiter);
 
+## Accumulates the radial distribution function of every %pair of particle types
+#
+# Every \a period time steps, analyze.rdf bins the distances of all particle pairs closer than \a r_max into one
+# histogram per %pair of particle types. The pairs are taken from a neighbor list, so a sample costs a single pass over
+# the neighbor list and runs natively in C++ without copying the particle data. The histograms are accumulated over
+# all samples and the averaged g(r) is written to \a filename by write(), overwriting the previous contents.
+#
+# The file has one row per bin. The first column is the distance at the bin center and the following columns are
+# g(r) of each %pair of particle types.
+#
+# The neighbor list is asked to include all pairs up to \a r_max, which may be longer than the cutoff of the %pair
+# forces using the same list. Pairs excluded from the neighbor list (see nlist.reset_exclusions()) do not contribute
+# to g(r).
+#
+# \MPI_SUPPORTED
+class rdf(_analyzer):
+    ## Initialize the rdf analyzer
+    #
+    # \param filename File to write g(r) to
+    # \param r_max Largest pair distance to bin (in distance units)
+    # \param period g(r) is sampled every \a period time steps
+    # \param nbins Number of bins between 0 and \a r_max
+    # \param nlist Neighbor list to take the pairs from (default of None uses the global neighbor list)
+    # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
+    #
+    # \b Examples:
+    # \code
+    # rdf = analyze.rdf(filename='rdf.dat', r_max=3.0, period=100)
+    # run(10000)
+    # rdf.write()
+    #
+    # analyze.rdf(filename='rdf.dat', r_max=5.0, nbins=250, period=1000, nlist=nl_c)
+    # \endcode
+    #
+    # \a period can be a function: see \ref variable_period_docs for details
+    def __init__(self, filename, r_max, period, nbins=100, nlist=None, phase=-1):
+        util.print_status_line();
+
+        # initialize base class
+        _analyzer.__init__(self);
+
+        self.r_max = r_max;
+
+        # subscribe r_max to the neighbor list
+        if nlist is None:
+            self.nlist = nl._subscribe_global_nlist(lambda:self.get_rcut());
+        else:
+            self.nlist = nlist;
+            self.nlist.subscribe(lambda:self.get_rcut());
+            self.nlist.update_rcut();
+
+        # create the c++ mirror class
+        self.cpp_analyzer = hoomd.RDFAnalyzer(globals.system_definition, self.nlist.cpp_nlist, filename, r_max, nbins);
+        self.setupAnalyzer(period, phase);
+
+    ## \internal
+    # \brief Get the r_cut pair dictionary requested from the neighbor list
+    def get_rcut(self):
+        if not self.enabled:
+            return None;
+
+        # request r_max for every pair of the active particle types
+        ntypes = globals.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(globals.system_definition.getParticleData().getNameByType(i));
+
+        r_cut_dict = nl.rcut();
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r_cut_dict.set_pair(type_list[i],type_list[j],self.r_max);
+
+        return r_cut_dict;
+
+    ## Write the averaged g(r) to the file
+    #
+    # write() averages all samples taken since the analyzer was created (or since the last reset()) and writes
+    # the result to the file given to analyze.rdf, replacing its contents. With MPI, the histograms of all ranks are
+    # summed here.
+    #
+    # \b Examples:
+    # \code
+    # rdf.write()
+    # \endcode
+    def write(self):
+        util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_analyzer.writeFile();
+
+    ## Discard all samples accumulated so far
+    #
+    # \b Examples:
+    # \code
+    # run(1000)  # equilibrate
+    # rdf.reset()
+    # run(10000)
+    # rdf.write()
+    # \endcode
+    def reset(self):
+        util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_analyzer.reset();
+
+    ## Change the parameters of the rdf analysis
+    #
+    # \param delimiter New delimiter between columns in the output file (if specified)
+    #
+    # \b Examples:
+    # \code
+    # rdf.set_params(delimiter=',');
+    # \endcode
+    def set_params(self, delimiter=None):
+        util.print_status_line();
+
+        if delimiter:
+            self.cpp_analyzer.setDelimiter(delimiter);
+
+## Accumulates the static structure factor of a group of particles
+#
+# Every \a period time steps, analyze.sq evaluates
+# \f[ S(\vec{k}) = \frac{1}{N} \left| \sum_{j=1}^N e^{i \vec{k} \cdot \vec{r}_j} \right|^2 \f]
+# for wave vectors \f$ \vec{k} \f$ of the reciprocal lattice of the simulation box with
+# \f$ |\vec{k}| \le k_\mathrm{max} \f$ and accumulates the values in \a nbins bins of \f$ |\vec{k}| \f$. The averaged S(k)
+# is written to \a filename by write(), overwriting the previous contents. The file has one row per non-empty bin with
+# the mean \f$ |\vec{k}| \f$ of the bin and S(k).
+#
+# The set of wave vectors is chosen once (at most \a max_k per bin) and kept while the box deforms by less than 10%.
+# The cost of a sample grows with the number of particles times the number of wave vectors.
+#
+# \MPI_SUPPORTED
+class sq(_analyzer):
+    ## Initialize the structure factor analyzer
+    #
+    # \param filename File to write S(k) to
+    # \param k_max Largest wave vector magnitude to sample (in inverse distance units)
+    # \param period S(k) is sampled every \a period time steps
+    # \param nbins Number of bins between 0 and \a k_max
+    # \param group Group of particles to compute S(k) of (default of None uses all particles)
+    # \param max_k Maximum number of wave vectors evaluated in each bin
+    # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
+    #
+    # Large shells contain many equivalent wave vectors. At most \a max_k of them are chosen at random in each bin,
+    # which bounds the cost of a sample to roughly N * nbins * max_k evaluations.
+    #
+    # \b Examples:
+    # \code
+    # sq = analyze.sq(filename='sq.dat', k_max=10.0, period=1000)
+    # run(10000)
+    # sq.write()
+    #
+    # analyze.sq(filename='sq_A.dat', k_max=8.0, nbins=80, period=500, group=group.type('A'))
+    # \endcode
+    #
+    # \a period can be a function: see \ref variable_period_docs for details
+    def __init__(self, filename, k_max, period, nbins=100, group=None, max_k=64, phase=-1):
+        util.print_status_line();
+
+        # initialize base class
+        _analyzer.__init__(self);
+
+        if group is None:
+            util._disable_status_lines = True;
+            group = hs_group.all();
+            util._disable_status_lines = False;
+
+        # create the c++ mirror class
+        self.cpp_analyzer = hoomd.StructureFactorAnalyzer(globals.system_definition, group.cpp_group, filename, k_max,
+                                                          nbins, max_k);
+        self.setupAnalyzer(period, phase);
+
+    ## Write the averaged S(k) to the file
+    #
+    # write() averages all samples taken since the analyzer was created (or since the last reset()) and writes
+    # the result to the file given to analyze.sq, replacing its contents.
+    #
+    # \b Examples:
+    # \code
+    # sq.write()
+    # \endcode
+    def write(self):
+        util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_analyzer.writeFile();
+
+    ## Discard all samples accumulated so far
+    #
+    # \b Examples:
+    # \code
+    # sq.reset()
+    # \endcode
+    def reset(self):
+        util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_analyzer.reset();
+
+    ## Change the parameters of the structure factor analysis
+    #
+    # \param delimiter New delimiter between columns in the output file (if specified)
+    #
+    # \b Examples:
+    # \code
+    # sq.set_params(delimiter=',');
+    # \endcode
+    def set_params(self, delimiter=None):
+        util.print_status_line();
+
+        if delimiter:
+            self.cpp_analyzer.setDelimiter(delimiter);
+
 ## Callback analyzer
 #
 # Create an analyzer that runs a given python callback method at a defined period.
 #
+# By default, the callback is called synchronously: the simulation waits until it returns. When \a asynchronous is
+# True, analyze.callback copies the requested particle \a fields on each period and hands them to a worker
+# thread that calls the callback while the simulation continues. The callback then receives two arguments: the time
+# step and a dict with the box (a data.boxdim) and one read-only numpy array per requested field, in tag order.
+# The data is a copy of the state at the given time step.
+#
+# Up to \a queue_size samples wait for the worker. When the queue is full, \a policy selects what happens:
+# - \b block - the simulation waits until the worker has taken a sample from the queue
+# - \b drop_oldest - the oldest sample in the queue is dropped
+# - \b skip - the new sample is dropped
+#
+# Valid \a fields are \b position, \b velocity, \b image, \b typeid, \b mass, \b charge, \b diameter, \b body and
+# \b orientation. The number of queued and dropped samples and the queue depth are printed at the end of each run()
+# and can be queried with query_queue(). run() returns after the worker has processed all samples of the run.
+#
+# An exception raised by an asynchronous callback is printed and ends the run at the next period.
+#
+# \note In MPI simulations, the asynchronous callback is only called on the root rank.
+#
+# \note The callback must not modify the system (e.g. through the particle data proxies) when called
+# asynchronously.
+#
 class callback(_analyzer):
     ## Initialize the callback analyzer
     #
     # \param callback The python callback object
     # \param period The callback is called every \a period time steps
     # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
+    # \param asynchronous Set to True to call the callback on a worker thread
+    # \param queue_size Maximum number of samples waiting for the worker
+    # \param policy What to do when the queue is full: 'block', 'drop_oldest' or 'skip'
+    # \param fields List of particle fields to pass to an asynchronous callback
     #
     # \b Examples:
     # \code
@@ -716,13 +971,91 @@ class callback(_analyzer):
     #   print(timestep)
     #
     # analyze.callback(callback = my_callback, period = 100)
+    #
+    # def msd(timestep, data):
+    #   r = data['position'] + data['image'] * data['box'].Lx
+    #   ...
+    #
+    # analyze.callback(callback = msd, period = 1000, asynchronous=True, fields=['position', 'image'])
+    # analyze.callback(callback = msd, period = 100, asynchronous=True, queue_size=2, policy='drop_oldest',
+    #                  fields=['position', 'image'])
     # \endcode
-    def __init__(self, callback, period, phase=-1):
+    def __init__(self, callback, period, phase=-1, asynchronous=False, queue_size=4, policy='block', fields=[]):
         util.print_status_line();
 
         # initialize base class
         _analyzer.__init__(self);
 
+        if not asynchronous:
+            # create the c++ mirror class
+            self.cpp_analyzer = hoomd.CallbackAnalyzer(globals.system_definition, callback)
+            self.setupAnalyzer(period, phase);
+            return;
+
+        policies = {'block': hoomd.CallbackAnalyzer.queuePolicy.block,
+                    'drop_oldest': hoomd.CallbackAnalyzer.queuePolicy.drop_oldest,
+                    'skip': hoomd.CallbackAnalyzer.queuePolicy.skip};
+        if not policy in policies:
+            globals.msg.error("analyze.callback: unknown queue policy " + str(policy) + "\n");
+            raise RuntimeError('Error creating callback analyzer');
+
+        field_flags = {'position': hoomd.CallbackAnalyzer.fieldFlags.position,
+                       'velocity': hoomd.CallbackAnalyzer.fieldFlags.velocity,
+                       'image': hoomd.CallbackAnalyzer.fieldFlags.image,
+                       'typeid': hoomd.CallbackAnalyzer.fieldFlags.type,
+                       'mass': hoomd.CallbackAnalyzer.fieldFlags.mass,
+                       'charge': hoomd.CallbackAnalyzer.fieldFlags.charge,
+                       'diameter': hoomd.CallbackAnalyzer.fieldFlags.diameter,
+                       'body': hoomd.CallbackAnalyzer.fieldFlags.body,
+                       'orientation': hoomd.CallbackAnalyzer.fieldFlags.orientation};
+        flags = 0;
+        for f in fields:
+            if not f in field_flags:
+                globals.msg.error("analyze.callback: unknown field " + str(f) + "\n");
+                raise RuntimeError('Error creating callback analyzer');
+            flags |= int(field_flags[f]);
+
+        # convert the box to a data.boxdim before calling the user's callback
+        dimensions = globals.system_definition.getNDimensions();
+        def call_async(timestep, sample):
+            b = sample['box'];
+            L = b.getL();
+            sample['box'] = data.boxdim(Lx=L.x, Ly=L.y, Lz=L.z, xy=b.getTiltFactorXY(), xz=b.getTiltFactorXZ(),
+                                        yz=b.getTiltFactorYZ(), dimensions=dimensions);
+            callback(timestep, sample);
+
         # create the c++ mirror class
-        self.cpp_analyzer = hoomd.CallbackAnalyzer(globals.system_definition, callback)
+        self.cpp_analyzer = hoomd.CallbackAnalyzer(globals.system_definition, call_async)
+        self.cpp_analyzer.setAsync(int(queue_size), policies[policy], flags);
         self.setupAnalyzer(period, phase);
+
+    ## Wait until all queued samples have been processed
+    #
+    # run() already waits for the worker at the end of the run, wait() is only needed when the callback is
+    # asynchronous and results are required during a run (e.g. from the run() callback).
+    #
+    # \b Examples:
+    # \code
+    # cb.wait()
+    # \endcode
+    def wait(self):
+        util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_analyzer.flush();
+
+    ## Query the queue statistics of an asynchronous callback
+    #
+    # \returns A dict with the current queue \b depth, the \b max_depth reached, and the number of \b queued and
+    #          \b dropped samples in the last run()
+    #
+    # \b Examples:
+    # \code
+    # stats = cb.query_queue()
+    # print(stats['dropped'])
+    # \endcode
+    def query_queue(self):
+        return {'depth': self.cpp_analyzer.getQueueDepth(),
+                'max_depth': self.cpp_analyzer.getMaxQueueDepth(),
+                'queued': self.cpp_analyzer.getNumQueued(),
+                'dropped': self.cpp_analyzer.getNumDropped()};
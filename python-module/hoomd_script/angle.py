@@ -498,6 +498,9 @@ def _table_eval(theta, V, T, width):
 # \f$  T_{\mathrm{user}}(\theta) \f$ and \f$ V_{\mathrm{user}}(\theta) \f$ are evaluated on *width* grid points
 # between \f$ 0 \f$ and \f$ \pi \f$. Values are interpolated linearly between grid points.
 # For correctness, you must specify: \f$ T = -\frac{\partial V}{\partial \theta}\f$
+# With \a interp='cubic', V is instead interpolated by cubic Hermite polynomials with slopes -T at the grid points, and
+# the force is the derivative of the interpolated V. This conserves energy much better and needs far fewer grid points
+# for the same accuracy. Cubic interpolation is only available on the CPU.
 #
 # The following coefficients must be set per unique %pair of particle types.
 # - \f$ T_{\mathrm{user}}(\theta) \f$ and \f$ V_{\mathrm{user}}(\theta) \f$ - evaluated by `func` (see example)
@@ -544,6 +547,7 @@ class table(force._force):
     #
     # \param width Number of points to use to interpolate V and F (see documentation above)
     # \param name Name of the force instance
+    # \param interp Interpolation between the grid points, 'linear' or 'cubic' (CPU only, see documentation above)
     #
     # \b Example:
     # \code
@@ -558,7 +562,7 @@ class table(force._force):
     #
     # \note %Pair coefficients for all type angles in the simulation must be
     # set before it can be started with run()
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interp='linear'):
         util.print_status_line();
 
         # initialize the base class
@@ -571,6 +575,8 @@ class table(force._force):
         else:
             self.cpp_force = hoomd.TableAngleForceComputeGPU(globals.system_definition, int(width), self.name);
 
+        self._set_interpolation(interp, 'angle.table');
+
         globals.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficent matrix
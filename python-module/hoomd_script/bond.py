@@ -467,6 +467,9 @@ def _table_eval(r, rmin, rmax, V, F, width):
 # \f$  F_{\mathrm{user}}(r) \f$ and \f$ V_{\mathrm{user}}(r) \f$ are evaluated on *width* grid points between
 # \f$ r_{\mathrm{min}} \f$ and \f$ r_{\mathrm{max}} \f$. Values are interpolated linearly between grid points.
 # For correctness, you must specify the force defined by: \f$ F = -\frac{\partial V}{\partial r}\f$
+# With \a interp='cubic', V is instead interpolated by cubic Hermite polynomials with slopes -F at the grid points, and
+# the force is the derivative of the interpolated V. This conserves energy much better and needs far fewer grid points
+# for the same accuracy. Cubic interpolation is only available on the CPU.
 #
 # The following coefficients must be set per unique %pair of particle types.
 # - \f$ F_{\mathrm{user}}(r) \f$ and \f$ V_{\mathrm{user}}(r) \f$ - evaluated by `func` (see example)
@@ -519,6 +522,7 @@ class table(force._force):
     #
     # \param width Number of points to use to interpolate V and F (see documentation above)
     # \param name Name of the force instance
+    # \param interp Interpolation between the grid points, 'linear' or 'cubic' (CPU only, see documentation above)
     #
     # \b Example:
     # \code
@@ -536,7 +540,7 @@ class table(force._force):
     #
     # \note Be sure that \c rmin and \c rmax cover the range of bond values.  If gpu eror checking is on, a error will
     # be thrown if a bond distance is outside than this range.
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interp='linear'):
         util.print_status_line();
 
         # initialize the base class
@@ -549,6 +553,8 @@ class table(force._force):
         else:
             self.cpp_force = hoomd.BondTablePotentialGPU(globals.system_definition, int(width), self.name);
 
+        self._set_interpolation(interp, 'bond.table');
+
         globals.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficent matrix
@@ -1261,6 +1261,9 @@ class particle_data_proxy:
             f = self.pdata.getPNetForce(self.tag);
             return (f.x, f.y, f.z);
         if name == "net_energy":
+            # energies are only computed on steps where they are logged, catch up on them first
+            if globals.integrator is not None and globals.integrator.cpp_integrator is not None:
+                globals.integrator.cpp_integrator.computeNetEnergy();
             f = self.pdata.getPNetForce(self.tag);
             return f.w;
         if name == "net_torque":
@@ -57,11 +57,13 @@
 # each command writes.
 
 import hoomd;
+import signal;
 from hoomd_script import globals;
 from hoomd_script import analyze;
 import sys;
 from hoomd_script import util;
 from hoomd_script import group as hs_group;
+from hoomd_script import data;
 
 ## Writes simulation snapshots in the HOOMD XML format
 #
@@ -81,6 +83,8 @@ class xml(analyze._analyzer):
     #                  is ignored for periodic updates
     # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
     # \param restart When True, write only \a filename and don't save previous states.
+    # \param background When True, write the files on a separate thread while the simulation continues
+    # \param keep Number of restart files to keep when \a restart is True
     #
     # \b Examples:
     # \code
@@ -97,7 +101,15 @@ class xml(analyze._analyzer):
     #
     # If period is set and restart is True, dump.xml() will write a temporary file and then move it to \a filename. This
     # stores only the most recent state of the simulation in the written file. It is useful for writing jobs that
-    # are restartable. TODO - link to restartable documentation.
+    # are restartable. TODO - link to restartable documentation. With \a keep > 1, the previous restart files are kept
+    # as \a filename.1 (the most recent), \a filename.2, ... up to \a filename.(keep-1). Use set_checkpoint() to also
+    # write the restart file when the job is about to end.
+    #
+    # If \a background is True, the state of the system is copied at the time step of the write and the file is
+    # written on a separate thread while the simulation continues. This hides the time spent formatting and writing
+    # large files, at the cost of memory for one copy of the system state. At most one file is written at a time.
+    # The last file is complete when the writer is destroyed (e.g. at the end of the script) or write_restart() is
+    # called. Restart files are only moved to \a filename once complete.
     #
     # By default, only particle positions are output to the dump files. This can be changed
     # with set_params(), or by specifying the options in the dump.xml() command.
@@ -106,7 +118,7 @@ class xml(analyze._analyzer):
     # \a filename is written immediately. \a time_step is passed on to write()
     #
     # \a period can be a function: see \ref variable_period_docs for details
-    def __init__(self, filename="dump", period=None, time_step=None, phase=-1, restart=False, **params):
+    def __init__(self, filename="dump", period=None, time_step=None, phase=-1, restart=False, background=False, keep=1, **params):
         util.print_status_line();
 
         # initialize base class
@@ -117,8 +129,14 @@ class xml(analyze._analyzer):
         if restart and period is None:
             raise ValueError("a period must be specified with restart=True");
 
+        if keep < 1:
+            globals.msg.error("dump.xml: keep must be at least 1\n");
+            raise ValueError("Error creating xml dump");
+
         # create the c++ mirror class
         self.cpp_analyzer = hoomd.HOOMDDumpWriter(globals.system_definition, filename, restart);
+        self.cpp_analyzer.setBackground(background);
+        self.cpp_analyzer.setKeep(int(keep));
         util._disable_status_lines = True;
         self.set_params(**params);
         util._disable_status_lines = False;
@@ -296,7 +314,44 @@ class xml(analyze._analyzer):
         if not self.restart:
             raise ValueError("Cannot write_restart() when restart=False");
 
-        self.cpp_analyzer.analyze(globals.system.getCurrentTimeStep());
+        self.cpp_analyzer.writeRestart(globals.system.getCurrentTimeStep());
+
+    ## Write a checkpoint when the job is about to end
+    #
+    # \param signals List of signal names (e.g. 'SIGTERM', 'SIGUSR1') that request a checkpoint
+    # \param margin Time (in hours) before the end of the run() time limit at which the checkpoint is written
+    #
+    # This only works when dump.xml() is in **restart** mode. Batch systems typically send a signal to a job some
+    # time before its wall clock limit expires. When one of \a signals arrives, or when less than \a margin hours remain
+    # of the \a limit_hours given to run() (or of the time in the environment variable HOOMD_WALLTIME_STOP), the
+    # restart file is written at the next time step and the run ends. Any following run() ends immediately. The
+    # conditions are checked at the time steps that are a multiple of the \a limit_multiple given to run().
+    #
+    # The signals no longer terminate the program once set_checkpoint() has been called.
+    #
+    # \b Examples:
+    # \code
+    # xml = dump.xml(filename="restart.xml", all=True, restart=True, period=100000, keep=3)
+    # xml.set_checkpoint(signals=['SIGTERM', 'SIGUSR1'])
+    # xml.set_checkpoint(signals=[], margin=0.25)
+    # run(1e9, limit_hours=24)
+    # \endcode
+    #
+    # \MPI_SUPPORTED
+    def set_checkpoint(self, signals=['SIGTERM', 'SIGUSR1'], margin=0.0):
+        util.print_status_line();
+
+        if not self.restart:
+            globals.msg.error("dump.xml: set_checkpoint() requires restart=True\n");
+            raise ValueError("Error setting checkpoint");
+
+        for name in signals:
+            if not hasattr(signal, name):
+                globals.msg.error("dump.xml: unknown signal " + str(name) + "\n");
+                raise ValueError("Error setting checkpoint");
+            hoomd.install_checkpoint_handler(int(getattr(signal, name)));
+
+        globals.system.setCheckpoint(self.cpp_analyzer, float(margin));
 
 ## Writes a simulation snapshot in the MOL2 format
 #
@@ -477,6 +532,231 @@ class dcd(analyze._analyzer):
         raise RuntimeError('Error changing updater period');
 
 
+## Writes compressed trajectories
+#
+# Every \a period time steps, the particle positions are appended to the specified file. Positions are stored with a
+# fixed precision and coded as differences to the previous frame, which needs typically 3-5 bytes per particle at a
+# precision of 1e-3 (DCD files take 12). Only the positions are stored, use in conjunction with dump.xml for the
+# particle types and topology.
+#
+# Compressing and writing a frame happens in the background while the simulation continues. The file can be read
+# with dump.compressed_trajectory.
+#
+# Particle positions are written directly in distance units, see \ref page_units for more information.
+#
+# \MPI_SUPPORTED
+class compressed(analyze._analyzer):
+    ## Initialize the compressed trajectory writer
+    #
+    # \param filename File name to write
+    # \param period Number of time steps between file dumps
+    # \param group Particle group to output to the file. If left as None, all particles will be written
+    # \param precision Positions are rounded to a multiple of \a precision (in distance units)
+    # \param keyframe_interval Every \a keyframe_interval frames, a frame is written that does not depend on the
+    #        previous ones. Reading a frame starts at the closest keyframe before it.
+    # \param overwrite When False, (the default) an existing file will be appended to. When True, an existing file
+    #        \a filename will be overwritten.
+    # \param unwrap_full When False, (the default) particle coordinates are always written inside the simulation box.
+    #        When True, particles will be unwrapped into their current box image before writing.
+    # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
+    #
+    # \b Examples:
+    # \code
+    # dump.compressed(filename="trajectory.hct", period=1000)
+    # traj = dump.compressed(filename="trajectory.hct", period=100, precision=1e-4, unwrap_full=True)
+    # \endcode
+    #
+    # \warning
+    # When you use dump.compressed to append to an existing file
+    # - \a precision and the number of particles in \a group must be the same as in the file.
+    # - dump.compressed will not write out data at time steps that already are present in the file to maintain a
+    #   consistent timeline
+    #
+    # \a period can be a function: see \ref variable_period_docs for details
+    def __init__(self, filename, period, group=None, precision=1e-3, keyframe_interval=100, overwrite=False, unwrap_full=False, phase=-1):
+        util.print_status_line();
+
+        # initialize base class
+        analyze._analyzer.__init__(self);
+
+        if group is None:
+            util._disable_status_lines = True;
+            group = hs_group.all();
+            util._disable_status_lines = False;
+
+        # create the c++ mirror class
+        self.cpp_analyzer = hoomd.CompressedDumpWriter(globals.system_definition, filename, group.cpp_group, float(precision), int(keyframe_interval), overwrite);
+        self.cpp_analyzer.setUnwrapFull(unwrap_full);
+        self.setupAnalyzer(period, phase);
+
+        # store metadata
+        self.filename = filename
+        self.period = period
+        self.group = group
+        self.precision = precision
+        self.metadata_fields = ['filename','period','group','precision']
+
+    ## Write the frame index to the file
+    #
+    # The index is written automatically when the writer is deleted at the end of the script. Files without an index
+    # can still be read, but opening them takes longer.
+    #
+    # \b Examples:
+    # \code
+    # traj.write_index()
+    # \endcode
+    def write_index(self):
+        util.print_status_line();
+        self.cpp_analyzer.writeIndex();
+
+## \internal
+# \brief Base class for trajectory readers
+#
+# Derived classes set \c cpp_reader, which provides getNumFrames(), getTimeStep(), getBox(), getPositionsNP() and
+# prefetch().
+class _trajectory:
+    ## \internal
+    # \brief Get the number of frames
+    def __len__(self):
+        return self.cpp_reader.getNumFrames();
+
+    ## \internal
+    # \brief Get a frame, or a list of frames for a slice
+    # \param index Index of the frame, negative values count from the end
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [_trajectory.frame(self.cpp_reader, i) for i in range(*index.indices(len(self)))];
+
+        if index < 0:
+            index += len(self);
+        if index < 0 or index >= len(self):
+            raise IndexError('frame index out of range');
+        return _trajectory.frame(self.cpp_reader, index);
+
+    ## \internal
+    # \brief Iterate over all frames
+    def __iter__(self):
+        return self.iterate();
+
+    ## Iterate over a range of frames
+    #
+    # \param start Index of the first frame
+    # \param stop Index behind the last frame (None for the end of the file)
+    # \param step Number of frames to advance between two iterations
+    #
+    # The file data of the next frame is read in the background while the current frame is processed.
+    #
+    # \b Examples:
+    # \code
+    # for frame in traj.iterate(start=100, step=10):
+    #     print(frame.timestep)
+    # \endcode
+    def iterate(self, start=0, stop=None, step=1):
+        for i in range(*slice(start, stop, step).indices(len(self))):
+            self.cpp_reader.prefetch(i + step);
+            yield _trajectory.frame(self.cpp_reader, i);
+
+    ## \internal
+    # \brief A frame of a trajectory
+    class frame:
+        ## \internal
+        # \param cpp_reader C++ reader of the file
+        # \param index Index of the frame
+        def __init__(self, cpp_reader, index):
+            self.cpp_reader = cpp_reader;
+            self.index = index;
+            self.timestep = cpp_reader.getTimeStep(index);
+
+            b = cpp_reader.getBox(index);
+            L = b.getL();
+            self.box = data.boxdim(Lx=L.x, Ly=L.y, Lz=L.z, xy=b.getTiltFactorXY(), xz=b.getTiltFactorXZ(), yz=b.getTiltFactorYZ());
+
+        ## \internal
+        # \brief Read the positions on demand
+        def __getattr__(self, name):
+            if name == 'position':
+                return self.cpp_reader.getPositionsNP(self.index);
+            raise AttributeError;
+
+## Reads compressed trajectories
+#
+# compressed_trajectory gives access to the frames of a file written by dump.compressed. Frames are numbered from 0
+# and can be read in any order. Every frame has the attributes
+# - \c timestep - the time step at which the frame was written
+# - \c box - the simulation box (data.boxdim)
+# - \c position - a N x 3 numpy array with the particle positions, in the order of the particle tags
+#
+# Reading the frames in sequence is fastest, a random frame takes longer the further it is from the closest keyframe
+# before it. Slicing the trajectory gives a list of frames, and iterate() loops over a range of frames with a stride.
+#
+# \b Examples:
+# \code
+# traj = dump.compressed_trajectory('trajectory.hct')
+# print(len(traj), traj.N)
+# last = traj[-1]
+# for frame in traj:
+#     print(frame.timestep, frame.position[0])
+# \endcode
+#
+# \note The positions of the whole file are not kept in memory, every access to \c position reads and decodes the
+# frame again. Store the array in a variable when it is used more than once.
+class compressed_trajectory(_trajectory):
+    ## Open a compressed trajectory file
+    #
+    # \param filename File name to read
+    def __init__(self, filename):
+        if globals.exec_conf is None:
+            globals.msg.error("Call context.initialize() before reading trajectories\n");
+            raise RuntimeError('Error reading trajectory');
+
+        self.cpp_reader = hoomd.CompressedTrajectoryReader(globals.exec_conf, filename);
+
+        ## Number of particles in every frame
+        self.N = self.cpp_reader.getN();
+        ## Precision of the positions in the file
+        self.precision = self.cpp_reader.getPrecision();
+
+## Reads DCD trajectories
+#
+# dcd_trajectory gives access to the frames of a file written by dump.dcd. The file is mapped into memory, so that
+# opening it is instant regardless of its size and frames are read from disk only when they are accessed. Frames
+# are numbered from 0 and can be read in any order at the same cost. Every frame has the attributes
+# - \c timestep - the time step at which the frame was written
+# - \c box - the simulation box (data.boxdim)
+# - \c position - a N x 3 numpy array with the particle positions, in the order in which they were written
+#
+# \c position refers directly to the data in the file without a copy. It is a read only float32 array that is not
+# contiguous in memory (use numpy.array(frame.position) for a contiguous copy). The array remains valid after the
+# trajectory is deleted.
+#
+# Slicing the trajectory gives a list of frames, and iterate() loops over a range of frames with a stride.
+#
+# \b Examples:
+# \code
+# traj = dump.dcd_trajectory('trajectory.dcd')
+# print(len(traj), traj.N)
+# for frame in traj.iterate(step=10):
+#     print(frame.timestep, frame.box.Lx, frame.position.mean(axis=0))
+# msd = [numpy.mean((f.position - traj[0].position)**2) for f in traj[::100]]
+# \endcode
+#
+# \note Only files with unit cell information, as written by dump.dcd, can be read. The number of frames is
+# determined from the file size, so that an incomplete last frame of a simulation that did not end cleanly is
+# ignored.
+class dcd_trajectory(_trajectory):
+    ## Open a DCD file
+    #
+    # \param filename File name to read
+    def __init__(self, filename):
+        if globals.exec_conf is None:
+            globals.msg.error("Call context.initialize() before reading trajectories\n");
+            raise RuntimeError('Error reading trajectory');
+
+        self.cpp_reader = hoomd.DCDTrajectoryReader(globals.exec_conf, filename);
+
+        ## Number of particles in every frame
+        self.N = self.cpp_reader.getN();
+
 ## Writes simulation snapshots in the PBD format
 #
 # Every \a period time steps, a new file will be created. The state of the
@@ -101,6 +101,7 @@ class _force(meta._metadata):
         self.force_name = "force%d" % (id);
         self.enabled = True;
         self.log =True;
+        self.period = 1;
         globals.forces.append(self);
 
         # base class constructor
@@ -205,6 +206,48 @@ class _force(meta._metadata):
         # run the benchmark
         return self.cpp_force.benchmark(int(n))
 
+    ## Sets the number of time steps between evaluations of the force
+    # \param period Evaluate the force every \a period time steps
+    #
+    # \b Examples:
+    # \code
+    # force.set_period(4)
+    # \endcode
+    #
+    # Slowly varying forces (e.g. long ranged pair potentials) can be evaluated less often than the fast ones
+    # (bonds, short ranged repulsion) to save time (multiple time step r-RESPA integration). A force with
+    # \a period > 1 is evaluated every \a period time steps and applied as an impulse \a period times as large as
+    # its regular contribution, split into two half kicks around the evaluation step. All force periods start in
+    # phase on the first time step of the first run(). The time step \a dt must remain small enough to resolve the
+    # fastest force that is evaluated every step.
+    #
+    # Between evaluations, the force is still computed on time steps where its potential energy or virial is needed
+    # (e.g. for logging), but it does not contribute to the net force on those steps. Each of these extra evaluations
+    # costs as much as a regular one, so they can eat up the savings:
+    # - Barostats (integrate.npt, integrate.nph, and the rigid body versions) need the virial on every time step, so
+    #   the force is computed on every step and \a period > 1 saves no time.
+    # - Logged energies and pressures require an evaluation on every logging step. Use a logging period that is a
+    #   multiple of \a period to avoid the extra evaluations.
+    #
+    # \note Force periods are only supported by integrate.mode_standard.
+    #
+    # To use this command, you must have saved the force in a variable, as
+    # shown in this example:
+    # \code
+    # force = pair.some_force()
+    # # ... later in the script
+    # force.set_period(4)
+    # \endcode
+    def set_period(self, period):
+        util.print_status_line();
+        self.check_initialization();
+
+        if int(period) < 1:
+            globals.msg.error("force.set_period: period must be at least 1\n");
+            raise RuntimeError('Error setting force period');
+
+        self.period = int(period);
+
     ## Enables the force
     #
     # \b Examples:
@@ -236,6 +279,20 @@ class _force(meta._metadata):
         raise RuntimeError("_force.update_coeffs should not be called");
         # does nothing: this is for derived classes to implement
 
+    ## \internal
+    # \brief Selects the interpolation scheme of a tabulated force
+    # \param interp 'linear' or 'cubic'
+    # \param cmd Name of the command, for error messages
+    def _set_interpolation(self, interp, cmd):
+        if interp == 'cubic':
+            if globals.exec_conf.isCUDAEnabled():
+                globals.msg.error(cmd + ": cubic interpolation is not supported on the GPU\n");
+                raise RuntimeError('Error setting up ' + cmd);
+            self.cpp_force.setCubicInterpolation(True);
+        elif interp != 'linear':
+            globals.msg.error(cmd + ": interp must be 'linear' or 'cubic'\n");
+            raise RuntimeError('Error setting up ' + cmd);
+
     ## \internal
     # \brief Returns the force data
     #
@@ -250,6 +307,7 @@ class _force(meta._metadata):
         data = meta._metadata.get_metadata(self)
         data['enabled'] = self.enabled
         data['log'] = self.log
+        data['period'] = self.period
         if self.name is not "":
             data['name'] = self.name
 
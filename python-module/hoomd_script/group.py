@@ -565,6 +565,27 @@ def charged(name='charged'):
 
 # {@
 
+## \internal
+# \brief Combine two groups
+#
+# \param a First group
+# \param b Second group
+# \param selector_class C++ selector class that combines two selectors
+# \param group_function C++ function that combines the member tags of two groups
+#
+# When both groups update their members (group.all(), or groups created with update=True), the new group is built
+# from the combination of both selectors, so that it is updated along with them. Otherwise, the current member tags
+# are combined, and the new group stays fixed like its operands, even if the selectors would now select different
+# particles (e.g. a cuboid after particles have moved).
+def _combine(a, b, selector_class, group_function):
+    selector_a = a.cpp_group.getSelector();
+    selector_b = b.cpp_group.getSelector();
+    if selector_a is not None and selector_b is not None and a.cpp_group.getUpdateTags() and b.cpp_group.getUpdateTags():
+        selector = selector_class(globals.system_definition, selector_a, selector_b);
+        return hoomd.ParticleGroup(globals.system_definition, selector, True);
+    else:
+        return group_function(a.cpp_group, b.cpp_group);
+
 ## Create a new group from the set difference or complement of two existing groups
 #
 # \param name User-assigned name for this group
@@ -583,7 +604,7 @@ def charged(name='charged'):
 # nottypeA = group.union(name="particles-not-typeA", a=all, b=groupA)
 # \endcode
 def difference(name, a, b):
-    new_cpp_group = hoomd.ParticleGroup.groupDifference(a.cpp_group, b.cpp_group);
+    new_cpp_group = _combine(a, b, hoomd.ParticleSelectorDifference, hoomd.ParticleGroup.groupDifference);
     # notify the user of the created group
     globals.msg.notice(2, 'Group "' + name + '" created containing ' + str(new_cpp_group.getNumMembersGlobal()) + ' particles\n');
     return group(name, new_cpp_group);
@@ -604,7 +625,7 @@ def difference(name, a, b):
 # groupC = group.intersection(name="groupC", a=groupA, b=group100_199)
 # \endcode
 def intersection(name, a, b):
-    new_cpp_group = hoomd.ParticleGroup.groupIntersection(a.cpp_group, b.cpp_group);
+    new_cpp_group = _combine(a, b, hoomd.ParticleSelectorIntersection, hoomd.ParticleGroup.groupIntersection);
     # notify the user of the created group
     globals.msg.notice(2, 'Group "' + name + '" created containing ' + str(new_cpp_group.getNumMembersGlobal()) + ' particles\n');
     return group(name, new_cpp_group);
@@ -625,7 +646,7 @@ def intersection(name, a, b):
 # groupAB = group.union(name="ab-particles", a=groupA, b=groupB)
 # \endcode
 def union(name, a, b):
-    new_cpp_group = hoomd.ParticleGroup.groupUnion(a.cpp_group, b.cpp_group);
+    new_cpp_group = _combine(a, b, hoomd.ParticleSelectorUnion, hoomd.ParticleGroup.groupUnion);
     # notify the user of the created group
     globals.msg.notice(2, 'Group "' + name + '" created containing ' + str(new_cpp_group.getNumMembersGlobal()) + ' particles\n');
     return group(name, new_cpp_group);
@@ -785,6 +785,14 @@ def _create_exec_conf():
     if globals.options.gpu_error_checking:
        exec_conf.setCUDAErrorChecking(True);
 
+    # set the placement policy for large particle arrays before any are allocated
+    huge_pages = globals.options.huge_pages;
+    if huge_pages is None:
+        huge_pages = 'none';
+    if huge_pages != 'none' or globals.options.first_touch:
+        exec_conf.setHostMemoryPolicy(getattr(hoomd.ExecutionConfiguration.hugePageMode, huge_pages),
+                                      bool(globals.options.first_touch));
+
     globals.exec_conf = exec_conf;
 
     return exec_conf;
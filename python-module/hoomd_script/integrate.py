@@ -169,6 +169,12 @@ class _integrator(meta._metadata):
             if f.enabled:
                 self.cpp_integrator.addForceCompute(f.cpp_force);
 
+                if f.period != 1:
+                    if not isinstance(self.cpp_integrator, hoomd.IntegratorTwoStep):
+                        globals.msg.error('Force periods are only supported by integrate.mode_standard\n');
+                        raise RuntimeError('Error updating forces');
+                    self.cpp_integrator.setForcePeriod(f.cpp_force, f.period);
+
         # set the constraint forces
         for f in globals.constraint_forces:
             if f.cpp_force is None:
@@ -982,7 +988,7 @@ def bdnvt(group, T, seed=0, gamma_diam=False, limit=None, tally=False):
 # \f[ \langle |\vec{F}_\mathrm{R}|^2 \rangle = 2 d k_\mathrm{B} T \gamma / \delta t, \f]
 # where \f$ \vec{F}_\mathrm{C} \f$ is the force on the particle from all potentials and constraint forces,
 # \f$ \gamma \f$ is the drag coefficient, \f$ \vec{v} \f$ is the particle's velocity, \f$ \vec{F}_\mathrm{R} \f$
-# is a uniform random force, and \f$ d \f$ is the dimensionality of the system (2 or 3).  The magnitude of
+# is a Gaussian random force, and \f$ d \f$ is the dimensionality of the system (2 or 3).  The magnitude of
 # the random force is chosen via the fluctuation-dissipation theorem
 # to be consistent with the specified drag and temperature, \f$ T \f$.
 # When \f$ T=0 \f$, the random force \f$ \vec{F}_\mathrm{R}=0 \f$.
@@ -1132,7 +1138,7 @@ class langevin(_integration_method):
 # \f[ \langle |\vec{v}(t)|^2 \rangle = d k_\mathrm{B} T / m, \f]
 # where \f$ \vec{F}_\mathrm{C} \f$ is the force on the particle from all potentials and constraint forces,
 # \f$ \gamma \f$ is the drag coefficient, \f$ \vec{F}_\mathrm{R} \f$
-# is a uniform random force, \f$ \vec{v} \f$ is the particle's velocity, and \f$ d \f$ is the dimensionality
+# is a Gaussian random force, \f$ \vec{v} \f$ is the particle's velocity, and \f$ d \f$ is the dimensionality
 # of the system. The magnitude of the random force is chosen via the fluctuation-dissipation theorem
 # to be consistent with the specified drag and temperature, \f$ T \f$.
 # When \f$ T=0 \f$, the random force \f$ \vec{F}_\mathrm{R}=0 \f$.
@@ -1273,7 +1279,10 @@ class brownian(_integration_method):
 # integrate.nve_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, every rank keeps a copy of all rigid bodies and the body forces and torques are summed
+# over all ranks. This is only supported on the CPU.
+# \MPI_SUPPORTED
 class nve_rigid(_integration_method):
     ## Specifies the NVE integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1300,10 +1309,10 @@ class nve_rigid(_integration_method):
                          feature='rigid body integration')
         cite._ensure_global_bib().add(c)
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nve_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nve_rigid is not supported on the GPU in multi-processor simulations.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1334,7 +1343,10 @@ class nve_rigid(_integration_method):
 # integrate.nvt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, every rank keeps a copy of all rigid bodies and the body forces and torques are summed
+# over all ranks. This is only supported on the CPU.
+# \MPI_SUPPORTED
 class nvt_rigid(_integration_method):
     ## Specifies the NVT integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1366,10 +1378,10 @@ class nvt_rigid(_integration_method):
                          feature='rigid body integration')
         cite._ensure_global_bib().add(c)
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nvt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nvt_rigid is not supported on the GPU in multi-processor simulations.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1452,7 +1464,10 @@ class nvt_rigid(_integration_method):
 # integrate.bdnvt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, every rank keeps a copy of all rigid bodies and the body forces and torques are summed
+# over all ranks. This is only supported on the CPU.
+# \MPI_SUPPORTED
 class bdnvt_rigid(_integration_method):
     ## Specifies the BD NVT integrator for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1488,10 +1503,10 @@ class bdnvt_rigid(_integration_method):
                          feature='rigid body integration')
         cite._ensure_global_bib().add(c)
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.bdnvt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.bdnvt_rigid is not supported on the GPU in multi-processor simulations.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1619,7 +1634,10 @@ class bdnvt_rigid(_integration_method):
 # integrate.npt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, every rank keeps a copy of all rigid bodies and the body forces and torques are summed
+# over all ranks. This is only supported on the CPU.
+# \MPI_SUPPORTED
 class npt_rigid(_integration_method):
     ## Specifies the NVT integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1661,10 +1679,10 @@ class npt_rigid(_integration_method):
                      feature='rigid body integration')
         cite._ensure_global_bib().add(c)
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.npt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.npt_rigid is not supported on the GPU in multi-processor simulations.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1840,7 +1858,10 @@ class npt_rigid(_integration_method):
 # integrate.nph_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, every rank keeps a copy of all rigid bodies and the body forces and torques are summed
+# over all ranks. This is only supported on the CPU.
+# \MPI_SUPPORTED
 class nph_rigid(_integration_method):
     ## Specifies the NPH integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1880,10 +1901,10 @@ class nph_rigid(_integration_method):
                      feature='rigid body integration')
         cite._ensure_global_bib().add(c)
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nph_rigid is not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nph_rigid is not supported on the GPU in multi-processor simulations.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -193,6 +193,9 @@ class _nlist:
     #        run() commands. (in distance units)
     # \param dist_check When set to False, disable the distance checking logic and always regenerate the nlist every
     #        \a check_period steps
+    # \param adaptive (if set) When True, predict the next build from the growth of the particle displacements and
+    #        skip the distance checks until close to it
+    # \param tune_r_buff (if set) When True, tune \a r_buff during the following runs to minimize the time per step
     #
     # set_params() changes one or more parameters of the neighbor list. \a r_buff and \a check_period
     # can have a significant effect on performance. As \a r_buff is made larger, the neighbor list needs
@@ -214,6 +217,16 @@ class _nlist:
     # moves a distance more than \a r_buff/2.0 during a the \a check_period. If this occurs, a \b dangerous
     # \b build is counted and printed in the neighbor list statistics at the end of a run().
     #
+    # With \a adaptive = True, each distance check records how far the fastest particle has moved relative to
+    # \a r_buff/2.0 and the following checks are skipped until shortly before it is predicted to get there.
+    # \a check_period is the minimum number of steps between a build and the next check. A build that finds the limit
+    # already exceeded on a skipped step counts as dangerous and makes later predictions more conservative. Adaptive
+    # checks are performed on the CPU only, on the GPU the list is checked every \a check_period steps.
+    #
+    # With \a tune_r_buff = True, \a r_buff is tuned during the following runs. The time per step is measured over
+    # several builds at a time and \a r_buff moves in the direction that makes the steps faster until it converges.
+    # The tuned value is printed at notice level 2.
+    #
     # When using pair.slj, \a d_max \b MUST be set to the maximum diameter that a particle will attain at any point
     # during the following run() commands (see pair.slj for more information). When using in conjunction with pair.slj,
     # pair.slj will
@@ -229,8 +242,9 @@ class _nlist:
     # nl.set_params(check_period = 11)
     # nl.set_params(r_buff = 0.7, check_period = 4)
     # nl.set_params(d_max = 3.0)
+    # nl.set_params(adaptive = True, tune_r_buff = True)
     # \endcode
-    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True):
+    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, adaptive=None, tune_r_buff=None):
         util.print_status_line();
 
         if self.cpp_nlist is None:
@@ -248,6 +262,12 @@ class _nlist:
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+        if adaptive is not None:
+            self.cpp_nlist.setAdaptive(adaptive);
+
+        if tune_r_buff is not None:
+            self.cpp_nlist.setTuneRBuff(tune_r_buff);
+
     ## Resets all exclusions in the neighborlist
     #
     # \param exclusions Select which interactions should be excluded from the %pair interaction calculation.
@@ -656,6 +676,9 @@ class cell(_nlist):
     #        run() commands. (in distance units)
     # \param dist_check When set to False, disable the distance checking logic and always regenerate the nlist every
     #        \a check_period steps
+    # \param adaptive (if set) When True, predict the next build from the growth of the particle displacements and
+    #        skip the distance checks until close to it
+    # \param tune_r_buff (if set) When True, tune \a r_buff during the following runs to minimize the time per step
     # \param deterministic (if set) Enable deterministic runs on the GPU by sorting the cell list
     #
     # set_params() changes one or more parameters of the neighbor list. \a r_buff and \a check_period
@@ -678,6 +701,16 @@ class cell(_nlist):
     # moves a distance more than \a r_buff/2.0 during a the \a check_period. If this occurs, a \b dangerous
     # \b build is counted and printed in the neighbor list statistics at the end of a run().
     #
+    # With \a adaptive = True, each distance check records how far the fastest particle has moved relative to
+    # \a r_buff/2.0 and the following checks are skipped until shortly before it is predicted to get there.
+    # \a check_period is the minimum number of steps between a build and the next check. A build that finds the limit
+    # already exceeded on a skipped step counts as dangerous and makes later predictions more conservative. Adaptive
+    # checks are performed on the CPU only, on the GPU the list is checked every \a check_period steps.
+    #
+    # With \a tune_r_buff = True, \a r_buff is tuned during the following runs. The time per step is measured over
+    # several builds at a time and \a r_buff moves in the direction that makes the steps faster until it converges.
+    # The tuned value is printed at notice level 2.
+    #
     # When using pair.slj, \a d_max \b MUST be set to the maximum diameter that a particle will attain at any point
     # during the following run() commands (see pair.slj for more information). When using in conjunction with pair.slj,
     # pair.slj will
@@ -693,6 +726,7 @@ class cell(_nlist):
     # nl.set_params(check_period = 11)
     # nl.set_params(r_buff = 0.7, check_period = 4)
     # nl.set_params(d_max = 3.0)
+    # nl.set_params(adaptive = True, tune_r_buff = True)
     # \endcode
     #
     # \note For truly deterministic simulations, also the autotuner should be disabled.
@@ -703,7 +737,8 @@ class cell(_nlist):
     # nlist.set_params(deterministic=True)
     # option.set_autotuner_params(enable=False)
     # \endcode
-    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, deterministic=None):
+    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, deterministic=None, adaptive=None,
+                   tune_r_buff=None):
         util.print_status_line();
 
         if self.cpp_nlist is None:
@@ -721,6 +756,12 @@ class cell(_nlist):
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+        if adaptive is not None:
+            self.cpp_nlist.setAdaptive(adaptive);
+
+        if tune_r_buff is not None:
+            self.cpp_nlist.setTuneRBuff(tune_r_buff);
+
         if deterministic is not None:
             self.cpp_cl.setSortCellList(deterministic)
 cell.cur_id = 0
@@ -817,6 +858,9 @@ class stencil(_nlist):
     #        run() commands. (in distance units)
     # \param dist_check When set to False, disable the distance checking logic and always regenerate the nlist every
     #        \a check_period steps
+    # \param adaptive (if set) When True, predict the next build from the growth of the particle displacements and
+    #        skip the distance checks until close to it
+    # \param tune_r_buff (if set) When True, tune \a r_buff during the following runs to minimize the time per step
     # \param cell_width The underlying stencil bin width for the cell list
     # \param deterministic (if set) Enable deterministic runs on the GPU by sorting the cell list
     #
@@ -840,6 +884,16 @@ class stencil(_nlist):
     # moves a distance more than \a r_buff/2.0 during a the \a check_period. If this occurs, a \b dangerous
     # \b build is counted and printed in the neighbor list statistics at the end of a run().
     #
+    # With \a adaptive = True, each distance check records how far the fastest particle has moved relative to
+    # \a r_buff/2.0 and the following checks are skipped until shortly before it is predicted to get there.
+    # \a check_period is the minimum number of steps between a build and the next check. A build that finds the limit
+    # already exceeded on a skipped step counts as dangerous and makes later predictions more conservative. Adaptive
+    # checks are performed on the CPU only, on the GPU the list is checked every \a check_period steps.
+    #
+    # With \a tune_r_buff = True, \a r_buff is tuned during the following runs. The time per step is measured over
+    # several builds at a time and \a r_buff moves in the direction that makes the steps faster until it converges.
+    # The tuned value is printed at notice level 2.
+    #
     # When using pair.slj, \a d_max \b MUST be set to the maximum diameter that a particle will attain at any point
     # during the following run() commands (see pair.slj for more information). When using in conjunction with pair.slj,
     # pair.slj will
@@ -855,6 +909,7 @@ class stencil(_nlist):
     # nl.set_params(check_period = 11)
     # nl.set_params(r_buff = 0.7, check_period = 4)
     # nl.set_params(d_max = 3.0)
+    # nl.set_params(adaptive = True, tune_r_buff = True)
     # \endcode
     #
     # \note For truly deterministic simulations, also the autotuner should be disabled.
@@ -865,7 +920,8 @@ class stencil(_nlist):
     # nlist.set_params(deterministic=True)
     # option.set_autotuner_params(enable=False)
     # \endcode
-    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, cell_width=None, deterministic=None):
+    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, cell_width=None, deterministic=None,
+                   adaptive=None, tune_r_buff=None):
         util.print_status_line();
 
         if self.cpp_nlist is None:
@@ -886,6 +942,12 @@ class stencil(_nlist):
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+        if adaptive is not None:
+            self.cpp_nlist.setAdaptive(adaptive);
+
+        if tune_r_buff is not None:
+            self.cpp_nlist.setTuneRBuff(tune_r_buff);
+
         if deterministic is not None:
             self.cpp_cl.setSortCellList(deterministic)
 
@@ -1065,6 +1127,9 @@ def _subscribe_global_nlist(cb):
 #        run() commands. (in distance units)
 # \param dist_check When set to False, disable the distance checking logic and always regenerate the nlist every
 #        \a check_period steps
+# \param adaptive (if set) When True, predict the next build from the growth of the particle displacements and
+#        skip the distance checks until close to it
+# \param tune_r_buff (if set) When True, tune \a r_buff during the following runs to minimize the time per step
 # \param deterministic (if set) Enable deterministic runs on the GPU by sorting the cell list
 #
 # set_params() changes one or more parameters of the neighbor list. \a r_buff and \a check_period
@@ -1087,6 +1152,8 @@ def _subscribe_global_nlist(cb):
 # moves a distance more than \a r_buff/2.0 during a the \a check_period. If this occurs, a \b dangerous
 # \b build is counted and printed in the neighbor list statistics at the end of a run().
 #
+# See cell.set_params() for the \a adaptive and \a tune_r_buff options.
+#
 # When using pair.slj, \a d_max \b MUST be set to the maximum diameter that a particle will attain at any point
 # during the following run() commands (see pair.slj for more information). When using in conjunction with pair.slj,
 # pair.slj will
@@ -1112,14 +1179,16 @@ def _subscribe_global_nlist(cb):
 # nlist.set_params(deterministic=True)
 # option.set_autotuner_params(enable=False)
 # \endcode
-def set_params(r_buff=None, check_period=None, d_max=None, dist_check=True, deterministic=True):
+def set_params(r_buff=None, check_period=None, d_max=None, dist_check=True, deterministic=True, adaptive=None,
+               tune_r_buff=None):
     util.print_status_line();
     if globals.neighbor_list is None:
         globals.msg.error('Cannot set global neighbor list parameters without creating it first\n');
         raise RuntimeError('Error modifying global neighbor list');
 
     util._disable_status_lines = True;
-    globals.neighbor_list.set_params(r_buff, check_period, d_max, dist_check, deterministic);
+    globals.neighbor_list.set_params(r_buff, check_period, d_max, dist_check, deterministic, adaptive=adaptive,
+                                     tune_r_buff=tune_r_buff);
     util._disable_status_lines = False;
 
 ## Thin wrapper for resetting exclusion for global neighbor list
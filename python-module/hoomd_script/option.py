@@ -76,6 +76,8 @@ class options:
         self.gpu_error_checking = None;
         self.min_cpu = None;
         self.ignore_display = None;
+        self.huge_pages = None;
+        self.first_touch = None;
         self.user = [];
         self.notice_level = 2;
         self.msg_file = None;
@@ -95,6 +97,8 @@ class options:
                    gpu_error_checking=self.gpu_error_checking,
                    min_cpu=self.min_cpu,
                    ignore_display=self.ignore_display,
+                   huge_pages=self.huge_pages,
+                   first_touch=self.first_touch,
                    user=self.user,
                    notice_level=self.notice_level,
                    msg_file=self.msg_file,
@@ -118,6 +122,8 @@ def _parse_command_line(arg_string=None):
     parser.add_option("--gpu_error_checking", dest="gpu_error_checking", action="store_true", default=False, help="Enable error checking on the GPU");
     parser.add_option("--minimize-cpu-usage", dest="min_cpu", action="store_true", default=False, help="Enable to keep the CPU usage of HOOMD to a bare minimum (will degrade overall performance somewhat)");
     parser.add_option("--ignore-display-gpu", dest="ignore_display", action="store_true", default=False, help="Attempt to avoid running on the display GPU");
+    parser.add_option("--huge-pages", dest="huge_pages", help="Huge pages for large particle arrays (none, transparent or explicit)", default='none');
+    parser.add_option("--first-touch", dest="first_touch", action="store_true", default=False, help="Place the pages of large particle arrays on the NUMA node of the OpenMP thread that processes them");
     parser.add_option("--notice-level", dest="notice_level", help="Minimum level of notice messages to print");
     parser.add_option("--msg-file", dest="msg_file", help="Name of file to write messages to");
     parser.add_option("--shared-msg-file", dest="shared_msg_file", help="(MPI only) Name of shared file to write message to (append partition #)");
@@ -140,6 +146,10 @@ def _parse_command_line(arg_string=None):
         if not (cmd_options.mode == "cpu" or cmd_options.mode == "gpu" or cmd_options.mode == "auto"):
             parser.error("--mode must be either cpu, gpu, or auto");
 
+    # check for valid huge page setting
+    if not (cmd_options.huge_pages == "none" or cmd_options.huge_pages == "transparent" or cmd_options.huge_pages == "explicit"):
+        parser.error("--huge-pages must be either none, transparent, or explicit");
+
     # check for sane options
     if cmd_options.mode == "cpu" and (cmd_options.gpu is not None):
         parser.error("--mode=cpu cannot be specified along with --gpu")
@@ -198,6 +208,8 @@ def _parse_command_line(arg_string=None):
     globals.options.gpu_error_checking = cmd_options.gpu_error_checking;
     globals.options.min_cpu = cmd_options.min_cpu;
     globals.options.ignore_display = cmd_options.ignore_display;
+    globals.options.huge_pages = cmd_options.huge_pages;
+    globals.options.first_touch = cmd_options.first_touch;
 
     globals.options.nx = cmd_options.nx;
     globals.options.ny = cmd_options.ny;
@@ -565,6 +565,63 @@ class pair(force._force):
         # future versions could use np functions to test the assumptions above and raise an error if they occur.
         return self.cpp_force.computeEnergyBetweenSets(tags1, tags2);
 
+## Evaluate several %pair forces in a single pass over their neighbor list
+#
+# Each %pair %force normally makes its own pass over the neighbor list, reading the particle positions and computing
+# the distance of every %pair. When several %pair forces share a neighbor list (e.g. pair.lj plus pair.yukawa),
+# pair.fuse walks the neighbor list once per time step, computes the %pair distances once and evaluates all of the
+# given %pair forces on them. The forces still act and log exactly as if they were computed separately.
+#
+# All forces passed to pair.fuse must use the same neighbor list. The DPD thermostats (pair.dpd and pair.dpdlj), the
+# anisotropic %pair forces and pair.tersoff cannot be fused.
+# pair.fuse has no effect on the GPU, where it prints a notice and leaves the forces unchanged.
+#
+# \b Example:
+# \code
+# lj = pair.lj(r_cut=3.0)
+# yuk = pair.yukawa(r_cut=3.0)
+# pair.fuse(lj, yuk)
+# \endcode
+#
+# \MPI_SUPPORTED
+class fuse:
+    ## Fuse %pair forces
+    #
+    # \param pairs Two or more %pair forces that share a neighbor list
+    def __init__(self, *pairs):
+        util.print_status_line();
+
+        # check that we have been initialized properly
+        if not init.is_initialized():
+            globals.msg.error("Cannot fuse pair forces before initialization\n");
+            raise RuntimeError('Error fusing pair forces');
+
+        if len(pairs) < 2:
+            globals.msg.error("pair.fuse: At least two pair forces must be given\n");
+            raise RuntimeError('Error fusing pair forces');
+
+        for p in pairs:
+            if not isinstance(p, pair) or not hasattr(p.cpp_force, 'setFusedCompute'):
+                globals.msg.error("pair.fuse: Only standard pair forces can be fused\n");
+                raise RuntimeError('Error fusing pair forces');
+            if isinstance(p, (dpd, dpdlj)):
+                globals.msg.error("pair.fuse: The DPD thermostat cannot be fused with other pair forces\n");
+                raise RuntimeError('Error fusing pair forces');
+            if p.nlist is not pairs[0].nlist:
+                globals.msg.error("pair.fuse: All fused pair forces must use the same neighbor list\n");
+                raise RuntimeError('Error fusing pair forces');
+
+        self.pairs = list(pairs);
+        self.cpp_compute = None;
+
+        if globals.exec_conf.isCUDAEnabled():
+            globals.msg.notice(2, "Notice: pair.fuse has no effect on the GPU\n");
+            return;
+
+        self.cpp_compute = hoomd.PotentialPairFused(globals.system_definition, pairs[0].nlist.cpp_nlist);
+        for p in pairs:
+            p.cpp_force.setFusedCompute(self.cpp_compute);
+
 ## Lennard-Jones %pair %force
 #
 # The command pair.lj specifies that a Lennard-Jones type %pair %force should be added to every
@@ -1232,6 +1289,9 @@ def _table_eval(r, rmin, rmax, V, F, width):
 # \f$  F_{\mathrm{user}}(r) \f$ and \f$ V_{\mathrm{user}}(r) \f$ are evaluated on *width* grid points between
 # \f$ r_{\mathrm{min}} \f$ and \f$ r_{\mathrm{max}} \f$. Values are interpolated linearly between grid points.
 # For correctness, you must specify the force defined by: \f$ F = -\frac{\partial V}{\partial r}\f$
+# With \a interp='cubic', V is instead interpolated by cubic Hermite polynomials with slopes -F at the grid points, and
+# the force is the derivative of the interpolated V. This conserves energy much better and needs far fewer grid points
+# for the same accuracy. Cubic interpolation is only available on the CPU.
 #
 # The following coefficients must be set per unique %pair of particle types.
 # - \f$ F_{\mathrm{user}}(r) \f$ and \f$ V_{\mathrm{user}}(r) \f$ - evaluated by `func` (see example)
@@ -1291,8 +1351,9 @@ class table(force._force):
     # \param width Number of points to use to interpolate V and F (see documentation above)
     # \param nlist Neighbor list (default of None automatically creates a global cell-list based neighbor list)
     # \param name Name of the force instance
+    # \param interp Interpolation between the grid points, 'linear' or 'cubic' (CPU only, see documentation above)
     #
-    def __init__(self, width, nlist=None, name=None):
+    def __init__(self, width, nlist=None, name=None, interp='linear'):
         util.print_status_line();
 
         # initialize the base class
@@ -1316,6 +1377,7 @@ class table(force._force):
             self.nlist.cpp_nlist.setStorageMode(hoomd.NeighborList.storageMode.full);
             self.cpp_force = hoomd.TablePotentialGPU(globals.system_definition, self.nlist.cpp_nlist, int(width), self.name);
 
+        self._set_interpolation(interp, 'pair.table');
         globals.system.addCompute(self.cpp_force, self.force_name);
 
         # stash the width for later use
@@ -1837,19 +1899,23 @@ class dpd_conservative(pair):
 # (commands eam/alloy and eam/fs) here: http://lammps.sandia.gov/doc/pair_eam.html
 # and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 #
-# \MPI_NOT_SUPPORTED
+# \MPI_SUPPORTED (CPU only)
 class eam(force._force):
     ## Specify the EAM %pair %force
     #
     # \param file Filename with potential tables in Alloy or FS format
     # \param type Type of file potential ('Alloy', 'FS')
     # \param nlist Neighbor list (default of None automatically creates a global cell-list based neighbor list)
+    # \param interp Interpolation of the tables, 'linear' or 'cubic' (CPU only)
+    #
+    # With \a interp='cubic', the tables are interpolated with cubic Hermite polynomials whose slopes are estimated from
+    # the tabulated values.
     #
     # \b Example:
     # \code
     # eam = pair.eam(file='al1.mendelev.eam.fs', type='FS')
     # \endcode
-    def __init__(self, file, type, nlist=None):
+    def __init__(self, file, type, nlist=None, interp='linear'):
         c = cite.article(cite_key = 'morozov2011',
                          author=['I V Morozov','A M Kazennova','R G Bystryia','G E Normana','V V Pisareva','V V Stegailova'],
                          title = 'Molecular dynamics simulations of the relaxation processes in the condensed matter on GPUs',
@@ -1864,10 +1930,10 @@ class eam(force._force):
 
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in multi-GPU simulations
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("pair.eam is not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("pair.eam is not supported in multi-GPU simulations.\n\n")
                 raise RuntimeError("Error setting up pair potential.")
 
         # initialize the base class
@@ -1883,6 +1949,8 @@ class eam(force._force):
         else:
             self.cpp_force = hoomd.EAMForceComputeGPU(globals.system_definition, file, type_of_file);
 
+        self._set_interpolation(interp, 'pair.eam');
+
         #After load EAMForceCompute we know r_cut from EAM potential`s file. We need update neighbor list.
         r_cut_new = self.cpp_force.get_r_cut();
         # if no neighbor list is supplied, use the default global neighborlist
@@ -1890,13 +1958,13 @@ class eam(force._force):
             self.nlist = nl._subscribe_global_nlist(lambda : r_cut_new)
         else: # otherwise, subscribe the specified neighbor list
             self.nlist = nlist
-            self.nlist.subscribe(lambda:self.get_rcut())
+            self.nlist.subscribe(lambda : r_cut_new)
             self.nlist.update_rcut()
 
         #Load neighbor list to compute.
-        self.cpp_force.set_neighbor_list(self.nlist);
+        self.cpp_force.set_neighbor_list(self.nlist.cpp_nlist);
         if globals.exec_conf.isCUDAEnabled():
-            self.nlist.setStorageMode(hoomd.NeighborList.storageMode.full);
+            self.nlist.cpp_nlist.setStorageMode(hoomd.NeighborList.storageMode.full);
 
         globals.msg.notice(2, "Set r_cut = " + str(r_cut_new) + " from potential`s file '" +  str(file) + "'.\n");
 
@@ -773,5 +773,83 @@ class balance(_updater):
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
 
+## Exchanges configurations between replicas running in different partitions
+#
+# Every \a period steps, neighboring partitions (see comm.get_partition()) attempt to swap their configurations.
+# Each partition runs one replica of the system at its own temperature \a T, which is the set point of the thermostat
+# in its integration mode (e.g. integrate.nvt, integrate.npt or integrate.langevin). Even pairs of partitions (0-1,
+# 2-3, ...) and odd pairs (1-2, 3-4, ...) alternate on consecutive exchange attempts. The swap between replicas
+# \f$ i \f$ and \f$ j \f$ is accepted with the probability
+# \f[ \min\left(1, \exp\left[(\beta_i - \beta_j)(U_i - U_j)\right]\right) \f]
+# where \f$ \beta = 1/T \f$ and \f$ U \f$ is the potential energy. The velocities of an accepted configuration are
+# rescaled to the temperature of the new replica.
+#
+# With \a hamiltonian=True, the replicas may also use different potentials (for example, different pair
+# coefficients in every partition). Each replica then evaluates its own potential energy on the configuration of its
+# partner to decide on the swap.
+#
+# Only the root ranks of two partner partitions communicate with each other. Both partners use the same random
+# number to decide on the swap, so \a seed must be the same in all partitions.
+#
+# update.replica_exchange uses the integration mode that is active when it is created. The particle types, masses,
+# charges and diameters must be the same in all partitions. Rigid bodies are not supported.
+#
+# Only the configurations are exchanged. The internal state of the thermostat and barostat (for example the
+# Nose-Hoover variables of integrate.nvt) stays in its partition and relaxes to the new configuration on the time
+# scale \a tau of the thermostat. Choose \a period much longer than \a tau.
+#
+# The acceptance ratios with the lower and upper neighbor partitions are available as the log quantities
+# \b replica_exchange_acceptance_down and \b replica_exchange_acceptance_up.
+#
+# \b Examples:
+# \code
+# # run with: mpirun -np 8 hoomd script.py --nrank=1
+# T = 1.0 + 0.1*comm.get_partition()
+# integrate.mode_standard(dt=0.005)
+# integrate.nvt(group=group.all(), T=T, tau=0.5)
+# update.replica_exchange(period=1000, seed=12)
+# \endcode
+#
+# \note The number of ranks per partition is set with the \c --nrank command line option. At least two partitions
+# are required.
+#
+# \MPI_SUPPORTED
+class replica_exchange(_updater):
+    ## Initialize the replica exchange
+    #
+    # \param period Exchanges will be attempted every \a period time steps
+    # \param seed Random seed for the acceptance test (must be the same in all partitions)
+    # \param hamiltonian Set to True if the replicas use different potentials
+    # \param phase When -1, start on the current time step. When >= 0, execute on steps where (step + phase) % period == 0.
+    #
+    def __init__(self, period, seed, hamiltonian=False, phase=-1):
+        util.print_status_line();
+
+        # initialize base class
+        _updater.__init__(self);
+
+        # replica exchange cannot be done without mpi
+        if not hoomd.is_MPI_available():
+            globals.msg.error("update.replica_exchange requires MPI\n");
+            raise RuntimeError("Error creating replica exchange");
+
+        if globals.integrator is None:
+            globals.msg.error("update.replica_exchange requires an integration mode\n");
+            raise RuntimeError("Error creating replica exchange");
+
+        # create the compute thermo
+        thermo = compute._get_unique_thermo(group=globals.group_all);
+
+        # create the c++ mirror class
+        self.cpp_updater = hoomd.ReplicaExchangeUpdater(globals.system_definition, thermo.cpp_compute,
+                                                        globals.integrator.cpp_integrator, int(seed), hamiltonian);
+        self.setupUpdater(period, phase);
+
+        # store metadata
+        self.period = period
+        self.seed = seed
+        self.hamiltonian = hamiltonian
+        self.metadata_fields = ['period','seed','hamiltonian']
+
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;
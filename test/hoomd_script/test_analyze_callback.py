@@ -37,6 +37,52 @@ class analyze_callback_tests(unittest.TestCase):
         self.assertEqual(self.test_index, 9)
         self.assertEqual(self.test_index_2, 10)
 
+    def test_async(self):
+        self.samples = []
+        def my_callback(timestep, data):
+            self.samples.append((timestep, data))
+        cb = analyze.callback(callback=my_callback, period=10, asynchronous=True, fields=['position', 'typeid'])
+        run(100);
+        self.assertEqual(len(self.samples), 10)
+        self.assertEqual([s[0] for s in self.samples], list(range(0, 100, 10)))
+        timestep, data = self.samples[-1]
+        self.assertEqual(data['position'].shape, (100, 3))
+        self.assertEqual(data['typeid'].shape, (100,))
+        self.assertFalse(data['position'].flags.writeable)
+        self.assertFalse('velocity' in data)
+        self.assertAlmostEqual(data['box'].Lx, globals.system_definition.getParticleData().getGlobalBox().getL().x, 5)
+        stats = cb.query_queue()
+        self.assertEqual(stats['queued'], 10)
+        self.assertEqual(stats['dropped'], 0)
+        self.assertEqual(stats['depth'], 0)
+
+    def test_async_drop(self):
+        import time
+        self.test_index = 0
+        def my_callback(timestep, data):
+            time.sleep(0.01)
+            self.test_index += 1
+        cb = analyze.callback(callback=my_callback, period=1, asynchronous=True, queue_size=1, policy='skip')
+        run(100);
+        stats = cb.query_queue()
+        self.assertEqual(stats['queued'] + stats['dropped'], 100)
+        self.assertEqual(self.test_index, stats['queued'])
+        self.assertTrue(stats['max_depth'] <= 1)
+
+    def test_async_error(self):
+        def my_callback(timestep, data):
+            raise ValueError('test')
+        analyze.callback(callback=my_callback, period=1, asynchronous=True)
+        self.assertRaises(RuntimeError, run, 100)
+
+    def test_async_bad_args(self):
+        def my_callback(timestep, data):
+            return
+        self.assertRaises(RuntimeError, analyze.callback, callback=my_callback, period=1, asynchronous=True,
+                          policy='wait')
+        self.assertRaises(RuntimeError, analyze.callback, callback=my_callback, period=1, asynchronous=True,
+                          fields=['pos'])
+
     def tearDown(self):
         init.reset();
 
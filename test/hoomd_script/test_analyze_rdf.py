@@ -0,0 +1,119 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd_script import *
+context.initialize()
+import unittest
+import os
+import tempfile
+
+# unit tests for analyze.rdf and analyze.sq
+class analyze_rdf_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = init.create_random(N=1000, phi_p=0.05);
+
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.dat');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    # reads the columns of the output file on the root rank
+    def read_columns(self):
+        f = open(self.tmp_file);
+        header = f.readline().split();
+        rows = [[float(x) for x in line.split()] for line in f];
+        f.close();
+        return header, rows;
+
+    # tests basic creation of the analyzer
+    def test_rdf(self):
+        rdf = analyze.rdf(filename=self.tmp_file, r_max=2.5, period=10);
+        run(100);
+        rdf.write();
+
+        if comm.get_rank() == 0:
+            header, rows = self.read_columns();
+            self.assertEqual(header, ['r', 'A-A']);
+            self.assertEqual(len(rows), 100);
+
+    # an ideal gas has g(r) = 1 away from the origin
+    def test_rdf_ideal_gas(self):
+        rdf = analyze.rdf(filename=self.tmp_file, r_max=3.0, nbins=10, period=1);
+        run(1);
+        rdf.write();
+
+        if comm.get_rank() == 0:
+            header, rows = self.read_columns();
+            g = sum([row[1] for row in rows[5:]]) / 5.0;
+            self.assertAlmostEqual(g, 1.0, delta=0.2);
+
+    # tests with phase and variable period
+    def test_rdf_phase(self):
+        analyze.rdf(filename=self.tmp_file, r_max=2.5, period=10, phase=0);
+        analyze.rdf(filename=self.tmp_file, r_max=2.5, period=lambda n: n*10);
+        run(100);
+
+    # tests the subscription of r_max to a separate neighbor list
+    def test_rdf_nlist(self):
+        nl_t = nlist.tree();
+        rdf = analyze.rdf(filename=self.tmp_file, r_max=4.0, period=10, nlist=nl_t);
+        lj = pair.lj(r_cut=2.5, nlist=nl_t);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        integrate.mode_standard(dt=0.005);
+        integrate.nve(group=group.all());
+        run(100);
+        self.assertEqual(nl_t.r_cut.values[('A','A')], 4.0);
+        rdf.reset();
+        run(10);
+        rdf.set_params(delimiter=',');
+        rdf.write();
+
+    # test that two types give three columns
+    def test_rdf_types(self):
+        self.s.particles.types.add('B');
+        self.s.particles[0].type = 'B';
+        rdf = analyze.rdf(filename=self.tmp_file, r_max=2.0, period=1);
+        run(1);
+        rdf.write();
+
+        if comm.get_rank() == 0:
+            header, rows = self.read_columns();
+            self.assertEqual(header, ['r', 'A-A', 'A-B', 'B-B']);
+
+    # tests basic creation of the structure factor analyzer
+    def test_sq(self):
+        sq = analyze.sq(filename=self.tmp_file, k_max=2.0, nbins=10, period=10);
+        run(100);
+        sq.write();
+
+        if comm.get_rank() == 0:
+            header, rows = self.read_columns();
+            self.assertEqual(header, ['k', 'S(k)']);
+            self.assertTrue(len(rows) > 0);
+            for row in rows:
+                self.assertTrue(row[0] <= 2.0);
+
+    # tests the structure factor of a group
+    def test_sq_group(self):
+        sq = analyze.sq(filename=self.tmp_file, k_max=1.0, period=10, group=group.tags(0,499));
+        run(10);
+        sq.reset();
+        run(10);
+        sq.write();
+
+    # tests that the number of wave vectors is capped per bin
+    def test_sq_max_k(self):
+        sq = analyze.sq(filename=self.tmp_file, k_max=4.0, nbins=4, period=10, max_k=8);
+        self.assertTrue(sq.cpp_analyzer.getNumWaveVectors() <= 4*8);
+        run(10);
+        sq.write();
+
+    def tearDown(self):
+        init.reset();
+        if comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
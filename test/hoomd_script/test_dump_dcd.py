@@ -65,6 +65,31 @@ class dmp_dcd_tests (unittest.TestCase):
         if (comm.get_rank() == 0):
             os.remove(self.tmp_file)
 
+    # tests reading the file back
+    def test_read(self):
+        dump.dcd(filename=self.tmp_file, period=10);
+        run(51)
+        if comm.get_rank() == 0:
+            traj = dump.dcd_trajectory(self.tmp_file);
+            self.assertEqual(len(traj), 6);
+            self.assertEqual(traj.N, 100);
+            self.assertEqual([f.timestep for f in traj], [0, 10, 20, 30, 40, 50]);
+            self.assertEqual([f.timestep for f in traj[1::2]], [10, 30, 50]);
+            self.assertEqual([f.timestep for f in traj.iterate(start=2, step=3)], [20, 50]);
+            self.assertAlmostEqual(traj[-1].box.Lx, globals.system_definition.getParticleData().getGlobalBox().getL().x, 4);
+
+            # positions are read only views of the file that stay valid after the trajectory is closed
+            pos = traj[0].position;
+            del traj
+            self.assertEqual(pos.shape, (100, 3));
+            self.assertFalse(pos.flags.writeable);
+            p = globals.system.particles[7].position;
+            self.assertAlmostEqual(pos[7,0], p[0], 4);
+            self.assertAlmostEqual(pos[7,1], p[1], 4);
+            self.assertAlmostEqual(pos[7,2], p[2], 4);
+
+            os.remove(self.tmp_file)
+
     # test disable/enable
     def test_enable_disable(self):
         dcd = dump.dcd(filename=self.tmp_file, period=100);
@@ -4,6 +4,7 @@
 from hoomd_script import *
 import unittest
 import os
+import signal
 
 # unit tests for dump.xml
 class dmp_xml_tests (unittest.TestCase):
@@ -33,6 +34,33 @@ class dmp_xml_tests (unittest.TestCase):
         dump.xml(filename="restart.xml", period=100, restart=True).write_restart();
         run(102);
 
+    # test rotation of restart files written in the background
+    def test_restart_keep(self):
+        xml = dump.xml(filename="restart_keep.xml", period=100, restart=True, background=True, keep=3);
+        run(302);
+        xml.cpp_analyzer.waitForWrite();
+        if comm.get_rank() == 0:
+            self.assertTrue(os.path.exists("restart_keep.xml"));
+            self.assertTrue(os.path.exists("restart_keep.xml.1"));
+            self.assertTrue(os.path.exists("restart_keep.xml.2"));
+            self.assertFalse(os.path.exists("restart_keep.xml.3"));
+            for f in ["restart_keep.xml", "restart_keep.xml.1", "restart_keep.xml.2"]:
+                os.remove(f);
+
+    # test checkpoint on a signal
+    def test_checkpoint(self):
+        xml = dump.xml(filename="checkpoint.xml", period=1000, restart=True);
+        xml.set_checkpoint(signals=['SIGUSR1']);
+        run(10);
+        if comm.get_rank() == 0 and os.path.exists("checkpoint.xml"):
+            os.remove("checkpoint.xml");
+        os.kill(os.getpid(), signal.SIGUSR1);
+        run(100);
+        self.assertEqual(get_step(), 10);
+        if comm.get_rank() == 0:
+            self.assertTrue(os.path.exists("checkpoint.xml"));
+            os.remove("checkpoint.xml");
+
     # test set_params
     def test_set_params(self):
         xml = dump.xml(filename="dump_xml", period=100);
@@ -185,6 +185,42 @@ class pair_group_tests (unittest.TestCase):
         tags = [(x.tag) for x in diffBall]
         self.assertEqual(tags, [0, 3, 4, 6, 7])
 
+    def test_combine_static(self):
+        # groups without update keep the members selected at creation
+        c = group.cuboid(name='c', xmin=0.5)
+        A = group.type(type='A')
+        B = group.type(type='B')
+        tags = [(x.tag) for x in c]
+        self.assertEqual(tags, [1, 2, 5])
+
+        # move a B particle into the cuboid
+        self.s.particles[8].position = (1.5, 0, 0);
+
+        union = group.union(name='test', a=c, b=A)
+        tags = [(x.tag) for x in union]
+        self.assertEqual(tags, [0, 1, 2, 3, 4, 5, 6, 7])
+
+        isect = group.intersection(name='test', a=c, b=B)
+        tags = [(x.tag) for x in isect]
+        self.assertEqual(tags, [1, 2, 5])
+
+        diff = group.difference(name='test', a=B, b=c)
+        tags = [(x.tag) for x in diff]
+        self.assertEqual(tags, [8, 9, 10])
+
+    def test_combine_update(self):
+        # groups with update combine their selectors and keep updating
+        all = group.all();
+        B = group.type(type='B', update=True)
+        diff = group.difference(name='test', a=all, b=B)
+        tags = [(x.tag) for x in diff]
+        self.assertEqual(tags, [0, 3, 4, 6, 7])
+
+        self.s.particles.add('A')
+        self.s.particles.add('B')
+        tags = [(x.tag) for x in diff]
+        self.assertEqual(tags, [0, 3, 4, 6, 7, 11])
+
     def tearDown(self):
         del self.s
         init.reset();
@@ -38,6 +38,16 @@ class integrate_nve_tests (unittest.TestCase):
         nve.set_params(limit=0.1);
         nve.set_params(zero_force=False);
 
+    # test multiple time step integration with a slow force
+    def test_force_period(self):
+        all = group.all();
+        slow = force.constant(fx=0.2, fy=0.0, fz=0.0);
+        slow.set_period(4);
+        integrate.mode_standard(dt=0.005);
+        integrate.nve(all);
+        run(100);
+        self.assertRaises(RuntimeError, slow.set_period, 0);
+
     # test w/ empty group
     def test_empty(self):
         empty = group.cuboid(name="empty", xmin=-100, xmax=-100, ymin=-100, ymax=-100, zmin=-100, zmax=-100)
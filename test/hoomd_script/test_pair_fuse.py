@@ -0,0 +1,54 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd_script import *
+import unittest
+import os
+
+# pair.fuse
+class pair_fuse_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        init.create_random(N=100, phi_p=0.05);
+
+        sorter.set_params(grid=8)
+
+    # basic test of creation and running
+    def test(self):
+        lj = pair.lj(r_cut=3.0);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        yuk = pair.yukawa(r_cut=2.5);
+        yuk.pair_coeff.set('A', 'A', epsilon=1.0, kappa=1.0);
+        pair.fuse(lj, yuk);
+
+        all = group.all();
+        integrate.mode_standard(dt=0.005);
+        integrate.nve(all);
+        log = analyze.log(quantities=['pair_lj_energy', 'pair_yukawa_energy'], period=1, filename=None);
+        run(10);
+        log.query('pair_lj_energy');
+        log.query('pair_yukawa_energy');
+
+    # fused forces must share a neighbor list
+    def test_different_nlist(self):
+        lj = pair.lj(r_cut=3.0);
+        yuk = pair.yukawa(r_cut=2.5, nlist=nlist.cell());
+        self.assertRaises(RuntimeError, pair.fuse, lj, yuk);
+
+    # at least two forces are needed
+    def test_single(self):
+        lj = pair.lj(r_cut=3.0);
+        self.assertRaises(RuntimeError, pair.fuse, lj);
+
+    # the dpd thermostat cannot be fused
+    def test_dpd(self):
+        lj = pair.lj(r_cut=3.0);
+        dpd = pair.dpd(r_cut=3.0, T=1.0);
+        self.assertRaises(RuntimeError, pair.fuse, lj, dpd);
+
+    def tearDown(self):
+        init.reset();
+
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -19,6 +19,19 @@ class pair_table_tests (unittest.TestCase):
         table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
         table.update_coeffs();
 
+    # test cubic interpolation
+    def test_cubic(self):
+        if globals.exec_conf.isCUDAEnabled():
+            self.assertRaises(RuntimeError, pair.table, width=100, interp='cubic');
+            return;
+        table = pair.table(width=100, interp='cubic');
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        run(1);
+
+    # test invalid interpolation
+    def test_bad_interp(self):
+        self.assertRaises(RuntimeError, pair.table, width=100, interp='quintic');
+
     # test missing coefficients
     def test_set_missing_epsilon(self):
         table = pair.table(width=1000);
@@ -268,6 +268,61 @@ void bond_force_type_test(bondforce_creator bf_creator, boost::shared_ptr<Execut
      }
 
 
+//! checks that cubic interpolation reproduces a cubic potential exactly
+void bond_force_cubic_test(bondforce_creator bf_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    boost::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, BoxDim(1000.0), 1, 1, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+
+    pdata_2->setPosition(0,make_scalar3(0.0,0.0,0.0));
+    pdata_2->setPosition(1,make_scalar3(1.3,0.0,0.0));
+    sysdef_2->getBondData()->addBondedGroup(Bond(0, 0,1));
+
+    // select cubic interpolation before the table is set, the coefficients are computed by setTable
+    boost::shared_ptr<BondTablePotential> fc_2 = bf_creator(sysdef_2,5);
+    fc_2->setCubicInterpolation(true);
+
+    // V = r^3 on 5 points between 1 and 3
+    vector<Scalar> V, F;
+    for (unsigned int i = 0; i < 5; i++)
+        {
+        Scalar r = Scalar(1.0) + Scalar(0.5) * Scalar(i);
+        V.push_back(r*r*r);
+        F.push_back(-Scalar(3.0)*r*r);
+        }
+    fc_2->setTable(0, V, F, 1.0, 3.0);
+
+    fc_2->compute(0);
+
+    {
+    GPUArray<Scalar4>& force_array_1 =  fc_2->getForceArray();
+    GPUArray<Scalar>& virial_array_1 =  fc_2->getVirialArray();
+    unsigned int pitch = virial_array_1.getPitch();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_1(virial_array_1,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].x, 5.07, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].y, tol_small);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].z, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].w, 0.5*2.197, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial_1.data[0*pitch+0], -0.5*5.07*1.3, tol);
+
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[1].x, -5.07, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[1].w, 0.5*2.197, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial_1.data[0*pitch+1], -0.5*5.07*1.3, tol);
+    }
+
+    // switching back to linear interpolation interpolates V and F separately
+    fc_2->setCubicInterpolation(false);
+    fc_2->compute(1);
+
+    {
+    GPUArray<Scalar4>& force_array_2 =  fc_2->getForceArray();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].x, 3.0 + 0.6*3.75, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].w, 0.5*(1.0 + 0.6*2.375), tol);
+    }
+    }
+
 
 //! BondTablePotential creator for bond_force_basic_tests()
 boost::shared_ptr<BondTablePotential> base_class_bf_creator(boost::shared_ptr<SystemDefinition> sysdef, unsigned int width)
@@ -297,6 +352,13 @@ BOOST_AUTO_TEST_CASE( BondTablePotential_type )
     bond_force_type_test(bf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for cubic interpolation on the CPU
+BOOST_AUTO_TEST_CASE( BondTablePotential_cubic )
+    {
+    bondforce_creator bf_creator = bind(base_class_bf_creator, _1, _2);
+    bond_force_cubic_test(bf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 
 #ifdef ENABLE_CUDA
 //! boost test case for bond forces on the GPU
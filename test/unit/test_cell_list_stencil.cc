@@ -196,16 +196,152 @@ void celllist_stencil_basic_test(boost::shared_ptr<ExecutionConfiguration> exec_
         }
     }
 
+//! Check a stencil against sampled distances between points in the cells
+/*!
+ * Every stored distance must be a lower bound to the distance between any two points in the reference and the shifted
+ * cell, and every cell offset within reach (that is not a periodic duplicate) must be part of the stencil.
+ */
+void check_stencil_distances(boost::shared_ptr<SystemDefinition> sysdef,
+                             boost::shared_ptr<CellList> cl,
+                             boost::shared_ptr<CellListStencil> cls,
+                             Scalar rstencil)
+    {
+    const BoxDim& box = sysdef->getParticleData()->getBox();
+    const Scalar3 L = box.getNearestPlaneDistance();
+    const Scalar3 w = cl->getCellWidth();
+    const uint3 dim = cl->getDim();
+    const Scalar3 a1 = (w.x / L.x) * box.getLatticeVector(0);
+    const Scalar3 a2 = (w.y / L.y) * box.getLatticeVector(1);
+    const Scalar3 a3 = (w.z / L.z) * box.getLatticeVector(2);
+    const int3 origin = make_int3((dim.x-1)/2, (dim.y-1)/2, (dim.z-1)/2);
+
+    ArrayHandle<Scalar4> h_stencil(cls->getStencils(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nstencil(cls->getStencilSizes(), access_location::host, access_mode::read);
+    const Index2D& stencil_idx = cls->getStencilIndexer();
+
+    // sample the cells on a grid of fractional coordinates including the corners
+    const unsigned int n_sample = 4;
+    for (int k=-4; k <= 4; ++k)
+        for (int j=-4; j <= 4; ++j)
+            for (int i=-4; i <= 4; ++i)
+                {
+                // skip periodic duplicates
+                if ((origin.x + i) < 0 || (origin.x + i) >= (int)dim.x ||
+                    (origin.y + j) < 0 || (origin.y + j) >= (int)dim.y ||
+                    (origin.z + k) < 0 || (origin.z + k) >= (int)dim.z)
+                    continue;
+
+                Scalar min_dist = Scalar(1e10);
+                for (unsigned int s=0; s < n_sample*n_sample*n_sample; ++s)
+                    for (unsigned int t=0; t < n_sample*n_sample*n_sample; ++t)
+                        {
+                        Scalar3 fs = make_scalar3(s % n_sample, (s/n_sample) % n_sample, s/(n_sample*n_sample));
+                        Scalar3 ft = make_scalar3(t % n_sample, (t/n_sample) % n_sample, t/(n_sample*n_sample));
+                        Scalar3 f = Scalar(1.0/(n_sample-1))*(ft - fs) + make_scalar3(i, j, k);
+                        Scalar3 dr = f.x*a1 + f.y*a2 + f.z*a3;
+                        min_dist = std::min(min_dist, sqrt(dot(dr,dr)));
+                        }
+
+                bool found = false;
+                for (unsigned int cur = 0; cur < h_nstencil.data[0]; ++cur)
+                    {
+                    Scalar4 stencil = h_stencil.data[stencil_idx(cur, 0)];
+                    if (__scalar_as_int(stencil.x) == i && __scalar_as_int(stencil.y) == j &&
+                        __scalar_as_int(stencil.z) == k)
+                        {
+                        found = true;
+                        BOOST_CHECK(sqrt(stencil.w) <= min_dist + Scalar(1e-4));
+                        }
+                    }
+
+                if (!found)
+                    BOOST_CHECK(min_dist >= rstencil - Scalar(1e-4));
+                }
+    }
+
+//! Test that the cell list stencil is correct in triclinic boxes and tolerates small deformations
+template <class CL>
+void celllist_stencil_triclinic_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(1, BoxDim(8.0, 0.5, 0.3, 0.2), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    boost::shared_ptr<CellList> cl(new CL(sysdef));
+    cl->setNominalWidth(Scalar(1.0));
+    cl->setRadius(1);
+    cl->compute(0);
+    boost::shared_ptr<CellListStencil> cls(new CellListStencil(sysdef, cl));
+    vector<Scalar> rstencil(1, 1.6);
+    cls->setRStencil(rstencil);
+    cls->compute(0);
+    check_stencil_distances(sysdef, cl, cls, rstencil[0]);
+
+    uint3 dim = cl->getDim();
+    unsigned int n_cells = cl->getCellIndexer().getNumElements();
+
+    // deform the box slightly, the cell dimensions must not change and the stencil must remain valid
+    for (unsigned int step=1; step <= 10; ++step)
+        {
+        BoxDim box(Scalar(8.0) + Scalar(0.01)*step);
+        box.setTiltFactors(Scalar(0.5) + Scalar(0.002)*step, Scalar(0.3), Scalar(0.2) - Scalar(0.002)*step);
+        pdata->setGlobalBox(box);
+        cl->compute(step);
+        cls->compute(step);
+
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().x, dim.x);
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().y, dim.y);
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().z, dim.z);
+        BOOST_CHECK_EQUAL_UINT(cl->getCellIndexer().getNumElements(), n_cells);
+        check_stencil_distances(sysdef, cl, cls, rstencil[0]);
+        }
+
+    // compress the box enough to require fewer cells, the stencil must follow
+    BoxDim box(Scalar(7.0), Scalar(0.4), Scalar(0.3), Scalar(0.2));
+    pdata->setGlobalBox(box);
+    cl->compute(20);
+    cls->compute(20);
+    BOOST_CHECK(cl->getDim().x < dim.x);
+    check_stencil_distances(sysdef, cl, cls, rstencil[0]);
+
+    // small fluctuations around the new size must not change the dimensions again
+    dim = cl->getDim();
+    for (unsigned int step=1; step <= 10; ++step)
+        {
+        Scalar delta = (step % 2) ? Scalar(0.1) : Scalar(-0.1);
+        BoxDim box(Scalar(7.0) + delta, Scalar(0.4), Scalar(0.3), Scalar(0.2));
+        pdata->setGlobalBox(box);
+        cl->compute(20+step);
+        cls->compute(20+step);
+
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().x, dim.x);
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().y, dim.y);
+        BOOST_CHECK_EQUAL_UINT(cl->getDim().z, dim.z);
+        check_stencil_distances(sysdef, cl, cls, rstencil[0]);
+        }
+    }
+
 //! test case for cell list stencil on the CPU
 BOOST_AUTO_TEST_CASE( CellListStencil_cpu )
     {
     celllist_stencil_basic_test<CellList>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cell list stencil in triclinic boxes on the CPU
+BOOST_AUTO_TEST_CASE( CellListStencil_triclinic_cpu )
+    {
+    celllist_stencil_triclinic_test<CellList>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for cell list stencil on the GPU
 BOOST_AUTO_TEST_CASE( CellListStencil_gpu )
     {
     celllist_stencil_basic_test<CellListGPU>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for cell list stencil in triclinic boxes on the GPU
+BOOST_AUTO_TEST_CASE( CellListStencil_triclinic_gpu )
+    {
+    celllist_stencil_triclinic_test<CellListGPU>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
\ No newline at end of file
@@ -64,7 +64,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Communicator.h"
 
 #include "ConstForceCompute.h"
+#include "EAMForceCompute.h"
+#include "NeighborListBinned.h"
 #include "TwoStepNVE.h"
+#include "TwoStepNVERigid.h"
 #include "IntegratorTwoStep.h"
 
 #ifdef ENABLE_CUDA
@@ -72,6 +75,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <algorithm>
+#include <fstream>
+#include <cmath>
 
 #define TO_TRICLINIC(v) dest_box.makeCoordinates(ref_box.makeFraction(make_scalar3(v.x,v.y,v.z)))
 #define TO_POS4(v) make_scalar4(v.x,v.y,v.z,h_pos.data[rtag].w)
@@ -3253,6 +3258,231 @@ void test_communicator_ghost_layer_width(communicator_creator comm_creator, boos
         }
     }
 
+//! Test the ghost update of a per-particle quantity
+void test_communicator_ghost_scalar(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,          // number of particles
+                                                             BoxDim(2.0), // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // place one particle in every box, close to the common corner of all boxes
+    pdata->setPosition(0, make_scalar3(-0.1,-0.1,-0.1),false);
+    pdata->setPosition(1, make_scalar3( 0.1,-0.1,-0.1),false);
+    pdata->setPosition(2, make_scalar3(-0.1, 0.1,-0.1),false);
+    pdata->setPosition(3, make_scalar3( 0.1, 0.1,-0.1),false);
+    pdata->setPosition(4, make_scalar3(-0.1,-0.1, 0.1),false);
+    pdata->setPosition(5, make_scalar3( 0.1,-0.1, 0.1),false);
+    pdata->setPosition(6, make_scalar3(-0.1, 0.1, 0.1),false);
+    pdata->setPosition(7, make_scalar3( 0.1, 0.1, 0.1),false);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf,  pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    comm->setFlags(flags);
+
+    // use a ghost layer wide enough that every particle is a ghost on every other processor, but narrower than half
+    // of a box
+    two_type_ghost_layer g(Scalar(0.2), Scalar(0.2));
+    comm->addGhostLayerWidthRequest(bind(&two_type_ghost_layer::get,g,_1));
+
+    comm->migrateParticles();
+    comm->exchangeGhosts();
+
+    unsigned int n_all = pdata->getN() + pdata->getNGhosts();
+    BOOST_REQUIRE(pdata->getNGhosts() >= 7);
+
+    // set a value depending on the tag for local particles and garbage for the ghosts
+    GPUArray<Scalar> field(n_all, exec_conf);
+        {
+        ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < n_all; ++i)
+            h_field.data[i] = (i < pdata->getN()) ? Scalar(1.5)*h_tag.data[i] + Scalar(1.0) : Scalar(-1.0);
+        }
+
+    comm->updateGhostScalar(field);
+
+        {
+        ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < n_all; ++i)
+            BOOST_CHECK_CLOSE(h_field.data[i], Scalar(1.5)*h_tag.data[i] + Scalar(1.0), tol);
+        }
+    }
+
+//! Write a single type EAM potential (alloy format) with smooth analytic tables
+/*! F(rho) = rho (rho - 4), rho(r) = (r_c - r)^2 and phi(r) = (r_c - r)^3, stored as Z(r) = r phi(r)
+*/
+void write_test_eam_file(const std::string& fname)
+    {
+    const unsigned int nrho = 2000;
+    const Scalar drho = Scalar(0.05);
+    const unsigned int nr = 201;
+    const Scalar rc = Scalar(1.6);
+    const Scalar dr = rc / Scalar(nr - 1);
+
+    std::ofstream f(fname.c_str());
+    f.precision(12);
+    f << "test potential" << std::endl << "for unit tests" << std::endl << "only" << std::endl;
+    f << "1 A" << std::endl;
+    f << nrho << " " << drho << " " << nr << " " << dr << " " << rc << std::endl;
+    f << "1 1.0 1.0 fcc" << std::endl;
+    for (unsigned int i = 0; i < nrho; i++)
+        {
+        Scalar rho = Scalar(i) * drho;
+        f << rho * (rho - Scalar(4.0)) << std::endl;
+        }
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        Scalar r = Scalar(i) * dr;
+        f << (rc - r) * (rc - r) << std::endl;
+        }
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        Scalar r = Scalar(i) * dr;
+        f << r * (rc - r) * (rc - r) * (rc - r) << std::endl;
+        }
+    }
+
+//! Compare EAM forces of a domain decomposed system to those of the same system without decomposition
+void test_communicator_eam(boost::shared_ptr<ExecutionConfiguration> exec_conf, NeighborList::storageMode mode)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    std::string fname("test_communicator_eam.eam.alloy");
+    if (exec_conf->getRank() == 0)
+        write_test_eam_file(fname);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // a random configuration, with every particle close to a domain boundary interacting with ghosts
+    // the ghost layer (r_cut + r_buff = 2.0) needs to be narrower than half of a box
+    const unsigned int n = 500;
+    BoxDim box(10.0);
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+    srand(12345);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        snap.pos[i] = vec3<Scalar>(Scalar(-5.0) + (Scalar)rand()/(Scalar)RAND_MAX*Scalar(10.0),
+                                   Scalar(-5.0) + (Scalar)rand()/(Scalar)RAND_MAX*Scalar(10.0),
+                                   Scalar(-5.0) + (Scalar)rand()/(Scalar)RAND_MAX*Scalar(10.0));
+        }
+
+    // reference: every rank holds the whole system
+    boost::shared_ptr<SystemDefinition> sysdef_ref(new SystemDefinition(n, box, 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_ref = sysdef_ref->getParticleData();
+    pdata_ref->initializeFromSnapshot(snap);
+
+    boost::shared_ptr<EAMForceCompute> eam_ref(new EAMForceCompute(sysdef_ref, (char *)fname.c_str(), 0));
+    boost::shared_ptr<NeighborList> nlist_ref(new NeighborListBinned(sysdef_ref, eam_ref->get_r_cut(), Scalar(0.4)));
+    nlist_ref->setStorageMode(mode);
+    eam_ref->set_neighbor_list(nlist_ref);
+    eam_ref->compute(0);
+
+    // domain decomposed system
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n, box, 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL()));
+    boost::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    boost::shared_ptr<EAMForceCompute> eam(new EAMForceCompute(sysdef, (char *)fname.c_str(), 0));
+    // the cell list needs the communicator to bin the ghost particles
+    boost::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setCommunicator(comm);
+    boost::shared_ptr<NeighborList> nlist(new NeighborListBinned(sysdef, eam->get_r_cut(), Scalar(0.4), cl));
+    nlist->setStorageMode(mode);
+    nlist->setCommunicator(comm);
+    eam->set_neighbor_list(nlist);
+    eam->setCommunicator(comm);
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::tag] = 1;
+    comm->setFlags(flags);
+    comm->migrateParticles();
+    comm->exchangeGhosts();
+
+    eam->compute(0);
+
+    // compare the forces, energies and virials of the local particles
+    double energy = 0.0;
+    double virial[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        {
+        ArrayHandle<Scalar4> h_force(eam->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(eam->getVirialArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_ref(eam_ref->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag_ref(pdata_ref->getRTags(), access_location::host, access_mode::read);
+        unsigned int pitch = eam->getVirialArray().getPitch();
+
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            unsigned int j = h_rtag_ref.data[h_tag.data[i]];
+            BOOST_REQUIRE(j < pdata_ref->getN());
+            // only the summation order differs
+            MY_BOOST_CHECK_SMALL(fabs(h_force.data[i].x - h_force_ref.data[j].x), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_force.data[i].y - h_force_ref.data[j].y), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_force.data[i].z - h_force_ref.data[j].z), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_force.data[i].w - h_force_ref.data[j].w), tol_small);
+            energy += h_force.data[i].w;
+            for (unsigned int k = 0; k < 6; k++)
+                virial[k] += h_virial.data[k*pitch+i];
+            }
+        }
+
+    // the totals over all ranks match the reference, so no pair is counted twice or missed
+    MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, virial, 6, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+    double energy_ref = 0.0;
+    double virial_ref[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        {
+        ArrayHandle<Scalar4> h_force_ref(eam_ref->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_ref(eam_ref->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = eam_ref->getVirialArray().getPitch();
+        for (unsigned int i = 0; i < pdata_ref->getN(); i++)
+            {
+            energy_ref += h_force_ref.data[i].w;
+            for (unsigned int k = 0; k < 6; k++)
+                virial_ref[k] += h_virial_ref.data[k*pitch+i];
+            }
+        }
+
+    BOOST_CHECK_CLOSE(energy, energy_ref, tol);
+    for (unsigned int k = 0; k < 6; k++)
+        MY_BOOST_CHECK_SMALL(Scalar(fabs(virial[k] - virial_ref[k])), tol_small);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (exec_conf->getRank() == 0)
+        remove(fname.c_str());
+    }
+
 //! Test per-type ghost layer
 void test_communicator_ghosts_per_type(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
     {
@@ -3438,6 +3668,119 @@ void test_communicator_ghosts_per_type(communicator_creator comm_creator, boost:
         }
     }
 
+//! Test rigid bodies whose constituent particles are spread over several processors
+void test_communicator_rigid_bodies(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,          // number of particles
+                                                             BoxDim(2.0), // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // place one particle in the middle of every box, the lower and the upper layer form one body each
+    pdata->setPosition(0, make_scalar3(-0.5,-0.5,-0.5),false);
+    pdata->setPosition(1, make_scalar3( 0.5,-0.5,-0.5),false);
+    pdata->setPosition(2, make_scalar3(-0.5, 0.5,-0.5),false);
+    pdata->setPosition(3, make_scalar3( 0.5, 0.5,-0.5),false);
+    pdata->setPosition(4, make_scalar3(-0.5,-0.5, 0.5),false);
+    pdata->setPosition(5, make_scalar3( 0.5,-0.5, 0.5),false);
+    pdata->setPosition(6, make_scalar3(-0.5, 0.5, 0.5),false);
+    pdata->setPosition(7, make_scalar3( 0.5, 0.5, 0.5),false);
+
+    for (unsigned int tag = 0; tag < 8; tag++)
+        pdata->setBody(tag, tag / 4);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf,  pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+    BOOST_REQUIRE_EQUAL(pdata->getN(), 1);
+
+    boost::shared_ptr<RigidData> rdata = sysdef->getRigidData();
+    rdata->initializeData();
+
+    // every rank holds both bodies
+    BOOST_REQUIRE_EQUAL(rdata->getNumBodies(), 2);
+    BOOST_CHECK_EQUAL(rdata->getNumDOF(), 12);
+    BOOST_CHECK_EQUAL(rdata->getNumIndexRigid(), 1);
+
+        {
+        ArrayHandle<Scalar> h_body_mass(rdata->getBodyMass(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_size(rdata->getBodySize(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_com(rdata->getCOM(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_offset(rdata->getBodyOffsets(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body_indices(rdata->getBodyParticleIndices(), access_location::host, access_mode::read);
+
+        unsigned int n_local = 0;
+        for (unsigned int body = 0; body < 2; body++)
+            {
+            BOOST_CHECK_EQUAL(h_body_size.data[body], 4);
+            BOOST_CHECK_CLOSE(h_body_mass.data[body], 4.0, tol);
+            MY_BOOST_CHECK_SMALL(h_com.data[body].x, tol_small);
+            MY_BOOST_CHECK_SMALL(h_com.data[body].y, tol_small);
+            BOOST_CHECK_CLOSE(h_com.data[body].z, body ? 0.5 : -0.5, tol);
+
+            BOOST_CHECK_EQUAL(h_body_offset.data[body+1] - h_body_offset.data[body], 4);
+            for (unsigned int k = h_body_offset.data[body]; k < h_body_offset.data[body+1]; k++)
+                if (h_body_indices.data[k] != NO_INDEX)
+                    n_local++;
+            }
+
+        // only the local particle is indexed
+        BOOST_CHECK_EQUAL(n_local, 1);
+        }
+
+    boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getNGlobal()-1));
+    boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+    boost::shared_ptr<TwoStepNVERigid> nve(new TwoStepNVERigid(sysdef, group_all));
+
+    // apply a force along x that grows with the tag
+        {
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque(pdata->getNetTorqueArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            h_net_force.data[i] = make_scalar4(Scalar(h_tag.data[i]+1), 0.0, 0.0, 0.0);
+            h_net_torque.data[i] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+            }
+        }
+
+    nve->setup();
+
+    // the body forces and torques are summed over all ranks
+        {
+        ArrayHandle<Scalar4> h_force(rdata->getForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_torque(rdata->getTorque(), access_location::host, access_mode::read);
+
+        BOOST_CHECK_CLOSE(h_force.data[0].x, 10.0, tol);
+        BOOST_CHECK_CLOSE(h_force.data[1].x, 26.0, tol);
+        for (unsigned int body = 0; body < 2; body++)
+            {
+            MY_BOOST_CHECK_SMALL(h_force.data[body].y, tol_small);
+            MY_BOOST_CHECK_SMALL(h_force.data[body].z, tol_small);
+            MY_BOOST_CHECK_SMALL(h_torque.data[body].x, tol_small);
+            MY_BOOST_CHECK_SMALL(h_torque.data[body].y, tol_small);
+            BOOST_CHECK_CLOSE(h_torque.data[body].z, -2.0, tol);
+            }
+        }
+    }
+
 //! Communicator creator for unit tests
 boost::shared_ptr<Communicator> base_class_communicator_creator(boost::shared_ptr<SystemDefinition> sysdef,
                                                          boost::shared_ptr<DomainDecomposition> decomposition)
@@ -3637,12 +3980,30 @@ BOOST_AUTO_TEST_CASE( communicator_ghost_layer_width_test )
     test_communicator_ghost_layer_width(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+BOOST_AUTO_TEST_CASE( communicator_ghost_scalar_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_ghost_scalar(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_eam_test )
+    {
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    test_communicator_eam(exec_conf, NeighborList::half);
+    test_communicator_eam(exec_conf, NeighborList::full);
+    }
+
 BOOST_AUTO_TEST_CASE( communicator_ghost_layer_per_type_test )
     {
     communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
     test_communicator_ghosts_per_type(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),BoxDim(2.0));
     }
 
+BOOST_AUTO_TEST_CASE( communicator_rigid_bodies_test )
+    {
+    test_communicator_rigid_bodies(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 
 //! Tests particle distribution on GPU
@@ -0,0 +1,209 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "CompressedDumpWriter.h"
+#include "CompressedTrajectoryReader.h"
+#include "TrajectoryCodec.h"
+
+#include <stdlib.h>
+#include <fstream>
+#include <boost/filesystem/operations.hpp>
+#include <boost/shared_ptr.hpp>
+using namespace boost::filesystem;
+using namespace boost;
+using namespace std;
+
+//! Name the unit test module
+#define BOOST_TEST_MODULE CompressedTrajectoryTests
+#include "boost_utf_configure.h"
+
+/*! \file test_compressed_trajectory.cc
+    \brief Unit tests for CompressedDumpWriter and CompressedTrajectoryReader
+    \ingroup unit_tests
+*/
+
+//! Checks that hctEncode() and hctDecode() reproduce the input exactly
+BOOST_AUTO_TEST_CASE( TrajectoryCodec_roundtrip )
+    {
+    // values of all magnitudes, in blocks of different widths and a partial last block
+    const unsigned int n = 1000;
+    std::vector<int> values(n);
+    srand(12345);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        int width = (i / 128) * 4;
+        int v = width > 0 ? rand() % (1 << (width-1)) : 0;
+        values[i] = (rand() % 2) ? v : -v;
+        }
+    values[600] = 2147483647;
+    values[601] = -2147483647 - 1;
+
+    std::vector<unsigned char> coded;
+    hctEncode(&values[0], n, coded);
+
+    // the first block is all zeros and takes a single byte
+    BOOST_CHECK_EQUAL((unsigned int)coded[0], 0u);
+
+    std::vector<int> decoded(n);
+    const unsigned char *end = hctDecode(&coded[0], &coded[0] + coded.size(), &decoded[0], n);
+    BOOST_REQUIRE(end == &coded[0] + coded.size());
+    for (unsigned int i = 0; i < n; i++)
+        BOOST_CHECK_EQUAL(decoded[i], values[i]);
+
+    // truncated input is detected
+    BOOST_CHECK(hctDecode(&coded[0], &coded[0] + coded.size() - 1, &decoded[0], n) == NULL);
+    }
+
+//! Move the particles to known positions that depend on the frame
+std::vector<Scalar3> set_trajectory_frame(boost::shared_ptr<ParticleData> pdata, unsigned int frame)
+    {
+    pdata->setGlobalBox(BoxDim(Scalar(10.0) + Scalar(0.1)*frame));
+
+    std::vector<Scalar3> pos(pdata->getN());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        pos[i] = make_scalar3(Scalar(-4.9) + Scalar(0.0327)*i + Scalar(0.01)*frame,
+                              Scalar(4.9) - Scalar(0.0211)*i,
+                              Scalar(0.0001)*i*frame);
+        pdata->setPosition(i, pos[i], false);
+        }
+    return pos;
+    }
+
+//! Checks the positions of a frame read from the file
+void check_trajectory_frame(CompressedTrajectoryReader& reader,
+                            unsigned int frame,
+                            const std::vector<Scalar3>& ref,
+                            Scalar precision)
+    {
+    std::vector< vec3<double> > pos;
+    reader.readPositions(frame, pos);
+    BOOST_REQUIRE_EQUAL(pos.size(), ref.size());
+    for (unsigned int i = 0; i < ref.size(); i++)
+        {
+        BOOST_CHECK_SMALL(Scalar(fabs(pos[i].x - ref[i].x)), Scalar(0.51)*precision);
+        BOOST_CHECK_SMALL(Scalar(fabs(pos[i].y - ref[i].y)), Scalar(0.51)*precision);
+        BOOST_CHECK_SMALL(Scalar(fabs(pos[i].z - ref[i].z)), Scalar(0.51)*precision);
+        }
+
+    MY_BOOST_CHECK_CLOSE(reader.getBox(frame).getL().x, Scalar(10.0) + Scalar(0.1)*frame, tol);
+    }
+
+//! Writes a trajectory, appends to it and reads the frames back in random order
+BOOST_AUTO_TEST_CASE( CompressedDumpWriter_roundtrip )
+    {
+    // temporary directory for files (avoid race conditions in multiple test invocations)
+    path ph = unique_path();
+    create_directories(ph);
+    std::string fname = ph.string() + "/test.hct";
+
+    const unsigned int N = 300;
+    const Scalar precision = Scalar(1e-3);
+
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(Scalar(10.0)), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::vector< std::vector<Scalar3> > ref;
+
+        {
+        CompressedDumpWriter writer(sysdef, fname, group_all, precision, 3, true);
+        for (unsigned int frame = 0; frame < 6; frame++)
+            {
+            ref.push_back(set_trajectory_frame(pdata, frame));
+            writer.analyze(100*frame);
+            }
+        writer.waitForWrite();
+
+        // the index is not written yet, the reader finds the frames by scanning the file
+        CompressedTrajectoryReader reader(exec_conf, fname);
+        BOOST_REQUIRE_EQUAL(reader.getNumFrames(), 6u);
+        check_trajectory_frame(reader, 5, ref[5], precision);
+        }
+
+        {
+        // append to the file, the frame at step 500 is already in it
+        CompressedDumpWriter writer(sysdef, fname, group_all, precision, 3, false);
+        set_trajectory_frame(pdata, 0);
+        writer.analyze(500);
+        for (unsigned int frame = 6; frame < 10; frame++)
+            {
+            ref.push_back(set_trajectory_frame(pdata, frame));
+            writer.analyze(100*frame);
+            }
+        }
+
+    CompressedTrajectoryReader reader(exec_conf, fname);
+    BOOST_REQUIRE_EQUAL(reader.getNumFrames(), 10u);
+    BOOST_CHECK_EQUAL(reader.getN(), N);
+    MY_BOOST_CHECK_CLOSE(reader.getPrecision(), precision, tol);
+
+    // random access, sequential access and access across the appended part
+    unsigned int order[] = {7, 2, 3, 4, 9, 0, 1, 5, 6, 8};
+    for (unsigned int i = 0; i < 10; i++)
+        {
+        BOOST_CHECK_EQUAL(reader.getTimeStep(order[i]), 100*order[i]);
+        check_trajectory_frame(reader, order[i], ref[order[i]], precision);
+        }
+
+    // frames are much smaller than the 12 bytes per particle of a DCD file
+    BOOST_CHECK(file_size(fname) < 10*N*6);
+
+    // a file in a different format is rejected
+    std::string bad_fname = ph.string() + "/bad.hct";
+        {
+        std::ofstream bad(bad_fname.c_str());
+        bad << "not a trajectory, but long enough for a header" << std::endl;
+        }
+    BOOST_CHECK_THROW(CompressedTrajectoryReader(exec_conf, bad_fname), std::runtime_error);
+
+    remove_all(ph);
+    }
@@ -0,0 +1,197 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+#include "DCDDumpWriter.h"
+#include "DCDTrajectoryReader.h"
+
+#include <fstream>
+#include <boost/filesystem/operations.hpp>
+#include <boost/shared_ptr.hpp>
+using namespace boost::filesystem;
+using namespace boost;
+using namespace std;
+
+//! Name the unit test module
+#define BOOST_TEST_MODULE DCDTrajectoryTests
+#include "boost_utf_configure.h"
+
+/*! \file test_dcd_trajectory.cc
+    \brief Unit tests for DCDTrajectoryReader
+    \ingroup unit_tests
+*/
+
+//! Box of a frame
+BoxDim dcd_trajectory_box(unsigned int frame)
+    {
+    BoxDim box(Scalar(10.0) + Scalar(0.1)*frame, Scalar(11.0), Scalar(12.0));
+    box.setTiltFactors(Scalar(0.2), Scalar(0.1)*frame, Scalar(-0.3));
+    return box;
+    }
+
+//! Move the particles to known positions and images that depend on the frame
+std::vector<Scalar3> set_dcd_trajectory_frame(boost::shared_ptr<ParticleData> pdata, unsigned int frame)
+    {
+    BoxDim box = dcd_trajectory_box(frame);
+    pdata->setGlobalBox(box);
+
+    // place the particles well inside the tilted box
+    std::vector<Scalar3> pos(pdata->getN());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        pos[i] = box.makeCoordinates(make_scalar3(Scalar(0.05) + Scalar(0.0029)*i + Scalar(0.01)*frame,
+                                                  Scalar(0.9) - Scalar(0.0028)*i,
+                                                  Scalar(0.1) + Scalar(0.0005)*i*frame));
+        pdata->setPosition(i, pos[i], false);
+        pdata->setImage(i, make_int3(int(i % 3) - 1, int(frame), -int(i % 5)));
+        }
+    return pos;
+    }
+
+//! Writes a DCD file and reads the frames back
+BOOST_AUTO_TEST_CASE( DCDTrajectoryReader_roundtrip )
+    {
+    // temporary directory for files (avoid race conditions in multiple test invocations)
+    path ph = unique_path();
+    create_directories(ph);
+    std::string fname = ph.string() + "/test.dcd";
+
+    const unsigned int N = 300;
+
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, dcd_trajectory_box(0), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::vector< std::vector<Scalar3> > ref;
+
+        {
+        DCDDumpWriter writer(sysdef, fname, 100, group_all, true);
+        writer.setUnwrapFull(true);
+        for (unsigned int frame = 0; frame < 5; frame++)
+            {
+            ref.push_back(set_dcd_trajectory_frame(pdata, frame));
+            writer.analyze(1000 + 100*frame);
+            }
+        }
+
+    DCDTrajectoryReader reader(exec_conf, fname);
+    BOOST_REQUIRE_EQUAL(reader.getNumFrames(), 5u);
+    BOOST_CHECK_EQUAL(reader.getN(), N);
+
+    unsigned int order[] = {3, 0, 4, 1, 2};
+    for (unsigned int k = 0; k < 5; k++)
+        {
+        unsigned int frame = order[k];
+        BOOST_CHECK_EQUAL(reader.getTimeStep(frame), 1000 + 100*frame);
+
+        // the box is reconstructed from the lattice vector lengths and angles
+        BoxDim ref_box = dcd_trajectory_box(frame);
+        DCDFrameView view = reader.getFrame(frame);
+        BOOST_CHECK_EQUAL(view.timestep, 1000 + 100*frame);
+        BOOST_CHECK_EQUAL(view.N, N);
+        MY_BOOST_CHECK_CLOSE(view.box.getL().x, ref_box.getL().x, tol);
+        MY_BOOST_CHECK_CLOSE(view.box.getL().y, ref_box.getL().y, tol);
+        MY_BOOST_CHECK_CLOSE(view.box.getL().z, ref_box.getL().z, tol);
+        MY_BOOST_CHECK_CLOSE(view.box.getTiltFactorXY(), ref_box.getTiltFactorXY(), tol);
+        MY_BOOST_CHECK_SMALL(view.box.getTiltFactorXZ() - ref_box.getTiltFactorXZ(), tol_small);
+        MY_BOOST_CHECK_CLOSE(view.box.getTiltFactorYZ(), ref_box.getTiltFactorYZ(), tol);
+
+        // the view holds the unwrapped coordinates as written
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 unwrapped = ref_box.shift(ref[frame][i], make_int3(int(i % 3) - 1, int(frame), -int(i % 5)));
+            MY_BOOST_CHECK_SMALL(Scalar(view.x[i]) - unwrapped.x, Scalar(1e-4)*fabs(unwrapped.x) + tol_small);
+            MY_BOOST_CHECK_SMALL(Scalar(view.y[i]) - unwrapped.y, Scalar(1e-4)*fabs(unwrapped.y) + tol_small);
+            MY_BOOST_CHECK_SMALL(Scalar(view.z[i]) - unwrapped.z, Scalar(1e-4)*fabs(unwrapped.z) + tol_small);
+            }
+
+        // a snapshot gets the wrapped positions and the images back
+        SnapshotParticleData<Scalar> snapshot;
+        reader.readSnapshot(frame, snapshot);
+        BOOST_REQUIRE_EQUAL(snapshot.size, N);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            MY_BOOST_CHECK_SMALL(snapshot.pos[i].x - ref[frame][i].x, Scalar(1e-3));
+            MY_BOOST_CHECK_SMALL(snapshot.pos[i].y - ref[frame][i].y, Scalar(1e-3));
+            MY_BOOST_CHECK_SMALL(snapshot.pos[i].z - ref[frame][i].z, Scalar(1e-3));
+            BOOST_CHECK_EQUAL(snapshot.image[i].x, int(i % 3) - 1);
+            BOOST_CHECK_EQUAL(snapshot.image[i].y, int(frame));
+            BOOST_CHECK_EQUAL(snapshot.image[i].z, -int(i % 5));
+            }
+        }
+
+    // out of range frames are rejected
+    BOOST_CHECK_THROW(reader.getFrame(5), std::runtime_error);
+
+    // an incomplete last frame is ignored
+    std::string truncated_fname = ph.string() + "/truncated.dcd";
+        {
+        std::ifstream in(fname.c_str(), ios::binary);
+        std::vector<char> buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(truncated_fname.c_str(), ios::binary);
+        out.write(&buf[0], buf.size() - 100);
+        }
+    DCDTrajectoryReader truncated(exec_conf, truncated_fname);
+    BOOST_CHECK_EQUAL(truncated.getNumFrames(), 4u);
+
+    // a file in a different format is rejected
+    std::string bad_fname = ph.string() + "/bad.dcd";
+        {
+        std::ofstream bad(bad_fname.c_str());
+        bad << "not a trajectory, but long enough for a header" << std::endl;
+        for (unsigned int i = 0; i < 10; i++)
+            bad << "padding padding padding" << std::endl;
+        }
+    BOOST_CHECK_THROW(DCDTrajectoryReader(exec_conf, bad_fname), std::runtime_error);
+
+    remove_all(ph);
+    }
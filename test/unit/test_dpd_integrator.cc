@@ -89,6 +89,7 @@ void dpd_conservative_force_test(boost::shared_ptr<ExecutionConfiguration> exec_
     {
     boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(50.0), 1, 0, 0, 0, 0, exec_conf));
     boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
     boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getN()-1));
     boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
 
@@ -177,7 +178,7 @@ void dpd_temperature_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
     for (unsigned int i = 0; i < 600; i++)
         {
         // Sample the Temperature
-        if (i > 0 && i % 100 == 0)
+        if (i >= 100 && i % 10 == 0)
             {
             thermo->compute(i);
             AvgT += thermo->getTemperature();
@@ -187,7 +188,7 @@ void dpd_temperature_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
 
         nve_up->update(i);
         }
-    AvgT /= 5;
+    AvgT /= 50;
     cout << "Average Temperature " << AvgT << endl;
     MY_BOOST_CHECK_CLOSE(AvgT, 2.0, 5);
 
@@ -0,0 +1,171 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#include <fstream>
+#include <cstdio>
+
+#include "EAMForceCompute.h"
+#include "NeighborListTree.h"
+
+using namespace std;
+using namespace boost;
+
+//! Name the unit test module
+#define BOOST_TEST_MODULE EAMForceTests
+#include "boost_utf_configure.h"
+
+/*! \file test_eam_force.cc
+    \brief Implements unit tests for EAMForceCompute
+    \ingroup unit_tests
+*/
+
+//! Write an EAM/Alloy file with quadratic tables for one type
+/*! F(rho) = rho (rho - 4), rho(r) = (rc - r)^2 and Z(r) = r phi(r) = (rc - r)^2 with rc = 1.6. Cubic interpolation
+    with central difference slopes reproduces quadratics exactly away from the ends of the tables.
+*/
+void write_quadratic_eam_file(const std::string& fname)
+    {
+    const unsigned int nrho = 101;
+    const Scalar drho = Scalar(0.05);
+    const unsigned int nr = 17;
+    const Scalar rc = Scalar(1.6);
+    const Scalar dr = rc / Scalar(nr - 1);
+
+    std::ofstream f(fname.c_str());
+    f.precision(12);
+    f << "test potential" << std::endl << "for unit tests" << std::endl << "only" << std::endl;
+    f << "1 A" << std::endl;
+    f << nrho << " " << drho << " " << nr << " " << dr << " " << rc << std::endl;
+    f << "1 1.0 1.0 fcc" << std::endl;
+    for (unsigned int i = 0; i < nrho; i++)
+        {
+        Scalar rho = Scalar(i) * drho;
+        f << rho * (rho - Scalar(4.0)) << std::endl;
+        }
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        Scalar r = Scalar(i) * dr;
+        f << (rc - r) * (rc - r) << std::endl;
+        }
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        Scalar r = Scalar(i) * dr;
+        f << (rc - r) * (rc - r) << std::endl;
+        }
+    }
+
+//! Checks that cubic interpolation of coarse tables reproduces the analytic energy and force
+void eam_force_cubic_test(boost::shared_ptr<ExecutionConfiguration> exec_conf, NeighborList::storageMode mode)
+    {
+    std::string fname("test_eam_force.eam.alloy");
+    write_quadratic_eam_file(fname);
+
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setPosition(0,make_scalar3(0.0,0.0,0.0));
+    pdata->setPosition(1,make_scalar3(0.7,0.0,0.0));
+
+    boost::shared_ptr<EAMForceCompute> fc(new EAMForceCompute(sysdef, (char *)fname.c_str(), 0));
+    boost::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, fc->get_r_cut(), Scalar(0.4)));
+    nlist->setStorageMode(mode);
+    fc->set_neighbor_list(nlist);
+    fc->setCubicInterpolation(true);
+    fc->compute(0);
+
+    // rho = 0.81, F = -2.5839, F' = -2.38, rho' = -1.8, phi = 0.81/0.7, phi' = -2.07/0.49
+    // E = 2 F + phi and dE/dr = 2 F' rho' + phi'
+    Scalar energy = Scalar(-2.5839) + Scalar(0.5) * Scalar(0.81/0.7);
+    Scalar dEdr = Scalar(2.0 * -2.38 * -1.8) - Scalar(2.07/0.49);
+
+    {
+    GPUArray<Scalar4>& force_array = fc->getForceArray();
+    GPUArray<Scalar>& virial_array = fc->getVirialArray();
+    unsigned int pitch = virial_array.getPitch();
+    ArrayHandle<Scalar4> h_force(force_array,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(virial_array,access_location::host,access_mode::read);
+
+    MY_BOOST_CHECK_CLOSE(h_force.data[0].x, dEdr, tol);
+    MY_BOOST_CHECK_SMALL(h_force.data[0].y, tol_small);
+    MY_BOOST_CHECK_SMALL(h_force.data[0].z, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force.data[0].w, energy, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial.data[0*pitch+0], -Scalar(0.5)*Scalar(0.7)*dEdr, tol);
+
+    MY_BOOST_CHECK_CLOSE(h_force.data[1].x, -dEdr, tol);
+    MY_BOOST_CHECK_CLOSE(h_force.data[1].w, energy, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial.data[0*pitch+1], -Scalar(0.5)*Scalar(0.7)*dEdr, tol);
+    }
+
+    // linear interpolation of the same coarse tables is noticeably off
+    fc->setCubicInterpolation(false);
+    fc->compute(1);
+
+    {
+    GPUArray<Scalar4>& force_array = fc->getForceArray();
+    ArrayHandle<Scalar4> h_force(force_array,access_location::host,access_mode::read);
+    BOOST_CHECK(fabs(h_force.data[0].x - dEdr) > Scalar(1e-3) * fabs(dEdr));
+    }
+
+    remove(fname.c_str());
+    }
+
+//! boost test case for cubic interpolation with a half neighbor list on the CPU
+BOOST_AUTO_TEST_CASE( EAMForceCompute_cubic_half )
+    {
+    eam_force_cubic_test(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                         NeighborList::half);
+    }
+
+//! boost test case for cubic interpolation with a full neighbor list on the CPU
+BOOST_AUTO_TEST_CASE( EAMForceCompute_cubic_full )
+    {
+    eam_force_cubic_test(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                         NeighborList::full);
+    }
@@ -87,6 +87,7 @@ void periodic_force_particle_test(periodicforce_creator periodic_creator, boost:
     // periodic boundary conditions will be handeled in another test
     boost::shared_ptr<SystemDefinition> sysdef_3(new SystemDefinition(3, BoxDim(5.0), 2, 0, 0, 0, 0, exec_conf));
     boost::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+    pdata_3->setFlags(~PDataFlags(0));
 
     pdata_3->setPosition(0,make_scalar3(1.7,0.0,0.0));
     pdata_3->setPosition(1,make_scalar3(2.0,0.0,0.0));
@@ -148,6 +149,7 @@ void periodic_force_comparison_test(periodicforce_creator periodic_creator1, per
     RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
     shared_ptr<SystemDefinition> sysdef(new SystemDefinition(rand_init, exec_conf));
     shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
 
     shared_ptr<PotentialExternalPeriodic> fc1 = periodic_creator1(sysdef);
     shared_ptr<PotentialExternalPeriodic> fc2 = periodic_creator2(sysdef);
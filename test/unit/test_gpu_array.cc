@@ -135,6 +135,133 @@ BOOST_AUTO_TEST_CASE( GPUArray_basic_tests )
 
     }
 
+//! Tests the size classes, reuse and release of blocks in HostArena
+BOOST_AUTO_TEST_CASE( HostArena_tests )
+    {
+    boost::shared_ptr<Messenger> msg(new Messenger());
+    HostArena arena(msg, 4096);
+
+    // size classes are spaced four per power of two
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(0), (size_t)64);
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(64), (size_t)64);
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(65), (size_t)80);
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(1000), (size_t)1024);
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(1025), (size_t)1280);
+    BOOST_CHECK_EQUAL(HostArena::getSizeClass(1500), (size_t)1536);
+
+    // blocks are aligned and a released block is handed out again for the same size class
+    void *a = arena.allocate(1000);
+    BOOST_CHECK_EQUAL((size_t)a % 32, (size_t)0);
+    BOOST_CHECK_EQUAL(arena.getCapacity(a), (size_t)1024);
+    arena.deallocate(a);
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)1024);
+
+    void *b = arena.allocate(1010);
+    BOOST_CHECK_EQUAL(a, b);
+    BOOST_CHECK_EQUAL(arena.getNumHits(), (unsigned int)1);
+    BOOST_CHECK_EQUAL(arena.getBytesInUse(), (size_t)1024);
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)0);
+
+    // a block is kept while shrinking to no less than a quarter of its capacity
+    BOOST_CHECK(arena.fitsInPlace(b, 1024));
+    BOOST_CHECK(arena.fitsInPlace(b, 256));
+    BOOST_CHECK(!arena.fitsInPlace(b, 255));
+    BOOST_CHECK(!arena.fitsInPlace(b, 1025));
+    arena.deallocate(b);
+
+    // exceeding the maximum cache size releases the largest blocks down to half the maximum
+    void *c = arena.allocate(2048);
+    void *d = arena.allocate(3072);
+    arena.deallocate(c);
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)(1024+2048));
+    arena.deallocate(d);
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)1024);
+
+    arena.trim();
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)0);
+    BOOST_CHECK_EQUAL(arena.getBytesInUse(), (size_t)0);
+    }
+
+//! Tests that blocks allocated under the huge page policies are aligned and usable
+BOOST_AUTO_TEST_CASE( HostArena_policy_tests )
+    {
+    boost::shared_ptr<Messenger> msg(new Messenger());
+    HostArena arena(msg);
+
+    // small blocks are not affected by the policy
+    arena.setPolicy(HostArena::transparent_huge_pages, false, 1024*1024);
+    char *a = (char *)arena.allocate(1000);
+    BOOST_CHECK_EQUAL((size_t)a % 32, (size_t)0);
+
+    // large blocks are aligned to the huge page size
+    size_t large = 4*1024*1024+100;
+    char *b = (char *)arena.allocate(large);
+    #ifdef __linux__
+    BOOST_CHECK_EQUAL((size_t)b % (2*1024*1024), (size_t)0);
+    #endif
+    memset(b, 1, large);
+    BOOST_CHECK_EQUAL(b[large-1], 1);
+
+    // explicit huge pages fall back to transparent ones if the pool is empty
+    arena.setPolicy(HostArena::explicit_huge_pages, true, 1024*1024);
+    char *c = (char *)arena.allocate(2*large);
+    BOOST_REQUIRE(c != NULL);
+    memset(c, 2, 2*large);
+    BOOST_CHECK_EQUAL(c[2*large-1], 2);
+
+    arena.deallocate(a);
+    arena.deallocate(b);
+    arena.deallocate(c);
+    arena.trim();
+    BOOST_CHECK_EQUAL(arena.getBytesCached(), (size_t)0);
+    }
+
+//! Tests that GPUArray resizes within its block on the host and clears the new elements
+BOOST_AUTO_TEST_CASE( GPUArray_host_resize_tests )
+    {
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    GPUArray<unsigned int> a(250, exec_conf);
+    unsigned int *ptr;
+        {
+        ArrayHandle<unsigned int> h_handle(a, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < 250; i++)
+            h_handle.data[i] = i+1;
+        ptr = h_handle.data;
+        }
+
+    // shrink and grow again within the 1024 byte size class
+    a.resize(100);
+    a.resize(240);
+    BOOST_CHECK_EQUAL(a.getNumElements(), (unsigned int)240);
+        {
+        ArrayHandle<unsigned int> h_handle(a, access_location::host, access_mode::read);
+        BOOST_CHECK_EQUAL(h_handle.data, ptr);
+        for (unsigned int i = 0; i < 100; i++)
+            BOOST_CHECK_EQUAL(h_handle.data[i], i+1);
+        for (unsigned int i = 100; i < 240; i++)
+            BOOST_CHECK_EQUAL(h_handle.data[i], (unsigned int)0);
+        }
+
+    // growing beyond the size class moves the data to a new block
+    a.resize(1000);
+        {
+        ArrayHandle<unsigned int> h_handle(a, access_location::host, access_mode::read);
+        BOOST_CHECK(h_handle.data != ptr);
+        for (unsigned int i = 0; i < 100; i++)
+            BOOST_CHECK_EQUAL(h_handle.data[i], i+1);
+        for (unsigned int i = 100; i < 1000; i++)
+            BOOST_CHECK_EQUAL(h_handle.data[i], (unsigned int)0);
+        }
+
+    // the released block serves the next allocation of the same size class
+    GPUArray<unsigned int> b(240, exec_conf);
+        {
+        ArrayHandle<unsigned int> h_handle(b, access_location::host, access_mode::read);
+        BOOST_CHECK_EQUAL(h_handle.data, ptr);
+        }
+    }
+
 #ifdef ENABLE_CUDA
 //! boost test case for testing device to/from host transfers
 BOOST_AUTO_TEST_CASE( GPUArray_transfer_tests )
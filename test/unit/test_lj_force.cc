@@ -573,6 +573,77 @@ void lj_force_shift_test(ljforce_creator lj_creator, boost::shared_ptr<Execution
     }
     }
 
+//! Test that energies are only computed on demand when pdata_flag::potential_energy is not set
+void lj_force_energy_on_demand_test(ljforce_creator lj_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // same three particle setup as in lj_force_particle_test
+    boost::shared_ptr<SystemDefinition> sysdef_3(new SystemDefinition(3, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+
+    // request everything except the potential energy
+    PDataFlags flags = ~PDataFlags(0);
+    flags[pdata_flag::potential_energy] = 0;
+    pdata_3->setFlags(flags);
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_3->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = Scalar(pow(2.0,1.0/6.0)); h_pos.data[1].y = h_pos.data[1].z = 0.0;
+    h_pos.data[2].x = Scalar(2.0*pow(2.0,1.0/6.0)); h_pos.data[2].y = h_pos.data[2].z = 0.0;
+    }
+    boost::shared_ptr<NeighborListTree> nlist_3(new NeighborListTree(sysdef_3, Scalar(1.3), Scalar(3.0)));
+    boost::shared_ptr<PotentialPairLJ> fc_3 = lj_creator(sysdef_3, nlist_3);
+    fc_3->setRcut(0, 0, Scalar(1.3));
+    fc_3->setShiftMode(PotentialPairLJ::shift);
+
+    Scalar epsilon = Scalar(1.15);
+    Scalar sigma = Scalar(1.2);
+    Scalar alpha = Scalar(0.45);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc_3->setParams(0,0,make_scalar2(lj1,lj2));
+    fc_3->compute(0);
+
+    {
+    // forces and virials are computed, energies are not
+    GPUArray<Scalar4>& force_array_1 =  fc_3->getForceArray();
+    GPUArray<Scalar>& virial_array_1 =  fc_3->getVirialArray();
+    unsigned int pitch = virial_array_1.getPitch();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_1(virial_array_1,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].x, -93.09822608552962, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].w, tol_small);
+    MY_BOOST_CHECK_CLOSE(Scalar(1./3.)*(h_virial_1.data[0*pitch+0]
+                                       +h_virial_1.data[3*pitch+0]
+                                       +h_virial_1.data[5*pitch+0]), 17.416537590989, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[1].x, tol_small);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[1].w, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[2].x, 93.09822608552962, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[2].w, tol_small);
+    }
+
+    // asking for the energy recomputes it with the shift applied, leaving the flags untouched
+    Scalar energy_shift = Scalar(4.0)*epsilon*(pow(sigma/Scalar(1.3),Scalar(12.0))
+                                               - alpha*pow(sigma/Scalar(1.3),Scalar(6.0)));
+    MY_BOOST_CHECK_CLOSE(fc_3->calcEnergySum(), Scalar(14.326044151)-Scalar(2.0)*energy_shift, tol);
+    BOOST_CHECK(!pdata_3->getFlags()[pdata_flag::potential_energy]);
+
+    {
+    GPUArray<Scalar4>& force_array_2 =  fc_3->getForceArray();
+    GPUArray<Scalar>& virial_array_2 =  fc_3->getVirialArray();
+    unsigned int pitch = virial_array_2.getPitch();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_2(virial_array_2,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].x, -93.09822608552962, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].w, Scalar(3.5815110377468)-Scalar(0.5)*energy_shift, tol);
+    MY_BOOST_CHECK_CLOSE(Scalar(1./3.)*(h_virial_2.data[0*pitch+0]
+                                       +h_virial_2.data[3*pitch+0]
+                                       +h_virial_2.data[5*pitch+0]), 17.416537590989, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[1].w, Scalar(7.1630220754935)-energy_shift, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[2].w, Scalar(3.5815110377468)-Scalar(0.5)*energy_shift, tol);
+    }
+    }
+
 //! LJForceCompute creator for unit tests
 boost::shared_ptr<PotentialPairLJ> base_class_lj_creator(boost::shared_ptr<SystemDefinition> sysdef,
                                                   boost::shared_ptr<NeighborList> nlist)
@@ -612,6 +683,13 @@ BOOST_AUTO_TEST_CASE( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for energy on demand test on CPU
+BOOST_AUTO_TEST_CASE( PotentialPairLJ_energy_on_demand )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_energy_on_demand_test(lj_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 # ifdef ENABLE_CUDA
 //! boost test case for particle test on GPU
 BOOST_AUTO_TEST_CASE( LJForceGPU_particle )
@@ -1097,6 +1097,58 @@ void neighborlist_cutoff_exclude_tests(boost::shared_ptr<ExecutionConfiguration>
         }
     }
 
+//! Tests that adaptive distance checks build the list on the same steps with fewer checks
+template <class NL>
+void neighborlist_adaptive_tests(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    boost::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, BoxDim(25.0), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+    h_pos.data[1] = make_scalar4(1.1, 0.0, 0.0, 0.0);
+    pdata_2->notifyParticleSort();
+    }
+
+    // r_buff = 0.4 allows a displacement of 0.2
+    boost::shared_ptr<NeighborList> nlist_std(new NL(sysdef_2, 1.0, 0.4));
+    nlist_std->setRCutPair(0,0,1.0);
+    nlist_std->setEvery(1);
+    boost::shared_ptr<NeighborList> nlist_adapt(new NL(sysdef_2, 1.0, 0.4));
+    nlist_adapt->setRCutPair(0,0,1.0);
+    nlist_adapt->setEvery(1);
+    nlist_adapt->setAdaptive(true);
+
+    // move particle 0 away from particle 1 at a constant velocity
+    vector<unsigned int> builds_std, builds_adapt;
+    for (unsigned int timestep = 0; timestep < 100; timestep++)
+        {
+            {
+            ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+            h_pos.data[0].x = -Scalar(0.013)*Scalar(timestep);
+            }
+
+        nlist_std->compute(timestep);
+        nlist_adapt->compute(timestep);
+        if (nlist_std->hasBeenUpdated(timestep))
+            builds_std.push_back(timestep);
+        if (nlist_adapt->hasBeenUpdated(timestep))
+            builds_adapt.push_back(timestep);
+        }
+
+    BOOST_REQUIRE(builds_std.size() > 2);
+    BOOST_CHECK_EQUAL_COLLECTIONS(builds_std.begin(), builds_std.end(), builds_adapt.begin(), builds_adapt.end());
+    BOOST_CHECK(nlist_adapt->getNumDistanceChecks() < nlist_std->getNumDistanceChecks() / 2);
+
+    // the pair has left the buffer for good
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist_adapt->getNNeighArray(), access_location::host, access_mode::read);
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[0] + h_n_neigh.data[1], 0);
+        }
+    }
+
 ///////////////
 // BINNED CPU
 ///////////////
@@ -1130,6 +1182,11 @@ BOOST_AUTO_TEST_CASE( NeighborListBinned_particle_asymm )
     {
     neighborlist_particle_asymm_tests<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! adaptive distance check test case for binned class
+BOOST_AUTO_TEST_CASE( NeighborListBinned_adaptive )
+    {
+    neighborlist_adaptive_tests<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! cutoff exclusion test case for binned class
 BOOST_AUTO_TEST_CASE( NeighborListBinned_cutoff_exclude )
     {
@@ -164,6 +164,72 @@ void nve_updater_integrate_tests(twostepnve_creator nve_creator, boost::shared_p
         }
     }
 
+//! Integrate with a slow force evaluated every 4th step and compare to the analytical solution
+void nve_updater_force_period_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // use a 1 particle system in a huge box so boundary conditions don't come into play
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(1, BoxDim(1000.0), 4, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = 0.0;
+    h_pos.data[0].y = 1.0;
+    h_pos.data[0].z = 2.0;
+    h_vel.data[0].x = 3.0;
+    h_vel.data[0].y = 2.0;
+    h_vel.data[0].z = 1.0;
+    }
+
+    Scalar deltaT = Scalar(0.0001);
+    unsigned int period = 4;
+    boost::shared_ptr<TwoStepNVE> two_step_nve = nve_creator(sysdef, group_all);
+    boost::shared_ptr<IntegratorTwoStep> nve_up(new IntegratorTwoStep(sysdef, deltaT));
+    nve_up->addIntegrationMethod(two_step_nve);
+
+    // a fast force evaluated every step and a slow one evaluated every 4th step
+    boost::shared_ptr<ConstForceCompute> fc_fast(new ConstForceCompute(sysdef, 1.5, 0.0, 0.0));
+    nve_up->addForceCompute(fc_fast);
+    boost::shared_ptr<ConstForceCompute> fc_slow(new ConstForceCompute(sysdef, 0.0, 2.5, 0.0));
+    nve_up->addForceCompute(fc_slow);
+
+    // invalid periods and unknown forces are rejected
+    boost::shared_ptr<ConstForceCompute> fc_other(new ConstForceCompute(sysdef, 0.0, 0.0, 1.0));
+    BOOST_CHECK_THROW(nve_up->setForcePeriod(fc_slow, 0), runtime_error);
+    BOOST_CHECK_THROW(nve_up->setForcePeriod(fc_other, 2), runtime_error);
+
+    nve_up->setForcePeriod(fc_slow, period);
+
+    // start out of phase with timestep 0 to test the offset
+    unsigned int start = 3;
+    nve_up->prepRun(start);
+
+    // the impulses of a constant slow force reproduce the exact trajectory at the end of every period
+    for (unsigned int i = 0; i <= 100*period; i++)
+        {
+        if (i % period == 0)
+            {
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+
+            Scalar t = Scalar(i) * deltaT;
+            MY_BOOST_CHECK_CLOSE(h_pos.data[0].x, 0.0 + 3.0 * t + 1.0/2.0 * 1.5 * t*t, tol);
+            MY_BOOST_CHECK_CLOSE(h_vel.data[0].x, 3.0 + 1.5 * t, tol);
+
+            MY_BOOST_CHECK_CLOSE(h_pos.data[0].y, 1.0 + 2.0 * t + 1.0/2.0 * 2.5 * t*t, tol);
+            MY_BOOST_CHECK_CLOSE(h_vel.data[0].y, 2.0 + 2.5 * t, tol);
+
+            MY_BOOST_CHECK_CLOSE(h_pos.data[0].z, 2.0 + 1.0 * t, tol);
+            MY_BOOST_CHECK_CLOSE(h_vel.data[0].z, 1.0, tol);
+            }
+
+        nve_up->update(start + i);
+        }
+    }
+
 //! Check that the particle movement limit works
 void nve_updater_limit_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -517,6 +583,13 @@ BOOST_AUTO_TEST_CASE( TwoStepNVE_integrate_tests )
     nve_updater_integrate_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for multiple time step integration
+BOOST_AUTO_TEST_CASE( TwoStepNVE_force_period_tests )
+    {
+    twostepnve_creator nve_creator = bind(base_class_nve_creator, _1, _2);
+    nve_updater_force_period_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! boost test case for base class limit tests
 BOOST_AUTO_TEST_CASE( TwoStepNVE_limit_tests )
     {
@@ -546,6 +619,13 @@ BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_integrate_tests )
     nve_updater_integrate_tests(nve_creator_gpu, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! boost test case for multiple time step integration
+BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_force_period_tests )
+    {
+    twostepnve_creator nve_creator_gpu = bind(gpu_nve_creator, _1, _2);
+    nve_updater_force_period_tests(nve_creator_gpu, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 //! boost test case for base class limit tests
 BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_limit_tests )
     {
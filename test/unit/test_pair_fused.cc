@@ -0,0 +1,224 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#include <iostream>
+
+#include <boost/shared_ptr.hpp>
+
+#include "AllPairPotentials.h"
+#include "PotentialPairFused.h"
+
+#include "NeighborListTree.h"
+#include "Initializers.h"
+
+#include <math.h>
+
+using namespace std;
+using namespace boost;
+
+/*! \file test_pair_fused.cc
+    \brief Implements unit tests for PotentialPairFused
+    \ingroup unit_tests
+*/
+
+//! Name the unit test module
+#define BOOST_TEST_MODULE PotentialPairFusedTests
+#include "boost_utf_configure.h"
+
+//! Set the same parameters on a set of LJ, Gauss and Yukawa potentials
+static void set_params(boost::shared_ptr<PotentialPairLJ> lj,
+                       boost::shared_ptr<PotentialPairGauss> gauss,
+                       boost::shared_ptr<PotentialPairYukawa> yukawa)
+    {
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.2);
+    Scalar alpha = Scalar(0.45);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    lj->setParams(0,0,make_scalar2(lj1,lj2));
+    lj->setRcut(0,0,Scalar(3.0));
+    lj->setRon(0,0,Scalar(2.0));
+    lj->setShiftMode(PotentialPairLJ::xplor);
+
+    gauss->setParams(0,0,make_scalar2(Scalar(1.5),Scalar(0.8)));
+    gauss->setRcut(0,0,Scalar(2.0));
+    gauss->setShiftMode(PotentialPairGauss::shift);
+
+    yukawa->setParams(0,0,make_scalar2(Scalar(2.0),Scalar(1.3)));
+    yukawa->setRcut(0,0,Scalar(2.5));
+    }
+
+//! Check that two force computes produced the same forces, energies and virials
+static void check_same_forces(boost::shared_ptr<ForceCompute> fc1, boost::shared_ptr<ForceCompute> fc2, unsigned int N)
+    {
+    ArrayHandle<Scalar4> h_force_1(fc1->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_1(fc1->getVirialArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_force_2(fc2->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_2(fc2->getVirialArray(),access_location::host,access_mode::read);
+    unsigned int pitch_1 = fc1->getVirialArray().getPitch();
+    unsigned int pitch_2 = fc2->getVirialArray().getPitch();
+
+    double deltaf2 = 0.0;
+    double deltape2 = 0.0;
+    double deltav2 = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        deltaf2 += double(h_force_2.data[i].x - h_force_1.data[i].x) * double(h_force_2.data[i].x - h_force_1.data[i].x);
+        deltaf2 += double(h_force_2.data[i].y - h_force_1.data[i].y) * double(h_force_2.data[i].y - h_force_1.data[i].y);
+        deltaf2 += double(h_force_2.data[i].z - h_force_1.data[i].z) * double(h_force_2.data[i].z - h_force_1.data[i].z);
+        deltape2 += double(h_force_2.data[i].w - h_force_1.data[i].w) * double(h_force_2.data[i].w - h_force_1.data[i].w);
+        for (unsigned int j = 0; j < 6; j++)
+            deltav2 += double(h_virial_2.data[j*pitch_2+i] - h_virial_1.data[j*pitch_1+i])
+                     * double(h_virial_2.data[j*pitch_2+i] - h_virial_1.data[j*pitch_1+i]);
+        }
+    deltaf2 /= double(N);
+    deltape2 /= double(N);
+    deltav2 /= double(N);
+    BOOST_CHECK_SMALL(deltaf2, double(tol_small));
+    BOOST_CHECK_SMALL(deltape2, double(tol_small));
+    BOOST_CHECK_SMALL(deltav2, double(tol_small));
+    }
+
+//! Test that fused pair potentials compute the same forces as separate ones
+void pair_fused_comparison_test(NeighborList::storageMode mode, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    boost::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist->setStorageMode(mode);
+
+    // reference potentials, computed separately
+    boost::shared_ptr<PotentialPairLJ> lj_ref(new PotentialPairLJ(sysdef, nlist));
+    boost::shared_ptr<PotentialPairGauss> gauss_ref(new PotentialPairGauss(sysdef, nlist));
+    boost::shared_ptr<PotentialPairYukawa> yukawa_ref(new PotentialPairYukawa(sysdef, nlist));
+    set_params(lj_ref, gauss_ref, yukawa_ref);
+
+    // fused potentials
+    boost::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    boost::shared_ptr<PotentialPairGauss> gauss(new PotentialPairGauss(sysdef, nlist));
+    boost::shared_ptr<PotentialPairYukawa> yukawa(new PotentialPairYukawa(sysdef, nlist));
+    set_params(lj, gauss, yukawa);
+
+    boost::shared_ptr<PotentialPairFused> fused(new PotentialPairFused(sysdef, nlist));
+    lj->setFusedCompute(fused);
+    gauss->setFusedCompute(fused);
+    yukawa->setFusedCompute(fused);
+    BOOST_CHECK_EQUAL(fused->getNumPotentials(), (unsigned int)3);
+
+    lj_ref->compute(0);
+    gauss_ref->compute(0);
+    yukawa_ref->compute(0);
+    lj->compute(0);
+    gauss->compute(0);
+    yukawa->compute(0);
+
+    check_same_forces(lj_ref, lj, N);
+    check_same_forces(gauss_ref, gauss, N);
+    check_same_forces(yukawa_ref, yukawa, N);
+
+    // move the particles and compute only one of the fused potentials at a later step
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            h_pos.data[i].x += Scalar(0.01) * Scalar(i % 7);
+        }
+    pdata->notifyParticleSort();
+
+    gauss_ref->compute(1);
+    gauss->compute(1);
+    check_same_forces(gauss_ref, gauss, N);
+
+    // the other fused potentials must not reuse the pass from an earlier step
+    lj_ref->compute(2);
+    yukawa_ref->compute(2);
+    lj->compute(2);
+    yukawa->compute(2);
+    check_same_forces(lj_ref, lj, N);
+    check_same_forces(yukawa_ref, yukawa, N);
+
+    // energies skipped in the fused pass are recomputed on demand
+    pdata->setFlags(PDataFlags(0));
+    lj->compute(3);
+    yukawa->compute(3);
+    pdata->setFlags(~PDataFlags(0));
+    lj_ref->compute(3);
+    MY_BOOST_CHECK_CLOSE(lj->calcEnergySum(), lj_ref->calcEnergySum(), tol);
+
+    // unregister the potentials
+    lj->setFusedCompute(boost::shared_ptr<PotentialPairFused>());
+    BOOST_CHECK_EQUAL(fused->getNumPotentials(), (unsigned int)2);
+    yukawa.reset();
+    BOOST_CHECK_EQUAL(fused->getNumPotentials(), (unsigned int)1);
+
+    // a potential on another neighbor list cannot be fused
+    boost::shared_ptr<NeighborListTree> nlist2(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    boost::shared_ptr<PotentialPairLJ> lj2(new PotentialPairLJ(sysdef, nlist2));
+    BOOST_CHECK_THROW(lj2->setFusedCompute(fused), std::runtime_error);
+    }
+
+//! boost test case for comparing fused and separate potentials with a full neighbor list
+BOOST_AUTO_TEST_CASE( PotentialPairFused_full )
+    {
+    pair_fused_comparison_test(NeighborList::full, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! boost test case for comparing fused and separate potentials with a half neighbor list
+BOOST_AUTO_TEST_CASE( PotentialPairFused_half )
+    {
+    pair_fused_comparison_test(NeighborList::half, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
@@ -401,6 +401,58 @@ BOOST_AUTO_TEST_CASE( RigidBodyGroup_one_test )
     }
 
 
+//! Checks that the compact per-body particle lists of RigidData follow a resort
+BOOST_AUTO_TEST_CASE( RigidData_body_particles_test )
+    {
+    boost::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<RigidData> rdata = sysdef->getRigidData();
+
+    BOOST_REQUIRE_EQUAL_UINT(rdata->getNumBodies(), 2);
+    BOOST_REQUIRE_EQUAL_UINT(rdata->getBodyOffsets().getNumElements(), 3);
+    BOOST_REQUIRE_EQUAL_UINT(rdata->getBodyParticleTags().getNumElements(), 4);
+
+    {
+    ArrayHandle<unsigned int> h_body_offset(rdata->getBodyOffsets(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_tags(rdata->getBodyParticleTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(rdata->getBodyParticleIndices(), access_location::host, access_mode::read);
+
+    // body 0 holds tags 0 and 1, body 1 holds tags 2 and 3
+    BOOST_CHECK_EQUAL_UINT(h_body_offset.data[0], 0);
+    BOOST_CHECK_EQUAL_UINT(h_body_offset.data[1], 2);
+    BOOST_CHECK_EQUAL_UINT(h_body_offset.data[2], 4);
+    for (unsigned int k = 0; k < 4; k++)
+        {
+        BOOST_CHECK_EQUAL_UINT(h_body_tags.data[k], k);
+        BOOST_CHECK_EQUAL_UINT(h_body_indices.data[k], k);
+        }
+    }
+
+    // reverse the particle order
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        h_tag.data[i] = pdata->getN() - 1 - i;
+        h_rtag.data[i] = pdata->getN() - 1 - i;
+        }
+    }
+
+    pdata->notifyParticleSort();
+
+    {
+    ArrayHandle<unsigned int> h_body_tags(rdata->getBodyParticleTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body_indices(rdata->getBodyParticleIndices(), access_location::host, access_mode::read);
+    for (unsigned int k = 0; k < 4; k++)
+        {
+        BOOST_CHECK_EQUAL_UINT(h_body_tags.data[k], k);
+        BOOST_CHECK_EQUAL_UINT(h_body_indices.data[k], 9 - k);
+        }
+    }
+    BOOST_CHECK_EQUAL_UINT(rdata->getNumIndexRigid(), 4);
+    }
+
 //! Checks that ParticleGroup can initialize by particle tag
 BOOST_AUTO_TEST_CASE( ParticleGroup_tag_test )
     {
@@ -501,6 +553,60 @@ BOOST_AUTO_TEST_CASE( ParticleGroup_boolean_tests)
     BOOST_CHECK_EQUAL_UINT(intersection_group->getMemberTag(1), 2);
     }
 
+//! Checks that the combination selectors match the boolean group operations
+BOOST_AUTO_TEST_CASE( ParticleSelector_combination_tests)
+    {
+    boost::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    boost::shared_ptr<ParticleSelector> selector04(new ParticleSelectorTag(sysdef, 0, 4));
+    boost::shared_ptr<ParticleSelector> selector0(new ParticleSelectorType(sysdef, 0, 0));
+
+    // union: tags 0-4 and type 0
+    boost::shared_ptr<ParticleSelector> union_selector(new ParticleSelectorUnion(sysdef, selector0, selector04));
+    ParticleGroup union_group(sysdef, union_selector);
+    BOOST_REQUIRE_EQUAL_UINT(union_group.getNumMembers(), 7);
+    BOOST_CHECK_EQUAL_UINT(union_group.getMemberTag(5), 5);
+    BOOST_CHECK_EQUAL_UINT(union_group.getMemberTag(6), 8);
+
+    // intersection
+    boost::shared_ptr<ParticleSelector> intersection_selector(
+        new ParticleSelectorIntersection(sysdef, selector0, selector04));
+    ParticleGroup intersection_group(sysdef, intersection_selector);
+    BOOST_REQUIRE_EQUAL_UINT(intersection_group.getNumMembers(), 2);
+    BOOST_CHECK_EQUAL_UINT(intersection_group.getMemberTag(0), 0);
+    BOOST_CHECK_EQUAL_UINT(intersection_group.getMemberTag(1), 2);
+
+    // difference, nested in a union with a cuboid around particle 9
+    boost::shared_ptr<ParticleSelector> difference_selector(
+        new ParticleSelectorDifference(sysdef, selector0, selector04));
+    boost::shared_ptr<ParticleSelector> cuboid_selector(new ParticleSelectorCuboid(sysdef,
+                                                                              make_scalar3(4.5, 4.5, 4.5),
+                                                                              make_scalar3(5.5, 5.5, 5.5)));
+    boost::shared_ptr<ParticleSelector> nested_selector(
+        new ParticleSelectorUnion(sysdef, difference_selector, cuboid_selector));
+    ParticleGroup nested_group(sysdef, nested_selector);
+    BOOST_REQUIRE_EQUAL_UINT(nested_group.getNumMembers(), 3);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberTag(0), 5);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberTag(1), 8);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberTag(2), 9);
+
+    // the batch evaluation agrees with the per tag test
+    std::vector<unsigned char> selected(pdata->getN());
+    nested_selector->selectLocal(&selected.front());
+    for (unsigned int tag = 0; tag < pdata->getN(); tag++)
+        BOOST_CHECK_EQUAL(bool(selected[pdata->getRTag(tag)]), nested_selector->isSelected(tag));
+
+    // moving particle 5 out of type 0 and re-evaluating the selection removes it from the group
+    pdata->setType(5, 1);
+    nested_group.updateMemberTags(true);
+    BOOST_REQUIRE_EQUAL_UINT(nested_group.getNumMembers(), 2);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberTag(0), 8);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberTag(1), 9);
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberIndex(0), pdata->getRTag(8));
+    BOOST_CHECK_EQUAL_UINT(nested_group.getMemberIndex(1), pdata->getRTag(9));
+    }
+
 //! Checks that the ParticleGroup::getTotalMass works correctly
 BOOST_AUTO_TEST_CASE( ParticleGroup_total_mass_tests)
     {
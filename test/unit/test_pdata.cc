@@ -461,6 +461,101 @@ BOOST_AUTO_TEST_CASE( BoxDim_triclinic_test )
     BOOST_CHECK_EQUAL(img.z, 0);
     }
 
+//! Test the batch BoxDim methods against their scalar counterparts
+BOOST_AUTO_TEST_CASE( BoxDim_array_test )
+    {
+    Scalar tol = Scalar(1e-4);
+    const unsigned int n = 200;
+
+    // a set of vectors covering up to one image in every direction, avoiding exact ties at half a box length
+    std::vector<Scalar3> v(n);
+    for (unsigned int i = 0; i < n; i++)
+        v[i] = make_scalar3(Scalar(-9.9) + Scalar(0.099)*i, Scalar(11.3) - Scalar(0.113)*i, Scalar(0.07)*(i%97) - Scalar(6.6));
+
+    std::vector<BoxDim> boxes;
+    boxes.push_back(BoxDim(make_scalar3(10.0, 12.0, 14.0)));
+    boxes.push_back(BoxDim(make_scalar3(10.0, 12.0, 14.0)));
+    boxes.back().setTiltFactors(1.0, 0.4, 0.9);
+    boxes.push_back(BoxDim(make_scalar3(10.0, 12.0, 14.0)));
+    boxes.back().setTiltFactors(0.3, 0.0, -0.2);
+    boxes.back().setPeriodic(make_uchar3(1,0,1));
+
+    for (unsigned int b = 0; b < boxes.size(); b++)
+        {
+        const BoxDim& box = boxes[b];
+
+        // minimum image
+        std::vector<Scalar3> w(v);
+        box.minImageArray(&w[0], n);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar3 cmp = box.minImage(v[i]);
+            MY_BOOST_CHECK_SMALL(w[i].x - cmp.x, tol);
+            MY_BOOST_CHECK_SMALL(w[i].y - cmp.y, tol);
+            MY_BOOST_CHECK_SMALL(w[i].z - cmp.z, tol);
+            }
+
+        // wrap, positions are placed up to one image out of the box
+        std::vector<Scalar4> pos(n);
+        std::vector<int3> img(n, make_int3(1,-2,3));
+        for (unsigned int i = 0; i < n; i++)
+            pos[i] = make_scalar4(v[i].x*Scalar(1.1), v[i].y*Scalar(1.1), v[i].z*Scalar(1.1), __int_as_scalar(i));
+        box.wrapArray(&pos[0], &img[0], n);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar4 cmp = make_scalar4(v[i].x*Scalar(1.1), v[i].y*Scalar(1.1), v[i].z*Scalar(1.1), __int_as_scalar(i));
+            int3 cmp_img = make_int3(1,-2,3);
+            box.wrap(cmp, cmp_img);
+            MY_BOOST_CHECK_SMALL(pos[i].x - cmp.x, tol);
+            MY_BOOST_CHECK_SMALL(pos[i].y - cmp.y, tol);
+            MY_BOOST_CHECK_SMALL(pos[i].z - cmp.z, tol);
+            BOOST_CHECK_EQUAL(__scalar_as_int(pos[i].w), (int)i);
+            BOOST_CHECK_EQUAL(img[i].x, cmp_img.x);
+            BOOST_CHECK_EQUAL(img[i].y, cmp_img.y);
+            BOOST_CHECK_EQUAL(img[i].z, cmp_img.z);
+            }
+
+        // fractional coordinates with a ghost layer
+        Scalar3 ghost_width = make_scalar3(0.5, 0.3, 0.0);
+        std::vector<Scalar3> f(n);
+        box.makeFractionArray(&pos[0], &f[0], n, ghost_width);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar3 cmp = box.makeFraction(make_scalar3(pos[i].x, pos[i].y, pos[i].z), ghost_width);
+            MY_BOOST_CHECK_SMALL(f[i].x - cmp.x, tol);
+            MY_BOOST_CHECK_SMALL(f[i].y - cmp.y, tol);
+            MY_BOOST_CHECK_SMALL(f[i].z - cmp.z, tol);
+            }
+        }
+
+    // orthorhombic boxes handle vectors any number of images away
+    BoxDim box(make_scalar3(10.0, 12.0, 14.0));
+    Scalar3 dx = make_scalar3(23.0, -31.0, 45.0);
+    box.minImageArray(&dx, 1);
+    MY_BOOST_CHECK_CLOSE(dx.x, 3.0, tol);
+    MY_BOOST_CHECK_CLOSE(dx.y, 5.0, tol);
+    MY_BOOST_CHECK_CLOSE(dx.z, 3.0, tol);
+
+    Scalar4 p = make_scalar4(23.0, -31.0, 45.0, 0.0);
+    int3 image = make_int3(0,0,0);
+    box.wrapArray(&p, &image, 1);
+    MY_BOOST_CHECK_CLOSE(p.x, 3.0, tol);
+    MY_BOOST_CHECK_CLOSE(p.y, 5.0, tol);
+    MY_BOOST_CHECK_CLOSE(p.z, 3.0, tol);
+    BOOST_CHECK_EQUAL(image.x, 2);
+    BOOST_CHECK_EQUAL(image.y, -3);
+    BOOST_CHECK_EQUAL(image.z, 3);
+
+    // positions exactly on the upper boundary are moved to the lower one, like wrap() does
+    p = make_scalar4(5.0, -6.0, 0.0, 0.0);
+    image = make_int3(0,0,0);
+    box.wrapArray(&p, &image, 1);
+    MY_BOOST_CHECK_CLOSE(p.x, -5.0, tol);
+    MY_BOOST_CHECK_CLOSE(p.y, -6.0, tol);
+    BOOST_CHECK_EQUAL(image.x, 1);
+    BOOST_CHECK_EQUAL(image.y, 0);
+    }
+
 //! Test operation of the particle data class
 BOOST_AUTO_TEST_CASE( ParticleData_test )
     {
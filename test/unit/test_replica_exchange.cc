@@ -0,0 +1,221 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2015 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE ReplicaExchangeTests
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
+#include "ComputeThermo.h"
+#include "TwoStepNVT.h"
+#include "IntegratorTwoStep.h"
+#include "AllPairPotentials.h"
+#include "NeighborListTree.h"
+#include "ReplicaExchangeUpdater.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <math.h>
+
+using namespace std;
+using namespace boost;
+
+/*! \file test_replica_exchange.cc
+    \brief Implements unit tests for ReplicaExchangeUpdater
+    \ingroup unit_tests
+*/
+
+//! A replica of a Lennard-Jones dimer in one partition
+struct Replica
+    {
+    //! Set up the dimer with separation \a r, velocity \a v of the second particle, LJ \a epsilon and temperature \a T
+    Replica(boost::shared_ptr<ExecutionConfiguration> exec_conf, Scalar r, Scalar v, Scalar epsilon, Scalar T,
+            bool hamiltonian)
+        {
+        sysdef = boost::shared_ptr<SystemDefinition>(new SystemDefinition(2, BoxDim(20.0), 1, 0, 0, 0, 0, exec_conf));
+        pdata = sysdef->getParticleData();
+        pdata->setFlags(~PDataFlags(0));
+
+        pdata->setPosition(0, make_scalar3(0.0,0.0,0.0));
+        pdata->setPosition(1, make_scalar3(r,0.0,0.0));
+        pdata->setVelocity(1, make_scalar3(v,0.0,0.0));
+
+        boost::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.4)));
+        lj = boost::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef, nlist));
+        lj->setRcut(0, 0, Scalar(3.0));
+        lj->setParams(0, 0, make_scalar2(Scalar(4.0)*epsilon, Scalar(4.0)*epsilon));
+
+        boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getNGlobal()-1));
+        boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+        thermo = boost::shared_ptr<ComputeThermo>(new ComputeThermo(sysdef, group_all));
+
+        integrator = boost::shared_ptr<IntegratorTwoStep>(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+        integrator->addIntegrationMethod(boost::shared_ptr<TwoStepNVT>(new TwoStepNVT(sysdef, group_all, thermo,
+            Scalar(0.5), boost::shared_ptr<VariantConst>(new VariantConst(T)))));
+        integrator->addForceCompute(lj);
+        integrator->prepRun(0);
+
+        remd = boost::shared_ptr<ReplicaExchangeUpdater>(new ReplicaExchangeUpdater(sysdef, thermo, integrator, 12,
+                                                                                      hamiltonian));
+        }
+
+    //! Get the potential energy of the current configuration
+    Scalar getPotentialEnergy()
+        {
+        thermo->forceCompute(1);
+        return thermo->getPotentialEnergy();
+        }
+
+    boost::shared_ptr<SystemDefinition> sysdef;         //!< The system
+    boost::shared_ptr<ParticleData> pdata;              //!< Its particle data
+    boost::shared_ptr<PotentialPairLJ> lj;              //!< The pair potential
+    boost::shared_ptr<ComputeThermo> thermo;            //!< Thermodynamic properties
+    boost::shared_ptr<IntegratorTwoStep> integrator;    //!< The integrator
+    boost::shared_ptr<ReplicaExchangeUpdater> remd;     //!< The updater under test
+    };
+
+//! LJ pair energy for unit epsilon and sigma
+Scalar lj_energy(Scalar r)
+    {
+    return Scalar(4.0)*(pow(r,Scalar(-12.0)) - pow(r,Scalar(-6.0)));
+    }
+
+//! Test the pairing of the partitions and the temperature replica exchange
+void replica_exchange_temperature_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs two partitions of one rank each
+    BOOST_REQUIRE_EQUAL(exec_conf->getNPartitions(), (unsigned int)2);
+    unsigned int partition = exec_conf->getPartition();
+
+    // the colder replica has the higher energy, so the swap is always accepted
+    Scalar r[2] = {1.0, 1.5};
+    Scalar v[2] = {0.5, 2.0};
+    Scalar T[2] = {1.0, 2.0};
+    Replica rep(exec_conf, r[partition], v[partition], Scalar(1.0), T[partition], false);
+    unsigned int other = 1 - partition;
+
+    rep.remd->update(0);
+
+    // the configurations have been swapped and the velocities rescaled by sqrt(T_own/T_other)
+    MY_BOOST_CHECK_CLOSE(rep.pdata->getPosition(1).x, r[other], tol);
+    MY_BOOST_CHECK_CLOSE(rep.pdata->getVelocity(1).x, v[other]*sqrt(T[partition]/T[other]), tol);
+    MY_BOOST_CHECK_CLOSE(rep.getPotentialEnergy(), lj_energy(r[other]), tol);
+
+    // the next attempt would pair 1-2, which does not exist with two partitions
+    rep.remd->update(1);
+    MY_BOOST_CHECK_CLOSE(rep.pdata->getPosition(1).x, r[other], tol);
+
+    // partition 0 exchanges with its upper neighbor, partition 1 with its lower neighbor
+    std::string accepted = (partition == 0) ? "replica_exchange_acceptance_up" : "replica_exchange_acceptance_down";
+    std::string unused = (partition == 0) ? "replica_exchange_acceptance_down" : "replica_exchange_acceptance_up";
+    MY_BOOST_CHECK_CLOSE(rep.remd->getLogValue(accepted, 1), 1.0, tol);
+    MY_BOOST_CHECK_SMALL(rep.remd->getLogValue(unused, 1), tol_small);
+
+    // now the colder replica has by far the lower energy, and the swap is rejected
+    Scalar r_rej[2] = {1.5, 0.8};
+    Replica rep_rej(exec_conf, r_rej[partition], v[partition], Scalar(1.0), T[partition], false);
+    rep_rej.remd->update(0);
+
+    MY_BOOST_CHECK_CLOSE(rep_rej.pdata->getPosition(1).x, r_rej[partition], tol);
+    MY_BOOST_CHECK_CLOSE(rep_rej.pdata->getVelocity(1).x, v[partition], tol);
+    MY_BOOST_CHECK_SMALL(rep_rej.remd->getLogValue(accepted, 1), tol_small);
+    }
+
+//! Test the Hamiltonian replica exchange
+void replica_exchange_hamiltonian_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    BOOST_REQUIRE_EQUAL(exec_conf->getNPartitions(), (unsigned int)2);
+    unsigned int partition = exec_conf->getPartition();
+    unsigned int other = 1 - partition;
+
+    // the replicas differ in epsilon, the acceptance exponent is eps_0 (u(1.5) - u(1.2)) + eps_1 (u(1.2) - u(1.5)) > 0
+    Scalar r[2] = {1.5, 1.2};
+    Scalar v[2] = {0.5, 2.0};
+    Scalar eps[2] = {2.0, 1.0};
+    Replica rep(exec_conf, r[partition], v[partition], eps[partition], Scalar(1.0), true);
+
+    rep.remd->update(0);
+
+    // each replica now evaluates its own potential on the configuration of the partner
+    MY_BOOST_CHECK_CLOSE(rep.pdata->getPosition(1).x, r[other], tol);
+    MY_BOOST_CHECK_CLOSE(rep.pdata->getVelocity(1).x, v[other], tol);
+    MY_BOOST_CHECK_CLOSE(rep.getPotentialEnergy(), eps[partition]*lj_energy(r[other]), tol);
+
+    // swapping the configurations is very unfavorable for the deep potential in partition 0 and is rejected
+    Scalar r_rej[2] = {1.12, 1.5};
+    Scalar eps_rej[2] = {100.0, 1.0};
+    Replica rep_rej(exec_conf, r_rej[partition], v[partition], eps_rej[partition], Scalar(1.0), true);
+    rep_rej.remd->update(0);
+
+    // the original configuration and its forces are restored
+    MY_BOOST_CHECK_CLOSE(rep_rej.pdata->getPosition(1).x, r_rej[partition], tol);
+    MY_BOOST_CHECK_CLOSE(rep_rej.pdata->getVelocity(1).x, v[partition], tol);
+    MY_BOOST_CHECK_CLOSE(rep_rej.getPotentialEnergy(), eps_rej[partition]*lj_energy(r_rej[partition]), tol);
+    }
+
+//! Execution configuration with one rank per partition
+boost::shared_ptr<ExecutionConfiguration> partitioned_exec_conf()
+    {
+    return boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU, -1,
+        false, false, boost::shared_ptr<Messenger>(), 1));
+    }
+
+//! Tests temperature replica exchange between two partitions
+BOOST_AUTO_TEST_CASE( ReplicaExchange_temperature )
+    {
+    replica_exchange_temperature_test(partitioned_exec_conf());
+    }
+
+//! Tests Hamiltonian replica exchange between two partitions
+BOOST_AUTO_TEST_CASE( ReplicaExchange_hamiltonian )
+    {
+    replica_exchange_hamiltonian_test(partitioned_exec_conf());
+    }
@@ -223,6 +223,58 @@ void angle_force_basic_tests(angleforce_creator tf_creator, boost::shared_ptr<Ex
 
     }
 
+//! checks that cubic interpolation reproduces a cubic potential exactly
+void angle_force_cubic_tests(angleforce_creator tf_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // an angle of 1 radian at particle 1, with unit bond lengths
+    boost::shared_ptr<SystemDefinition> sysdef_3(new SystemDefinition(3, BoxDim(1000.0), 1, 0, 1, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+
+    pdata_3->setPosition(0,make_scalar3(1.0,0.0,0.0));
+    pdata_3->setPosition(1,make_scalar3(0.0,0.0,0.0));
+    pdata_3->setPosition(2,make_scalar3(cos(1.0),sin(1.0),0.0));
+    sysdef_3->getAngleData()->addBondedGroup(Angle(0,0,1,2));
+
+    // V = theta^3 on 5 points between 0 and pi
+    unsigned int width = 5;
+    boost::shared_ptr<TableAngleForceCompute> fc_3 = tf_creator(sysdef_3,width);
+    std::vector<Scalar> V, T;
+    for (unsigned int i = 0; i < width; ++i)
+        {
+        Scalar theta = (Scalar)i/(Scalar)(width-1)*Scalar(M_PI);
+        V.push_back(theta*theta*theta);
+        T.push_back(-Scalar(3.0)*theta*theta);
+        }
+    fc_3->setTable(0, V, T);
+    fc_3->setCubicInterpolation(true);
+
+    fc_3->compute(0);
+
+    {
+    GPUArray<Scalar4>& force_array_1 =  fc_3->getForceArray();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+
+    // dV/dtheta = 3 closes the angle
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].x, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].y, 3.0, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].z, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[2].x, 3.0*sin(1.0), tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[2].y, -3.0*cos(1.0), tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[2].z, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].w + h_force_1.data[1].w + h_force_1.data[2].w, 1.0, tol);
+    }
+
+    // linear interpolation of the same table is noticeably off
+    fc_3->setCubicInterpolation(false);
+    fc_3->compute(1);
+
+    {
+    GPUArray<Scalar4>& force_array_2 =  fc_3->getForceArray();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    BOOST_CHECK(fabs(h_force_2.data[0].w + h_force_2.data[1].w + h_force_2.data[2].w - Scalar(1.0)) > Scalar(0.1));
+    }
+    }
+
 #if 0
 //! Compares the output of two TableAngleForceComputes
 void angle_force_comparison_tests(angleforce_creator tf_creator1,
@@ -322,6 +374,13 @@ BOOST_AUTO_TEST_CASE( TableAngleForceCompute_basic )
     angle_force_basic_tests(tf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for cubic interpolation of angle forces on the CPU
+BOOST_AUTO_TEST_CASE( TableAngleForceCompute_cubic )
+    {
+    angleforce_creator tf_creator = bind(base_class_tf_creator, _1,_2);
+    angle_force_cubic_tests(tf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! boost test case for angle forces on the GPU
 BOOST_AUTO_TEST_CASE( TableAngleForceComputeGPU_basic )
@@ -342,6 +342,62 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, boost::shared_
 
     }
 
+//! checks that cubic interpolation reproduces a cubic potential exactly
+void dihedral_force_cubic_tests(dihedralforce_creator tf_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // right angles at particles 1 and 2 and a dihedral angle of 1 radian, with unit bond lengths
+    boost::shared_ptr<SystemDefinition> sysdef_4(new SystemDefinition(4, BoxDim(1000.0), 1, 0, 0, 1, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_4 = sysdef_4->getParticleData();
+
+    pdata_4->setPosition(0,make_scalar3(0.0,1.0,0.0));
+    pdata_4->setPosition(1,make_scalar3(0.0,0.0,0.0));
+    pdata_4->setPosition(2,make_scalar3(1.0,0.0,0.0));
+    pdata_4->setPosition(3,make_scalar3(1.0,cos(1.0),sin(1.0)));
+    sysdef_4->getDihedralData()->addBondedGroup(Dihedral(0,0,1,2,3));
+
+    // select cubic interpolation before the table is set, the coefficients are computed by setTable
+    unsigned int width = 5;
+    boost::shared_ptr<TableDihedralForceCompute> fc_4 = tf_creator(sysdef_4,width);
+    fc_4->setCubicInterpolation(true);
+
+    // V = phi^3 on 5 points between -pi and pi
+    std::vector<Scalar> V, T;
+    for (unsigned int i = 0; i < width; ++i)
+        {
+        Scalar phi = -M_PI+(Scalar)i/(Scalar)(width-1)*Scalar(2*M_PI);
+        V.push_back(phi*phi*phi);
+        T.push_back(-Scalar(3.0)*phi*phi);
+        }
+    fc_4->setTable(0, V, T);
+
+    fc_4->compute(0);
+
+    {
+    GPUArray<Scalar4>& force_array_1 =  fc_4->getForceArray();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+
+    // dV/dphi = 3 rotates the outer particles towards each other
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].x, tol_small);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].y, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].z, 3.0, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].w, 0.25, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[3].x, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[3].y, 3.0*sin(1.0), tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[3].z, -3.0*cos(1.0), tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[3].w, 0.25, tol);
+    }
+
+    // linear interpolation of the same table is noticeably off
+    fc_4->setCubicInterpolation(false);
+    fc_4->compute(1);
+
+    {
+    GPUArray<Scalar4>& force_array_2 =  fc_4->getForceArray();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    BOOST_CHECK(fabs(h_force_2.data[0].w - Scalar(0.25)) > Scalar(0.01));
+    }
+    }
+
 #if 0
 //! Compares the output of two TableDihedralForceComputes
 void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
@@ -441,6 +497,13 @@ BOOST_AUTO_TEST_CASE( TableDihedralForceCompute_basic )
     dihedral_force_basic_tests(tf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for cubic interpolation of dihedral forces on the CPU
+BOOST_AUTO_TEST_CASE( TableDihedralForceCompute_cubic )
+    {
+    dihedralforce_creator tf_creator = bind(base_class_tf_creator, _1,_2);
+    dihedral_force_cubic_tests(tf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! boost test case for dihedral forces on the GPU
 BOOST_AUTO_TEST_CASE( TableDihedralForceComputeGPU_basic )
@@ -347,6 +347,63 @@ void table_potential_type_test(table_potential_creator table_creator, boost::sha
     }
     }
 
+//! checks that cubic interpolation reproduces a cubic potential exactly
+void table_potential_cubic_test(table_potential_creator table_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = Scalar(1.3); h_pos.data[1].y = h_pos.data[1].z = 0.0;
+    }
+
+    boost::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    boost::shared_ptr<TablePotential> fc = table_creator(sysdef, nlist, 5);
+
+    // V = r^3 on 5 points between 1 and 3
+    vector<Scalar> V, F;
+    for (unsigned int i = 0; i < 5; i++)
+        {
+        Scalar r = Scalar(1.0) + Scalar(0.5) * Scalar(i);
+        V.push_back(r*r*r);
+        F.push_back(-Scalar(3.0)*r*r);
+        }
+    fc->setTable(0, 0, V, F, 1.0, 3.0);
+    fc->setCubicInterpolation(true);
+
+    fc->compute(0);
+
+    {
+    GPUArray<Scalar4>& force_array_1 =  fc->getForceArray();
+    GPUArray<Scalar>& virial_array_1 =  fc->getVirialArray();
+    unsigned int pitch = virial_array_1.getPitch();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_1(virial_array_1,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].x, 5.07, tol);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].y, tol_small);
+    MY_BOOST_CHECK_SMALL(h_force_1.data[0].z, tol_small);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[0].w, 0.5*2.197, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial_1.data[0*pitch+0], -0.5*5.07*1.3, tol);
+
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[1].x, -5.07, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_1.data[1].w, 0.5*2.197, tol);
+    MY_BOOST_CHECK_CLOSE(h_virial_1.data[0*pitch+1], -0.5*5.07*1.3, tol);
+    }
+
+    // switching back to linear interpolation interpolates V and F separately
+    fc->setCubicInterpolation(false);
+    fc->compute(1);
+
+    {
+    GPUArray<Scalar4>& force_array_2 =  fc->getForceArray();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].x, 3.0 + 0.6*3.75, tol);
+    MY_BOOST_CHECK_CLOSE(h_force_2.data[0].w, 0.5*(1.0 + 0.6*2.375), tol);
+    }
+    }
+
 //! TablePotential creator for unit tests
 boost::shared_ptr<TablePotential> base_class_table_creator(boost::shared_ptr<SystemDefinition> sysdef,
                                                     boost::shared_ptr<NeighborList> nlist,
@@ -382,6 +439,13 @@ BOOST_AUTO_TEST_CASE( TablePotential_type )
     table_potential_type_test(table_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for cubic interpolation on CPU
+BOOST_AUTO_TEST_CASE( TablePotential_cubic )
+    {
+    table_potential_creator table_creator_base = bind(base_class_table_creator, _1, _2, _3);
+    table_potential_cubic_test(table_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! boost test case for basic test on GPU
 BOOST_AUTO_TEST_CASE( TablePotentialGPU_basic )
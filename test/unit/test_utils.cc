@@ -54,14 +54,16 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <math.h>
 #include "ClockSource.h"
 #include "Profiler.h"
+#include "PerformanceCounter.h"
 #include "Variant.h"
+#include "RandomNumbers.h"
 
 //! Name the unit test module
 #define BOOST_TEST_MODULE UtilityClassesTests
 #include "boost_utf_configure.h"
 
 /*! \file utils_test.cc
-    \brief Unit tests for ClockSource, Profiler, and Variant
+    \brief Unit tests for ClockSource, Profiler, Variant, and PhiloxGenerator
     \ingroup unit_tests
 */
 
@@ -190,6 +192,35 @@ BOOST_AUTO_TEST_CASE(Profiler_test)
 
     }
 
+//! check the nesting of timed regions and the per interval values of PerformanceCounter
+BOOST_AUTO_TEST_CASE(PerformanceCounter_test)
+    {
+    PerformanceCounter outer, inner, events;
+
+        {
+        PerformanceRegion region_outer(outer);
+        Sleep(100);
+            {
+            PerformanceRegion region_inner(inner);
+            Sleep(200);
+            }
+        Sleep(100);
+        }
+
+    // the inner region is only counted for the inner counter
+    BOOST_CHECK(outer.getTotal() >= int64_t(200e6) && outer.getTotal() < int64_t(280e6));
+    BOOST_CHECK(inner.getTotal() >= int64_t(200e6) && inner.getTotal() < int64_t(280e6));
+
+    // intervals
+    events.add(3);
+    BOOST_CHECK_EQUAL(events.getInterval(10), int64_t(3));
+    events.add(2);
+    BOOST_CHECK_EQUAL(events.getInterval(10), int64_t(3));
+    BOOST_CHECK_EQUAL(events.getInterval(20), int64_t(2));
+    BOOST_CHECK_EQUAL(events.getInterval(30), int64_t(0));
+    BOOST_CHECK_EQUAL(events.getTotal(), int64_t(5));
+    }
+
 //! perform some simple checks on the variant types
 BOOST_AUTO_TEST_CASE(Variant_test)
     {
@@ -284,3 +315,68 @@ BOOST_AUTO_TEST_CASE(VariantLinear_test3)
     BOOST_CHECK_CLOSE(v.getValue(1750), 15.0, tol);
     BOOST_CHECK_CLOSE(v.getValue(3500), 50.0, tol);
     }
+
+//! check the Philox block function against the reference implementation
+BOOST_AUTO_TEST_CASE(Philox_known_answer_test)
+    {
+    unsigned int ctr[4] = {0, 0, 0, 0};
+    unsigned int key[2] = {0, 0};
+    philox4x32_10(ctr, key);
+    BOOST_CHECK_EQUAL(ctr[0], 0x6627e8d5u);
+    BOOST_CHECK_EQUAL(ctr[1], 0xe169c58du);
+    BOOST_CHECK_EQUAL(ctr[2], 0xbc57ac4cu);
+    BOOST_CHECK_EQUAL(ctr[3], 0x9b00dbd8u);
+
+    unsigned int ctr2[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    unsigned int key2[2] = {0xffffffff, 0xffffffff};
+    philox4x32_10(ctr2, key2);
+    BOOST_CHECK_EQUAL(ctr2[0], 0x408f276du);
+    BOOST_CHECK_EQUAL(ctr2[1], 0x41c83b0eu);
+    BOOST_CHECK_EQUAL(ctr2[2], 0xa20bc7c6u);
+    BOOST_CHECK_EQUAL(ctr2[3], 0x6d5451fdu);
+    }
+
+//! check that the numbers only depend on the key and the ids
+BOOST_AUTO_TEST_CASE(PhiloxGenerator_streams_test)
+    {
+    PhiloxGenerator a(12, rng_stream::langevin, 100, 7);
+    PhiloxGenerator b(12, rng_stream::langevin, 100, 7);
+    PhiloxGenerator c(12, rng_stream::langevin, 100, 8);
+    PhiloxGenerator d(12, rng_stream::bd, 100, 7);
+
+    unsigned int n_diff_c = 0;
+    unsigned int n_diff_d = 0;
+    for (unsigned int i = 0; i < 10; i++)
+        {
+        unsigned int ua = a.u32();
+        BOOST_CHECK_EQUAL(ua, b.u32());
+        if (ua != c.u32()) n_diff_c++;
+        if (ua != d.u32()) n_diff_d++;
+        }
+    BOOST_CHECK_EQUAL(n_diff_c, (unsigned int)10);
+    BOOST_CHECK_EQUAL(n_diff_d, (unsigned int)10);
+    }
+
+//! check the moments of the uniform and Gaussian distributions
+BOOST_AUTO_TEST_CASE(PhiloxGenerator_moments_test)
+    {
+    const unsigned int n = 200000;
+    double sum_u = 0, sum_u2 = 0, sum_n = 0, sum_n2 = 0;
+    Scalar min_u = 1, max_u = -1;
+    for (unsigned int tag = 0; tag < n; tag++)
+        {
+        PhiloxGenerator rng(3, rng_stream::dpd, 1, tag);
+        Scalar u = rng.s<Scalar>(-1,1);
+        Scalar g = rng.normal<Scalar>();
+        sum_u += u; sum_u2 += u*u;
+        sum_n += g; sum_n2 += g*g;
+        min_u = std::min(min_u, u);
+        max_u = std::max(max_u, u);
+        }
+
+    BOOST_CHECK(min_u > Scalar(-1.0) && max_u < Scalar(1.0));
+    BOOST_CHECK_SMALL(sum_u/n, 0.01);
+    BOOST_CHECK_CLOSE(sum_u2/n, 1.0/3.0, 1.0);
+    BOOST_CHECK_SMALL(sum_n/n, 0.01);
+    BOOST_CHECK_CLOSE(sum_n2/n, 1.0, 1.0);
+    }